@@ -2,7 +2,6 @@
 #define GPS_H
 
 #include <Arduino.h>
-#include <TinyGPS++.h>
 
 namespace Velma {
 namespace GPS {
@@ -15,10 +14,12 @@ namespace GPS {
      * @brief Initialize the GPS module (UART setup).
      * 
      * Sets up the GPS module with specified serial interface and baud rate.
-     * Also initializes the transistor pin for power control.
+     * Also initializes the transistor pin for power control. The receiver is
+     * then switched to UBX-only output at 115200 baud with NAV-PVT,
+     * NAV-STATUS and NAV-DOP at 10 Hz.
      * 
      * @param serial Reference to HardwareSerial interface (e.g. Serial1).
-     * @param baud_rate Communication baud rate (default 9600).
+     * @param baud_rate Receiver's baud rate at power-up (default 9600).
      */
     void init(HardwareSerial& serial, uint32_t baud_rate = 9600);
 
@@ -137,11 +138,13 @@ namespace GPS {
     /**
      * @brief Read and parse available GPS data.
      * 
-     * Processes incoming NMEA data using TinyGPS++ library.
-     * Updates internal state with latest position, status, and satellite information.
-     * Should be called frequently (e.g., in main loop) to maintain current data.
+     * Parses incoming UBX frames (Fletcher checksum checked) from the UART
+     * receive buffer. Updates internal state with latest position, status,
+     * and satellite information when a NAV-PVT completes an epoch.
+     * Should be called at least every 5 ms at 115200 baud so the receive
+     * buffer does not overflow.
      * 
-     * @return true if new data was processed, false otherwise.
+     * @return true if a new navigation epoch was processed, false otherwise.
      */
     bool read();
 
@@ -10,17 +10,23 @@ byte interruptPin = 3;
 byte channelAmount = 6;
 PPMReader ppm(interruptPin, channelAmount);
 
+unsigned long lastFrame = 0;
+
 void setup() {
     Serial.begin(115200);
 }
 
 void loop() {
-    // Print latest valid values from all channels
-    for (byte channel = 1; channel <= channelAmount; ++channel) {
-        unsigned value = ppm.latestValidChannelValue(channel, 0);
-        Serial.print(value);
-        if(channel < channelAmount) Serial.print('\t');
+    // Print all channels of each new frame, taken from one consistent snapshot
+    unsigned values[6];
+    unsigned long frame = ppm.latestFrame(values);
+    if (frame != lastFrame) {
+        lastFrame = frame;
+        for (byte channel = 0; channel < channelAmount; ++channel) {
+            Serial.print(values[channel]);
+            if(channel < channelAmount - 1) Serial.print('\t');
+        }
+        Serial.println();
     }
-    Serial.println();
     delay(20);
 }
@@ -20,60 +20,132 @@ along with PPM Reader.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "PPMReader.h"
 
-PPMReader *PPMReader::ppm;
+PPMReader *PPMReader::instances[PPM_READER_MAX_INSTANCES];
 
+template <byte instance>
 void PPMReader::PPM_ISR(void) {
-  ppm->handleInterrupt(); 
+  instances[instance]->handlePulse(micros());
 }
 
+void (*const PPMReader::isrTable[PPM_READER_MAX_INSTANCES])(void) = {
+    PPM_ISR<0>, PPM_ISR<1>, PPM_ISR<2>, PPM_ISR<3>
+};
+
 
 PPMReader::PPMReader(byte interruptPin, byte channelAmount):
     interruptPin(interruptPin), channelAmount(channelAmount) {
-    // Setup an array for storing channel values
-    rawValues = new unsigned [channelAmount];
-    for (int i = 0; i < channelAmount; ++i) {
-        rawValues[i] = 0;
+    // Setup both frame buffers for storing channel values
+    frameValues = new unsigned [2 * channelAmount];
+    for (int i = 0; i < 2 * channelAmount; ++i) {
+        frameValues[i] = 0;
     }
-    // Attach an interrupt to the pin
+    // Attach an interrupt to the pin through the first free trampoline
     pinMode(interruptPin, INPUT);
-    if(ppm == NULL) {
-        ppm = this;
-        attachInterrupt(digitalPinToInterrupt(interruptPin), PPM_ISR, RISING);
+    for (byte i = 0; i < PPM_READER_MAX_INSTANCES; ++i) {
+        if (instances[i] == NULL) {
+            slot = i;
+            instances[slot] = this;
+            attachInterrupt(digitalPinToInterrupt(interruptPin), isrTable[slot], RISING);
+            break;
+        }
     }
 }
 
 PPMReader::~PPMReader(void) {
-    detachInterrupt(digitalPinToInterrupt(interruptPin));
-    if(ppm == this) ppm = NULL;
-    delete [] rawValues;
+    if (isAttached()) {
+        detachInterrupt(digitalPinToInterrupt(interruptPin));
+        instances[slot] = NULL;
+    }
+    delete [] frameValues;
 }
 
-void PPMReader::handleInterrupt(void) {
-    // Remember the current micros() and calculate the time since the last pulseReceived()
-    unsigned long previousMicros = microsAtLastPulse;
-    microsAtLastPulse = micros();
-    unsigned long time = microsAtLastPulse - previousMicros;
+void PPMReader::handlePulse(unsigned long pulseMicros) {
+    // Calculate the time since the last pulse
+    unsigned long time = pulseMicros - microsAtLastPulse;
+    microsAtLastPulse = pulseMicros;
 
-    if (time > blankTime) {
-        // Blank detected: restart from channel 1 
+    if (!pulseSeen || time > failsafeTimeout) {
+        // First pulse or signal lost: wait for the next blank
+        pulseSeen = true;
+        synchronized = false;
         pulseCounter = 0;
     }
-    else {
-        // Store times between pulses as channel values
-        if (pulseCounter < channelAmount) {
-            rawValues[pulseCounter] = time;
-            ++pulseCounter;
+    else if (time > blankTime) {
+        // Blank detected: a frame cut short by it is complete, then restart from channel 1
+        if (pulseCounter > 0 && pulseCounter < channelAmount) {
+            publishFrame();
+        }
+        pulseCounter = 0;
+        synchronized = true;
+    }
+    else if (synchronized && pulseCounter < channelAmount) {
+        // Store times between pulses as channel values in the back frame
+        byte back = (frameCounter + 1) & 1;
+        frameValues[back * channelAmount + pulseCounter] = time;
+        ++pulseCounter;
+        // A full frame is published with its last channel rather than at the blank that follows
+        if (pulseCounter == channelAmount) {
+            publishFrame();
+        }
+    }
+}
+
+void PPMReader::publishFrame(void) {
+    byte back = (frameCounter + 1) & 1;
+    volatile unsigned *backValues = frameValues + back * channelAmount;
+    volatile unsigned *frontValues = frameValues + (back ^ 1) * channelAmount;
+    // Channels which were not transmitted keep their old values
+    for (byte i = pulseCounter; i < channelAmount; ++i) {
+        backValues[i] = frontValues[i];
+    }
+    frameMicros[back] = microsAtLastPulse;
+    frameSequences[back] = ++frameSequence;
+    // Flip: the back frame becomes the front one
+    frameCounter = frameCounter + 1;
+}
+
+unsigned long PPMReader::latestFrame(unsigned *values, unsigned long *receivedMicros) {
+    // Copy the front frame and retry if the ISR flipped the frames meanwhile. After a flip it may be
+    // writing the buffer being copied. Frames are milliseconds apart, so a retry almost always succeeds
+    byte counter;
+    unsigned long sequence;
+    unsigned long received;
+    do {
+        counter = frameCounter;
+        byte front = counter & 1;
+        volatile unsigned *frontValues = frameValues + front * channelAmount;
+        for (byte i = 0; i < channelAmount; ++i) {
+            values[i] = frontValues[i];
         }
+        received = frameMicros[front];
+        sequence = frameSequences[front];
+    } while (counter != frameCounter);
+
+    if (receivedMicros != NULL) {
+        *receivedMicros = received;
     }
+    return sequence;
+}
+
+unsigned PPMReader::readChannel(byte index, unsigned long *receivedMicros) {
+    // The same snapshot as latestFrame(), for a single channel
+    byte counter;
+    unsigned value;
+    do {
+        counter = frameCounter;
+        byte front = counter & 1;
+        value = frameValues[front * channelAmount + index];
+        *receivedMicros = frameMicros[front];
+    } while (counter != frameCounter);
+    return value;
 }
 
 unsigned PPMReader::rawChannelValue(byte channel) {
     // Check for channel's validity and return the latest raw channel value or 0
     unsigned value = 0;
     if (channel >= 1 && channel <= channelAmount) {
-        noInterrupts();
-        value = rawValues[channel-1];
-        interrupts();
+        unsigned long received;
+        value = readChannel(channel - 1, &received);
     }
     return value;
 }
@@ -81,18 +153,13 @@ unsigned PPMReader::rawChannelValue(byte channel) {
 unsigned PPMReader::latestValidChannelValue(byte channel, unsigned defaultValue) {
     // Check for channel's validity and return the latest valid channel value or defaultValue.
     unsigned value = defaultValue;
-	unsigned long timeout;
-	noInterrupts();
-	timeout = micros() - microsAtLastPulse;
-	interrupts();
-    if ((timeout < failsafeTimeout) && (channel >= 1) && (channel <= channelAmount)) {
-        noInterrupts();
-        value = rawValues[channel-1];
-		interrupts();
-		if (value >= minChannelValue - channelValueMaxError && value <= maxChannelValue + channelValueMaxError) {
-			value = constrain(value, minChannelValue, maxChannelValue);
-		}
-        else value = defaultValue;
+    if ((channel >= 1) && (channel <= channelAmount)) {
+        unsigned long received;
+        unsigned raw = readChannel(channel - 1, &received);
+        if (micros() - received < failsafeTimeout &&
+            raw >= minChannelValue - channelValueMaxError && raw <= maxChannelValue + channelValueMaxError) {
+            value = constrain(raw, minChannelValue, maxChannelValue);
+        }
     }
     return value;
 }
@@ -23,6 +23,9 @@ along with PPM Reader.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <Arduino.h>
 
+// The maximum number of PPM reader instances, each on its own external interrupt pin
+#define PPM_READER_MAX_INSTANCES 4
+
 class PPMReader {
 
     public:
@@ -50,23 +53,46 @@ class PPMReader {
     // The number of channels to be expected in the PPM signal
     byte channelAmount = 0;
 
-    // Arrays for keeping track of channel values
-    volatile unsigned *rawValues = NULL;
+    // The ISR trampoline slot used by this instance, or PPM_READER_MAX_INSTANCES if none was free
+    byte slot = PPM_READER_MAX_INSTANCES;
+
+    // Two frame buffers of channelAmount values each. The ISR receives into the back one and flips
+    // them when the frame is complete, so it never writes the front frame that readers copy
+    volatile unsigned *frameValues = NULL;
+    volatile unsigned long frameMicros[2] = {0, 0};
+    volatile unsigned long frameSequences[2] = {0, 0};
+
+    // Bumped by the ISR on each flip; its low bit selects the front frame. A reader retries if it
+    // changed during the copy. A single byte so that it is loaded atomically on 8-bit boards
+    volatile byte frameCounter = 0;
+
+    // The number of complete frames received
+    unsigned long frameSequence = 0;
 
     // A counter variable for determining which channel is being read next
-    volatile byte pulseCounter = 0;
+    byte pulseCounter = 0;
+
+    // Pulses are ignored until the first blank, so that a frame joined midway is never published.
+    // The first pulse, or one after a gap longer than failsafeTimeout, only starts the timing
+    bool pulseSeen = false;
+    bool synchronized = false;
 
     // A time variable to remember when the last pulse was read
-    volatile unsigned long microsAtLastPulse = 0;
+    unsigned long microsAtLastPulse = 0;
 
-    // Pointer to PPMReader object used by ISR. Replace by an array if multiple PPM reader instances are needed
-    static PPMReader *ppm;
+    // Instances attached to the ISR trampolines
+    static PPMReader *instances[PPM_READER_MAX_INSTANCES];
 
     public:
 
     PPMReader(byte interruptPin, byte channelAmount);
     ~PPMReader(void);
 
+    // Copies all channels of the latest complete frame into values (channelAmount entries) as one consistent snapshot,
+    // without disabling interrupts. Optionally reports the micros() at which the frame was completed.
+    // Returns the frame's sequence number (counting from 1), or 0 if no complete frame has been received yet
+    unsigned long latestFrame(unsigned *values, unsigned long *receivedMicros = NULL);
+
     // Returns the latest raw (not necessarily valid) value for the channel (starting from 1)
     unsigned rawChannelValue(byte channel);
 
@@ -74,13 +100,23 @@ class PPMReader {
     // Returns defaultValue if the channel hasn't received any valid values yet, or the PPM signal was absent for more than failsafeTimeout
     unsigned latestValidChannelValue(byte channel, unsigned defaultValue);
 
+    // Returns false if all interrupt slots were taken when this instance was created
+    bool isAttached(void) const { return slot < PPM_READER_MAX_INSTANCES; }
+
+    // Handles a pulse edge received at pulseMicros. Called by the ISR; can also be fed recorded pulse times
+    void handlePulse(unsigned long pulseMicros);
+
     private:
 
-    // An interrupt service routine for handling the interrupts activated by PPM pulses
-    void handleInterrupt(void);
+    // Reads one channel (starting from 0) of the latest complete frame
+    unsigned readChannel(byte index, unsigned long *receivedMicros);
+
+    // Completes the frame being received and makes it the front frame
+    void publishFrame(void);
 
-    // Interrupt service routine function compatible with attachInterrupt. Add more funcitons if multiple PPM reader instances are needed
-    static void PPM_ISR(void);
+    // Interrupt service routines compatible with attachInterrupt, one per slot
+    template <byte instance> static void PPM_ISR(void);
+    static void (*const isrTable[PPM_READER_MAX_INSTANCES])(void);
 
 };
 
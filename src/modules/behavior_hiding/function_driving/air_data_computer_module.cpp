@@ -0,0 +1,41 @@
+#include "air_data_computer_module.h"
+
+// Calibration on the shared arena. The remaining AirDataComputerModule
+// operations are implemented against these; calibrationStats is nullptr
+// whenever this module does not hold the arena.
+
+static const uint8_t AIR_DATA_CALIBRATION_DIMS = 6;         // alt, airspeed, pressure, temp, aoa, aos
+static const uint16_t AIR_DATA_CALIBRATION_SAMPLES = 100;   // For a complete calibration
+
+void AirDataComputerModule::startCalibration() {
+    // Refused while another module calibrates; isCalibrating() stays false
+    calibrationStats = calibrationArena.leaseStats(this, AIR_DATA_CALIBRATION_DIMS);
+    if (calibrationStats == nullptr) {
+        return;
+    }
+    calibrationInProgress = true;
+    calibrationStartTime = millis();
+    calibrationSamples = 0;
+}
+
+void AirDataComputerModule::stopCalibration() {
+    calibrationArena.release(this);
+    calibrationStats = nullptr;
+    calibrationInProgress = false;
+}
+
+bool AirDataComputerModule::addCalibrationSample(double altitude, double airspeed, double pressure, double temperature, double aoa, double aos) {
+    if (!calibrationInProgress || calibrationStats == nullptr) {
+        return false;
+    }
+    calibrationStats->add((float)altitude, (float)airspeed, (float)pressure, (float)temperature, (float)aoa, (float)aos);
+    calibrationSamples++;
+    return true;
+}
+
+double AirDataComputerModule::getCalibrationProgress() const {
+    if (calibrationSamples >= AIR_DATA_CALIBRATION_SAMPLES) {
+        return 1.0;
+    }
+    return (double)calibrationSamples / AIR_DATA_CALIBRATION_SAMPLES;
+}
@@ -5,6 +5,8 @@
 #include "../../hardware_hiding/device_interface/air_data_interface.h"
 #include "../../software_decision/physical_models/aircraft_motion.h"
 #include "../../software_decision/application_data_types/numeric_types.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "../../software_decision/software_utility/calibration_arena.h"
 
 // Air data states
 enum class AirDataState {
@@ -92,7 +94,7 @@ enum class AirDataEventType {
 // Air data event structure
 struct AirDataEvent {
     AirDataEventType type;
-    String description;
+    EventText description;
     unsigned long timestamp;
     uint8_t severity;
     bool acknowledged;
@@ -176,7 +178,7 @@ private:
     bool calibrationInProgress;
     unsigned long calibrationStartTime;
     uint16_t calibrationSamples;
-    double calibrationData[100][6]; // [samples][alt, airspeed, pressure, temp, aoa, aos]
+    CalibrationStats* calibrationStats; // Leased from calibrationArena while calibrating: alt, airspeed, pressure, temp, aoa, aos
     
     // Component interfaces
     AirDataInterface* airDataInterface;
@@ -244,12 +246,15 @@ public:
     void validateAirData();
     void updateAirDataQuality();
     
-    // Calibration
+    // Calibration. startCalibration() leases the shared arena and is
+    // refused while another module holds it; stopCalibration() releases it,
+    // so read getCalibrationStats() before stopping.
     void startCalibration();
     void stopCalibration();
     bool isCalibrating() const { return calibrationInProgress; }
     bool addCalibrationSample(double altitude, double airspeed, double pressure, double temperature, double aoa, double aos);
     double getCalibrationProgress() const;
+    const CalibrationStats* getCalibrationStats() const { return calibrationStats; }
     bool calibrateAltitude(double knownAltitude);
     bool calibrateAirspeed(double knownAirspeed);
     bool calibratePressure(double knownPressure);
@@ -268,7 +273,7 @@ public:
     void setLapseRate(double rate);
     
     // Error handling
-    void addEvent(AirDataEventType type, const String& description, uint8_t severity = 128);
+    void addEvent(AirDataEventType type, StringView description, uint8_t severity = 128);
     uint8_t getErrorCount() const { return errorCount; }
     uint8_t getWarningCount() const { return warningCount; }
     uint8_t getCriticalErrorCount() const { return criticalErrorCount; }
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../../hardware_hiding/device_interface/audible_signal_interface.h"
 #include "../../shared_services/mode_determination.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Audio signal types
 enum class AudioSignalType {
@@ -106,7 +107,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeSignalConfigs();
@@ -181,7 +182,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
@@ -10,6 +10,7 @@
 #include "../../hardware_hiding/device_interface/display_interface.h"
 #include "../../hardware_hiding/device_interface/input_interface.h"
 #include "../../behavior_hiding/shared_services/alert_module.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Console States
 enum class ConsoleState {
@@ -58,11 +59,11 @@ struct ConsoleConfig {
 
 // Console Data Structure
 struct ConsoleData {
-    String current_menu;
-    String display_line1;
-    String display_line2;
+    DisplayLine current_menu;
+    DisplayLine display_line1;
+    DisplayLine display_line2;
     char last_key_pressed;
-    String received_data;
+    FixedString<63> received_data;
     bool access_granted;
     bool cheat_code_mode;
     uint32_t timestamp;
@@ -70,8 +71,8 @@ struct ConsoleData {
 
 // Cheat Code Structure
 struct CheatCode {
-    String code;
-    String description;
+    NameText code;
+    EventText description;
     bool enabled;
     uint32_t activation_time;
 };
@@ -96,7 +97,7 @@ private:
     AlertModule* alertModule;
     
     // Menu System
-    String menuItems[10];
+    DisplayLine menuItems[10];
     uint8_t menuItemCount;
     uint8_t currentMenuItem;
     
@@ -106,7 +107,7 @@ private:
     bool cheatCodeMode;
     
     // Access Control
-    String accessCode;
+    NameText accessCode;
     bool accessGranted;
     uint32_t accessTimeout;
     
@@ -144,20 +145,20 @@ public:
     
     // Display Management
     void clearDisplay();
-    void setDisplayLine(uint8_t line, const String& text);
-    void setDisplayLines(const String& line1, const String& line2);
-    void scrollDisplay(const String& text);
+    void setDisplayLine(uint8_t line, StringView text);
+    void setDisplayLines(StringView line1, StringView line2);
+    void scrollDisplay(StringView text);
     void setBacklight(bool enable);
     void setContrast(uint8_t contrast);
     
     // Menu System
-    void addMenuItem(const String& item);
+    void addMenuItem(StringView item);
     void removeMenuItem(uint8_t index);
     void setCurrentMenuItem(uint8_t index);
     void nextMenuItem();
     void previousMenuItem();
     void selectMenuItem();
-    String getCurrentMenuItem() const;
+    StringView getCurrentMenuItem() const;
     
     // Input Handling
     char getLastKeyPressed() const { return consoleData.last_key_pressed; }
@@ -167,22 +168,22 @@ public:
     
     // Communication
     void sendData(const String& data);
-    String getReceivedData() const { return consoleData.received_data; }
+    StringView getReceivedData() const { return consoleData.received_data.view(); }
     bool hasReceivedData() const;
     void clearReceivedData();
     
     // Cheat Code System
-    void addCheatCode(const String& code, const String& description);
-    void removeCheatCode(const String& code);
-    void enableCheatCode(const String& code, bool enable);
-    bool isCheatCodeActive(const String& code) const;
-    void activateCheatCode(const String& code);
-    void deactivateCheatCode(const String& code);
+    void addCheatCode(StringView code, StringView description);
+    void removeCheatCode(StringView code);
+    void enableCheatCode(StringView code, bool enable);
+    bool isCheatCodeActive(StringView code) const;
+    void activateCheatCode(StringView code);
+    void deactivateCheatCode(StringView code);
     void listCheatCodes(String& list);
     
     // Access Control
-    void setAccessCode(const String& code);
-    bool checkAccessCode(const String& code);
+    void setAccessCode(StringView code);
+    bool checkAccessCode(StringView code);
     bool isAccessGranted() const { return accessGranted; }
     void grantAccess();
     void revokeAccess();
@@ -225,7 +226,7 @@ public:
     // Event Handlers
     void onKeyPressed(char key);
     void onMenuSelected(uint8_t item);
-    void onDataReceived(const String& data);
+    void onDataReceived(StringView data);
     void onAlertReceived(const String& alert);
     void onStateChanged(ConsoleState oldState, ConsoleState newState);
     void onModeChanged(ConsoleMode oldMode, ConsoleMode newMode);
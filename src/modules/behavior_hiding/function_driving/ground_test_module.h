@@ -5,6 +5,7 @@
 #include "../../hardware_hiding/device_interface/air_data_interface.h"
 #include "../../hardware_hiding/device_interface/inertial_measurement_interface.h"
 #include "../../software_decision/application_data_types/state_events.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Test states
 enum class TestState {
@@ -65,11 +66,11 @@ struct TestConfig {
 // Test step structure
 struct TestStep {
     uint8_t stepId;
-    String description;
+    EventText description;
     uint16_t duration;           // ms
     bool completed;
     TestResult result;
-    String notes;
+    EventText notes;
     unsigned long startTime;
     unsigned long endTime;
 };
@@ -87,8 +88,8 @@ struct TestData {
     uint8_t completedSteps;
     uint8_t passedSteps;
     uint8_t failedSteps;
-    String description;
-    String operatorName;
+    EventText description;
+    NameText operatorName;
 };
 
 // Test event types
@@ -109,7 +110,7 @@ enum class TestEventType {
 // Test event structure
 struct TestEvent {
     TestEventType type;
-    String description;
+    EventText description;
     unsigned long timestamp;
     uint8_t severity;
     bool acknowledged;
@@ -303,7 +304,7 @@ public:
     bool testObstacleAvoidance();
     
     // Error handling
-    void addEvent(TestEventType type, const String& description, uint8_t severity = 128);
+    void addEvent(TestEventType type, StringView description, uint8_t severity = 128);
     uint8_t getErrorCount() const { return errorCount; }
     uint8_t getWarningCount() const { return warningCount; }
     uint8_t getCriticalErrorCount() const { return criticalErrorCount; }
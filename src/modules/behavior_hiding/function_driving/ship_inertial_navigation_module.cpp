@@ -0,0 +1,42 @@
+#include "ship_inertial_navigation_module.h"
+
+// Calibration on the shared arena. The remaining ShipInertialNavigationModule
+// operations are implemented against these; calibrationStats is nullptr
+// whenever this module does not hold the arena.
+
+static const uint8_t NAV_CALIBRATION_DIMS = 6;          // lat, lon, alt, heading, pitch, roll
+static const uint16_t NAV_CALIBRATION_SAMPLES = 100;    // For a complete calibration
+
+void ShipInertialNavigationModule::startCalibration() {
+    // Refused while another module calibrates; isCalibrating() stays false
+    calibrationStats = calibrationArena.leaseStats(this, NAV_CALIBRATION_DIMS);
+    if (calibrationStats == nullptr) {
+        return;
+    }
+    calibrationInProgress = true;
+    calibrationStartTime = millis();
+    calibrationSamples = 0;
+}
+
+void ShipInertialNavigationModule::stopCalibration() {
+    calibrationArena.release(this);
+    calibrationStats = nullptr;
+    calibrationInProgress = false;
+}
+
+bool ShipInertialNavigationModule::addCalibrationSample(double lat, double lon, double alt, double heading, double pitch, double roll) {
+    if (!calibrationInProgress || calibrationStats == nullptr) {
+        return false;
+    }
+    // Relative to the first sample, so float keeps the spread in latitude
+    calibrationStats->add((float)lat, (float)lon, (float)alt, (float)heading, (float)pitch, (float)roll);
+    calibrationSamples++;
+    return true;
+}
+
+double ShipInertialNavigationModule::getCalibrationProgress() const {
+    if (calibrationSamples >= NAV_CALIBRATION_SAMPLES) {
+        return 1.0;
+    }
+    return (double)calibrationSamples / NAV_CALIBRATION_SAMPLES;
+}
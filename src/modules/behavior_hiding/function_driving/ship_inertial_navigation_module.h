@@ -5,6 +5,8 @@
 #include "../../hardware_hiding/device_interface/inertial_measurement_interface.h"
 #include "../../software_decision/physical_models/aircraft_motion.h"
 #include "../../software_decision/application_data_types/numeric_types.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "../../software_decision/software_utility/calibration_arena.h"
 
 // Navigation states
 enum class NavigationState {
@@ -86,7 +88,7 @@ enum class NavigationEventType {
 // Navigation event structure
 struct NavigationEvent {
     NavigationEventType type;
-    String description;
+    EventText description;
     unsigned long timestamp;
     uint8_t severity;
     bool acknowledged;
@@ -133,7 +135,7 @@ private:
     bool calibrationInProgress;
     unsigned long calibrationStartTime;
     uint16_t calibrationSamples;
-    double calibrationData[100][6]; // [samples][lat, lon, alt, heading, pitch, roll]
+    CalibrationStats* calibrationStats; // Leased from calibrationArena while calibrating: lat, lon, alt, heading, pitch, roll
     
     // Component interfaces
     InertialMeasurementInterface* imuInterface;
@@ -181,12 +183,15 @@ public:
     bool updateIMUData(double heading, double pitch, double roll);
     bool isIMUValid() const { return currentAccuracy.imuValid; }
     
-    // Calibration
+    // Calibration. startCalibration() leases the shared arena and is
+    // refused while another module holds it; stopCalibration() releases it,
+    // so read getCalibrationStats() before stopping.
     void startCalibration();
     void stopCalibration();
     bool isCalibrating() const { return calibrationInProgress; }
     bool addCalibrationSample(double lat, double lon, double alt, double heading, double pitch, double roll);
     double getCalibrationProgress() const;
+    const CalibrationStats* getCalibrationStats() const { return calibrationStats; }
     
     // Accuracy assessment
     bool isNavigationAccurate() const;
@@ -195,7 +200,7 @@ public:
     double getAttitudeAccuracy() const { return currentAccuracy.attitudeAccuracy; }
     
     // Error handling
-    void addEvent(NavigationEventType type, const String& description, uint8_t severity = 128);
+    void addEvent(NavigationEventType type, StringView description, uint8_t severity = 128);
     uint8_t getErrorCount() const { return errorCount; }
     uint8_t getWarningCount() const { return warningCount; }
     uint8_t getCriticalErrorCount() const { return criticalErrorCount; }
@@ -8,6 +8,7 @@
 #include "../../hardware_hiding/extended_computer/computer_state.h"
 #include "../../shared_services/mode_determination.h"
 #include "../../shared_services/system_values.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // System states
 enum class SystemState {
@@ -57,7 +58,7 @@ enum class SystemEventType {
 // System event structure
 struct SystemEvent {
     SystemEventType type;
-    String description;
+    EventText description;
     unsigned long timestamp;
     uint8_t severity;  // 0-255, higher = more severe
     bool acknowledged;
@@ -111,7 +112,7 @@ private:
     void changeState(SystemState newState);
     void changeMode(SystemMode newMode);
     void updateSystemHealth();
-    void addEvent(SystemEventType type, const String& description, uint8_t severity = 128);
+    void addEvent(SystemEventType type, StringView description, uint8_t severity = 128);
     void performSystemCheck();
     void logSystemStatus();
     bool validateStateTransition(SystemState newState);
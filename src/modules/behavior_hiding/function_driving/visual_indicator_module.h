@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../../hardware_hiding/device_interface/panel_interface.h"
 #include "../../shared_services/mode_determination.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Visual indicator types
 enum class IndicatorType {
@@ -125,7 +126,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeIndicators();
@@ -216,7 +217,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
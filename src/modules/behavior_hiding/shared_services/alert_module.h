@@ -2,6 +2,7 @@
 #define ALERT_MODULE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Alert Levels
 enum class AlertLevel {
@@ -40,8 +41,8 @@ struct Alert {
     AlertState state;
     uint32_t timestamp;
     uint32_t duration_ms;
-    String message;
-    String source;
+    EventText message;
+    NameText source;
     bool is_valid;
 };
 
@@ -61,7 +62,7 @@ struct AlertError {
     bool memory_error;
     bool display_error;
     bool audio_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class AlertModule {
@@ -104,19 +105,19 @@ public:
     void reset();
     
     // Alert Creation
-    uint32_t createAlert(AlertLevel level, AlertType type, const String& message, const String& source = "");
-    uint32_t createSystemAlert(AlertLevel level, const String& message);
-    uint32_t createSensorAlert(AlertLevel level, const String& message);
-    uint32_t createCommunicationAlert(AlertLevel level, const String& message);
-    uint32_t createBatteryAlert(AlertLevel level, const String& message);
-    uint32_t createFlightAlert(AlertLevel level, const String& message);
-    uint32_t createSafetyAlert(AlertLevel level, const String& message);
+    uint32_t createAlert(AlertLevel level, AlertType type, StringView message, StringView source = StringView());
+    uint32_t createSystemAlert(AlertLevel level, StringView message);
+    uint32_t createSensorAlert(AlertLevel level, StringView message);
+    uint32_t createCommunicationAlert(AlertLevel level, StringView message);
+    uint32_t createBatteryAlert(AlertLevel level, StringView message);
+    uint32_t createFlightAlert(AlertLevel level, StringView message);
+    uint32_t createSafetyAlert(AlertLevel level, StringView message);
     
     // Alert Management
     bool acknowledgeAlert(uint32_t alertId);
     bool resolveAlert(uint32_t alertId);
     bool dismissAlert(uint32_t alertId);
-    bool updateAlert(uint32_t alertId, const String& newMessage);
+    bool updateAlert(uint32_t alertId, StringView newMessage);
     bool setAlertDuration(uint32_t alertId, uint32_t duration_ms);
     
     // Alert Queries
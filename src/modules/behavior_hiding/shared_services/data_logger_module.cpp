@@ -0,0 +1,561 @@
+#include "data_logger_module.h"
+
+static_assert(DLOG_LEVEL_ERROR == static_cast<uint8_t>(LogLevel::LOG_ERROR),
+              "DLOG levels must match LogLevel");
+static_assert(LOG_FLAG_ERROR_EVENT == (1 << static_cast<uint8_t>(LogEntryType::ERROR_EVENT)),
+              "LogIndexFlag bits must follow LogEntryType order");
+
+// Read callback for LogIndexReader; context is the File being searched
+static uint16_t readFileAt(void* context, uint32_t offset, char* buffer, uint16_t length) {
+    File* file = static_cast<File*>(context);
+    if (!file->seek(offset)) {
+        return 0;
+    }
+    int bytesRead = file->read(buffer, length);
+    return bytesRead > 0 ? (uint16_t)bytesRead : 0;
+}
+
+// Formats one deferred record as a "@D <hex>" line, returns its length
+static uint16_t formatDeferredLine(char* line, const uint8_t* record, uint8_t length) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    char* p = line;
+    *p++ = '@'; *p++ = 'D'; *p++ = ' ';
+    for (uint8_t i = 0; i < length; i++) {
+        *p++ = HEX_DIGITS[record[i] >> 4];
+        *p++ = HEX_DIGITS[record[i] & 0x0F];
+    }
+    *p++ = '\n';
+    *p = '\0';
+    return (uint16_t)(p - line);
+}
+
+// Recovery sink; context is the File being rebuilt
+static bool writeRecoveredData(void* context, const char* data, uint16_t length) {
+    File* file = static_cast<File*>(context);
+    return file->write((const uint8_t*)data, length) == length;
+}
+
+// Log file lifecycle; the index follows the file it describes
+
+bool DataLoggerModule::openLogFile() {
+    // FILE_WRITE appends, which would leave an earlier session's footer in
+    // the middle of the records while beginLogIndex() starts a new, empty
+    // sidecar. Start the log over with its index so the two always match.
+    if (SD.exists(currentFileName) && !SD.remove(currentFileName)) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to replace ";
+        errorInfo.error_message += currentFileName;
+        return false;
+    }
+    currentFile = SD.open(currentFileName, FILE_WRITE);
+    if (!currentFile) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to open ";
+        errorInfo.error_message += currentFileName;
+        return false;
+    }
+    currentFileSize = currentFile.size();
+    writeBuffer = "";
+    lastFlushTime = millis();
+    return beginLogIndex();
+}
+
+void DataLoggerModule::closeLogFile() {
+    if (!currentFile) {
+        return;
+    }
+    // Writes the last partial block and the footer, then flushes
+    finalizeLogIndex();
+    flushBuffer();
+    currentFile.close();
+}
+
+void DataLoggerModule::flushBuffer() {
+    if (!currentFile || writeBuffer.length() == 0) {
+        return;
+    }
+    TRACE_SCOPE(SD_WRITE);
+    size_t length = writeBuffer.length();
+    size_t written = currentFile.write((const uint8_t*)writeBuffer.c_str(), length);
+    currentFileSize += written;
+    if (written != length) {
+        errorInfo.write_error = true;
+        errorInfo.error_message = "Short write to log file";
+    }
+    writeBuffer = "";
+    currentFile.flush();
+    if (indexFile) {
+        indexFile.flush();
+    }
+    lastFlushTime = millis();
+}
+
+String DataLoggerModule::formatLogEntry(LogEntryType type, const String& data) {
+    static const char* const TYPE_NAMES[] = { "FLIGHT", "SENSOR", "SYSTEM", "ERROR", "USER", "CALIB" };
+    String line;
+    if (config.enable_timestamp) {
+        line += String(millis());
+        line += ' ';
+    }
+    line += TYPE_NAMES[static_cast<uint8_t>(type)];
+    line += ' ';
+    line += data;
+    line += '\n';
+    return line;
+}
+
+bool DataLoggerModule::logData(LogEntryType type, const String& data) {
+    TRACE_SCOPE(LOGGING);
+    uint32_t timestamp = millis();
+    String line = formatLogEntry(type, data);
+
+    if (flightRecorder.isActive()) {
+        return appendFlightRecord(line.c_str(), line.length(), timestamp);
+    }
+    if (!currentFile) {
+        errorInfo.write_error = true;
+        errorInfo.error_message = "No log file open";
+        return false;
+    }
+
+    // Offset of the record once the buffer ahead of it reaches the card
+    uint32_t offset = currentFileSize + writeBuffer.length();
+    writeBuffer += line;
+    indexRecord(type, timestamp, offset);
+    lastWriteTime = timestamp;
+
+    if (writeBuffer.length() >= bufferSize || millis() - lastFlushTime >= config.flush_interval_ms) {
+        flushBuffer();
+    }
+    return true;
+}
+
+// Seek index maintenance
+
+String DataLoggerModule::indexFileName(const String& filename) {
+    int dot = filename.lastIndexOf('.');
+    String base = dot >= 0 ? filename.substring(0, dot) : filename;
+    return base + ".IDX";
+}
+
+bool DataLoggerModule::beginLogIndex() {
+    indexBuilder.reset();
+    if (config.index_interval_records == 0) {
+        return true;
+    }
+    indexBuilder.setInterval(config.index_interval_records);
+
+    String sidecarName = indexFileName(currentFileName);
+    if (SD.exists(sidecarName)) {
+        SD.remove(sidecarName);
+    }
+    indexFile = SD.open(sidecarName, FILE_WRITE);
+    if (!indexFile) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to create index file";
+        return false;
+    }
+    return true;
+}
+
+void DataLoggerModule::indexRecord(LogEntryType type, uint32_t timestamp, uint32_t offset) {
+    if (config.index_interval_records == 0) {
+        return;
+    }
+
+    // offset is where the record landed in the log; the index line follows it
+    if (indexBuilder.addRecord(timestamp, offset, static_cast<uint8_t>(type))) {
+        LogIndexEntry entry;
+        if (indexBuilder.takeEntry(entry)) {
+            writeIndexEntry(entry);
+        }
+    }
+}
+
+void DataLoggerModule::writeIndexEntry(const LogIndexEntry& entry) {
+    char line[LOG_INDEX_ENTRY_SIZE + 1];
+    formatLogIndexEntry(entry, line);
+    line[LOG_INDEX_ENTRY_SIZE] = '\0';
+
+    // In-stream copy lets a crashed log be re-indexed by scanning for "@I " lines
+    writeBuffer += line;
+    if (indexFile) {
+        indexFile.write((const uint8_t*)line, LOG_INDEX_ENTRY_SIZE);
+    }
+}
+
+bool DataLoggerModule::finalizeLogIndex() {
+    if (config.index_interval_records == 0 || !indexFile) {
+        return true;
+    }
+
+    LogIndexEntry entry;
+    if (indexBuilder.takeEntry(entry)) {
+        writeIndexEntry(entry);
+    }
+    flushBuffer();
+
+    // Copy the sidecar to the end of the log as the footer
+    LogIndexTrailer trailer;
+    trailer.footerOffset = currentFile.size();
+    trailer.entryCount = 0;
+
+    indexFile.flush();
+    indexFile.seek(0);
+    char chunk[LOG_INDEX_ENTRY_SIZE];
+    while (indexFile.read(chunk, LOG_INDEX_ENTRY_SIZE) == LOG_INDEX_ENTRY_SIZE) {
+        if (currentFile.write((const uint8_t*)chunk, LOG_INDEX_ENTRY_SIZE) != LOG_INDEX_ENTRY_SIZE) {
+            errorInfo.write_error = true;
+            errorInfo.error_message = "Failed to write index footer";
+            return false;
+        }
+        trailer.entryCount++;
+    }
+
+    char trailerLine[LOG_INDEX_TRAILER_SIZE];
+    formatLogIndexTrailer(trailer, trailerLine);
+    currentFile.write((const uint8_t*)trailerLine, LOG_INDEX_TRAILER_SIZE);
+    currentFile.flush();
+    currentFileSize = currentFile.size();
+
+    String sidecarName = indexFileName(currentFileName);
+    indexFile.close();
+    SD.remove(sidecarName);
+    return true;
+}
+
+bool DataLoggerModule::openLogIndex(File& file, LogIndexReader& reader, File& sidecar) {
+    reader = LogIndexReader(readFileAt, &file);
+    if (reader.openFooter(file.size())) {
+        return true;
+    }
+
+    // Log still open or never closed cleanly: fall back to the sidecar
+    sidecar = SD.open(indexFileName(String(file.name())), FILE_READ);
+    if (!sidecar) {
+        return false;
+    }
+    reader = LogIndexReader(readFileAt, &sidecar);
+    return reader.openSidecar(sidecar.size());
+}
+
+// Indexed access
+
+bool DataLoggerModule::readLogRange(const String& filename, uint32_t offset, char* buffer,
+                                    uint16_t length, uint16_t& bytesRead) {
+    bytesRead = 0;
+    File file = SD.open(filename, FILE_READ);
+    if (!file) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to open ";
+        errorInfo.error_message += filename;
+        return false;
+    }
+
+    bytesRead = readFileAt(&file, offset, buffer, length);
+    file.close();
+    return true;
+}
+
+bool DataLoggerModule::seekLogTime(const String& filename, uint32_t timestamp, uint32_t& offset) {
+    File file = SD.open(filename, FILE_READ);
+    if (!file) {
+        return false;
+    }
+
+    File sidecar;
+    LogIndexReader reader(readFileAt, &file);
+    LogIndexEntry entry;
+    bool found = openLogIndex(file, reader, sidecar) && reader.findByTime(timestamp, entry);
+    if (found) {
+        offset = entry.offset;
+    }
+
+    if (sidecar) {
+        sidecar.close();
+    }
+    file.close();
+    return found;
+}
+
+bool DataLoggerModule::findFirstLogEntry(const String& filename, LogEntryType type, uint32_t& offset) {
+    File file = SD.open(filename, FILE_READ);
+    if (!file) {
+        return false;
+    }
+
+    File sidecar;
+    LogIndexReader reader(readFileAt, &file);
+    LogIndexEntry entry;
+    uint16_t flag = (uint16_t)(1u << static_cast<uint8_t>(type));
+    bool found = openLogIndex(file, reader, sidecar) && reader.findFirstWithFlags(flag, entry);
+    if (found) {
+        // Start of the block holding the first entry of this type
+        offset = entry.offset;
+    }
+
+    if (sidecar) {
+        sidecar.close();
+    }
+    file.close();
+    return found;
+}
+
+bool DataLoggerModule::readLogWindow(const String& filename, uint32_t startTime, uint32_t endTime,
+                                     String& content) {
+    File file = SD.open(filename, FILE_READ);
+    if (!file) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to open ";
+        errorInfo.error_message += filename;
+        return false;
+    }
+
+    // Without an index this degrades to a full scan
+    uint32_t startOffset = 0;
+    uint32_t endOffset = file.size();
+
+    File sidecar;
+    LogIndexReader reader(readFileAt, &file);
+    if (openLogIndex(file, reader, sidecar)) {
+        LogIndexEntry entry;
+        uint32_t index;
+        if (reader.findByTime(startTime, entry)) {
+            startOffset = entry.offset;
+        }
+        if (reader.findByTime(endTime, entry, &index) &&
+            reader.getEntry(index + 1, entry)) {
+            endOffset = entry.offset;
+        } else if (!sidecar) {
+            endOffset = reader.getFooterOffset();
+        }
+    }
+    if (sidecar) {
+        sidecar.close();
+    }
+
+    // Block-granular window; index lines are dropped from the output
+    content = "";
+    String line;
+    file.seek(startOffset);
+    for (uint32_t position = startOffset; position < endOffset; position++) {
+        int c = file.read();
+        if (c < 0) {
+            break;
+        }
+        line += (char)c;
+        if (c == '\n') {
+            if (!isLogIndexLine(line.c_str())) {
+                content += line;
+            }
+            line = "";
+        }
+    }
+    if (line.length() > 0 && !isLogIndexLine(line.c_str())) {
+        content += line;
+    }
+
+    file.close();
+    return true;
+}
+
+void DataLoggerModule::setIndexInterval(uint16_t records) {
+    config.index_interval_records = records;
+    indexBuilder.setInterval(records);
+}
+
+// Deferred event log
+
+bool DataLoggerModule::setModuleLogLevel(LogModule module, uint8_t level) {
+    // Only modules marked runtime-adjustable in log_config.h can change
+    return setLogModuleLevel(module, level);
+}
+
+uint8_t DataLoggerModule::processDeferredLog(uint8_t maxRecords) {
+    TRACE_SCOPE(LOGGING);
+    uint8_t record[DLOG_MAX_RECORD_SIZE];
+    uint8_t length;
+    uint8_t processed = 0;
+
+    uint16_t dropped = deferredLog.takeDroppedCount();
+    if (dropped > 0) {
+        DLOG_WARNING(LOGGER_BUFFER_OVERFLOW, dropped);
+    }
+
+    char line[3 + 2 * DLOG_MAX_RECORD_SIZE + 2];
+    while (processed < maxRecords && deferredLog.pop(record, length)) {
+        uint16_t lineLength = formatDeferredLine(line, record, length);
+        if (flightRecorder.isActive()) {
+            flightRecorder.append(line, lineLength, deferredRecordTimestamp(record));
+        } else {
+            LogEntryType type = deferredRecordLevel(record) >= DLOG_LEVEL_ERROR
+                                    ? LogEntryType::ERROR_EVENT
+                                    : LogEntryType::SYSTEM_EVENT;
+            uint32_t offset = currentFileSize + writeBuffer.length();
+            writeBuffer += line;
+            indexRecord(type, deferredRecordTimestamp(record), offset);
+        }
+        processed++;
+    }
+    return processed;
+}
+
+// Trace snapshots
+
+void DataLoggerModule::appendTraceLine(void* context, const char* line, uint16_t length) {
+    DataLoggerModule* logger = static_cast<DataLoggerModule*>(context);
+    if (logger->flightRecorder.isActive()) {
+        logger->flightRecorder.append(line, length, millis());
+        return;
+    }
+    // dumpTrace() lines are short; copy to terminate for String
+    char text[96];
+    if (length >= sizeof(text)) {
+        length = sizeof(text) - 1;
+    }
+    memcpy(text, line, length);
+    text[length] = '\0';
+    logger->writeBuffer += text;
+}
+
+uint8_t DataLoggerModule::logTraceSnapshot() {
+    // Drains the trace ring into the blackbox for trace_to_chrome
+    return dumpTrace(appendTraceLine, this);
+}
+
+// Flight recorder
+
+bool DataLoggerModule::readFlightBlock(void* context, uint32_t block, uint8_t* buffer) {
+    DataLoggerModule* logger = static_cast<DataLoggerModule*>(context);
+    return SdVolume::sdCard()->readBlock(logger->flightRegionStart + block, buffer);
+}
+
+bool DataLoggerModule::writeFlightBlock(void* context, uint32_t block, const uint8_t* buffer) {
+    DataLoggerModule* logger = static_cast<DataLoggerModule*>(context);
+    // Non-blocking: returns once the block is clocked out, the card programs it
+    // in the background and the next command waits for it
+    return SdVolume::sdCard()->writeBlock(logger->flightRegionStart + block, buffer, 0);
+}
+
+bool DataLoggerModule::reserveFlightRegion() {
+    // Second handle on the volume SD.begin() mounted; the FAT is only touched
+    // here, on the ground, never while recording
+    Sd2Card* card = SdVolume::sdCard();
+    SdVolume volume;
+    SdFile root;
+    if (card == nullptr || !volume.init(card) || !root.openRoot(&volume)) {
+        errorInfo.sd_card_error = true;
+        errorInfo.error_message = "Flight recorder: volume not mounted";
+        return false;
+    }
+
+    uint32_t size = (uint32_t)config.flight_recorder_blocks * FLIGHT_BLOCK_SIZE;
+    uint32_t firstBlock = 0;
+    uint32_t lastBlock = 0;
+    SdFile region;
+    bool reserved = false;
+
+    // Reuse the existing file so recovery of the previous flight stays possible
+    if (region.open(&root, FLIGHT_RECORDER_FILE, O_READ)) {
+        reserved = region.fileSize() == size && region.contiguousRange(&firstBlock, &lastBlock);
+        region.close();
+        if (!reserved) {
+            SdFile::remove(&root, FLIGHT_RECORDER_FILE);
+        }
+    }
+    if (!reserved) {
+        reserved = region.createContiguous(&root, FLIGHT_RECORDER_FILE, size) &&
+                   region.contiguousRange(&firstBlock, &lastBlock);
+        region.close();
+    }
+    root.close();
+
+    if (!reserved) {
+        errorInfo.space_error = true;
+        errorInfo.error_message = "Flight recorder: no contiguous space";
+        return false;
+    }
+
+    flightRegionStart = firstBlock;
+    flightRecorder.attach(readFlightBlock, writeFlightBlock, this, config.flight_recorder_blocks);
+    return true;
+}
+
+bool DataLoggerModule::startFlightRecorder() {
+    if (config.flight_recorder_blocks == 0) {
+        return false;
+    }
+    if (flightRecorder.isActive()) {
+        return true;
+    }
+    if (!reserveFlightRegion()) {
+        return false;
+    }
+    if (!flightRecorder.begin()) {
+        errorInfo.sd_card_error = true;
+        errorInfo.error_message = "Flight recorder: region scan failed";
+        return false;
+    }
+    lastFlushTime = millis();
+    return true;
+}
+
+bool DataLoggerModule::stopFlightRecorder() {
+    if (!flightRecorder.end()) {
+        errorInfo.write_error = true;
+        errorInfo.error_message = "Flight recorder: final block write failed";
+        return false;
+    }
+    return true;
+}
+
+bool DataLoggerModule::appendFlightRecord(const char* data, uint16_t length, uint32_t timestamp) {
+    if (!flightRecorder.append(data, length, timestamp)) {
+        errorInfo.write_error = true;
+        return false;
+    }
+    return true;
+}
+
+bool DataLoggerModule::processFlightRecorder() {
+    // flush_interval_ms bounds how much a power loss can take with it
+    if (!flightRecorder.isActive() || millis() - lastFlushTime < config.flush_interval_ms) {
+        return true;
+    }
+    lastFlushTime = millis();
+    if (!flightRecorder.seal()) {
+        errorInfo.write_error = true;
+        return false;
+    }
+    return true;
+}
+
+bool DataLoggerModule::recoverFlightRecorder(const String& filename, FlightRecoveryResult& result,
+                                             uint16_t session) {
+    if (flightRecorder.isActive()) {
+        errorInfo.error_message = "Flight recorder: stop recording before recovery";
+        return false;
+    }
+    if (config.flight_recorder_blocks == 0 || !reserveFlightRegion()) {
+        return false;
+    }
+
+    File output = SD.open(filename, FILE_WRITE);
+    if (!output) {
+        errorInfo.file_system_error = true;
+        errorInfo.error_message = "Failed to create ";
+        errorInfo.error_message += filename;
+        return false;
+    }
+
+    // The recorder's block buffer is idle; the SD cache is not, output writes use it
+    uint8_t* block = flightRecorder.getIdleBuffer();
+    bool recovered = recoverFlightSession(readFlightBlock, this, config.flight_recorder_blocks, session,
+                                          writeRecoveredData, &output, block, result);
+    output.close();
+
+    if (!recovered) {
+        errorInfo.error_message = "Flight recorder: nothing to recover";
+    }
+    return recovered;
+}
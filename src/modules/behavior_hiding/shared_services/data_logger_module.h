@@ -3,6 +3,14 @@
 
 #include <Arduino.h>
 #include <SD.h>
+#include "log_index.h"
+#include "deferred_log.h"
+#include "flight_recorder.h"
+#include "../../software_decision/software_utility/trace.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
+
+// Pre-allocated contiguous file whose blocks back the flight recorder ring
+#define FLIGHT_RECORDER_FILE "FLIGHT.REC"
 
 // Logger States
 enum class LoggerState {
@@ -58,6 +66,8 @@ struct LoggerConfig {
     bool enable_timestamp;
     uint16_t flush_interval_ms;
     String log_directory;
+    uint16_t index_interval_records;  // Records per seek index block (0 = no index)
+    uint16_t flight_recorder_blocks;  // Raw SD blocks reserved for the flight recorder (0 = disabled)
 };
 
 // Logger Error Information
@@ -66,7 +76,7 @@ struct LoggerError {
     bool file_system_error;
     bool write_error;
     bool space_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class DataLoggerModule {
@@ -93,6 +103,14 @@ private:
     String writeBuffer;
     uint16_t bufferSize;
     
+    // Seek Index
+    LogIndexBuilder indexBuilder;
+    File indexFile;
+    
+    // Flight Recorder
+    FlightRecorder flightRecorder;
+    uint32_t flightRegionStart;
+    
     // Private Methods
     bool initializeSDCard();
     bool createLogFile();
@@ -104,6 +122,20 @@ private:
     String generateFileName();
     String formatTimestamp(uint32_t timestamp);
     
+    // Seek index maintenance, driven from openLogFile()/logData()/closeLogFile()
+    String indexFileName(const String& filename);
+    bool beginLogIndex();
+    void indexRecord(LogEntryType type, uint32_t timestamp, uint32_t offset);
+    void writeIndexEntry(const LogIndexEntry& entry);
+    bool finalizeLogIndex();
+    bool openLogIndex(File& file, LogIndexReader& reader, File& sidecar);
+    
+    // Flight recorder region on the raw card
+    bool reserveFlightRegion();
+    static bool readFlightBlock(void* context, uint32_t block, uint8_t* buffer);
+    static bool writeFlightBlock(void* context, uint32_t block, const uint8_t* buffer);
+    static void appendTraceLine(void* context, const char* line, uint16_t length);
+    
 public:
     DataLoggerModule(int cs_pin = 4);
     ~DataLoggerModule();
@@ -140,11 +172,19 @@ public:
     bool deleteLogFile(const String& filename);
     bool listLogFiles(String& fileList);
     
+    // Indexed Access (closed logs use the footer, open or crashed logs the sidecar)
+    bool readLogRange(const String& filename, uint32_t offset, char* buffer, uint16_t length, uint16_t& bytesRead);
+    bool seekLogTime(const String& filename, uint32_t timestamp, uint32_t& offset);
+    bool findFirstLogEntry(const String& filename, LogEntryType type, uint32_t& offset);
+    bool readLogWindow(const String& filename, uint32_t startTime, uint32_t endTime, String& content);
+    void setIndexInterval(uint16_t records);
+    
     // Specialized Logging
     bool logBlackboxData(const String& data);
     bool storeCheatCodeScript(const String& scriptName, const String& script);
     bool retrieveCheatCodeScript(const String& scriptName, String& script);
     bool logTelemetryData(const String& data);
+    uint8_t logTraceSnapshot();
     
     // Sensor-specific logging methods
     bool logSensorData(SensorType sensorType, const String& sensorData, uint32_t timestamp = 0);
@@ -154,6 +194,15 @@ public:
     // Non-blocking operations for flight loops
     bool writeNonBlocking(const String& data);
     bool processBufferedWrites();
+    uint8_t processDeferredLog(uint8_t maxRecords = 8);
+    
+    // Flight Recorder (while active, logData() appends here instead of writeBuffer)
+    bool startFlightRecorder();
+    bool stopFlightRecorder();
+    bool appendFlightRecord(const char* data, uint16_t length, uint32_t timestamp);
+    bool processFlightRecorder();
+    bool recoverFlightRecorder(const String& filename, FlightRecoveryResult& result, uint16_t session = 0);
+    bool isFlightRecorderActive() const { return flightRecorder.isActive(); }
     
     // Data Access
     LoggerState getState() const { return currentState; }
@@ -184,6 +233,7 @@ public:
     void setBufferSize(uint16_t size);
     void enableTimestamp(bool enable);
     void setLogLevel(uint8_t level);
+    bool setModuleLogLevel(LogModule module, uint8_t level);
     
     // Utility Functions
     String formatLogEntry(LogEntryType type, const String& data);
@@ -0,0 +1,179 @@
+#include "deferred_log.h"
+
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+static_assert((DEFERRED_LOG_CAPACITY & (DEFERRED_LOG_CAPACITY - 1)) == 0,
+              "DEFERRED_LOG_CAPACITY must be a power of two");
+
+static const uint16_t DLOG_MASK = DEFERRED_LOG_CAPACITY - 1;
+
+DeferredLog deferredLog;
+
+DeferredLog::DeferredLog() : head(0), tail(0), droppedCount(0) {
+}
+
+bool DeferredLog::write(const uint8_t* data, uint8_t length) {
+    uint16_t h = head;
+    if ((uint16_t)(DEFERRED_LOG_CAPACITY - (uint16_t)(h - tail)) < length) {
+        droppedCount++;
+        return false;
+    }
+
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[(h + i) & DLOG_MASK] = data[i];
+    }
+    head = h + length;
+    return true;
+}
+
+bool DeferredLog::pop(uint8_t* out, uint8_t& length) {
+    uint16_t t = tail;
+    if ((uint16_t)(head - t) < DLOG_HEADER_SIZE) {
+        return false;
+    }
+
+    length = DLOG_HEADER_SIZE + buffer[(t + 7) & DLOG_MASK];
+    for (uint8_t i = 0; i < length; i++) {
+        out[i] = buffer[(t + i) & DLOG_MASK];
+    }
+    tail = t + length;
+    return true;
+}
+
+uint16_t DeferredLog::takeDroppedCount() {
+    uint16_t dropped = droppedCount;
+    droppedCount = 0;
+    return dropped;
+}
+
+void DeferredLog::clear() {
+    tail = head;
+    droppedCount = 0;
+}
+
+// Host-side decoding. The dictionary is left out of firmware builds so the
+// format strings never take up RAM on the aircraft.
+
+#ifndef ARDUINO
+
+#define LOG_FORMAT_STRING(id, module, format) format,
+#define LOG_FORMAT_COMPONENT(id, module, format) #module,
+
+static const char* const FORMAT_STRINGS[] = { LOG_FORMATS(LOG_FORMAT_STRING) };
+static const char* const FORMAT_COMPONENTS[] = { LOG_FORMATS(LOG_FORMAT_COMPONENT) };
+
+#undef LOG_FORMAT_STRING
+#undef LOG_FORMAT_COMPONENT
+
+const char* deferredFormatString(uint16_t id) {
+    return id < (uint16_t)LogFormatId::COUNT ? FORMAT_STRINGS[id] : nullptr;
+}
+
+const char* deferredComponent(uint16_t id) {
+    return id < (uint16_t)LogFormatId::COUNT ? FORMAT_COMPONENTS[id] : nullptr;
+}
+
+static bool readDeferredArg(const uint8_t*& p, const uint8_t* end, uint8_t& tag,
+                            long long& integer, double& real) {
+    if (p >= end) {
+        return false;
+    }
+    tag = *p++;
+    uint8_t width = tag & 0x0F;
+    if (width == 0 || width > 8 || p + width > end) {
+        return false;
+    }
+
+    if (tag & DLOG_ARG_FLOAT) {
+        float value;
+        memcpy(&value, p, sizeof(float));
+        real = value;
+    } else {
+        uint64_t raw = 0;
+        for (uint8_t i = 0; i < width; i++) {
+            raw |= (uint64_t)p[i] << (8 * i);
+        }
+        if ((tag & DLOG_ARG_SIGNED) && width < 8 && (raw & (1ULL << (8 * width - 1)))) {
+            raw |= ~0ULL << (8 * width);
+        }
+        integer = (long long)raw;
+    }
+    p += width;
+    return true;
+}
+
+uint16_t formatDeferredRecord(const uint8_t* record, uint8_t length, char* out, uint16_t outSize) {
+    if (outSize == 0) {
+        return 0;
+    }
+    out[0] = '\0';
+    if (length < DLOG_HEADER_SIZE) {
+        return 0;
+    }
+
+    const char* format = deferredFormatString(deferredRecordId(record));
+    if (format == nullptr) {
+        return snprintf(out, outSize, "<unknown format %u>", deferredRecordId(record));
+    }
+
+    const uint8_t* arg = record + DLOG_HEADER_SIZE;
+    const uint8_t* end = record + length;
+    uint16_t used = 0;
+
+    while (*format != '\0' && used + 1 < outSize) {
+        if (*format != '%') {
+            out[used++] = *format++;
+            continue;
+        }
+        if (format[1] == '%') {
+            out[used++] = '%';
+            format += 2;
+            continue;
+        }
+
+        // Copy flags, width and precision; drop length modifiers since the
+        // argument tag already says how wide the value is
+        char spec[16];
+        uint8_t specLength = 0;
+        spec[specLength++] = *format++;
+        while (*format != '\0' && strchr("-+ #0123456789.", *format) != nullptr && specLength < 10) {
+            spec[specLength++] = *format++;
+        }
+        while (*format == 'l' || *format == 'h') {
+            format++;
+        }
+        char conversion = *format != '\0' ? *format++ : 'd';
+
+        uint8_t tag;
+        long long integer = 0;
+        double real = 0;
+        int written;
+        if (!readDeferredArg(arg, end, tag, integer, real)) {
+            written = snprintf(out + used, outSize - used, "<?>");
+        } else if (strchr("fFeEgG", conversion) != nullptr) {
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            written = snprintf(out + used, outSize - used, spec,
+                               (tag & DLOG_ARG_FLOAT) ? real : (double)integer);
+        } else {
+            spec[specLength++] = 'l';
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion == 'c' ? 'd' : conversion;
+            spec[specLength] = '\0';
+            written = snprintf(out + used, outSize - used, spec,
+                               (tag & DLOG_ARG_FLOAT) ? (long long)real : integer);
+        }
+
+        if (written < 0) {
+            break;
+        }
+        used += (uint16_t)written < outSize - used ? (uint16_t)written : outSize - used - 1;
+    }
+
+    out[used] = '\0';
+    return used;
+}
+
+#endif // ARDUINO
@@ -0,0 +1,139 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <stdint.h>
+#include <string.h>
+#include "log_formats.h"
+
+// Deferred-formatting event log.
+//
+// DLOG_* macros store only the format ID, a timestamp and the raw argument
+// bytes in a RAM ring; no String is built and no number is formatted on the
+// aircraft. DataLoggerModule::processDeferredLog() drains the ring into the
+// flight log as "@D <hex>" lines, and the host decoder rebuilds the text
+// from log_formats.h.
+//
+//   record: id (2) | timestamp (4) | level (1) | arg bytes (1) | args
+//   arg:    type tag (1) | little-endian value (1, 2 or 4 bytes)
+//
+// Arguments must be integers, bool or float. Strings belong in the format
+// table, so passing a char pointer fails to compile. Calls filtered out by
+// log_config.h compile to nothing, arguments included, and evaluate false.
+
+#ifndef DEFERRED_LOG_CAPACITY
+#define DEFERRED_LOG_CAPACITY 256   // Bytes, must be a power of two
+#endif
+
+#ifndef DLOG_TIMESTAMP
+#define DLOG_TIMESTAMP() millis()
+#endif
+
+#define DLOG(level, id, ...) \
+    (LOG_ENABLED((level), logFormatModule(LogFormatId::id)) && \
+     deferredLog.record(LogFormatId::id, (level), DLOG_TIMESTAMP(), ##__VA_ARGS__))
+
+#define DLOG_DEBUG(id, ...)    DLOG(DLOG_LEVEL_DEBUG, id, ##__VA_ARGS__)
+#define DLOG_INFO(id, ...)     DLOG(DLOG_LEVEL_INFO, id, ##__VA_ARGS__)
+#define DLOG_WARNING(id, ...)  DLOG(DLOG_LEVEL_WARNING, id, ##__VA_ARGS__)
+#define DLOG_ERROR(id, ...)    DLOG(DLOG_LEVEL_ERROR, id, ##__VA_ARGS__)
+#define DLOG_CRITICAL(id, ...) DLOG(DLOG_LEVEL_CRITICAL, id, ##__VA_ARGS__)
+
+static const uint8_t DLOG_HEADER_SIZE = 8;
+static const uint8_t DLOG_MAX_RECORD_SIZE = 64;
+
+// Argument type tags: low nibble is the byte width
+static const uint8_t DLOG_ARG_SIGNED = 0x10;
+static const uint8_t DLOG_ARG_FLOAT = 0x20;
+
+// Encoded size of each argument type
+template <typename T> struct DeferredArgSize { static const uint8_t value = 1 + sizeof(T); };
+template <> struct DeferredArgSize<double> { static const uint8_t value = 1 + sizeof(float); };
+
+template <typename... Args> struct DeferredArgsSize;
+template <> struct DeferredArgsSize<> { static const uint8_t value = 0; };
+template <typename T, typename... Rest> struct DeferredArgsSize<T, Rest...> {
+    static const uint8_t value = DeferredArgSize<T>::value + DeferredArgsSize<Rest...>::value;
+};
+
+template <typename T>
+inline uint8_t* putDeferredArg(uint8_t* p, T value) {
+    *p++ = (uint8_t)(sizeof(T) | ((T)-1 < (T)0 ? DLOG_ARG_SIGNED : 0));
+    memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+}
+
+inline uint8_t* putDeferredArg(uint8_t* p, float value) {
+    *p++ = DLOG_ARG_FLOAT | sizeof(float);
+    memcpy(p, &value, sizeof(float));
+    return p + sizeof(float);
+}
+
+inline uint8_t* putDeferredArg(uint8_t* p, double value) {
+    return putDeferredArg(p, (float)value);
+}
+
+uint8_t* putDeferredArg(uint8_t* p, const char* value) = delete;
+uint8_t* putDeferredArg(uint8_t* p, char* value) = delete;
+
+inline void putDeferredArgs(uint8_t*) {}
+
+template <typename T, typename... Rest>
+inline void putDeferredArgs(uint8_t* p, T value, Rest... rest) {
+    putDeferredArgs(putDeferredArg(p, value), rest...);
+}
+
+class DeferredLog {
+private:
+    uint8_t buffer[DEFERRED_LOG_CAPACITY];
+    volatile uint16_t head;       // Next byte to write
+    volatile uint16_t tail;       // Next byte to read
+    uint16_t droppedCount;
+
+    bool write(const uint8_t* data, uint8_t length);
+
+public:
+    DeferredLog();
+
+    // Single producer: call from the main loop, not from ISRs
+    template <typename... Args>
+    bool record(LogFormatId id, uint8_t level, uint32_t timestamp, Args... args) {
+        static_assert(DLOG_HEADER_SIZE + DeferredArgsSize<Args...>::value <= DLOG_MAX_RECORD_SIZE,
+                      "Too many deferred log arguments");
+        uint8_t entry[DLOG_HEADER_SIZE + DeferredArgsSize<Args...>::value];
+        uint16_t rawId = static_cast<uint16_t>(id);
+        memcpy(entry, &rawId, 2);
+        memcpy(entry + 2, &timestamp, 4);
+        entry[6] = level;
+        entry[7] = DeferredArgsSize<Args...>::value;
+        putDeferredArgs(entry + DLOG_HEADER_SIZE, args...);
+        return write(entry, sizeof(entry));
+    }
+
+    // Copies the oldest record into out (DLOG_MAX_RECORD_SIZE bytes)
+    bool pop(uint8_t* out, uint8_t& length);
+
+    uint16_t available() const { return (uint16_t)(head - tail); }
+    bool isEmpty() const { return head == tail; }
+    uint16_t getDroppedCount() const { return droppedCount; }
+    uint16_t takeDroppedCount();
+    void clear();
+};
+
+extern DeferredLog deferredLog;
+
+// Record accessors
+inline uint16_t deferredRecordId(const uint8_t* record) { return record[0] | (record[1] << 8); }
+inline uint32_t deferredRecordTimestamp(const uint8_t* record) {
+    uint32_t timestamp;
+    memcpy(&timestamp, record + 2, 4);
+    return timestamp;
+}
+inline uint8_t deferredRecordLevel(const uint8_t* record) { return record[6]; }
+
+// Host-side only: dictionary lookups (nullptr for unknown IDs) and text
+// reconstruction, which returns the number of characters written
+const char* deferredFormatString(uint16_t id);
+const char* deferredComponent(uint16_t id);
+uint16_t formatDeferredRecord(const uint8_t* record, uint8_t length, char* out, uint16_t outSize);
+
+#endif // DEFERRED_LOG_H
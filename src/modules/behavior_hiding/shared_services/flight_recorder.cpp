@@ -0,0 +1,263 @@
+#include "flight_recorder.h"
+#include <string.h>
+
+static_assert(sizeof(FlightBlockHeader) == FLIGHT_BLOCK_HEADER_SIZE, "FlightBlockHeader must be packed");
+
+// CRC-32 (IEEE, reflected), nibble table keeps it at 64 bytes
+static const uint32_t CRC_TABLE[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+uint32_t flightBlockCrc(const uint8_t* block) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (uint16_t i = 0; i < FLIGHT_BLOCK_SIZE - FLIGHT_BLOCK_CRC_SIZE; i++) {
+        crc = CRC_TABLE[(crc ^ block[i]) & 0x0F] ^ (crc >> 4);
+        crc = CRC_TABLE[(crc ^ (block[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+bool isValidFlightBlock(const uint8_t* block, FlightBlockHeader& header) {
+    memcpy(&header, block, sizeof(header));
+    if (header.magic != FLIGHT_BLOCK_MAGIC || header.length > FLIGHT_BLOCK_PAYLOAD_SIZE) {
+        return false;
+    }
+    uint32_t stored;
+    memcpy(&stored, block + FLIGHT_BLOCK_SIZE - FLIGHT_BLOCK_CRC_SIZE, sizeof(stored));
+    return stored == flightBlockCrc(block);
+}
+
+bool scanFlightRegion(FlightBlockReadFn readFn, void* context, uint32_t blockCount,
+                      uint8_t* block, FlightRegionInfo& info) {
+    info.validBlocks = 0;
+    info.lastSequence = 0;
+    info.lastSession = 0;
+
+    FlightBlockHeader header;
+    for (uint32_t slot = 0; slot < blockCount; slot++) {
+        if (!readFn(context, slot, block)) {
+            return false;
+        }
+        if (!isValidFlightBlock(block, header) || header.sequence % blockCount != slot) {
+            continue;
+        }
+        if (info.validBlocks == 0 || header.sequence > info.lastSequence) {
+            info.lastSequence = header.sequence;
+            info.lastSession = header.session;
+        }
+        info.validBlocks++;
+    }
+    return true;
+}
+
+static bool writeGap(FlightRecoverySinkFn sinkFn, void* sinkContext, uint32_t missing, bool midLine) {
+    char line[16];
+    char* p = line;
+    if (midLine) {
+        *p++ = '\n';
+    }
+    *p++ = '@'; *p++ = 'G'; *p++ = ' ';
+
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (missing % 10);
+        missing /= 10;
+    } while (missing > 0);
+    while (count > 0) {
+        *p++ = digits[--count];
+    }
+    *p++ = '\n';
+    return sinkFn(sinkContext, line, (uint16_t)(p - line));
+}
+
+bool recoverFlightSession(FlightBlockReadFn readFn, void* context, uint32_t blockCount,
+                          uint16_t session, FlightRecoverySinkFn sinkFn, void* sinkContext,
+                          uint8_t* block, FlightRecoveryResult& result) {
+    memset(&result, 0, sizeof(result));
+    if (blockCount == 0) {
+        return false;
+    }
+
+    if (session == 0) {
+        FlightRegionInfo info;
+        if (!scanFlightRegion(readFn, context, blockCount, block, info) || info.validBlocks == 0) {
+            return false;
+        }
+        session = info.lastSession;
+    }
+    result.session = session;
+
+    // First pass: sequence range of the session that survived in the ring
+    FlightBlockHeader header;
+    bool found = false;
+    for (uint32_t slot = 0; slot < blockCount; slot++) {
+        if (!readFn(context, slot, block)) {
+            return false;
+        }
+        if (!isValidFlightBlock(block, header) || header.session != session ||
+            header.sequence % blockCount != slot) {
+            continue;
+        }
+        if (!found || header.sequence < result.firstSequence) {
+            result.firstSequence = header.sequence;
+        }
+        if (!found || header.sequence > result.lastSequence) {
+            result.lastSequence = header.sequence;
+        }
+        found = true;
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Second pass: emit payloads in sequence order, one "@G" line per gap
+    uint32_t missing = 0;
+    bool midLine = false;
+    for (uint32_t sequence = result.firstSequence; ; sequence++) {
+        if (!readFn(context, sequence % blockCount, block)) {
+            return false;
+        }
+        if (isValidFlightBlock(block, header) && header.session == session &&
+            header.sequence == sequence) {
+            if (missing > 0) {
+                if (!writeGap(sinkFn, sinkContext, missing, midLine)) {
+                    return false;
+                }
+                result.blocksMissing += missing;
+                missing = 0;
+                midLine = false;
+            }
+            if (header.length > 0) {
+                if (!sinkFn(sinkContext, (const char*)block + FLIGHT_BLOCK_HEADER_SIZE, header.length)) {
+                    return false;
+                }
+                midLine = block[FLIGHT_BLOCK_HEADER_SIZE + header.length - 1] != '\n';
+            }
+            if (result.blocksRecovered == 0) {
+                result.firstTimestamp = header.firstTimestamp;
+            }
+            result.lastTimestamp = header.lastTimestamp;
+            result.blocksRecovered++;
+            result.bytesRecovered += header.length;
+        } else {
+            missing++;
+        }
+
+        if (sequence == result.lastSequence) {
+            break;
+        }
+    }
+    return true;
+}
+
+FlightRecorder::FlightRecorder()
+    : readFn(nullptr), writeFn(nullptr), deviceContext(nullptr), blockCount(0),
+      active(false), blocksWritten(0), writeErrors(0) {
+    memset(&header, 0, sizeof(header));
+}
+
+void FlightRecorder::attach(FlightBlockReadFn read, FlightBlockWriteFn write, void* context, uint32_t blocks) {
+    readFn = read;
+    writeFn = write;
+    deviceContext = context;
+    blockCount = blocks;
+    active = false;
+}
+
+void FlightRecorder::startBlock() {
+    header.magic = FLIGHT_BLOCK_MAGIC;
+    header.length = 0;
+    header.firstTimestamp = 0;
+    header.lastTimestamp = 0;
+}
+
+bool FlightRecorder::begin() {
+    active = false;
+    if (readFn == nullptr || writeFn == nullptr || blockCount == 0) {
+        return false;
+    }
+
+    FlightRegionInfo info;
+    if (!scanFlightRegion(readFn, deviceContext, blockCount, block, info)) {
+        return false;
+    }
+
+    if (info.validBlocks > 0) {
+        header.sequence = info.lastSequence + 1;
+        header.session = info.lastSession + 1;
+    } else {
+        header.sequence = 0;
+        header.session = 1;
+    }
+    if (header.session == 0) {
+        header.session = 1;  // 0 means "latest" to recoverFlightSession()
+    }
+
+    blocksWritten = 0;
+    writeErrors = 0;
+    startBlock();
+    active = true;
+    return true;
+}
+
+bool FlightRecorder::end() {
+    if (!active) {
+        return true;
+    }
+    bool ok = seal();
+    active = false;
+    return ok;
+}
+
+bool FlightRecorder::append(const char* data, uint16_t length, uint32_t timestamp) {
+    if (!active) {
+        return false;
+    }
+
+    bool ok = true;
+    while (length > 0) {
+        if (header.length == 0) {
+            header.firstTimestamp = timestamp;
+        }
+        header.lastTimestamp = timestamp;
+
+        uint16_t space = FLIGHT_BLOCK_PAYLOAD_SIZE - header.length;
+        uint16_t chunk = length < space ? length : space;
+        memcpy(block + FLIGHT_BLOCK_HEADER_SIZE + header.length, data, chunk);
+        header.length += chunk;
+        data += chunk;
+        length -= chunk;
+
+        if (header.length == FLIGHT_BLOCK_PAYLOAD_SIZE) {
+            ok = seal() && ok;
+        }
+    }
+    return ok;
+}
+
+bool FlightRecorder::seal() {
+    if (!active || header.length == 0) {
+        return true;
+    }
+
+    memcpy(block, &header, sizeof(header));
+    memset(block + FLIGHT_BLOCK_HEADER_SIZE + header.length, 0, FLIGHT_BLOCK_PAYLOAD_SIZE - header.length);
+    uint32_t crc = flightBlockCrc(block);
+    memcpy(block + FLIGHT_BLOCK_SIZE - FLIGHT_BLOCK_CRC_SIZE, &crc, sizeof(crc));
+
+    // A failed write still consumes its sequence number; recovery reports the gap
+    bool ok = writeFn(deviceContext, header.sequence % blockCount, block);
+    if (ok) {
+        blocksWritten++;
+    } else {
+        writeErrors++;
+    }
+
+    header.sequence++;
+    startBlock();
+    return ok;
+}
@@ -0,0 +1,117 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+
+// Crash-safe flight recorder ring.
+//
+// Log bytes are packed into 512-byte blocks written straight to a reserved
+// range of raw SD blocks, so nothing in flight touches the FAT, the
+// directory or the SD library's block cache. Block sequence numbers are
+// monotonic across sessions and block N lands in slot N % blockCount. Every
+// block carries its session, sequence and a CRC32; a block torn by power
+// loss fails its check and recoverFlightSession() reports it as a gap while
+// rebuilding the byte stream in sequence order.
+//
+// A block is written once and never rewritten, so a power loss can only
+// cost the block being programmed plus whatever was still in RAM. seal()
+// bounds the latter by committing a partly filled block.
+
+#define FLIGHT_BLOCK_SIZE 512
+#define FLIGHT_BLOCK_MAGIC 0x31524656UL  // "VFR1"
+#define FLIGHT_BLOCK_HEADER_SIZE 20
+#define FLIGHT_BLOCK_CRC_SIZE 4
+#define FLIGHT_BLOCK_PAYLOAD_SIZE (FLIGHT_BLOCK_SIZE - FLIGHT_BLOCK_HEADER_SIZE - FLIGHT_BLOCK_CRC_SIZE)
+
+// Block layout: header | payload | CRC32 over header and payload
+struct FlightBlockHeader {
+    uint32_t magic;
+    uint32_t sequence;        // Monotonic across sessions
+    uint16_t session;         // Incremented by every FlightRecorder::begin()
+    uint16_t length;          // Payload bytes used
+    uint32_t firstTimestamp;  // Timestamp of the first append into the block
+    uint32_t lastTimestamp;   // Timestamp of the last append into the block
+};
+
+// Block device callbacks; block numbers are relative to the reserved region
+typedef bool (*FlightBlockReadFn)(void* context, uint32_t block, uint8_t* buffer);
+typedef bool (*FlightBlockWriteFn)(void* context, uint32_t block, const uint8_t* buffer);
+
+// Receives the recovered byte stream
+typedef bool (*FlightRecoverySinkFn)(void* context, const char* data, uint16_t length);
+
+// Region summary found by scanFlightRegion()
+struct FlightRegionInfo {
+    uint32_t validBlocks;
+    uint32_t lastSequence;    // Highest valid sequence number
+    uint16_t lastSession;     // Session of the block holding lastSequence
+};
+
+struct FlightRecoveryResult {
+    uint16_t session;
+    uint32_t firstSequence;
+    uint32_t lastSequence;
+    uint32_t blocksRecovered;
+    uint32_t blocksMissing;   // Torn, overwritten or never written
+    uint32_t bytesRecovered;
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+};
+
+uint32_t flightBlockCrc(const uint8_t* block);
+bool isValidFlightBlock(const uint8_t* block, FlightBlockHeader& header);
+
+// Full region scan; block is a FLIGHT_BLOCK_SIZE scratch buffer
+bool scanFlightRegion(FlightBlockReadFn readFn, void* context, uint32_t blockCount,
+                      uint8_t* block, FlightRegionInfo& info);
+
+// Rebuilds one session in sequence order; each gap is written to the sink
+// as a "@G <missing blocks>" line. Session 0 selects the most recent one.
+bool recoverFlightSession(FlightBlockReadFn readFn, void* context, uint32_t blockCount,
+                          uint16_t session, FlightRecoverySinkFn sinkFn, void* sinkContext,
+                          uint8_t* block, FlightRecoveryResult& result);
+
+class FlightRecorder {
+private:
+    FlightBlockReadFn readFn;
+    FlightBlockWriteFn writeFn;
+    void* deviceContext;
+    uint32_t blockCount;
+
+    uint8_t block[FLIGHT_BLOCK_SIZE];
+    FlightBlockHeader header;
+    bool active;
+
+    uint32_t blocksWritten;
+    uint32_t writeErrors;
+
+    void startBlock();
+
+public:
+    FlightRecorder();
+
+    void attach(FlightBlockReadFn read, FlightBlockWriteFn write, void* context, uint32_t blocks);
+
+    // Scans the region once (ground only) and opens a new session after the last one
+    bool begin();
+    // Commits the partial block and stops recording
+    bool end();
+
+    // Hot path: memcpy into the block buffer, one raw write per full block
+    bool append(const char* data, uint16_t length, uint32_t timestamp);
+    // Commits a partly filled block; the remainder of it stays unused
+    bool seal();
+
+    bool isActive() const { return active; }
+    uint16_t getSession() const { return header.session; }
+    uint32_t getSequence() const { return header.sequence; }
+    uint16_t getPendingBytes() const { return header.length; }
+    uint32_t getBlockCount() const { return blockCount; }
+    uint32_t getBlocksWritten() const { return blocksWritten; }
+    uint32_t getWriteErrors() const { return writeErrors; }
+
+    // Block buffer as scratch for scans and recovery, null while recording
+    uint8_t* getIdleBuffer() { return active ? nullptr : block; }
+};
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,24 @@
+#include "log_config.h"
+
+#define LOG_MODULE_LEVEL(module, level, runtime) level,
+
+uint8_t logRuntimeLevels[static_cast<uint8_t>(LogModule::COUNT)] = { LOG_MODULES(LOG_MODULE_LEVEL) };
+
+#undef LOG_MODULE_LEVEL
+
+bool setLogModuleLevel(LogModule module, uint8_t level) {
+    if (module >= LogModule::COUNT || !logRuntimeAdjustable(module)) {
+        return false;
+    }
+    // Levels below the compiled-in minimum have no code left to enable
+    uint8_t floor = LOG_MODULE_LEVELS[static_cast<uint8_t>(module)];
+    logRuntimeLevels[static_cast<uint8_t>(module)] = level > floor ? level : floor;
+    return true;
+}
+
+uint8_t getLogModuleLevel(LogModule module) {
+    if (module >= LogModule::COUNT) {
+        return DLOG_LEVEL_OFF;
+    }
+    return logRuntimeLevels[static_cast<uint8_t>(module)];
+}
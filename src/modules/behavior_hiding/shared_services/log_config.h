@@ -0,0 +1,86 @@
+#ifndef LOG_CONFIG_H
+#define LOG_CONFIG_H
+
+#include <stdint.h>
+
+// Compile-time logging configuration.
+//
+// A log call is compiled in only if its level is at or above both
+// LOG_COMPILE_LEVEL and its module's level below. Anything filtered out is
+// a constant-false branch, so the optimiser drops the call together with
+// its argument expressions. Modules marked runtime-adjustable also check a
+// level that can be changed in flight with setLogModuleLevel(); for all
+// other modules that check folds away as well.
+
+// Same values as LogLevel so records map straight onto logger levels
+#define DLOG_LEVEL_DEBUG    0
+#define DLOG_LEVEL_INFO     1
+#define DLOG_LEVEL_WARNING  2
+#define DLOG_LEVEL_ERROR    3
+#define DLOG_LEVEL_CRITICAL 4
+#define DLOG_LEVEL_OFF      5
+
+// Global floor, e.g. -DLOG_COMPILE_LEVEL=DLOG_LEVEL_WARNING for flight builds
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL DLOG_LEVEL_INFO
+#endif
+
+//   X(module, minimum level, runtime adjustable)
+#define LOG_MODULES(X) \
+    X(SYSTEM,  DLOG_LEVEL_INFO,    false) \
+    X(IMU,     DLOG_LEVEL_INFO,    true)  \
+    X(GPS,     DLOG_LEVEL_INFO,    true)  \
+    X(BARO,    DLOG_LEVEL_INFO,    false) \
+    X(RADIO,   DLOG_LEVEL_INFO,    false) \
+    X(ESC,     DLOG_LEVEL_WARNING, false) \
+    X(BATTERY, DLOG_LEVEL_INFO,    false) \
+    X(CONTROL, DLOG_LEVEL_INFO,    true)  \
+    X(LOGGER,  DLOG_LEVEL_INFO,    false)
+
+#define LOG_MODULE_ENUM(module, level, runtime) module,
+#define LOG_MODULE_LEVEL(module, level, runtime) level,
+#define LOG_MODULE_RUNTIME(module, level, runtime) runtime,
+
+enum class LogModule : uint8_t {
+    LOG_MODULES(LOG_MODULE_ENUM)
+    COUNT
+};
+
+static constexpr uint8_t LOG_MODULE_LEVELS[] = { LOG_MODULES(LOG_MODULE_LEVEL) };
+static constexpr bool LOG_MODULE_RUNTIME_LEVELS[] = { LOG_MODULES(LOG_MODULE_RUNTIME) };
+
+#undef LOG_MODULE_ENUM
+#undef LOG_MODULE_LEVEL
+#undef LOG_MODULE_RUNTIME
+
+// Runtime levels for opted-in modules, defined in log_config.cpp
+extern uint8_t logRuntimeLevels[static_cast<uint8_t>(LogModule::COUNT)];
+
+constexpr bool logCompiledIn(uint8_t level, LogModule module) {
+    return level >= LOG_COMPILE_LEVEL && level >= LOG_MODULE_LEVELS[static_cast<uint8_t>(module)];
+}
+
+constexpr bool logRuntimeAdjustable(LogModule module) {
+    return LOG_MODULE_RUNTIME_LEVELS[static_cast<uint8_t>(module)];
+}
+
+// Template argument forces compile-time evaluation whatever the optimiser does
+template <bool Enabled> struct LogConstant { static const bool value = Enabled; };
+
+// level and module must be constant expressions
+#define LOG_ENABLED(level, module) \
+    (LogConstant<logCompiledIn((level), (module))>::value && \
+     (!LogConstant<logRuntimeAdjustable(module)>::value || \
+      (level) >= logRuntimeLevels[static_cast<uint8_t>(module)]))
+
+// Only affects runtime-adjustable modules; returns false for the others
+bool setLogModuleLevel(LogModule module, uint8_t level);
+uint8_t getLogModuleLevel(LogModule module);
+
+// Guards a String-building call such as DataLoggerModule::logSystemEvent so
+// that the message expression is never evaluated when the level is filtered:
+//   LOG_IF(IMU, DLOG_LEVEL_WARNING, logger.logSystemEvent("IMU", LogLevel::LOG_WARNING, msg));
+#define LOG_IF(module, level, statement) \
+    do { if (LOG_ENABLED((level), LogModule::module)) { statement; } } while (0)
+
+#endif // LOG_CONFIG_H
@@ -0,0 +1,54 @@
+#ifndef LOG_FORMATS_H
+#define LOG_FORMATS_H
+
+#include <stdint.h>
+#include "log_config.h"
+
+// Format string dictionary for deferred logging.
+//
+// Firmware only stores the ID and raw argument bytes of each entry; the
+// host decoder compiles this same table to turn them back into text.
+// IDs are assigned by position, so only ever append to the list and never
+// reorder or remove entries, or old logs will decode with the wrong text.
+//
+//   X(id, module, format)
+//
+// module must name a LogModule from log_config.h; it selects the
+// compile-time filter for the entry and is printed by the host decoder.
+
+#define LOG_FORMATS(X) \
+    X(BOOT_COMPLETE,          SYSTEM,  "boot complete in %lu ms") \
+    X(LOOP_OVERRUN,           SYSTEM,  "control loop overrun: %lu us (budget %lu us)") \
+    X(IMU_READ_TIMEOUT,       IMU,     "read timeout after %u us") \
+    X(IMU_SATURATED,          IMU,     "axis %u saturated: %d") \
+    X(IMU_CALIBRATED,         IMU,     "gyro bias %.3f %.3f %.3f deg/s") \
+    X(GPS_FIX_CHANGED,        GPS,     "fix type %u, %u satellites") \
+    X(GPS_CHECKSUM_ERROR,     GPS,     "checksum error on message class 0x%02x") \
+    X(BARO_OUT_OF_RANGE,      BARO,    "pressure out of range: %.1f Pa") \
+    X(RADIO_SIGNAL_LOST,      RADIO,   "signal lost after %lu ms without a frame") \
+    X(RADIO_FAILSAFE,         RADIO,   "failsafe engaged, throttle %u") \
+    X(ESC_OUTPUT_CLAMPED,     ESC,     "motor %u output clamped to %u us") \
+    X(BATTERY_LOW,            BATTERY, "battery low: %.2f V") \
+    X(PID_INTEGRAL_LIMIT,     CONTROL, "axis %u integral limited at %.2f") \
+    X(MODE_CHANGED,           CONTROL, "flight mode %u -> %u") \
+    X(LOGGER_BUFFER_OVERFLOW, LOGGER,  "deferred log dropped %u entries")
+
+#define LOG_FORMAT_ENUM(id, module, format) id,
+
+enum class LogFormatId : uint16_t {
+    LOG_FORMATS(LOG_FORMAT_ENUM)
+    COUNT
+};
+
+#define LOG_FORMAT_MODULE(id, module, format) LogModule::module,
+
+static constexpr LogModule LOG_FORMAT_MODULES[] = { LOG_FORMATS(LOG_FORMAT_MODULE) };
+
+#undef LOG_FORMAT_ENUM
+#undef LOG_FORMAT_MODULE
+
+constexpr LogModule logFormatModule(LogFormatId id) {
+    return LOG_FORMAT_MODULES[static_cast<uint16_t>(id)];
+}
+
+#endif // LOG_FORMATS_H
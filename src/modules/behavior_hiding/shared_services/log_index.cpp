@@ -0,0 +1,228 @@
+#include "log_index.h"
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+static char* writeHex(char* out, uint32_t value, uint8_t digits) {
+    for (int8_t i = digits - 1; i >= 0; i--) {
+        out[i] = HEX_DIGITS[value & 0x0F];
+        value >>= 4;
+    }
+    return out + digits;
+}
+
+static bool readHex(const char* in, uint8_t digits, uint32_t& value) {
+    value = 0;
+    for (uint8_t i = 0; i < digits; i++) {
+        char c = in[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+        else return false;
+        value = (value << 4) | nibble;
+    }
+    return true;
+}
+
+void formatLogIndexEntry(const LogIndexEntry& entry, char* buffer) {
+    char* p = buffer;
+    *p++ = '@'; *p++ = 'I'; *p++ = ' ';
+    p = writeHex(p, entry.timestamp, 8); *p++ = ' ';
+    p = writeHex(p, entry.offset, 8); *p++ = ' ';
+    p = writeHex(p, entry.recordNumber, 8); *p++ = ' ';
+    p = writeHex(p, entry.blockFlags, 4); *p++ = ' ';
+    p = writeHex(p, entry.cumulativeFlags, 4);
+    *p = '\n';
+}
+
+bool parseLogIndexEntry(const char* buffer, LogIndexEntry& entry) {
+    if (!isLogIndexLine(buffer) || buffer[LOG_INDEX_ENTRY_SIZE - 1] != '\n') {
+        return false;
+    }
+
+    uint32_t blockFlags, cumulativeFlags;
+    if (!readHex(buffer + 3, 8, entry.timestamp) ||
+        !readHex(buffer + 12, 8, entry.offset) ||
+        !readHex(buffer + 21, 8, entry.recordNumber) ||
+        !readHex(buffer + 30, 4, blockFlags) ||
+        !readHex(buffer + 35, 4, cumulativeFlags)) {
+        return false;
+    }
+
+    entry.blockFlags = (uint16_t)blockFlags;
+    entry.cumulativeFlags = (uint16_t)cumulativeFlags;
+    return true;
+}
+
+void formatLogIndexTrailer(const LogIndexTrailer& trailer, char* buffer) {
+    char* p = buffer;
+    *p++ = '@'; *p++ = 'X'; *p++ = ' ';
+    p = writeHex(p, trailer.footerOffset, 8); *p++ = ' ';
+    p = writeHex(p, trailer.entryCount, 8); *p++ = ' ';
+    *p++ = 'I'; *p++ = 'D'; *p++ = 'X'; *p++ = '1';
+    *p = '\n';
+}
+
+bool parseLogIndexTrailer(const char* buffer, LogIndexTrailer& trailer) {
+    if (buffer[0] != '@' || buffer[1] != 'X' || buffer[2] != ' ' ||
+        buffer[21] != 'I' || buffer[22] != 'D' || buffer[23] != 'X' || buffer[24] != '1' ||
+        buffer[25] != '\n') {
+        return false;
+    }
+    return readHex(buffer + 3, 8, trailer.footerOffset) &&
+           readHex(buffer + 12, 8, trailer.entryCount);
+}
+
+bool isLogIndexLine(const char* line) {
+    return line[0] == '@' && line[1] == 'I' && line[2] == ' ';
+}
+
+// LogIndexBuilder
+
+LogIndexBuilder::LogIndexBuilder(uint16_t interval)
+    : interval(interval > 0 ? interval : LOG_INDEX_DEFAULT_INTERVAL) {
+    reset();
+}
+
+void LogIndexBuilder::reset() {
+    recordsInBlock = 0;
+    recordCount = 0;
+    cumulativeFlags = 0;
+    current = LogIndexEntry{};
+}
+
+void LogIndexBuilder::setInterval(uint16_t newInterval) {
+    if (newInterval > 0) {
+        interval = newInterval;
+    }
+}
+
+bool LogIndexBuilder::addRecord(uint32_t timestamp, uint32_t offset, uint8_t entryType) {
+    uint16_t flag = entryType < 16 ? (uint16_t)(1u << entryType) : 0;
+
+    if (recordsInBlock == 0) {
+        current.timestamp = timestamp;
+        current.offset = offset;
+        current.recordNumber = recordCount;
+        current.blockFlags = 0;
+    }
+
+    current.blockFlags |= flag;
+    cumulativeFlags |= flag;
+    recordsInBlock++;
+    recordCount++;
+
+    return recordsInBlock >= interval;
+}
+
+bool LogIndexBuilder::takeEntry(LogIndexEntry& entry) {
+    if (recordsInBlock == 0) {
+        return false;
+    }
+
+    current.cumulativeFlags = cumulativeFlags;
+    entry = current;
+    recordsInBlock = 0;
+    return true;
+}
+
+// LogIndexReader
+
+LogIndexReader::LogIndexReader(LogIndexReadFn read, void* ctx)
+    : readFn(read), context(ctx), trailer{0, 0}, valid(false) {
+}
+
+bool LogIndexReader::openFooter(uint32_t fileSize) {
+    valid = false;
+    if (fileSize < LOG_INDEX_TRAILER_SIZE) {
+        return false;
+    }
+
+    char buffer[LOG_INDEX_TRAILER_SIZE];
+    uint32_t trailerOffset = fileSize - LOG_INDEX_TRAILER_SIZE;
+    if (readFn(context, trailerOffset, buffer, LOG_INDEX_TRAILER_SIZE) != LOG_INDEX_TRAILER_SIZE ||
+        !parseLogIndexTrailer(buffer, trailer)) {
+        return false;
+    }
+
+    // The footer must end exactly where the trailer begins
+    valid = trailer.footerOffset + trailer.entryCount * LOG_INDEX_ENTRY_SIZE == trailerOffset;
+    return valid;
+}
+
+bool LogIndexReader::openSidecar(uint32_t fileSize) {
+    trailer.footerOffset = 0;
+    trailer.entryCount = fileSize / LOG_INDEX_ENTRY_SIZE;
+    valid = trailer.entryCount > 0;
+    return valid;
+}
+
+bool LogIndexReader::getEntry(uint32_t index, LogIndexEntry& entry) {
+    if (!valid || index >= trailer.entryCount) {
+        return false;
+    }
+
+    char buffer[LOG_INDEX_ENTRY_SIZE];
+    uint32_t offset = trailer.footerOffset + index * LOG_INDEX_ENTRY_SIZE;
+    if (readFn(context, offset, buffer, LOG_INDEX_ENTRY_SIZE) != LOG_INDEX_ENTRY_SIZE) {
+        return false;
+    }
+    return parseLogIndexEntry(buffer, entry);
+}
+
+bool LogIndexReader::findByTime(uint32_t timestamp, LogIndexEntry& entry, uint32_t* index) {
+    if (!valid || trailer.entryCount == 0) {
+        return false;
+    }
+
+    // Find the last entry whose timestamp is <= the target
+    uint32_t low = 0;
+    uint32_t high = trailer.entryCount;
+    LogIndexEntry probe;
+    while (high - low > 1) {
+        uint32_t mid = low + (high - low) / 2;
+        if (!getEntry(mid, probe)) {
+            return false;
+        }
+        if (probe.timestamp <= timestamp) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (index != nullptr) {
+        *index = low;
+    }
+    return getEntry(low, entry);
+}
+
+bool LogIndexReader::findFirstWithFlags(uint16_t flags, LogIndexEntry& entry, uint32_t* index) {
+    if (!valid || trailer.entryCount == 0) {
+        return false;
+    }
+
+    // Cumulative flags only ever gain bits, so the predicate is monotonic
+    uint32_t low = 0;
+    uint32_t high = trailer.entryCount;
+    LogIndexEntry probe;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (!getEntry(mid, probe)) {
+            return false;
+        }
+        if (probe.cumulativeFlags & flags) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    if (low >= trailer.entryCount) {
+        return false;
+    }
+    if (index != nullptr) {
+        *index = low;
+    }
+    return getEntry(low, entry);
+}
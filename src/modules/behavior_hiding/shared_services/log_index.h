@@ -0,0 +1,109 @@
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#include <stdint.h>
+
+// Sparse seek index for flight logs.
+//
+// Every N records the logger writes one fixed-width index line into the log
+// stream and appends the same line to a sidecar file. When the log is closed
+// the sidecar is copied to the end of the log as a footer, followed by a
+// fixed-width trailer that points at it. Everything stays plain ASCII, so the
+// log remains a text file, and a reader only needs random-access reads to
+// binary search it. This works on the SD card, on the host, or over the
+// telemetry link.
+//
+//   index line: "@I tttttttt oooooooo rrrrrrrr ffff cccc\n"
+//               timestamp, offset, record number, block flags, cumulative flags
+//   trailer:    "@X oooooooo nnnnnnnn IDX1\n"
+//               footer offset, entry count
+
+// Event flag bits, one per LogEntryType in declaration order
+enum LogIndexFlag : uint16_t {
+    LOG_FLAG_FLIGHT_DATA      = 1 << 0,
+    LOG_FLAG_SENSOR_DATA      = 1 << 1,
+    LOG_FLAG_SYSTEM_EVENT     = 1 << 2,
+    LOG_FLAG_ERROR_EVENT      = 1 << 3,
+    LOG_FLAG_USER_ACTION      = 1 << 4,
+    LOG_FLAG_CALIBRATION_DATA = 1 << 5
+};
+
+static const uint16_t LOG_INDEX_DEFAULT_INTERVAL = 64;
+static const uint8_t LOG_INDEX_ENTRY_SIZE = 40;
+static const uint8_t LOG_INDEX_TRAILER_SIZE = 26;
+
+// One index entry describes a block of up to N consecutive records
+struct LogIndexEntry {
+    uint32_t timestamp;        // Timestamp of the first record in the block
+    uint32_t offset;           // Byte offset of the first record in the block
+    uint32_t recordNumber;     // Sequence number of the first record
+    uint16_t blockFlags;       // Entry types seen in this block
+    uint16_t cumulativeFlags;  // Entry types seen since the start of the file
+};
+
+struct LogIndexTrailer {
+    uint32_t footerOffset;     // Byte offset of the first footer entry
+    uint32_t entryCount;       // Number of footer entries
+};
+
+// Random-access read used by the reader; returns the number of bytes read
+typedef uint16_t (*LogIndexReadFn)(void* context, uint32_t offset, char* buffer, uint16_t length);
+
+// Encoding helpers; buffers must hold LOG_INDEX_ENTRY_SIZE / LOG_INDEX_TRAILER_SIZE bytes
+void formatLogIndexEntry(const LogIndexEntry& entry, char* buffer);
+bool parseLogIndexEntry(const char* buffer, LogIndexEntry& entry);
+void formatLogIndexTrailer(const LogIndexTrailer& trailer, char* buffer);
+bool parseLogIndexTrailer(const char* buffer, LogIndexTrailer& trailer);
+bool isLogIndexLine(const char* line);
+
+// Tracks block boundaries while records are written
+class LogIndexBuilder {
+private:
+    uint16_t interval;
+    uint16_t recordsInBlock;
+    uint32_t recordCount;
+    uint16_t cumulativeFlags;
+    LogIndexEntry current;
+
+public:
+    LogIndexBuilder(uint16_t interval = LOG_INDEX_DEFAULT_INTERVAL);
+
+    void reset();
+    void setInterval(uint16_t newInterval);
+    uint16_t getInterval() const { return interval; }
+    uint32_t getRecordCount() const { return recordCount; }
+
+    // Call after each record is placed at offset; returns true when the block is full
+    bool addRecord(uint32_t timestamp, uint32_t offset, uint8_t entryType);
+    // Closes the current block; false if it holds no records
+    bool takeEntry(LogIndexEntry& entry);
+};
+
+// Binary searches the footer (or a sidecar file) through a read callback
+class LogIndexReader {
+private:
+    LogIndexReadFn readFn;
+    void* context;
+    LogIndexTrailer trailer;
+    bool valid;
+
+public:
+    LogIndexReader(LogIndexReadFn read, void* ctx);
+
+    // Opens the footer of a closed log; false if the log has no trailer
+    bool openFooter(uint32_t fileSize);
+    // Opens a sidecar file, which is a bare sequence of index lines
+    bool openSidecar(uint32_t fileSize);
+
+    bool isValid() const { return valid; }
+    uint32_t getEntryCount() const { return valid ? trailer.entryCount : 0; }
+    uint32_t getFooterOffset() const { return trailer.footerOffset; }
+
+    bool getEntry(uint32_t index, LogIndexEntry& entry);
+    // Last block starting at or before timestamp (first block if none)
+    bool findByTime(uint32_t timestamp, LogIndexEntry& entry, uint32_t* index = nullptr);
+    // First block containing any of flags, found via the monotonic cumulative flags
+    bool findFirstWithFlags(uint16_t flags, LogIndexEntry& entry, uint32_t* index = nullptr);
+};
+
+#endif // LOG_INDEX_H
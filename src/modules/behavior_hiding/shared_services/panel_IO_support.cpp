@@ -0,0 +1,55 @@
+#include "panel_IO_support.h"
+
+// Calibration on the shared arena. The remaining PanelIOSupport operations
+// are implemented against these; calibrationStats is nullptr whenever this
+// module does not hold the arena.
+
+static const uint16_t PANEL_IO_CALIBRATION_SAMPLES = 100;   // Per channel, for a complete calibration
+
+void PanelIOSupport::startCalibration() {
+    // One ChannelStats per possible channel; the arena is sized for this lease.
+    // Refused while another module calibrates; isCalibrating() stays false.
+    calibrationStats = calibrationArena.leaseChannels(this, MAX_IO_CHANNELS);
+    if (calibrationStats == nullptr) {
+        return;
+    }
+    calibrationInProgress = true;
+    calibrationStartTime = millis();
+    calibrationSamples = 0;
+}
+
+void PanelIOSupport::stopCalibration() {
+    calibrationArena.release(this);
+    calibrationStats = nullptr;
+    calibrationInProgress = false;
+}
+
+bool PanelIOSupport::addCalibrationSample(uint8_t ioId, double value) {
+    if (!calibrationInProgress || calibrationStats == nullptr || ioId >= MAX_IO_CHANNELS) {
+        return false;
+    }
+    calibrationStats[ioId].add((float)value);
+    calibrationSamples++;
+    return true;
+}
+
+double PanelIOSupport::getCalibrationProgress() const {
+    if (calibrationStats == nullptr || ioCount == 0) {
+        return 0.0;
+    }
+    // As far along as the channel with the fewest samples
+    uint16_t fewest = PANEL_IO_CALIBRATION_SAMPLES;
+    for (uint8_t i = 0; i < ioCount && i < MAX_IO_CHANNELS; i++) {
+        if (calibrationStats[i].count < fewest) {
+            fewest = calibrationStats[i].count;
+        }
+    }
+    return (double)fewest / PANEL_IO_CALIBRATION_SAMPLES;
+}
+
+const ChannelStats* PanelIOSupport::getCalibrationStats(uint8_t ioId) const {
+    if (calibrationStats == nullptr || ioId >= MAX_IO_CHANNELS) {
+        return nullptr;
+    }
+    return &calibrationStats[ioId];
+}
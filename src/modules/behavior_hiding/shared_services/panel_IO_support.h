@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../../hardware_hiding/device_interface/panel_interface.h"
 #include "../../software_decision/application_data_types/state_events.h"
+#include "../../software_decision/software_utility/calibration_arena.h"
 
 // IO states
 enum class IOState {
@@ -170,7 +171,7 @@ private:
     bool calibrationInProgress;
     unsigned long calibrationStartTime;
     uint16_t calibrationSamples;
-    double calibrationData[MAX_IO_CHANNELS][100];
+    ChannelStats* calibrationStats;     // Leased from calibrationArena while calibrating, one per IO channel
     
     // Component interfaces
     PanelInterface* panelInterface;
@@ -305,12 +306,15 @@ public:
     void testI2CIO();
     void testSPIIO();
     
-    // Calibration
+    // Calibration. startCalibration() leases the shared arena and is
+    // refused while another module holds it; stopCalibration() releases it.
     void startCalibration();
     void stopCalibration();
     bool isCalibrating() const { return calibrationInProgress; }
     bool addCalibrationSample(uint8_t ioId, double value);
     double getCalibrationProgress() const;
+    // nullptr unless calibrating
+    const ChannelStats* getCalibrationStats(uint8_t ioId) const;
     
     // Utility functions
     bool validateIOConfig(const IOConfig& config) const;
@@ -0,0 +1,222 @@
+#include "sensor_scheduler.h"
+#include <string.h>
+
+// Wrap-safe "a is at or after b"
+static bool reached(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) >= 0;
+}
+
+SensorScheduler::SensorScheduler() {
+    reset();
+}
+
+void SensorScheduler::reset() {
+    memset(tasks, 0, sizeof(tasks));
+    taskCount = 0;
+    cursor = 0;
+    budgetUs = SENSOR_FRAME_BUDGET_US;
+    frameUs = 0;
+    worstFrameUs = 0;
+    frameSteps = 0;
+}
+
+uint8_t SensorScheduler::addTask(const SensorTaskOps* ops, void* context, uint8_t index, uint32_t periodUs) {
+    if (taskCount >= SENSOR_TASK_MAX || ops == nullptr || ops->trigger == nullptr || ops->collect == nullptr) {
+        return SENSOR_TASK_NONE;
+    }
+    SensorTask& task = tasks[taskCount];
+    memset(&task, 0, sizeof(task));
+    task.ops = ops;
+    task.context = context;
+    task.index = index;
+    task.enabled = true;
+    task.phase = SensorPhase::IDLE;
+    task.periodUs = periodUs > 0 ? periodUs : 1;
+    return taskCount++;
+}
+
+void SensorScheduler::setPeriod(uint8_t task, uint32_t periodUs) {
+    if (task < taskCount) {
+        tasks[task].periodUs = periodUs > 0 ? periodUs : 1;
+        tasks[task].started = false;
+        tasks[task].avgIntervalUs = 0;
+    }
+}
+
+void SensorScheduler::setEnabled(uint8_t task, bool enabled) {
+    if (task >= taskCount || tasks[task].enabled == enabled) {
+        return;
+    }
+    SensorTask& t = tasks[task];
+    t.enabled = enabled;
+    // An abandoned reading is not collected; the rate restarts on enable
+    t.phase = SensorPhase::IDLE;
+    t.started = false;
+    t.lastCollect = 0;
+    t.avgIntervalUs = 0;
+}
+
+SensorStep SensorScheduler::nextStep(const SensorTask& task, uint32_t now) const {
+    switch (task.phase) {
+        case SensorPhase::IDLE:
+            if (task.enabled && (!task.started || reached(now, task.nextDue))) {
+                return SensorStep::TRIGGER;
+            }
+            return SensorStep::NONE;
+        case SensorPhase::WAITING:
+            if (!reached(now, task.readyAt)) {
+                return SensorStep::NONE;
+            }
+            return task.ops->ready != nullptr ? SensorStep::POLL : SensorStep::COLLECT;
+        case SensorPhase::COLLECT:
+            return SensorStep::COLLECT;
+    }
+    return SensorStep::NONE;
+}
+
+// Returns true when the step collected a reading
+bool SensorScheduler::runStep(SensorTask& task, SensorStep step, uint32_t now) {
+    switch (step) {
+        case SensorStep::TRIGGER: {
+            if (!task.started) {
+                task.nextDue = now;
+                task.started = true;
+            }
+            uint32_t late = now - task.nextDue;
+            if (late >= task.periodUs) {
+                uint32_t skipped = late / task.periodUs;
+                task.missedPeriods += skipped;
+                task.nextDue += skipped * task.periodUs;
+            }
+            task.nextDue += task.periodUs;
+
+            uint32_t readyIn = 0;
+            if (!task.ops->trigger(task.context, task.index, readyIn)) {
+                task.failures++;
+                task.phase = SensorPhase::IDLE;
+                return false;
+            }
+            task.waitStart = now;
+            task.readyAt = now + readyIn;
+            task.phase = SensorPhase::WAITING;
+            return false;
+        }
+        case SensorStep::POLL:
+            if (task.ops->ready(task.context, task.index)) {
+                task.phase = SensorPhase::COLLECT;
+            } else if (now - task.waitStart > SENSOR_WAIT_TIMEOUT_US) {
+                task.failures++;
+                task.phase = SensorPhase::IDLE;
+            } else {
+                task.readyAt = now + SENSOR_POLL_INTERVAL_US;
+            }
+            return false;
+        case SensorStep::COLLECT: {
+            task.phase = SensorPhase::IDLE;
+            if (!task.ops->collect(task.context, task.index)) {
+                task.failures++;
+                return false;
+            }
+            if (task.completions > 0) {
+                int32_t interval = (int32_t)(now - task.lastCollect);
+                if (task.avgIntervalUs == 0) {
+                    task.avgIntervalUs = interval;
+                } else {
+                    int32_t avg = (int32_t)task.avgIntervalUs;
+                    task.avgIntervalUs = avg + (interval - avg) / (1 << SENSOR_RATE_SHIFT);
+                }
+            }
+            task.lastCollect = now;
+            task.completions++;
+            return true;
+        }
+        case SensorStep::NONE:
+            break;
+    }
+    return false;
+}
+
+uint8_t SensorScheduler::runFrame(SensorClockFn clock) {
+    uint32_t start = clock();
+    uint8_t collected = 0;
+    uint16_t deferred = 0;              // Tasks with a step carried over
+    uint8_t firstDeferred = SENSOR_TASK_NONE;
+    bool exhausted = false;
+    frameSteps = 0;
+
+    // Passes over the tasks until one runs nothing, so a trigger that is
+    // ready at once is collected in the same frame if it fits
+    bool progress = taskCount > 0;
+    while (progress && !exhausted) {
+        progress = false;
+        for (uint8_t k = 0; k < taskCount; k++) {
+            uint8_t i = (uint8_t)((cursor + k) % taskCount);
+            SensorTask& task = tasks[i];
+            uint32_t now = clock();
+            SensorStep step = nextStep(task, now);
+            if (step == SensorStep::NONE) {
+                continue;
+            }
+
+            uint32_t used = now - start;
+            if (frameSteps > 0 && used + task.stepCostUs[(uint8_t)step] > budgetUs) {
+                if (!(deferred & (1u << i))) {
+                    deferred |= (1u << i);
+                    task.deferredFrames++;
+                    if (firstDeferred == SENSOR_TASK_NONE) {
+                        firstDeferred = i;
+                    }
+                }
+                if (used >= budgetUs) {
+                    exhausted = true;
+                    break;
+                }
+                continue;
+            }
+
+            if (runStep(task, step, now)) {
+                collected++;
+            }
+            uint32_t cost = clock() - now;
+            uint32_t& peak = task.stepCostUs[(uint8_t)step];
+            peak = cost > peak ? cost : peak - (peak >> SENSOR_COST_DECAY_SHIFT);
+            frameSteps++;
+            progress = true;
+        }
+    }
+
+    // Whoever was carried over goes first next frame; otherwise rotate
+    if (firstDeferred != SENSOR_TASK_NONE) {
+        cursor = firstDeferred;
+    } else if (taskCount > 0) {
+        cursor = (uint8_t)((cursor + 1) % taskCount);
+    }
+
+    frameUs = clock() - start;
+    if (frameUs > worstFrameUs) {
+        worstFrameUs = frameUs;
+    }
+    return collected;
+}
+
+float SensorScheduler::getAchievedRate(uint8_t task) const {
+    if (task >= taskCount || tasks[task].avgIntervalUs == 0) {
+        return 0.0f;
+    }
+    return 1000000.0f / tasks[task].avgIntervalUs;
+}
+
+float SensorScheduler::getTargetRate(uint8_t task) const {
+    if (task >= taskCount) {
+        return 0.0f;
+    }
+    return 1000000.0f / tasks[task].periodUs;
+}
+
+bool SensorScheduler::isBehind(uint8_t task) const {
+    if (task >= taskCount || tasks[task].avgIntervalUs == 0) {
+        return false;
+    }
+    const SensorTask& t = tasks[task];
+    return t.avgIntervalUs > t.periodUs + (t.periodUs >> SENSOR_RATE_SHIFT);
+}
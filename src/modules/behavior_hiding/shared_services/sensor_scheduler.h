@@ -0,0 +1,128 @@
+#ifndef SENSOR_SCHEDULER_H
+#define SENSOR_SCHEDULER_H
+
+#include <stdint.h>
+
+// Budgeted round-robin scheduler for step-wise sensor reads.
+//
+// Each sensor read is split into three steps, none of which waits:
+//   trigger  start a conversion or transfer, say how long until it is ready
+//   poll     optional: ask the device whether the result is in yet
+//   collect  read the finished result
+// Between steps the task is parked, so a 25 ms ultrasonic echo or a 6 ms
+// barometer conversion costs the loop nothing while it runs.
+//
+// runFrame() runs whatever steps are due, in round-robin order, until the
+// frame budget is spent. Before a step runs, its cost (a decaying peak of
+// what it took before) is checked against what is left of the budget; a
+// step that does not fit is carried to the next frame, and that task goes
+// first then. The first step of a frame always runs, so an expensive step
+// cannot starve.
+//
+// Triggers are phase-locked to the task period: a late trigger does not
+// push the following ones back, and whole periods lost to overload are
+// skipped and counted. The achieved interval between collects is filtered
+// per task, to compare against the target period.
+//
+// Times are 32-bit microseconds from the clock passed to runFrame(); all
+// comparisons are wrap-safe.
+
+static const uint8_t SENSOR_TASK_MAX = 10;
+static const uint8_t SENSOR_TASK_NONE = 0xFF;
+static const uint32_t SENSOR_FRAME_BUDGET_US = 2000;    // Default per frame
+static const uint32_t SENSOR_POLL_INTERVAL_US = 500;    // Between "not ready" polls
+static const uint32_t SENSOR_WAIT_TIMEOUT_US = 50000;   // Trigger to ready, at most
+static const uint8_t SENSOR_RATE_SHIFT = 3;             // Interval filter gain 1/8
+static const uint8_t SENSOR_COST_DECAY_SHIFT = 4;       // Step cost peak decay 1/16
+
+// Step callbacks. index is the owner's own number for the sensor.
+struct SensorTaskOps {
+    // Starts a reading; readyInUs is preset to 0. False on failure.
+    bool (*trigger)(void* context, uint8_t index, uint32_t& readyInUs);
+    // True once the result is in; nullptr to rely on readyInUs alone
+    bool (*ready)(void* context, uint8_t index);
+    // Reads the result. False if it was unusable.
+    bool (*collect)(void* context, uint8_t index);
+};
+
+enum class SensorStep : uint8_t {
+    TRIGGER,
+    POLL,
+    COLLECT,
+    NONE
+};
+
+enum class SensorPhase : uint8_t {
+    IDLE,           // Waiting for the next period
+    WAITING,        // Triggered, result not ready yet
+    COLLECT         // Result ready
+};
+
+struct SensorTask {
+    const SensorTaskOps* ops;
+    void* context;
+    uint8_t index;
+    bool enabled;
+    bool started;                       // nextDue is valid
+    SensorPhase phase;
+
+    uint32_t periodUs;
+    uint32_t nextDue;                   // Next trigger time
+    uint32_t readyAt;                   // Next poll or collect time
+    uint32_t waitStart;                 // When the current reading was triggered
+    uint32_t lastCollect;
+    uint32_t stepCostUs[3];             // Decaying peak per SensorStep
+
+    // Rate tracking
+    uint32_t avgIntervalUs;             // Filtered time between collects
+    uint32_t completions;
+    uint32_t failures;                  // Trigger, collect or wait timeout
+    uint32_t missedPeriods;             // Skipped under overload
+    uint32_t deferredFrames;            // Frames in which a step did not fit
+};
+
+typedef uint32_t (*SensorClockFn)();
+
+class SensorScheduler {
+private:
+    SensorTask tasks[SENSOR_TASK_MAX];
+    uint8_t taskCount;
+    uint8_t cursor;                     // First task looked at next frame
+    uint32_t budgetUs;
+
+    // Last frame
+    uint32_t frameUs;
+    uint32_t worstFrameUs;
+    uint8_t frameSteps;
+
+    SensorStep nextStep(const SensorTask& task, uint32_t now) const;
+    bool runStep(SensorTask& task, SensorStep step, uint32_t now);
+
+public:
+    SensorScheduler();
+    void reset();
+
+    // Returns the task number, or SENSOR_TASK_NONE when full
+    uint8_t addTask(const SensorTaskOps* ops, void* context, uint8_t index, uint32_t periodUs);
+    void setPeriod(uint8_t task, uint32_t periodUs);
+    void setEnabled(uint8_t task, bool enabled);
+    void setBudget(uint32_t us) { budgetUs = us; }
+
+    // Runs due steps until the budget is spent; returns readings collected
+    uint8_t runFrame(SensorClockFn clock);
+
+    uint8_t getTaskCount() const { return taskCount; }
+    const SensorTask& getTask(uint8_t task) const { return tasks[task]; }
+    // Achieved and target rates, in Hz
+    float getAchievedRate(uint8_t task) const;
+    float getTargetRate(uint8_t task) const;
+    // Achieved interval more than 1/8 over the period
+    bool isBehind(uint8_t task) const;
+
+    uint32_t getBudget() const { return budgetUs; }
+    uint32_t getFrameUs() const { return frameUs; }
+    uint32_t getWorstFrameUs() const { return worstFrameUs; }
+    uint8_t getFrameSteps() const { return frameSteps; }
+};
+
+#endif // SENSOR_SCHEDULER_H
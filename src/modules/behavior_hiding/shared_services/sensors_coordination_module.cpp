@@ -0,0 +1,356 @@
+#include "sensors_coordination_module.h"
+#include <string.h>
+
+// Step-wise sensor reads on the frame-budgeted scheduler. The remaining
+// SensorsCoordinationModule operations are implemented against these;
+// initialize() and addSensor() call scheduleSensor() for each sensor they
+// bring up, which waits on that sensor's I2C probe.
+
+// HMC5883L single measurement
+static const uint8_t HMC5883L_REG_MODE = 0x02;
+static const uint8_t HMC5883L_REG_STATUS = 0x09;
+static const uint8_t HMC5883L_MODE_SINGLE = 0x01;
+static const uint8_t HMC5883L_STATUS_READY = 0x01;
+static const uint32_t HMC5883L_CONVERSION_US = 6000;
+
+// Magnetometer fit, in the units of magnetic_field (uT)
+static const float MAG_FIELD_SCALE_UT = 50.0f;
+static const uint32_t MAG_CAL_SAMPLE_MS = 100;
+static const uint32_t MAG_CAL_SOLVE_MS = 1000;
+
+// Every I2C chip this module can drive, registered before anything is probed
+static const I2cDeviceSpec SENSOR_I2C_DEVICES[] = {
+    I2C_DEVICE_MPU6050,
+    I2C_DEVICE_HMC5883L,
+    I2C_DEVICE_BMP280,
+    I2C_DEVICE_BMP280_SECONDARY
+};
+static const uint8_t SENSOR_I2C_DEVICE_COUNT = sizeof(SENSOR_I2C_DEVICES) / sizeof(SENSOR_I2C_DEVICES[0]);
+
+// HC-SR04: first look once an echo from ~17 cm could have ended
+static const uint32_t ULTRASONIC_FIRST_POLL_US = 1000;
+
+const SensorTaskOps SensorsCoordinationModule::STEP_OPS = {
+    &SensorsCoordinationModule::triggerStep,
+    &SensorsCoordinationModule::readyStep,
+    &SensorsCoordinationModule::collectStep
+};
+
+static uint32_t schedulerClock() {
+    return micros();
+}
+
+static bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    return i2cBus.writeRegister(address, reg, value) == I2cResult::OK;
+}
+
+static bool readRegister(uint8_t address, uint8_t reg, uint8_t& value) {
+    return i2cBus.readRegisters(address, reg, &value, 1) == I2cResult::OK;
+}
+
+bool SensorsCoordinationModule::triggerStep(void* context, uint8_t sensor_index, uint32_t& ready_in_us) {
+    return static_cast<SensorsCoordinationModule*>(context)->triggerSensor(sensor_index, ready_in_us);
+}
+
+bool SensorsCoordinationModule::readyStep(void* context, uint8_t sensor_index) {
+    return static_cast<SensorsCoordinationModule*>(context)->sensorReady(sensor_index);
+}
+
+bool SensorsCoordinationModule::collectStep(void* context, uint8_t sensor_index) {
+    return static_cast<SensorsCoordinationModule*>(context)->collectSensor(sensor_index);
+}
+
+uint8_t SensorsCoordinationModule::findTask(uint8_t sensor_index) const {
+    for (uint8_t t = 0; t < scheduler.getTaskCount(); t++) {
+        if (scheduler.getTask(t).index == sensor_index) {
+            return t;
+        }
+    }
+    return SENSOR_TASK_NONE;
+}
+
+// The chip each I2C sensor type is; false for the others
+static bool defaultI2cSpec(SensorType type, I2cDeviceSpec& spec) {
+    switch (type) {
+        case SensorType::MPU6050:      spec = I2C_DEVICE_MPU6050; return true;
+        case SensorType::BMP280:       spec = I2C_DEVICE_BMP280; return true;
+        case SensorType::MAGNETOMETER: spec = I2C_DEVICE_HMC5883L; return true;
+        default:
+            return false;
+    }
+}
+
+uint8_t SensorsCoordinationModule::sensorAddress(uint8_t sensor_index) const {
+    const SensorConfig& config = configs[sensor_index];
+    I2cDeviceSpec spec;
+    if (config.i2c_address != 0 || !defaultI2cSpec(config.type, spec)) {
+        return config.i2c_address;
+    }
+    return spec.address;
+}
+
+bool SensorsCoordinationModule::i2cSensorPresent(uint8_t sensor_index) {
+    I2cDeviceSpec spec;
+    if (!defaultI2cSpec(configs[sensor_index].type, spec)) {
+        return true;
+    }
+    // A configured address overrides the default; the chip's ID check stays
+    spec.address = sensorAddress(sensor_index);
+    uint8_t handle = i2cBus.addDevice(spec);
+    if (handle == I2C_NO_DEVICE) {
+        handleSensorError(sensor_index, "I2C device registry full");
+        return false;
+    }
+    // Steps the boot probe only as far as this chip
+    if (i2cBus.awaitProbe(handle) != I2cDeviceState::PRESENT) {
+        handleSensorError(sensor_index, "I2C sensor not found");
+        return false;
+    }
+    return true;
+}
+
+bool SensorsCoordinationModule::scheduleSensor(uint8_t sensor_index) {
+    if (!isValidSensorIndex(sensor_index) || !i2cSensorPresent(sensor_index)) {
+        return false;
+    }
+    uint32_t period_us = configs[sensor_index].update_interval * 1000UL;
+    uint8_t task = findTask(sensor_index);
+    if (task != SENSOR_TASK_NONE) {
+        scheduler.setPeriod(task, period_us);
+        scheduler.setEnabled(task, true);
+        return true;
+    }
+    if (scheduler.addTask(&STEP_OPS, this, sensor_index, period_us) == SENSOR_TASK_NONE) {
+        handleSensorError(sensor_index, "Sensor schedule full");
+        return false;
+    }
+    return true;
+}
+
+bool SensorsCoordinationModule::triggerSensor(uint8_t sensor_index, uint32_t& ready_in_us) {
+    const SensorConfig& config = configs[sensor_index];
+    switch (config.type) {
+        case SensorType::BMP280:
+            // Normally already started by the last collect
+            if (barometer.isConverting()) {
+                ready_in_us = barometer.remainingUs(micros());
+                return true;
+            }
+            return barometer.startConversion(micros(), ready_in_us);
+        case SensorType::MAGNETOMETER:
+            ready_in_us = HMC5883L_CONVERSION_US;
+            return writeRegister(sensorAddress(sensor_index), HMC5883L_REG_MODE, HMC5883L_MODE_SINGLE);
+        case SensorType::ULTRASONIC:
+            ready_in_us = ULTRASONIC_FIRST_POLL_US;
+            return ranger.trigger(micros());
+        default:
+            // The IMU samples continuously and the GPS streams into the
+            // UART buffer; there is nothing to start
+            return true;
+    }
+}
+
+bool SensorsCoordinationModule::sensorReady(uint8_t sensor_index) {
+    const SensorConfig& config = configs[sensor_index];
+    uint8_t status;
+    switch (config.type) {
+        case SensorType::BMP280:
+            // Worst-case conversion time, so no status poll on the bus
+            return barometer.isDue(micros());
+        case SensorType::MAGNETOMETER:
+            return readRegister(sensorAddress(sensor_index), HMC5883L_REG_STATUS, status) &&
+                   (status & HMC5883L_STATUS_READY);
+        case SensorType::ULTRASONIC:
+            ultrasonic_result = ranger.poll(micros());
+            return ultrasonic_result != UltrasonicResult::PENDING;
+        default:
+            return true;
+    }
+}
+
+bool SensorsCoordinationModule::collectSensor(uint8_t sensor_index) {
+    switch (configs[sensor_index].type) {
+        case SensorType::MPU6050:      readMPU6050(sensor_index); break;
+        case SensorType::BMP280:       readBMP280(sensor_index); break;
+        case SensorType::GPS:          readGPS(sensor_index); break;
+        case SensorType::MAGNETOMETER: readMagnetometer(sensor_index); correctMagnetometer(sensor_index); break;
+        case SensorType::ULTRASONIC:   readUltrasonic(sensor_index); break;
+        default:
+            return false;
+    }
+    processSensorData(sensor_index);
+    if (!currentData.is_valid) {
+        return false;
+    }
+    last_update[sensor_index] = currentData.timestamp;
+    onSensorDataUpdated(sensor_index, currentData);
+    return true;
+}
+
+void SensorsCoordinationModule::correctMagnetometer(uint8_t sensor_index) {
+    if (!currentData.is_valid) {
+        return;
+    }
+    if (sensor_index != mag_sensor_index) {
+        mag_sensor_index = sensor_index;
+        magCalibrator.begin(MAG_FIELD_SCALE_UT);
+    }
+    memcpy(mag_raw, currentData.magnetic_field, sizeof(mag_raw));
+    mag_raw_fresh = true;
+    // Full 3x3 soft-iron correction; calibrations[] only records the status
+    if (configs[sensor_index].enable_calibration) {
+        magCalibrator.correct(currentData.magnetic_field, currentData.magnetic_field);
+    }
+}
+
+bool SensorsCoordinationModule::calibrateMagnetometer() {
+    uint8_t index = mag_sensor_index;
+    for (uint8_t i = 0; index == 0xFF && i < sensor_count; i++) {
+        if (configs[i].type == SensorType::MAGNETOMETER) {
+            index = i;
+        }
+    }
+    if (index == 0xFF) {
+        return false;
+    }
+    mag_sensor_index = index;
+    magCalibrator.begin(MAG_FIELD_SCALE_UT);
+    mag_raw_fresh = false;
+    calibrations[index].is_calibrated = false;
+    return true;
+}
+
+void SensorsCoordinationModule::updateMagnetometerCalibration() {
+    if (mag_sensor_index == 0xFF || !configs[mag_sensor_index].enable_calibration) {
+        return;
+    }
+    uint32_t now = millis();
+    if (mag_raw_fresh && now - mag_last_sample_ms >= MAG_CAL_SAMPLE_MS) {
+        mag_last_sample_ms = now;
+        mag_raw_fresh = false;
+        magCalibrator.addSample(mag_raw);
+    }
+    if (now - mag_last_solve_ms < MAG_CAL_SOLVE_MS) {
+        return;
+    }
+    mag_last_solve_ms = now;
+    MagCalResult result = magCalibrator.solve();
+    if (result == MagCalResult::FITTED || result == MagCalResult::CONVERGED) {
+        calibrations[mag_sensor_index].is_calibrated = true;
+        calibrations[mag_sensor_index].calibration_time = now;
+    }
+    if (result == MagCalResult::CONVERGED) {
+        onCalibrationComplete(mag_sensor_index);
+    }
+}
+
+bool SensorsCoordinationModule::attachUltrasonicEcho(uint8_t sensor_index, uint8_t echo_pin) {
+    if (!isValidSensorIndex(sensor_index) || configs[sensor_index].type != SensorType::ULTRASONIC) {
+        return false;
+    }
+    if (!ranger.attach(configs[sensor_index].pin, echo_pin)) {
+        handleSensorError(sensor_index, "Echo pin has no free external interrupt");
+        return false;
+    }
+    ultrasonic_result = UltrasonicResult::PENDING;
+    // The HC-SR04 needs its last echo to die away before the next ping
+    if (configs[sensor_index].update_interval < ULTRASONIC_MIN_CYCLE_MS) {
+        configs[sensor_index].update_interval = ULTRASONIC_MIN_CYCLE_MS;
+    }
+    return scheduleSensor(sensor_index);
+}
+
+bool SensorsCoordinationModule::initializeI2C() {
+    // The bus is shared with the other drivers; whoever comes first starts it
+    if (!i2cBus.isAttached()) {
+        i2cBus.beginWire();
+    }
+    i2c_initialized = i2cBus.isAttached();
+    // Boot checks only these addresses, one per probe step as each sensor
+    // is scheduled
+    for (uint8_t i = 0; i < SENSOR_I2C_DEVICE_COUNT; i++) {
+        if (i2cBus.addDevice(SENSOR_I2C_DEVICES[i]) == I2C_NO_DEVICE) {
+            i2c_errors++;
+        }
+    }
+    return i2c_initialized;
+}
+
+bool SensorsCoordinationModule::initBMP280(uint8_t sensor_index) {
+    // The driver is shared with AirDataInterface, which may have started it
+    uint8_t address = sensorAddress(sensor_index);
+    if (barometer.isPresent() && barometer.getAddress() == address) {
+        return true;
+    }
+    if (!barometer.begin(address)) {
+        handleSensorError(sensor_index, "BMP280 not found");
+        return false;
+    }
+    return true;
+}
+
+void SensorsCoordinationModule::readBMP280(uint8_t sensor_index) {
+    currentData.is_valid = barometer.collect();
+    if (currentData.is_valid) {
+        // The speed of sound follows the air temperature
+        ranger.setTemperature(barometer.getTemperature());
+    }
+    // Start the next conversion now, so it is done by the next period
+    uint32_t ready_in_us;
+    barometer.startConversion(micros(), ready_in_us);
+
+    currentData.pressure = barometer.getPressure();
+    currentData.altitude = barometer.getAltitude();
+    currentData.temperature_bmp = barometer.getTemperature();
+    // When the conversion started, not when it was collected
+    currentData.timestamp = millis() - (micros() - barometer.getSampleStartUs()) / 1000;
+    currentData.source = configs[sensor_index].type;
+}
+
+bool SensorsCoordinationModule::configureBarometer(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter filter) {
+    return barometer.configure(temperature, pressure, filter);
+}
+
+float SensorsCoordinationModule::read_barometer() {
+    // Pipelined: returns the latest altitude and never waits
+    barometer.service(micros());
+    return barometer.getAltitude();
+}
+
+void SensorsCoordinationModule::readUltrasonic(uint8_t sensor_index) {
+    // Median-filtered by the ranger; the echo itself was timed by interrupt
+    currentData.distance = ranger.getDistance();
+    currentData.timestamp = millis();
+    currentData.source = configs[sensor_index].type;
+    currentData.is_valid = ultrasonic_result == UltrasonicResult::ECHO;
+}
+
+bool SensorsCoordinationModule::readAllSensors() {
+    bool produced = scheduler.runFrame(schedulerClock) > 0;
+    // Rate-limited inside: samples at 10 Hz, refits at 1 Hz
+    updateMagnetometerCalibration();
+    return produced;
+}
+
+void SensorsCoordinationModule::setUpdateInterval(uint8_t sensor_index, uint32_t interval_ms) {
+    if (!isValidSensorIndex(sensor_index)) {
+        return;
+    }
+    configs[sensor_index].update_interval = interval_ms;
+    uint8_t task = findTask(sensor_index);
+    if (task != SENSOR_TASK_NONE) {
+        scheduler.setPeriod(task, interval_ms * 1000UL);
+    }
+}
+
+float SensorsCoordinationModule::getAchievedRate(uint8_t sensor_index) const {
+    return scheduler.getAchievedRate(findTask(sensor_index));
+}
+
+float SensorsCoordinationModule::getTargetRate(uint8_t sensor_index) const {
+    return scheduler.getTargetRate(findTask(sensor_index));
+}
+
+bool SensorsCoordinationModule::isSensorBehind(uint8_t sensor_index) const {
+    return scheduler.isBehind(findTask(sensor_index));
+}
@@ -3,6 +3,12 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "sensor_scheduler.h"
+#include "../../hardware_hiding/device_interface/ultrasonic_ranger.h"
+#include "../../hardware_hiding/device_interface/bmp280_driver.h"
+#include "../../hardware_hiding/extended_computer/i2c_bus.h"
+#include "../../software_decision/software_utility/mag_calibrator.h"
 
 // Sensor Types
 enum class SensorType {
@@ -77,7 +83,7 @@ struct SensorError {
     bool calibration_error;     // Calibration error
     bool timeout_error;         // Sensor timeout
     bool data_error;            // Invalid data received
-    String error_message;       // Detailed error description
+    ErrorText error_message;       // Detailed error description
 };
 
 // Sensor Calibration Data
@@ -110,6 +116,23 @@ private:
     bool i2c_initialized;
     uint8_t i2c_errors;
     
+    // Step-wise reads, run a frame budget at a time
+    SensorScheduler scheduler;
+    static const SensorTaskOps STEP_OPS;
+    
+    // Interrupt-timed sonar and the outcome of its last reading
+    UltrasonicRanger ranger;
+    UltrasonicResult ultrasonic_result;
+    
+    // Online hard/soft-iron fit. Collects keep the raw field for it; the
+    // slow-rate update folds it in and refits.
+    MagCalibrator magCalibrator;
+    uint8_t mag_sensor_index = 0xFF;
+    float mag_raw[3] = { 0.0f, 0.0f, 0.0f };
+    bool mag_raw_fresh = false;
+    uint32_t mag_last_sample_ms = 0;
+    uint32_t mag_last_solve_ms = 0;
+    
     // Private Methods
     bool initializeI2C();
     bool initializeSensor(uint8_t sensor_index);
@@ -132,6 +155,23 @@ private:
     void readGPS(uint8_t sensor_index);
     void readMagnetometer(uint8_t sensor_index);
     void readUltrasonic(uint8_t sensor_index);
+    void correctMagnetometer(uint8_t sensor_index);
+    
+    // Sensor steps for the scheduler: the read methods above collect a
+    // finished conversion and do not wait
+    bool scheduleSensor(uint8_t sensor_index);
+    // The I2C registry's verdict on the sensor's chip; true for others
+    bool i2cSensorPresent(uint8_t sensor_index);
+    // Configured I2C address, or the chip's default when left at 0 (0 is
+    // the general call address)
+    uint8_t sensorAddress(uint8_t sensor_index) const;
+    uint8_t findTask(uint8_t sensor_index) const;
+    bool triggerSensor(uint8_t sensor_index, uint32_t& ready_in_us);
+    bool sensorReady(uint8_t sensor_index);
+    bool collectSensor(uint8_t sensor_index);
+    static bool triggerStep(void* context, uint8_t sensor_index, uint32_t& ready_in_us);
+    static bool readyStep(void* context, uint8_t sensor_index);
+    static bool collectStep(void* context, uint8_t sensor_index);
 
 public:
     // Constructor
@@ -143,15 +183,22 @@ public:
     void setSensorConfig(uint8_t sensor_index, const SensorConfig& config);
     void enableSensor(uint8_t sensor_index);
     void disableSensor(uint8_t sensor_index);
+    // Echo pin for an ULTRASONIC sensor, whose pin is the trigger; the echo
+    // pin needs an external interrupt
+    bool attachUltrasonicEcho(uint8_t sensor_index, uint8_t echo_pin);
     
     // Configuration
     void setUpdateInterval(uint8_t sensor_index, uint32_t interval_ms);
     void enableCalibration(uint8_t sensor_index, bool enable);
     void enableFiltering(uint8_t sensor_index, bool enable);
     void setFilterCoefficient(uint8_t sensor_index, float alpha);
+    bool configureBarometer(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter filter);
     
     // Data Reading
+    // Runs one frame of sensor steps within the frame budget, then the
+    // magnetometer calibration update; true if any sensor produced a reading
     bool readAllSensors();
+    void setFrameBudget(uint32_t budget_us) { scheduler.setBudget(budget_us); }
     bool readSensor(uint8_t sensor_index);
     SensorData getSensorData(uint8_t sensor_index) const;
     SensorData getCurrentData() const { return currentData; }
@@ -167,7 +214,14 @@ public:
     // Calibration
     bool calibrateSensor(uint8_t sensor_index);
     bool calibrateMPU6050();
+    // Restarts the online magnetometer fit; it converges as the vehicle is
+    // turned through enough orientations and keeps refining in flight
     bool calibrateMagnetometer();
+    // Slow rate group: samples the field at 10 Hz and refits at 1 Hz.
+    // Calls onCalibrationComplete() once, when the fit first becomes good.
+    // readAllSensors() calls it every frame.
+    void updateMagnetometerCalibration();
+    const MagCalibrator& getMagCalibrator() const { return magCalibrator; }
     void setCalibrationData(uint8_t sensor_index, const SensorCalibration& cal);
     SensorCalibration getCalibrationData(uint8_t sensor_index) const;
     void resetCalibration(uint8_t sensor_index);
@@ -178,6 +232,10 @@ public:
     bool isSensorEnabled(uint8_t sensor_index) const;
     bool isSensorCalibrated(uint8_t sensor_index) const;
     uint8_t getSensorCount() const { return sensor_count; }
+    float getAchievedRate(uint8_t sensor_index) const;     // Hz
+    float getTargetRate(uint8_t sensor_index) const;       // Hz
+    bool isSensorBehind(uint8_t sensor_index) const;
+    const SensorScheduler& getScheduler() const { return scheduler; }
     
     // Error Handling
     bool hasError() const;
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "../../software_decision/application_data_types/numeric_types.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Mathematical constants
 #define PI 3.14159265359f
@@ -260,7 +261,7 @@ private:
     
     // Error tracking
     static UtilityError lastError;
-    static String lastErrorMessage;
+    static ErrorText lastErrorMessage;
     
 public:
     // Utility access
@@ -275,7 +276,7 @@ public:
     
     // Error handling
     static UtilityError getLastError() { return lastError; }
-    static String getLastErrorMessage() { return lastErrorMessage; }
+    static const char* getLastErrorMessage() { return lastErrorMessage.c_str(); }
     static void clearErrors();
     
     // System utilities
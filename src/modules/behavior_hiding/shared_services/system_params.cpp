@@ -0,0 +1,313 @@
+#include "system_params.h"
+#include "../../hardware_hiding/extended_computer/config_store.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#else
+#include <chrono>
+#define PROGMEM
+#define memcpy_P memcpy
+#define memcmp_P memcmp
+#define strlen_P strlen
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#endif
+
+#include "system_params_hash.h"
+
+#ifdef ARDUINO
+static unsigned long defaultParamClock() {
+    return millis();
+}
+#else
+static unsigned long defaultParamClock() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+static_assert(PARAM_HASH_KEYS == PARAM_COUNT,
+              "system_params_hash.h is stale: rerun tools/param_hash_gen");
+static_assert(CONFIG_KEY_PARAM_BASE + PARAM_COUNT <= CONFIG_MAX_KEYS,
+              "Not enough ConfigStore keys for SYSTEM_PARAMS");
+
+#define PARAM_NAME(id, name, kind, def, lo, hi, category, persistent) \
+    static const char PARAM_NAME_##id[] PROGMEM = name;
+
+SYSTEM_PARAMS(PARAM_NAME)
+
+#undef PARAM_NAME
+
+#define PARAM_INFO(id, name, kind, def, lo, hi, category, persistent) \
+    { PARAM_NAME_##id, ParamKind::kind, static_cast<uint8_t>(SystemValueCategory::category), \
+      persistent, (float)(def), (float)(lo), (float)(hi) },
+
+static const ParamInfo PARAM_INFO_TABLE[PARAM_COUNT] PROGMEM = {
+    SYSTEM_PARAMS(PARAM_INFO)
+};
+
+#undef PARAM_INFO
+
+void getParamInfo(Param param, ParamInfo& info) {
+    memcpy_P(&info, &PARAM_INFO_TABLE[static_cast<uint8_t>(param)], sizeof(ParamInfo));
+}
+
+uint8_t getParamName(Param param, char* buffer) {
+    ParamInfo info;
+    getParamInfo(param, info);
+    uint8_t length = (uint8_t)strlen_P(info.name);
+    memcpy_P(buffer, info.name, length + 1);
+    return length;
+}
+
+static ParamValue defaultSlot(Param param) {
+    ParamInfo info;
+    getParamInfo(param, info);
+    ParamValue slot;
+    slot.intValue = 0;
+    switch (info.kind) {
+        case ParamKind::BOOL:  slot.boolValue = info.defaultValue != 0.0f; break;
+        case ParamKind::INT:   slot.intValue = (int32_t)info.defaultValue; break;
+        case ParamKind::FLOAT: slot.floatValue = info.defaultValue; break;
+    }
+    return slot;
+}
+
+SystemParams::SystemParams()
+    : sequence(0), lastChangeMs(0), lastFlushMs(0), clock(defaultParamClock), flushCursor(0), flushWrites(0) {
+    memset(dirty, 0, sizeof(dirty));
+    memset(changedAt, 0, sizeof(changedAt));
+
+    // Defaults are the baseline, not changes: nothing starts dirty
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        values[i] = defaultSlot(static_cast<Param>(i));
+    }
+}
+
+void SystemParams::resetToDefaults() {
+    // Defaults are in range by construction; one sequence number covers them all
+    uint32_t resetSequence = sequence + 1;
+    bool changed = false;
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        ParamValue slot = defaultSlot(static_cast<Param>(i));
+        if (memcmp(&slot, &values[i], sizeof(slot)) != 0) {
+            values[i] = slot;
+            dirty[i >> 3] |= 1 << (i & 7);
+            changedAt[i] = resetSequence;
+            changed = true;
+        }
+    }
+    if (changed) {
+        sequence = resetSequence;
+        lastChangeMs = clock();
+    }
+}
+
+void SystemParams::setEpoch(uint16_t epoch) {
+    sequence = (uint32_t)epoch << PARAM_EPOCH_SHIFT;
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        changedAt[i] = sequence;
+    }
+}
+
+void SystemParams::restore(Param param, const ParamValue& value) {
+    uint8_t index = static_cast<uint8_t>(param);
+    if (index < PARAM_COUNT) {
+        values[index] = value;
+        dirty[index >> 3] &= ~(1 << (index & 7));
+    }
+}
+
+void SystemParams::markChanged(uint8_t index) {
+    dirty[index >> 3] |= 1 << (index & 7);
+    changedAt[index] = ++sequence;
+    // The settle time runs from here, not from when flush() notices
+    lastChangeMs = clock();
+}
+
+bool SystemParams::isDirty(Param param) const {
+    uint8_t index = static_cast<uint8_t>(param);
+    return index < PARAM_COUNT && (dirty[index >> 3] & (1 << (index & 7)));
+}
+
+uint8_t SystemParams::getDirtyCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < sizeof(dirty); i++) {
+        for (uint8_t bits = dirty[i]; bits; bits &= bits - 1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void SystemParams::markAllDirty() {
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        dirty[i >> 3] |= 1 << (i & 7);
+    }
+}
+
+uint8_t SystemParams::flush(ParamWriteFn writeFn, void* context, unsigned long nowMs,
+                            const ParamFlushPolicy& policy) {
+    if (nowMs - lastChangeMs < policy.settleMs || nowMs - lastFlushMs < policy.intervalMs) {
+        return 0;
+    }
+
+    // Round-robin from the cursor so a failing entry cannot starve the rest
+    uint8_t written = 0;
+    for (uint8_t step = 0; step < PARAM_COUNT && written < policy.maxPerStep; step++) {
+        uint8_t index = flushCursor;
+        flushCursor = (flushCursor + 1) % PARAM_COUNT;
+        if (!(dirty[index >> 3] & (1 << (index & 7)))) {
+            continue;
+        }
+        ParamInfo info;
+        getParamInfo(static_cast<Param>(index), info);
+        if (!info.persistent) {
+            dirty[index >> 3] &= ~(1 << (index & 7));
+            continue;
+        }
+        if (!writeFn(context, static_cast<Param>(index), values[index])) {
+            break;
+        }
+        dirty[index >> 3] &= ~(1 << (index & 7));
+        written++;
+        flushWrites++;
+    }
+    if (written > 0) {
+        lastFlushMs = nowMs;
+    }
+    return written;
+}
+
+uint8_t SystemParams::flushAll(ParamWriteFn writeFn, void* context) {
+    uint8_t written = 0;
+    for (uint8_t index = 0; index < PARAM_COUNT; index++) {
+        if (!(dirty[index >> 3] & (1 << (index & 7)))) {
+            continue;
+        }
+        ParamInfo info;
+        getParamInfo(static_cast<Param>(index), info);
+        if (info.persistent && !writeFn(context, static_cast<Param>(index), values[index])) {
+            continue;
+        }
+        dirty[index >> 3] &= ~(1 << (index & 7));
+        if (info.persistent) {
+            written++;
+            flushWrites++;
+        }
+    }
+    return written;
+}
+
+uint8_t SystemParams::changedSince(uint32_t seq, Param* params, uint8_t maxParams) const {
+    uint8_t count = 0;
+    // A seq from another boot epoch says nothing about this boot's changes
+    bool everything = seq == 0 || (seq >> PARAM_EPOCH_SHIFT) != (sequence >> PARAM_EPOCH_SHIFT);
+    for (uint8_t i = 0; i < PARAM_COUNT && count < maxParams; i++) {
+        if (everything || changedAt[i] > seq) {
+            params[count++] = static_cast<Param>(i);
+        }
+    }
+    return count;
+}
+
+bool SystemParams::find(const char* name, uint8_t length, Param& param) {
+    if (length == 0 || length > PARAM_NAME_MAX) {
+        return false;
+    }
+    uint8_t bucket = paramHash(name, length, 0) % PARAM_HASH_BUCKETS;
+    uint8_t seed = pgm_read_byte(&PARAM_HASH_SEEDS[bucket]);
+    uint8_t slot = paramHash(name, length, seed) % PARAM_HASH_KEYS;
+    uint8_t index = pgm_read_byte(&PARAM_HASH_ORDER[slot]);
+
+    // The hash places every known name; one compare rejects unknown ones
+    ParamInfo info;
+    getParamInfo(static_cast<Param>(index), info);
+    if (strlen_P(info.name) != length || memcmp_P(name, info.name, length) != 0) {
+        return false;
+    }
+    param = static_cast<Param>(index);
+    return true;
+}
+
+bool SystemParams::setNumeric(Param param, float value) {
+    uint8_t index = static_cast<uint8_t>(param);
+    if (index >= PARAM_COUNT) {
+        return false;
+    }
+    ParamInfo info;
+    getParamInfo(param, info);
+    if (!(value >= info.minValue && value <= info.maxValue)) {
+        return false;
+    }
+    ParamValue slot = values[index];
+    switch (info.kind) {
+        case ParamKind::BOOL:  slot.boolValue = value != 0.0f; break;
+        case ParamKind::INT:   slot.intValue = (int32_t)lroundf(value); break;
+        case ParamKind::FLOAT: slot.floatValue = value; break;
+    }
+    if (memcmp(&slot, &values[index], sizeof(slot)) != 0) {
+        values[index] = slot;
+        markChanged(index);
+    }
+    return true;
+}
+
+float SystemParams::getNumeric(Param param) const {
+    uint8_t index = static_cast<uint8_t>(param);
+    if (index >= PARAM_COUNT) {
+        return 0.0f;
+    }
+    ParamInfo info;
+    getParamInfo(param, info);
+    switch (info.kind) {
+        case ParamKind::BOOL:  return values[index].boolValue ? 1.0f : 0.0f;
+        case ParamKind::INT:   return (float)values[index].intValue;
+        case ParamKind::FLOAT: return values[index].floatValue;
+    }
+    return 0.0f;
+}
+
+bool storeParamRecord(void* store, Param param, const ParamValue& value) {
+    ParamInfo info;
+    getParamInfo(param, info);
+    return static_cast<ConfigStore*>(store)->saveImage(
+        CONFIG_KEY_PARAM_BASE + static_cast<uint8_t>(param), static_cast<uint8_t>(info.kind), value);
+}
+
+uint8_t loadParamRecords(SystemParams& params, const ConfigStore& store) {
+    uint8_t restored = 0;
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        ParamInfo info;
+        getParamInfo(static_cast<Param>(i), info);
+        ParamValue value;
+        if (!info.persistent ||
+            !store.loadImage(CONFIG_KEY_PARAM_BASE + i, static_cast<uint8_t>(info.kind), value)) {
+            continue;
+        }
+        float numeric = 0.0f;
+        switch (info.kind) {
+            case ParamKind::BOOL:  numeric = value.boolValue ? 1.0f : 0.0f; break;
+            case ParamKind::INT:   numeric = (float)value.intValue; break;
+            case ParamKind::FLOAT: numeric = value.floatValue; break;
+        }
+        // Limits may have tightened since the value was saved
+        if (numeric >= info.minValue && numeric <= info.maxValue) {
+            params.restore(static_cast<Param>(i), value);
+            restored++;
+        }
+    }
+    return restored;
+}
+
+uint16_t beginParamEpoch(SystemParams& params, ConfigStore& store) {
+    uint16_t epoch = 0;
+    store.loadImage(CONFIG_KEY_BOOT_EPOCH, 1, epoch);
+    // Epoch 0 is never used, so no boot's numbers start at the "never synced" seq
+    epoch = epoch == 0xFFFF ? 1 : epoch + 1;
+    store.saveImage(CONFIG_KEY_BOOT_EPOCH, 1, epoch);
+    params.setEpoch(epoch);
+    return epoch;
+}
@@ -0,0 +1,263 @@
+#ifndef SYSTEM_PARAMS_H
+#define SYSTEM_PARAMS_H
+
+#include <stdint.h>
+
+// Compile-time keyed flight parameters.
+//
+// Every tunable the control loop reads is declared once in SYSTEM_PARAMS
+// and becomes a Param enumerator. Code reads them with
+// systemValues.get<Param::RollP>(), which compiles to an array load with
+// the right C++ type; no name is looked up at run time.
+//
+// The console and the telemetry parameter protocol still address
+// parameters by name. SystemParams::find() resolves a name with a minimal
+// perfect hash (system_params_hash.h, generated by tools/param_hash_gen)
+// and a single name compare, instead of comparing against every entry.
+// Regenerate the hash whenever SYSTEM_PARAMS changes; a stale table fails
+// to compile (wrong count) or fails the unit test (wrong slots).
+//
+// Names and limits live in flash on AVR.
+//
+// Changes are not written through. Each set that changes a value marks the
+// parameter dirty, stamps it with a change sequence number and notes the
+// time of the change. flush() is called every frame and writes at most a
+// few dirty parameters per call, and only once the table has been quiet
+// for a settle time, so dragging a gain slider on the ground station costs
+// one EEPROM write, not fifty. changedSince(seq) lists what changed after
+// a sequence number, so the ground station only fetches changed parameters
+// over the radio. The top PARAM_EPOCH_SHIFT bits of a sequence number are
+// the boot epoch (beginParamEpoch()), so a number the ground station kept
+// from before a reboot lists everything instead of nothing.
+//
+// storeParamRecord() is the ParamWriteFn for the EEPROM ConfigStore: one
+// record per Param, versioned by kind, so loadParamRecords() at boot skips
+// any parameter whose kind changed since it was saved.
+
+// System value categories
+enum class SystemValueCategory {
+    FLIGHT_CONTROL,
+    NAVIGATION,
+    PROPULSION,
+    COMMUNICATION,
+    SENSORS,
+    SAFETY,
+    MAINTENANCE,
+    CONFIGURATION
+};
+
+//  X(id, console name, kind, default, min, max, SystemValueCategory, persistent)
+// Append only: the enumerator order is the telemetry and EEPROM order.
+#define SYSTEM_PARAMS(X) \
+    X(RollP,           "ROLL_P",         FLOAT, 1.3f,   0.0f,    20.0f,   FLIGHT_CONTROL, true)  \
+    X(RollI,           "ROLL_I",         FLOAT, 0.04f,  0.0f,    1.0f,    FLIGHT_CONTROL, true)  \
+    X(RollD,           "ROLL_D",         FLOAT, 18.0f,  0.0f,    100.0f,  FLIGHT_CONTROL, true)  \
+    X(RollMax,         "ROLL_MAX",       INT,   400,    0,       1000,    FLIGHT_CONTROL, true)  \
+    X(PitchP,          "PITCH_P",        FLOAT, 1.3f,   0.0f,    20.0f,   FLIGHT_CONTROL, true)  \
+    X(PitchI,          "PITCH_I",        FLOAT, 0.04f,  0.0f,    1.0f,    FLIGHT_CONTROL, true)  \
+    X(PitchD,          "PITCH_D",        FLOAT, 18.0f,  0.0f,    100.0f,  FLIGHT_CONTROL, true)  \
+    X(PitchMax,        "PITCH_MAX",      INT,   400,    0,       1000,    FLIGHT_CONTROL, true)  \
+    X(YawP,            "YAW_P",          FLOAT, 4.0f,   0.0f,    20.0f,   FLIGHT_CONTROL, true)  \
+    X(YawI,            "YAW_I",          FLOAT, 0.02f,  0.0f,    1.0f,    FLIGHT_CONTROL, true)  \
+    X(YawD,            "YAW_D",          FLOAT, 0.0f,   0.0f,    100.0f,  FLIGHT_CONTROL, true)  \
+    X(YawMax,          "YAW_MAX",        INT,   400,    0,       1000,    FLIGHT_CONTROL, true)  \
+    X(AutoLevel,       "AUTO_LEVEL",     BOOL,  1,      0,       1,       FLIGHT_CONTROL, true)  \
+    X(LevelGain,       "LEVEL_GAIN",     FLOAT, 15.0f,  0.0f,    50.0f,   FLIGHT_CONTROL, true)  \
+    X(ThrottleIdle,    "THR_IDLE",       INT,   1100,   1000,    1300,    PROPULSION,     true)  \
+    X(ThrottleMax,     "THR_MAX",        INT,   2000,   1800,    2000,    PROPULSION,     true)  \
+    X(ArmingChecks,    "ARM_CHECKS",     BOOL,  1,      0,       1,       SAFETY,         true)  \
+    X(BatteryLowVolts, "BATT_LOW_V",     FLOAT, 10.5f,  6.0f,    25.0f,   SAFETY,         true)  \
+    X(BatteryCells,    "BATT_CELLS",     INT,   3,      1,       6,       SAFETY,         true)  \
+    X(FailsafeTimeout, "FS_TIMEOUT_MS",  INT,   1000,   100,     10000,   SAFETY,         true)  \
+    X(ReturnAltitude,  "RTL_ALT_M",      FLOAT, 30.0f,  5.0f,    120.0f,  NAVIGATION,     true)  \
+    X(GeofenceRadius,  "FENCE_RADIUS_M", FLOAT, 300.0f, 10.0f,   5000.0f, NAVIGATION,     true)  \
+    X(MagDeclination,  "MAG_DECL_DEG",   FLOAT, 0.0f,   -180.0f, 180.0f,  SENSORS,        true)  \
+    X(GpsRate,         "GPS_RATE_HZ",    INT,   5,      1,       10,      SENSORS,        true)  \
+    X(LogRate,         "LOG_RATE_HZ",    INT,   50,     1,       250,     CONFIGURATION,  true)  \
+    X(TelemetryRate,   "TELEM_RATE_HZ",  INT,   10,     1,       50,      COMMUNICATION,  true)  \
+    X(DebugOutput,     "DEBUG_OUT",      BOOL,  0,      0,       1,       CONFIGURATION,  false)
+
+#define PARAM_ENUM(id, name, kind, def, lo, hi, category, persistent) id,
+
+enum class Param : uint8_t {
+    SYSTEM_PARAMS(PARAM_ENUM)
+    COUNT
+};
+
+#undef PARAM_ENUM
+
+static const uint8_t PARAM_COUNT = static_cast<uint8_t>(Param::COUNT);
+static const uint8_t PARAM_NAME_MAX = 15;   // Console name length limit
+
+enum class ParamKind : uint8_t {
+    BOOL,
+    INT,
+    FLOAT
+};
+
+union ParamValue {
+    bool boolValue;
+    int32_t intValue;
+    float floatValue;
+};
+
+// One SYSTEM_PARAMS row, as copied out of flash
+struct ParamInfo {
+    const char* name;       // Flash address on AVR
+    ParamKind kind;
+    uint8_t category;       // SystemValueCategory
+    bool persistent;
+    float defaultValue;
+    float minValue;
+    float maxValue;
+};
+
+// Persistent store hook used by flush(); returns false to retry later
+typedef bool (*ParamWriteFn)(void* context, Param param, const ParamValue& value);
+
+struct ParamFlushPolicy {
+    uint16_t settleMs;      // Quiet time after the last change before writing
+    uint16_t intervalMs;    // Minimum time between flush steps
+    uint8_t maxPerStep;     // Parameters written per step
+};
+
+static const ParamFlushPolicy PARAM_FLUSH_DEFAULT = { 1000, 50, 1 };
+
+// Sequence numbers: boot epoch above, changes this boot below
+static const uint8_t PARAM_EPOCH_SHIFT = 16;
+
+// Time of a change, on the clock flush() is given (millis() on the board)
+typedef unsigned long (*ParamClockFn)();
+
+class ConfigStore;
+
+// Typed access by kind
+template <ParamKind K> struct ParamKindType;
+
+template <> struct ParamKindType<ParamKind::BOOL> {
+    typedef bool type;
+    static bool read(const ParamValue& slot) { return slot.boolValue; }
+    static bool same(const ParamValue& slot, bool value) { return slot.boolValue == value; }
+    static void write(ParamValue& slot, bool value) { slot.boolValue = value; }
+};
+
+template <> struct ParamKindType<ParamKind::INT> {
+    typedef int32_t type;
+    static int32_t read(const ParamValue& slot) { return slot.intValue; }
+    static bool same(const ParamValue& slot, int32_t value) { return slot.intValue == value; }
+    static void write(ParamValue& slot, int32_t value) { slot.intValue = value; }
+};
+
+template <> struct ParamKindType<ParamKind::FLOAT> {
+    typedef float type;
+    static float read(const ParamValue& slot) { return slot.floatValue; }
+    static bool same(const ParamValue& slot, float value) { return slot.floatValue == value; }
+    static void write(ParamValue& slot, float value) { slot.floatValue = value; }
+};
+
+template <Param P> struct ParamTraits;
+
+#define PARAM_TRAITS(id, name, kind, def, lo, hi, category, persistent)       \
+    template <> struct ParamTraits<Param::id> : ParamKindType<ParamKind::kind> { \
+        static constexpr float minimum() { return lo; }                        \
+        static constexpr float maximum() { return hi; }                        \
+    };
+
+SYSTEM_PARAMS(PARAM_TRAITS)
+
+#undef PARAM_TRAITS
+
+// Hash used by the generated table; seed 0 picks the bucket
+inline uint32_t paramHash(const char* text, uint8_t length, uint8_t seed) {
+    uint32_t hash = 2166136261UL ^ seed;
+    for (uint8_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)text[i];
+        hash *= 16777619UL;
+    }
+    return hash ^ (hash >> 15);
+}
+
+class SystemParams {
+private:
+    ParamValue values[PARAM_COUNT];
+
+    // Change tracking
+    uint8_t dirty[(PARAM_COUNT + 7) / 8];
+    uint32_t changedAt[PARAM_COUNT];    // Sequence number of the last change
+    uint32_t sequence;                  // Last sequence number handed out
+    unsigned long lastChangeMs;         // Time of the newest change
+    unsigned long lastFlushMs;
+    ParamClockFn clock;
+    uint8_t flushCursor;
+    uint16_t flushWrites;
+
+    void markChanged(uint8_t index);
+
+public:
+    SystemParams();
+
+    // Compile-time keyed access
+    template <Param P>
+    typename ParamTraits<P>::type get() const {
+        return ParamTraits<P>::read(values[static_cast<uint8_t>(P)]);
+    }
+
+    template <Param P>
+    bool set(typename ParamTraits<P>::type value) {
+        if ((float)value < ParamTraits<P>::minimum() || (float)value > ParamTraits<P>::maximum()) {
+            return false;
+        }
+        uint8_t index = static_cast<uint8_t>(P);
+        if (!ParamTraits<P>::same(values[index], value)) {
+            ParamTraits<P>::write(values[index], value);
+            markChanged(index);
+        }
+        return true;
+    }
+
+    // Run-time keyed access for the console and telemetry; values are
+    // converted to and from float and range checked
+    static bool find(const char* name, uint8_t length, Param& param);
+    bool setNumeric(Param param, float value);
+    float getNumeric(Param param) const;
+
+    // Every parameter back to its default, marked in one change
+    void resetToDefaults();
+
+    // Sets a value read back from the store without marking it dirty
+    void restore(Param param, const ParamValue& value);
+
+    // Dirty tracking and batched persistence
+    bool isDirty(Param param) const;
+    uint8_t getDirtyCount() const;
+    void markAllDirty();                // Forces a full rewrite, e.g. after a store reset
+    // Writes up to policy.maxPerStep dirty parameters; returns how many were written
+    uint8_t flush(ParamWriteFn writeFn, void* context, unsigned long nowMs,
+                  const ParamFlushPolicy& policy = PARAM_FLUSH_DEFAULT);
+    // Writes every dirty parameter now, ignoring the policy (before power down)
+    uint8_t flushAll(ParamWriteFn writeFn, void* context);
+    uint16_t getFlushWrites() const { return flushWrites; }
+    void setClock(ParamClockFn clockFn) { clock = clockFn; }
+
+    // Parameter sync: sequence numbers only grow; seq 0 means "never synced"
+    // and, like a seq from another boot epoch, lists every parameter
+    void setEpoch(uint16_t epoch);      // At boot, before any change
+    uint16_t getEpoch() const { return (uint16_t)(sequence >> PARAM_EPOCH_SHIFT); }
+    uint32_t getSequence() const { return sequence; }
+    uint32_t getChangedAt(Param param) const { return changedAt[static_cast<uint8_t>(param)]; }
+    // Fills params with those changed after seq, in Param order; returns the count
+    uint8_t changedSince(uint32_t seq, Param* params, uint8_t maxParams) const;
+};
+
+void getParamInfo(Param param, ParamInfo& info);
+// Copies the console name into buffer (PARAM_NAME_MAX + 1 bytes); returns its length
+uint8_t getParamName(Param param, char* buffer);
+
+// ConfigStore persistence: setParamStore(storeParamRecord, &configStore)
+bool storeParamRecord(void* store, Param param, const ParamValue& value);
+// Restores every stored, in-range persistent parameter; returns how many
+uint8_t loadParamRecords(SystemParams& params, const ConfigStore& store);
+// Advances the stored boot counter and starts params on it; returns the epoch
+uint16_t beginParamEpoch(SystemParams& params, ConfigStore& store);
+
+#endif // SYSTEM_PARAMS_H
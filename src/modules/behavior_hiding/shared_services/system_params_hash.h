@@ -0,0 +1,20 @@
+#ifndef SYSTEM_PARAMS_HASH_H
+#define SYSTEM_PARAMS_HASH_H
+
+// Generated by tools/param_hash_gen from SYSTEM_PARAMS. Do not edit.
+
+#define PARAM_HASH_KEYS 27
+#define PARAM_HASH_BUCKETS 7
+
+// Per-bucket seed for the slot hash
+static const uint8_t PARAM_HASH_SEEDS[PARAM_HASH_BUCKETS] PROGMEM = {
+    23, 3, 2, 6, 24, 43, 53
+};
+
+// Slot -> Param
+static const uint8_t PARAM_HASH_ORDER[PARAM_HASH_KEYS] PROGMEM = {
+    2, 1, 5, 26, 0, 16, 22, 20, 7, 17, 19, 6, 23, 4, 14, 11,
+    24, 8, 9, 15, 10, 3, 21, 25, 12, 18, 13
+};
+
+#endif // SYSTEM_PARAMS_HASH_H
@@ -3,18 +3,8 @@
 
 #include <Arduino.h>
 #include "../../software_decision/application_data_types/numeric_types.h"
-
-// System value categories
-enum class SystemValueCategory {
-    FLIGHT_CONTROL,
-    NAVIGATION,
-    PROPULSION,
-    COMMUNICATION,
-    SENSORS,
-    SAFETY,
-    MAINTENANCE,
-    CONFIGURATION
-};
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "system_params.h"
 
 // System value types
 enum class SystemValueType {
@@ -64,6 +54,8 @@ struct SystemValueEntry {
         void* structValue;
     } data;
     bool isInitialized;
+    bool dirty;                 // Changed since last persisted
+    uint32_t changeSeq;         // Shares the parameter sequence numbers
 };
 
 // System configuration
@@ -85,6 +77,12 @@ private:
     SystemValueEntry values[MAX_SYSTEM_VALUES];
     uint16_t valueCount;
     
+    // Flight parameters, keyed at compile time (system_params.h)
+    SystemParams params;
+    ParamWriteFn paramStore;
+    void* paramStoreContext;
+    ParamFlushPolicy flushPolicy;
+    
     // Configuration
     SystemValuesConfig config;
     
@@ -94,13 +92,13 @@ private:
     
     // Error tracking
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Helper methods
     uint16_t findValueIndex(const String& name) const;
     bool validateValue(const SystemValueEntry& entry, const void* newValue) const;
     void updateValueMetadata(SystemValueEntry& entry);
-    bool persistValue(const SystemValueEntry& entry);
+    bool persistValue(const SystemValueEntry& entry);   // One registered value to the store
     bool loadPersistedValue(SystemValueEntry& entry);
     void logValueChange(const SystemValueEntry& entry, const String& oldValue, const String& newValue);
 
@@ -113,7 +111,49 @@ public:
     void setConfiguration(const SystemValuesConfig& newConfig);
     SystemValuesConfig getConfiguration() const { return config; }
     
-    // Value management
+    // Flight parameters: get<Param::RollP>() is a typed array read
+    template <Param P>
+    typename ParamTraits<P>::type get() const { return params.get<P>(); }
+    template <Param P>
+    bool set(typename ParamTraits<P>::type value) { return params.set<P>(value); }
+    
+    // Console and telemetry parameter protocol; the only by-name lookups
+    bool setParamByName(StringView name, float value) {
+        Param param;
+        return name.length() <= PARAM_NAME_MAX &&
+               SystemParams::find(name.data(), (uint8_t)name.length(), param) &&
+               params.setNumeric(param, value);
+    }
+    bool getParamByName(StringView name, float& value) const {
+        Param param;
+        if (name.length() > PARAM_NAME_MAX || !SystemParams::find(name.data(), (uint8_t)name.length(), param)) {
+            return false;
+        }
+        value = params.getNumeric(param);
+        return true;
+    }
+    
+    // Batched persistence: sets only mark parameters dirty; flushParams(),
+    // called every frame with millis(), writes a few once changes settle
+    void setParamStore(ParamWriteFn writeFn, void* context) { paramStore = writeFn; paramStoreContext = context; }
+    void setFlushPolicy(const ParamFlushPolicy& policy) { flushPolicy = policy; }
+    uint8_t flushParams(unsigned long nowMs) {
+        return paramStore ? params.flush(paramStore, paramStoreContext, nowMs, flushPolicy) : 0;
+    }
+    uint8_t getDirtyParamCount() const { return params.getDirtyCount(); }
+    // Boot: restores what storeParamRecord() saved, without marking it dirty
+    uint8_t loadParams(const ConfigStore& store) { return loadParamRecords(params, store); }
+    // Boot: starts this boot's parameter sync epoch
+    uint16_t beginParamSync(ConfigStore& store) { return beginParamEpoch(params, store); }
+    
+    // Parameter sync: the ground station sends its last sequence number and
+    // fetches only what changed since
+    uint32_t getParamSequence() const { return params.getSequence(); }
+    uint8_t getParamsChangedSince(uint32_t seq, Param* changed, uint8_t maxParams) const {
+        return params.changedSince(seq, changed, maxParams);
+    }
+    
+    // Value management (registered at run time, looked up by name)
     bool registerValue(const String& name, const String& description, 
                       SystemValueCategory category, SystemValueType type,
                       SystemValueAccess access = SystemValueAccess::READ_WRITE,
@@ -150,7 +190,7 @@ public:
     // Persistence
     bool enableValuePersistence(const String& name, bool enable);
     bool isValuePersistent(const String& name) const;
-    bool saveAllPersistentValues();
+    bool saveAllPersistentValues();     // Writes every persistent registered value now
     bool loadAllPersistentValues();
     
     // Validation
@@ -166,7 +206,7 @@ public:
     // Status and monitoring
     bool isHealthy() const;
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Utility methods
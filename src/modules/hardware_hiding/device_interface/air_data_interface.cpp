@@ -1,5 +1,7 @@
 #include "air_data_interface.h"
 #include <math.h>
+#include "../extended_computer/timer_module.h"
+#include "../../software_decision/software_utility/trace.h"
 
 // Error flag definitions
 #define ERROR_SENSOR_READ_FAILED    0x01
@@ -10,7 +12,7 @@
 
 AirDataInterface::AirDataInterface() 
     : sensorCount(0), altitudeCalibration(0.0), airspeedCalibration(0.0), 
-      temperatureCalibration(0.0), errorFlags(0) {
+      temperatureCalibration(0.0), seaLevelPressure(BMP280_SEA_LEVEL_PA), errorFlags(0) {
     
     // Initialize sensor arrays
     for (uint8_t i = 0; i < MAX_SENSORS; i++) {
@@ -25,24 +27,34 @@ AirDataInterface::AirDataInterface()
 }
 
 bool AirDataInterface::initialize() {
-    Wire.begin();
-    
-    // Initialize I2C communication
-    if (!Wire.begin()) {
+    // The bus is shared; start it only if no other module has. Off the
+    // board there is no Wire, and a test attaches its own transport.
+#ifdef ARDUINO
+    if (!i2cBus.isAttached()) {
+        i2cBus.beginWire();
+    }
+#endif
+    if (!i2cBus.isAttached()) {
         lastError = "Failed to initialize I2C";
         errorFlags |= ERROR_I2C_COMMUNICATION;
         return false;
     }
     
-    // Scan for available sensors
-    for (uint8_t address = 0x08; address <= 0x77; address++) {
-        Wire.beginTransmission(address);
-        if (Wire.endTransmission() == 0) {
-            // Found a device, check if it's a known air data sensor
-            if (addSensor(AirDataSensorType::STATIC_PRESSURE, address)) {
-                Serial.print("Found air data sensor at address 0x");
-                Serial.println(address, HEX);
-            }
+    // Only the addresses a barometer can be at, and only a chip that
+    // identifies as one becomes a static pressure sensor
+    const I2cDeviceSpec barometers[2] = { I2C_DEVICE_BMP280, I2C_DEVICE_BMP280_SECONDARY };
+    for (uint8_t i = 0; i < 2; i++) {
+        uint8_t handle = i2cBus.addDevice(barometers[i]);
+        if (handle == I2C_NO_DEVICE) {
+            lastError = "I2C device registry full";
+            errorFlags |= ERROR_I2C_COMMUNICATION;
+            continue;
+        }
+        // Another module may have checked it already; the registry remembers
+        i2cBus.awaitProbe(handle);
+        if (i2cBus.isPresent(handle) && addSensor(AirDataSensorType::STATIC_PRESSURE, barometers[i].address)) {
+            Serial.print("Found air data sensor at address 0x");
+            Serial.println(barometers[i].address, HEX);
         }
     }
     
@@ -90,6 +102,7 @@ bool AirDataInterface::removeSensor(uint8_t sensorIndex) {
 }
 
 bool AirDataInterface::getAirData(AirDataMeasurement& measurement) {
+    TRACE_SCOPE(BARO_READ);
     if (sensorCount == 0) {
         lastError = "No sensors available";
         return false;
@@ -97,6 +110,7 @@ bool AirDataInterface::getAirData(AirDataMeasurement& measurement) {
     
     // Initialize measurement structure
     measurement.timestamp = millis();
+    measurement.sampleUs = TimerModule::nowUs();
     measurement.isValid = false;
     
     // Aggregate data from all healthy sensors
@@ -177,58 +191,46 @@ bool AirDataInterface::readSensorData(uint8_t sensorIndex, AirDataMeasurement& m
 }
 
 bool AirDataInterface::readPressureSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement) {
-    Wire.beginTransmission(sensor.i2cAddress);
-    Wire.write(0x00); // Register address for pressure data
-    if (Wire.endTransmission() != 0) {
+    // The driver binds to the first static pressure sensor that identifies
+    // as a BMP280
+    if (!barometer.isPresent() && !barometer.begin(sensor.i2cAddress)) {
         return false;
     }
-    
-    if (Wire.requestFrom(sensor.i2cAddress, 3) != 3) {
+    if (barometer.getAddress() != sensor.i2cAddress) {
         return false;
     }
     
-    uint32_t rawPressure = 0;
-    rawPressure |= Wire.read() << 16;
-    rawPressure |= Wire.read() << 8;
-    rawPressure |= Wire.read();
-    
-    // Convert raw value to pressure (Pa) - this is a simplified conversion
-    float pressure = (float)rawPressure * 0.01; // Adjust based on actual sensor
+    // Collects the conversion started last call, if done, and starts the
+    // next; nothing here waits for the sensor. SensorsCoordinationModule
+    // may have collected it instead; the sample is the driver's either way.
+    barometer.service(micros());
+    if (!barometer.hasSample()) {
+        return false;
+    }
     
     // Apply calibration
-    pressure = applyCalibration(pressure, sensor.calibrationOffset, sensor.calibrationScale);
-    
-    // Calculate altitude using standard atmosphere model
-    const float P0 = 101325.0; // Standard sea level pressure (Pa)
-    const float T0 = 288.15;   // Standard sea level temperature (K)
-    const float L = -0.0065;   // Temperature lapse rate (K/m)
-    const float g = 9.80665;   // Gravitational acceleration (m/s²)
-    const float R = 287.1;     // Specific gas constant for air (J/kg·K)
-    
-    if (pressure > 0) {
-        measurement.altitude = (T0 / L) * (pow(pressure / P0, -L * R / g) - 1);
-    } else {
-        measurement.altitude = 0;
-    }
+    float pressure = applyCalibration(barometer.getPressure(), sensor.calibrationOffset, sensor.calibrationScale);
     
+    measurement.altitude = pressureToAltitude(pressure, seaLevelPressure);
     measurement.pressure = pressure;
-    measurement.timestamp = millis();
+    measurement.temperature = barometer.getTemperature();
+    
+    // The sample is from when its conversion started, not when collected
+    uint32_t ageUs = micros() - barometer.getSampleStartUs();
+    measurement.timestamp = millis() - ageUs / 1000;
+    measurement.sampleUs = TimerModule::nowUs() - ageUs;
     
     return true;
 }
 
 bool AirDataInterface::readTemperatureSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement) {
-    Wire.beginTransmission(sensor.i2cAddress);
-    Wire.write(0x03); // Register address for temperature data
-    if (Wire.endTransmission() != 0) {
-        return false;
-    }
-    
-    if (Wire.requestFrom(sensor.i2cAddress, 2) != 2) {
+    uint8_t raw[2];
+    // Register address for temperature data
+    if (i2cBus.readRegisters(sensor.i2cAddress, 0x03, raw, 2) != I2cResult::OK) {
         return false;
     }
     
-    uint16_t rawTemp = Wire.read() << 8 | Wire.read();
+    uint16_t rawTemp = raw[0] << 8 | raw[1];
     float temperature = (float)rawTemp * 0.01 - 273.15; // Convert to Celsius
     
     // Apply calibration
@@ -236,23 +238,20 @@ bool AirDataInterface::readTemperatureSensor(const AirDataSensorConfig& sensor,
     
     measurement.temperature = temperature;
     measurement.timestamp = millis();
+    measurement.sampleUs = TimerModule::nowUs();
     
     return true;
 }
 
 bool AirDataInterface::readPitotSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement) {
     // Read dynamic pressure from pitot tube
-    Wire.beginTransmission(sensor.i2cAddress);
-    Wire.write(0x01); // Register address for dynamic pressure
-    if (Wire.endTransmission() != 0) {
+    uint8_t raw[2];
+    // Register address for dynamic pressure
+    if (i2cBus.readRegisters(sensor.i2cAddress, 0x01, raw, 2) != I2cResult::OK) {
         return false;
     }
     
-    if (Wire.requestFrom(sensor.i2cAddress, 2) != 2) {
-        return false;
-    }
-    
-    uint16_t rawPressure = Wire.read() << 8 | Wire.read();
+    uint16_t rawPressure = raw[0] << 8 | raw[1];
     float dynamicPressure = (float)rawPressure * 0.01; // Convert to Pa
     
     // Apply calibration
@@ -270,21 +269,19 @@ bool AirDataInterface::readPitotSensor(const AirDataSensorConfig& sensor, AirDat
     
     measurement.timestamp = millis();
     
+    measurement.sampleUs = TimerModule::nowUs();
+    
     return true;
 }
 
 bool AirDataInterface::readAoASensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement) {
-    Wire.beginTransmission(sensor.i2cAddress);
-    Wire.write(0x02); // Register address for AoA data
-    if (Wire.endTransmission() != 0) {
+    uint8_t raw[2];
+    // Register address for AoA data
+    if (i2cBus.readRegisters(sensor.i2cAddress, 0x02, raw, 2) != I2cResult::OK) {
         return false;
     }
     
-    if (Wire.requestFrom(sensor.i2cAddress, 2) != 2) {
-        return false;
-    }
-    
-    uint16_t rawAoA = Wire.read() << 8 | Wire.read();
+    uint16_t rawAoA = raw[0] << 8 | raw[1];
     float angleOfAttack = (float)rawAoA * 0.01 - 90.0; // Convert to degrees, center at 0
     
     // Apply calibration
@@ -292,22 +289,19 @@ bool AirDataInterface::readAoASensor(const AirDataSensorConfig& sensor, AirDataM
     
     measurement.angleOfAttack = angleOfAttack;
     measurement.timestamp = millis();
+    measurement.sampleUs = TimerModule::nowUs();
     
     return true;
 }
 
 bool AirDataInterface::readSideslipSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement) {
-    Wire.beginTransmission(sensor.i2cAddress);
-    Wire.write(0x04); // Register address for sideslip data
-    if (Wire.endTransmission() != 0) {
-        return false;
-    }
-    
-    if (Wire.requestFrom(sensor.i2cAddress, 2) != 2) {
+    uint8_t raw[2];
+    // Register address for sideslip data
+    if (i2cBus.readRegisters(sensor.i2cAddress, 0x04, raw, 2) != I2cResult::OK) {
         return false;
     }
     
-    uint16_t rawSideslip = Wire.read() << 8 | Wire.read();
+    uint16_t rawSideslip = raw[0] << 8 | raw[1];
     float sideslip = (float)rawSideslip * 0.01 - 90.0; // Convert to degrees, center at 0
     
     // Apply calibration
@@ -315,6 +309,7 @@ bool AirDataInterface::readSideslipSensor(const AirDataSensorConfig& sensor, Air
     
     measurement.sideslip = sideslip;
     measurement.timestamp = millis();
+    measurement.sampleUs = TimerModule::nowUs();
     
     return true;
 }
@@ -478,6 +473,15 @@ void AirDataInterface::performAutoCalibration() {
     }
 }
 
+bool AirDataInterface::configureBarometer(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter filter) {
+    if (!barometer.configure(temperature, pressure, filter)) {
+        lastError = "Barometer not configured";
+        errorFlags |= ERROR_I2C_COMMUNICATION;
+        return false;
+    }
+    return true;
+}
+
 // Health monitoring methods
 bool AirDataInterface::isSensorHealthy(uint8_t sensorIndex) const {
     if (sensorIndex >= sensorCount) return false;
@@ -512,8 +516,7 @@ void AirDataInterface::update() {
     for (uint8_t i = 0; i < sensorCount; i++) {
         if (sensors[i].enabled) {
             // Check if sensor is responding
-            Wire.beginTransmission(sensors[i].i2cAddress);
-            if (Wire.endTransmission() != 0) {
+            if (i2cBus.ping(sensors[i].i2cAddress) != I2cResult::OK) {
                 updateSensorHealth(i, false);
             }
         }
@@ -541,8 +544,7 @@ void AirDataInterface::runSelfTest() {
         Serial.print(sensors[i].i2cAddress, HEX);
         Serial.print("): ");
         
-        Wire.beginTransmission(sensors[i].i2cAddress);
-        if (Wire.endTransmission() == 0) {
+        if (i2cBus.ping(sensors[i].i2cAddress) == I2cResult::OK) {
             Serial.println("OK");
         } else {
             Serial.println("FAIL");
@@ -559,7 +561,7 @@ void AirDataInterface::runSelfTest() {
         Serial.print("Temperature: "); Serial.print(measurement.temperature); Serial.println(" °C");
     } else {
         Serial.println("Data acquisition: FAIL");
-        Serial.print("Error: "); Serial.println(lastError);
+        Serial.print("Error: "); Serial.println(lastError.c_str());
     }
     
     Serial.println("=== Self Test Complete ===");
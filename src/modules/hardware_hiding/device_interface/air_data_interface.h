@@ -2,7 +2,9 @@
 #define AIR_DATA_INTERFACE_H
 
 #include <Arduino.h>
-#include <Wire.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "bmp280_driver.h"
+#include "../extended_computer/i2c_bus.h"
 
 // Air data sensor types
 enum class AirDataSensorType {
@@ -23,6 +25,7 @@ struct AirDataMeasurement {
     float sideslip;           // Sideslip angle in degrees
     float density;            // Air density in kg/m³
     unsigned long timestamp;  // Measurement timestamp
+    uint64_t sampleUs;        // TimerModule::nowUs() when the sample was taken
     bool isValid;             // Data validity flag
 };
 
@@ -54,12 +57,20 @@ private:
     float airspeedCalibration;
     float temperatureCalibration;
     
+    // Static pressure comes from the shared barometer driver
+    float seaLevelPressure;   // Pa, altimeter setting
+    
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool readSensorData(uint8_t sensorIndex, AirDataMeasurement& measurement);
+    bool readPressureSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement);
+    bool readTemperatureSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement);
+    bool readPitotSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement);
+    bool readAoASensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement);
+    bool readSideslipSensor(const AirDataSensorConfig& sensor, AirDataMeasurement& measurement);
     void updateSensorHealth(uint8_t sensorIndex, bool readingSuccess);
     float applyCalibration(float rawValue, float offset, float scale);
     bool validateMeasurement(const AirDataMeasurement& measurement);
@@ -87,6 +98,8 @@ public:
     void setAirspeedCalibration(float offset, float scale);
     void setTemperatureCalibration(float offset, float scale);
     void performAutoCalibration();
+    bool configureBarometer(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter filter);
+    void setSeaLevelPressure(float pressurePa) { seaLevelPressure = pressurePa; }
     
     // Health monitoring
     bool isSensorHealthy(uint8_t sensorIndex) const;
@@ -95,7 +108,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // System interface
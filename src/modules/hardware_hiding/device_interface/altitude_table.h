@@ -0,0 +1,35 @@
+#ifndef ALTITUDE_TABLE_H
+#define ALTITUDE_TABLE_H
+
+// Generated by tools/altitude_table_gen. Do not edit.
+
+#define ALTITUDE_TABLE_MIN_PA 30000
+#define ALTITUDE_TABLE_STEP_PA 500
+#define ALTITUDE_TABLE_COUNT 161
+
+// ISA altitude in cm at ALTITUDE_TABLE_MIN_PA + i * ALTITUDE_TABLE_STEP_PA
+static const int32_t ALTITUDE_TABLE[ALTITUDE_TABLE_COUNT] PROGMEM = {
+    916395, 905318, 894387, 883598, 872947, 862429, 852042, 841782,
+    831644, 821627, 811727, 801940, 792264, 782697, 773235, 763876,
+    754618, 745458, 736394, 727423, 718543, 709754, 701051, 692434,
+    683901, 675450, 667078, 658786, 650570, 642429, 634362, 626367,
+    618443, 610589, 602802, 595083, 587429, 579839, 572312, 564848,
+    557444, 550099, 542814, 535586, 528414, 521299, 514238, 507230,
+    500276, 493373, 486522, 479720, 472969, 466266, 459610, 453002,
+    446440, 439924, 433453, 427026, 420642, 414302, 408004, 401747,
+    395532, 389357, 383222, 377126, 371069, 365050, 359069, 353125,
+    347217, 341346, 335510, 329710, 323944, 318212, 312514, 306850,
+    301218, 295619, 290052, 284517, 279012, 273539, 268096, 262684,
+    257301, 251947, 246623, 241327, 236059, 230819, 225607, 220423,
+    215265, 210134, 205030, 199951, 194899, 189872, 184870, 179893,
+    174941, 170013, 165109, 160229, 155373, 150540, 145730, 140943,
+    136179, 131437, 126717, 122019, 117343, 112688, 108054, 103442,
+    98850, 94279, 89728, 85198, 80687, 76197, 71726, 67274,
+    62842, 58428, 54034, 49658, 45301, 40962, 36641, 32338,
+    28053, 23786, 19536, 15304, 11088, 6890, 2709, -1456,
+    -5604, -9735, -13851, -17950, -22033, -26100, -30152, -34188,
+    -38208, -42214, -46204, -50178, -54138, -58084, -62014, -65930,
+    -69831
+};
+
+#endif // ALTITUDE_TABLE_H
@@ -2,6 +2,7 @@
 #define AUDIBLE_SIGNAL_INTERFACE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Audio signal types
 enum class AudioSignalType {
@@ -64,7 +65,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool generateTone(uint8_t pin, uint16_t frequency, uint16_t duration);
@@ -106,7 +107,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // System interface
@@ -0,0 +1,211 @@
+#include "bmp280_driver.h"
+
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_dword(address) (*(const uint32_t*)(address))
+#endif
+
+#include "altitude_table.h"
+
+// Registers
+#define BMP280_REG_CALIBRATION      0x88
+#define BMP280_REG_CHIP_ID          0xD0
+#define BMP280_REG_RESET            0xE0
+#define BMP280_REG_CTRL_MEAS        0xF4
+#define BMP280_REG_CONFIG           0xF5
+#define BMP280_REG_DATA             0xF7
+
+#define BMP280_MODE_FORCED          0x01
+#define BMP280_ADC_SKIPPED          0x80000
+
+void bmp280ParseCalibration(const uint8_t* raw, Bmp280Calibration& calibration) {
+    // Little-endian words, T1..T3 then P1..P9
+    uint16_t words[12];
+    for (uint8_t i = 0; i < 12; i++) {
+        words[i] = (uint16_t)(raw[2 * i] | (raw[2 * i + 1] << 8));
+    }
+    calibration.T1 = words[0];
+    calibration.T2 = (int16_t)words[1];
+    calibration.T3 = (int16_t)words[2];
+    calibration.P1 = words[3];
+    calibration.P2 = (int16_t)words[4];
+    calibration.P3 = (int16_t)words[5];
+    calibration.P4 = (int16_t)words[6];
+    calibration.P5 = (int16_t)words[7];
+    calibration.P6 = (int16_t)words[8];
+    calibration.P7 = (int16_t)words[9];
+    calibration.P8 = (int16_t)words[10];
+    calibration.P9 = (int16_t)words[11];
+}
+
+// Datasheet 8.2, with left shifts of signed values written as multiplies
+int32_t bmp280CompensateTemperature(int32_t adcT, const Bmp280Calibration& calibration, int32_t& tFine) {
+    int32_t var1 = (((adcT >> 3) - ((int32_t)calibration.T1 * 2)) * (int32_t)calibration.T2) >> 11;
+    int32_t delta = (adcT >> 4) - (int32_t)calibration.T1;
+    int32_t var2 = (((delta * delta) >> 12) * (int32_t)calibration.T3) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t bmp280CompensatePressure(int32_t adcP, int32_t tFine, const Bmp280Calibration& calibration) {
+    int64_t var1 = (int64_t)tFine - 128000;
+    int64_t var2 = var1 * var1 * (int64_t)calibration.P6;
+    var2 = var2 + var1 * (int64_t)calibration.P5 * ((int64_t)1 << 17);
+    var2 = var2 + (int64_t)calibration.P4 * ((int64_t)1 << 35);
+    var1 = ((var1 * var1 * (int64_t)calibration.P3) >> 8) + var1 * (int64_t)calibration.P2 * ((int64_t)1 << 12);
+    var1 = ((((int64_t)1 << 47) + var1) * (int64_t)calibration.P1) >> 33;
+    if (var1 == 0) {
+        return 0;   // Avoid division by zero
+    }
+    int64_t p = 1048576 - adcP;
+    p = ((p * ((int64_t)1 << 31) - var2) * 3125) / var1;
+    var1 = ((int64_t)calibration.P9 * (p >> 13) * (p >> 13)) >> 25;
+    var2 = ((int64_t)calibration.P8 * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (int64_t)calibration.P7 * 16;
+    return (uint32_t)p;
+}
+
+uint32_t bmp280ConversionUs(Bmp280Oversampling temperature, Bmp280Oversampling pressure) {
+    // Datasheet 3.8.1, maximum: 1.25 ms + 2.3 ms per temperature sample
+    // + 2.3 ms per pressure sample + 0.575 ms if pressure is measured
+    uint8_t t = (uint8_t)temperature;
+    uint8_t p = (uint8_t)pressure;
+    uint32_t us = 1250;
+    if (t > 0) {
+        us += 2300UL << (t - 1);
+    }
+    if (p > 0) {
+        us += (2300UL << (p - 1)) + 575;
+    }
+    return us;
+}
+
+float pressureToAltitude(float pressurePa, float seaLevelPa) {
+    // h(p; p0) = h(p * P0 / p0; P0), so one table serves any setting
+    float p = pressurePa * (BMP280_SEA_LEVEL_PA / seaLevelPa);
+    float x = (p - ALTITUDE_TABLE_MIN_PA) * (1.0f / ALTITUDE_TABLE_STEP_PA);
+    // Beyond either end, the end segment is extended
+    int16_t i = x <= 0.0f ? 0 : (int16_t)x;
+    if (i > ALTITUDE_TABLE_COUNT - 2) {
+        i = ALTITUDE_TABLE_COUNT - 2;
+    }
+    int32_t h0 = (int32_t)pgm_read_dword(&ALTITUDE_TABLE[i]);
+    int32_t h1 = (int32_t)pgm_read_dword(&ALTITUDE_TABLE[i + 1]);
+    return (h0 + (h1 - h0) * (x - i)) * 0.01f;
+}
+
+Bmp280 barometer;
+
+Bmp280::Bmp280()
+    : address(BMP280_ADDRESS_PRIMARY), present(false),
+      temperatureOversampling(Bmp280Oversampling::X1), pressureOversampling(Bmp280Oversampling::X4),
+      filter(Bmp280Filter::X4), converting(false), conversionStart(0), sampleStart(0),
+      temperatureCentiC(0), pressureQ8(0), sampleValid(false), samples(0), errors(0) {
+    conversionUs = bmp280ConversionUs(temperatureOversampling, pressureOversampling);
+}
+
+bool Bmp280::writeRegister(uint8_t reg, uint8_t value) {
+    return i2cBus.writeRegister(address, reg, value) == I2cResult::OK;
+}
+
+bool Bmp280::readRegisters(uint8_t reg, uint8_t* data, uint8_t length) {
+    return i2cBus.readRegisters(address, reg, data, length) == I2cResult::OK;
+}
+
+bool Bmp280::begin(uint8_t i2cAddress) {
+    address = i2cAddress;
+    present = false;
+    converting = false;
+    sampleValid = false;
+
+    uint8_t id;
+    if (!readRegisters(BMP280_REG_CHIP_ID, &id, 1) || (id != BMP280_CHIP_ID && id != BME280_CHIP_ID)) {
+        return false;
+    }
+    uint8_t raw[BMP280_CALIBRATION_LENGTH];
+    if (!readRegisters(BMP280_REG_CALIBRATION, raw, BMP280_CALIBRATION_LENGTH)) {
+        return false;
+    }
+    bmp280ParseCalibration(raw, calibration);
+    if (calibration.P1 == 0) {
+        return false;
+    }
+    present = true;
+    return configure(temperatureOversampling, pressureOversampling, filter);
+}
+
+bool Bmp280::configure(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter iirFilter) {
+    temperatureOversampling = temperature;
+    pressureOversampling = pressure;
+    filter = iirFilter;
+    conversionUs = bmp280ConversionUs(temperature, pressure);
+    if (!present) {
+        return false;
+    }
+    // The config register is only written reliably in sleep mode, which
+    // forced mode returns to after each conversion
+    converting = false;
+    return writeRegister(BMP280_REG_CTRL_MEAS, 0x00) &&
+           writeRegister(BMP280_REG_CONFIG, (uint8_t)((uint8_t)iirFilter << 2));
+}
+
+bool Bmp280::startConversion(uint32_t nowUs, uint32_t& readyInUs) {
+    uint8_t ctrl = (uint8_t)(((uint8_t)temperatureOversampling << 5) |
+                             ((uint8_t)pressureOversampling << 2) | BMP280_MODE_FORCED);
+    if (!present || !writeRegister(BMP280_REG_CTRL_MEAS, ctrl)) {
+        errors++;
+        return false;
+    }
+    converting = true;
+    conversionStart = nowUs;
+    readyInUs = conversionUs;
+    return true;
+}
+
+uint32_t Bmp280::remainingUs(uint32_t nowUs) const {
+    uint32_t elapsed = nowUs - conversionStart;
+    return (!converting || elapsed >= conversionUs) ? 0 : conversionUs - elapsed;
+}
+
+bool Bmp280::collect() {
+    converting = false;
+    uint8_t data[6];
+    if (!present || !readRegisters(BMP280_REG_DATA, data, 6)) {
+        errors++;
+        return false;
+    }
+    int32_t adcP = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+    int32_t adcT = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
+    if (adcT == BMP280_ADC_SKIPPED || adcP == BMP280_ADC_SKIPPED) {
+        errors++;
+        return false;
+    }
+    int32_t tFine;
+    int32_t temperature = bmp280CompensateTemperature(adcT, calibration, tFine);
+    uint32_t pressure = bmp280CompensatePressure(adcP, tFine, calibration);
+    if (pressure == 0) {
+        errors++;
+        return false;
+    }
+    temperatureCentiC = temperature;
+    pressureQ8 = pressure;
+    sampleStart = conversionStart;
+    sampleValid = true;
+    samples++;
+    return true;
+}
+
+bool Bmp280::service(uint32_t nowUs) {
+    bool collected = false;
+    if (converting) {
+        if (!isDue(nowUs)) {
+            return false;
+        }
+        collected = collect();
+    }
+    uint32_t readyIn;
+    startConversion(nowUs, readyIn);
+    return collected;
+}
@@ -0,0 +1,146 @@
+#ifndef BMP280_DRIVER_H
+#define BMP280_DRIVER_H
+
+#include <Arduino.h>
+#include "../extended_computer/i2c_bus.h"
+
+// BMP280 barometer in forced mode, compensated with the datasheet's
+// integer routines (section 8.2: 32-bit temperature, 64-bit pressure).
+//
+// Reads are pipelined so nobody waits for a conversion. Each call of
+// service() collects the conversion started by the previous one, if its
+// worst-case time has passed, and starts the next. Called once per frame,
+// the conversion runs between frames and costs only the two I2C
+// transfers. startConversion() and collect() are also exposed for the
+// sensor scheduler's trigger and collect steps.
+//
+// Oversampling and the IIR filter are configurable. Each oversampling
+// step roughly halves the noise and adds 2.3 ms to the conversion. The
+// filter also applies in forced mode, at one step per conversion.
+//
+// Altitude comes from a generated pressure-to-altitude table with linear
+// interpolation (altitude_table.h), not a pow() per sample.
+//
+// The board has one barometer, so there is one driver: the global
+// barometer below. AirDataInterface and SensorsCoordinationModule both
+// read it, and whichever finds a conversion due collects it. A sample is
+// stamped with its conversion's start, not with the time it was collected.
+
+static const uint8_t BMP280_ADDRESS_PRIMARY = 0x76;
+static const uint8_t BMP280_ADDRESS_SECONDARY = 0x77;
+static const uint8_t BMP280_CHIP_ID = 0x58;
+static const uint8_t BME280_CHIP_ID = 0x60;         // Same pressure and temperature path
+static const uint8_t BMP280_CALIBRATION_LENGTH = 24;
+static const float BMP280_SEA_LEVEL_PA = 101325.0f;
+
+enum class Bmp280Oversampling : uint8_t {
+    SKIP = 0,       // Channel not measured
+    X1 = 1,
+    X2 = 2,
+    X4 = 3,
+    X8 = 4,
+    X16 = 5
+};
+
+enum class Bmp280Filter : uint8_t {
+    OFF = 0,
+    X2 = 1,
+    X4 = 2,
+    X8 = 3,
+    X16 = 4
+};
+
+// Trimming parameters from registers 0x88..0x9F
+struct Bmp280Calibration {
+    uint16_t T1;
+    int16_t T2;
+    int16_t T3;
+    uint16_t P1;
+    int16_t P2;
+    int16_t P3;
+    int16_t P4;
+    int16_t P5;
+    int16_t P6;
+    int16_t P7;
+    int16_t P8;
+    int16_t P9;
+};
+
+// Datasheet compensation, independent of the bus
+void bmp280ParseCalibration(const uint8_t* raw, Bmp280Calibration& calibration);
+// 0.01 degC; tFine carries the temperature into pressure compensation
+int32_t bmp280CompensateTemperature(int32_t adcT, const Bmp280Calibration& calibration, int32_t& tFine);
+// Pa in Q24.8, 0 if the calibration is unusable
+uint32_t bmp280CompensatePressure(int32_t adcP, int32_t tFine, const Bmp280Calibration& calibration);
+// Worst-case forced conversion time
+uint32_t bmp280ConversionUs(Bmp280Oversampling temperature, Bmp280Oversampling pressure);
+// ISA altitude for a pressure, relative to the given sea-level pressure
+float pressureToAltitude(float pressurePa, float seaLevelPa = BMP280_SEA_LEVEL_PA);
+
+class Bmp280 {
+private:
+    uint8_t address;
+    bool present;
+    Bmp280Calibration calibration;
+
+    // Settings
+    Bmp280Oversampling temperatureOversampling;
+    Bmp280Oversampling pressureOversampling;
+    Bmp280Filter filter;
+    uint32_t conversionUs;
+
+    // Conversion in flight
+    bool converting;
+    uint32_t conversionStart;
+    uint32_t sampleStart;           // conversionStart of the last sample
+
+    // Last sample
+    int32_t temperatureCentiC;
+    uint32_t pressureQ8;            // Pa in Q24.8
+    bool sampleValid;
+    uint32_t samples;
+    uint32_t errors;
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegisters(uint8_t reg, uint8_t* data, uint8_t length);
+
+public:
+    Bmp280();
+
+    // Checks the chip ID, reads the trimming parameters and applies the
+    // current settings; the sensor is left asleep
+    bool begin(uint8_t i2cAddress = BMP280_ADDRESS_PRIMARY);
+    bool configure(Bmp280Oversampling temperature, Bmp280Oversampling pressure, Bmp280Filter iirFilter);
+
+    // Starts a forced conversion; readyInUs is its worst-case time
+    bool startConversion(uint32_t nowUs, uint32_t& readyInUs);
+    bool isConverting() const { return converting; }
+    bool isDue(uint32_t nowUs) const { return converting && nowUs - conversionStart >= conversionUs; }
+    uint32_t remainingUs(uint32_t nowUs) const;
+    // Reads and compensates a finished conversion
+    bool collect();
+    // Pipelined read: collects a due conversion and starts the next.
+    // True when a new sample was collected.
+    bool service(uint32_t nowUs);
+
+    // Last sample
+    bool hasSample() const { return sampleValid; }
+    int32_t getTemperatureCentiC() const { return temperatureCentiC; }
+    uint32_t getPressureQ8() const { return pressureQ8; }
+    // micros() when the last sample's conversion started
+    uint32_t getSampleStartUs() const { return sampleStart; }
+    float getTemperature() const { return temperatureCentiC * 0.01f; }
+    float getPressure() const { return pressureQ8 * (1.0f / 256.0f); }
+    float getAltitude(float seaLevelPa = BMP280_SEA_LEVEL_PA) const { return pressureToAltitude(getPressure(), seaLevelPa); }
+
+    bool isPresent() const { return present; }
+    uint8_t getAddress() const { return address; }
+    uint32_t getConversionUs() const { return conversionUs; }
+    uint32_t getSamples() const { return samples; }
+    uint32_t getErrors() const { return errors; }
+};
+
+// The board's barometer
+extern Bmp280 barometer;
+
+#endif // BMP280_DRIVER_H
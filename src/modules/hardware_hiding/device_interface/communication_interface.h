@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <SoftwareSerial.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Communication States
 enum class CommState {
@@ -140,7 +141,7 @@ struct CommError {
     bool timeout_error;
     bool protocol_error;
     bool hardware_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class CommunicationInterface {
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <LiquidCrystal_I2C.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Display States
 enum class DisplayState {
@@ -56,7 +57,7 @@ struct DisplayError {
     bool hardware_error;
     bool initialization_error;
     bool memory_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class DisplayInterface {
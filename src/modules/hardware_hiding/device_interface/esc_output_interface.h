@@ -2,6 +2,7 @@
 #define ESC_OUTPUT_INTERFACE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // ESC States
 enum class ESCState {
@@ -50,7 +51,7 @@ struct ESCError {
     bool protocol_error;
     bool voltage_error;
     bool temperature_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class ESCOutputInterface {
@@ -0,0 +1,146 @@
+#include "gps_interface.h"
+#include "../../software_decision/software_utility/trace.h"
+
+// Receiver configuration and UBX data path. The remaining GPSInterface
+// operations are implemented against these.
+
+bool GPSInterface::configureGPS() {
+    uint8_t frame[32];
+    uint16_t length;
+
+    // Switch the port to UBX-only at 115200. The receiver changes baud as
+    // soon as it takes the frame, so there is no ACK to wait for; send it at
+    // the factory rate and at the target rate in case it is already there.
+    const uint32_t rates[2] = { (uint32_t)baud_rate, UBX_BAUD };
+    length = ubxCfgPrtUart(UBX_BAUD, frame, sizeof(frame));
+    for (uint8_t i = 0; i < 2; i++) {
+        gpsSerial->begin(rates[i]);
+        sendUBXCommand(frame, length);
+        gpsSerial->flush();
+        delay(100);
+    }
+    gpsSerial->begin(UBX_BAUD);
+    baud_rate = GPSBaudRate::BAUD_115200;
+    config.baud_rate = GPSBaudRate::BAUD_115200;
+    ubx.reset();
+
+    // 10 Hz solutions, and the three NAV messages on every one
+    length = ubxCfgRate(UBX_PERIOD_MS, frame, sizeof(frame));
+    sendUBXCommand(frame, length);
+    bool ok = waitForAck(UBX_CLASS_CFG, UBX_CFG_RATE);
+
+    const uint8_t messages[3] = { UBX_NAV_STATUS, UBX_NAV_DOP, UBX_NAV_PVT };
+    for (uint8_t i = 0; i < 3; i++) {
+        length = ubxCfgMsg(UBX_CLASS_NAV, messages[i], 1, frame, sizeof(frame));
+        sendUBXCommand(frame, length);
+        ok &= waitForAck(UBX_CLASS_CFG, UBX_CFG_MSG);
+    }
+
+    if (!ok) {
+        errorInfo.communication_error = true;
+        errorInfo.error_message = "UBX configuration not acknowledged";
+        return false;
+    }
+    config.navigation_rate = 1000 / UBX_PERIOD_MS;
+    config.update_rate_hz = 1000 / UBX_PERIOD_MS;
+    return true;
+}
+
+void GPSInterface::sendUBXCommand(const uint8_t* command, uint8_t length) {
+    if (length > 0) {
+        gpsSerial->write(command, length);
+    }
+}
+
+bool GPSInterface::waitForAck(uint8_t cls, uint8_t id) {
+    uint32_t start = millis();
+    while (millis() - start < UBX_ACK_TIMEOUT_MS) {
+        while (gpsSerial->available() > 0) {
+            uint8_t got = ubx.encode((uint8_t)gpsSerial->read());
+            if ((got & (UBX_GOT_ACK | UBX_GOT_NAK)) && ubx.isAckFor(cls, id)) {
+                return got == UBX_GOT_ACK;
+            }
+        }
+    }
+    return false;
+}
+
+void GPSInterface::setNavigationRate(uint8_t rate_hz) {
+    if (rate_hz == 0) {
+        return;
+    }
+    uint8_t frame[16];
+    uint16_t length = ubxCfgRate(1000 / rate_hz, frame, sizeof(frame));
+    sendUBXCommand(frame, length);
+    if (waitForAck(UBX_CLASS_CFG, UBX_CFG_RATE)) {
+        config.navigation_rate = rate_hz;
+    }
+}
+
+void GPSInterface::readGPSData() {
+    // Bounded so a burst cannot hold up the loop; the rest stays in the
+    // receive buffer for the next call
+    for (uint8_t n = 0; n < READ_BUDGET && gpsSerial->available() > 0; n++) {
+        if (ubx.encode((uint8_t)gpsSerial->read()) & UBX_GOT_PVT) {
+            newEpoch = true;
+            processGPSData();
+        }
+    }
+    lastReadTime = millis();
+}
+
+void GPSInterface::processGPSData() {
+    const UbxNavSolution& nav = ubx.getSolution();
+    uint64_t arrivalUs = TimerModule::nowUs();
+    TimerModule::onGpsEpoch(nav.iTOW, arrivalUs);
+    bool fixOk = (nav.fixFlags & 0x01) && nav.fixType >= UBX_FIX_2D && nav.fixType <= UBX_FIX_GNSS_DR;
+
+    currentData.latitude = nav.lat * 1e-7;
+    currentData.longitude = nav.lon * 1e-7;
+    currentData.altitude = nav.hMSL * 1e-3;
+    currentData.speed = nav.gSpeed * 1e-3;
+    currentData.course = nav.headMot * 1e-5;
+    currentData.satellites = nav.numSV;
+    currentData.fix_quality = nav.fixType;
+    currentData.timestamp = millis();
+    currentData.time_of_week = nav.iTOW;
+    // The measurement instant, not when the solution got here
+    if (!TimerModule::getTimeBase().toLocalUs((uint64_t)nav.iTOW * 1000, currentData.sample_us)) {
+        currentData.sample_us = arrivalUs;
+    }
+    currentData.is_valid = fixOk;
+
+    currentStatus.has_fix = fixOk;
+    currentStatus.satellites = nav.numSV;
+    // NAV-DOP precedes NAV-PVT in an epoch; keep the previous value if it
+    // was lost
+    if (nav.dopITOW == nav.pvtITOW) {
+        currentStatus.hdop = nav.hDOP * 0.01;
+    }
+    currentStatus.altitude = currentData.altitude;
+    currentStatus.speed = currentData.speed;
+    currentStatus.fix_quality = nav.fixType;
+
+    if (!fixOk) {
+        currentState = GPSState::SEARCHING;
+    } else if (nav.fixType == UBX_FIX_2D) {
+        currentState = GPSState::FIX_2D;
+    } else {
+        currentState = GPSState::FIX_3D;
+    }
+    if (fixOk) {
+        lastValidUpdate = currentData.timestamp;
+        errorInfo.fix_lost_error = false;
+    }
+}
+
+bool GPSInterface::read() {
+    TRACE_SCOPE(GPS_READ);
+    newEpoch = false;
+    readGPSData();
+    return newEpoch;
+}
+
+uint32_t GPSInterface::getFixAge() const {
+    return millis() - lastValidUpdate;
+}
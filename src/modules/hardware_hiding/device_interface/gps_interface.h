@@ -2,7 +2,9 @@
 #define GPS_INTERFACE_H
 
 #include <Arduino.h>
-#include <TinyGPSPlus.h>
+#include "ubx_parser.h"
+#include "../extended_computer/timer_module.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // GPS States
 enum class GPSState {
@@ -15,7 +17,8 @@ enum class GPSState {
 };
 
 // GPS Configuration
-enum class GPSBaudRate {
+// GPS baud rates; 57600 and 115200 need more than the 16-bit int on AVR
+enum class GPSBaudRate : uint32_t {
     BAUD_9600 = 9600,
     BAUD_19200 = 19200,
     BAUD_38400 = 38400,
@@ -27,12 +30,14 @@ enum class GPSBaudRate {
 struct GPSData {
     double latitude;
     double longitude;
-    double altitude;
-    double speed;
-    double course;
+    double altitude;        // Above mean sea level, m
+    double speed;           // Ground speed, m/s
+    double course;          // Heading of motion, degrees
     uint8_t satellites;
-    uint8_t fix_quality;
-    uint32_t timestamp;
+    uint8_t fix_quality;    // NAV-PVT fixType
+    uint32_t timestamp;     // millis() when the epoch arrived
+    uint32_t time_of_week;  // GPS time of week of the epoch, ms
+    uint64_t sample_us;     // Epoch in TimerModule::nowUs() time (arrival until PPS gives GPS time)
     bool is_valid;
 };
 
@@ -61,7 +66,7 @@ struct GPSError {
     bool timeout_error;
     bool fix_lost_error;
     bool antenna_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class GPSInterface {
@@ -78,13 +83,21 @@ private:
     GPSConfig config;
     GPSError errorInfo;
     
-    // GPS Object
-    TinyGPSPlus gps;
+    // UBX parser, fed from the UART receive buffer. At 115200 baud the
+    // 64-byte HardwareSerial buffer fills in about 5.5 ms, so read() must be
+    // called at least that often (or SERIAL_RX_BUFFER_SIZE raised).
+    UbxParser ubx;
+    bool newEpoch;
     
     // Timing
     uint32_t lastValidUpdate;
     uint32_t lastReadTime;
     
+    static const uint32_t UBX_BAUD = 115200;
+    static const uint16_t UBX_PERIOD_MS = 100;      // 10 Hz
+    static const uint16_t UBX_ACK_TIMEOUT_MS = 250;
+    static const uint8_t READ_BUDGET = 128;         // Bytes parsed per readGPSData
+    
     // Private Methods
     bool initializeHardware();
     bool configureGPS();
@@ -93,6 +106,7 @@ private:
     bool validateData();
     void updateErrorInfo();
     void sendUBXCommand(const uint8_t* command, uint8_t length);
+    bool waitForAck(uint8_t cls, uint8_t id);
     
 public:
     GPSInterface(HardwareSerial& serial, uint8_t pin = -1);
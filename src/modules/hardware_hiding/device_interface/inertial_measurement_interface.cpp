@@ -0,0 +1,152 @@
+#include "inertial_measurement_interface.h"
+#include "../extended_computer/i2c_bus.h"
+#include "../extended_computer/timer_module.h"
+#include "../../software_decision/application_data_types/state_events.h"
+#include "../../software_decision/software_utility/trace.h"
+
+// Boot-time gyro bias from the learned temperature model, and sample reads
+// stamped at the data-ready edge. The remaining InertialMeasurementInterface
+// operations are implemented against these; calibrate() leaves the gyro
+// offsets in calibration in deg/s.
+
+static const uint8_t GYRO_BIAS_BOOT_ATTEMPTS = 3;
+
+// MPU6050 interrupt: 50 us active-high pulse on each new sample
+static const uint8_t MPU6050_REG_INT_PIN_CFG = 0x37;
+static const uint8_t MPU6050_REG_INT_ENABLE = 0x38;
+static const uint8_t MPU6050_INT_PULSE_HIGH = 0x00;
+static const uint8_t MPU6050_INT_DATA_READY = 0x01;
+
+volatile uint64_t InertialMeasurementInterface::dataReadyUs = 0;
+volatile bool InertialMeasurementInterface::dataReadyPending = false;
+
+// MPU6050 temperature: C = raw / 340 + 36.53
+static const float MPU6050_TEMP_LSB_PER_C = 340.0f;
+static const float MPU6050_TEMP_OFFSET_C = 36.53f;
+
+static float gyroLsbPerDps(IMUConfig config) {
+    switch (config) {
+        case IMUConfig::GYRO_250DPS:  return 131.0f;
+        case IMUConfig::GYRO_1000DPS: return 32.8f;
+        case IMUConfig::GYRO_2000DPS: return 16.4f;
+        default:                      return 65.5f;
+    }
+}
+
+static float rawTemperature(int16_t raw) {
+    return raw / MPU6050_TEMP_LSB_PER_C + MPU6050_TEMP_OFFSET_C;
+}
+
+GyroBootResult InertialMeasurementInterface::startupGyroBias(ConfigStore* store, uint16_t window_samples, uint8_t delay_ms) {
+    GyroBootResult result = GyroBootResult::NO_MODEL;
+    float bias[3];
+    float lsb = gyroLsbPerDps(gyro_config);
+
+    CalibrationStats* window = calibrationArena.leaseStats(this, GYRO_BIAS_WINDOW_DIMS);
+    if (window != nullptr) {
+        for (uint8_t attempt = 0; attempt < GYRO_BIAS_BOOT_ATTEMPTS; attempt++) {
+            window->begin(GYRO_BIAS_WINDOW_DIMS);
+            for (uint16_t n = 0; n < window_samples; n++) {
+                RawIMUData raw;
+                if (readRawData(raw)) {
+                    float sample[GYRO_BIAS_WINDOW_DIMS] = {
+                        raw.gyro_x / lsb, raw.gyro_y / lsb, raw.gyro_z / lsb, rawTemperature(raw.temp)
+                    };
+                    window->add(sample);
+                }
+                delay(delay_ms);
+            }
+            result = gyroBiasModel.checkBoot(*window, bias);
+            if (result != GyroBootResult::MOVING) {
+                break;
+            }
+        }
+        if (result == GyroBootResult::MODEL) {
+            gyroBiasModel.addStillWindow(*window);
+        }
+        calibrationArena.release(this);
+    }
+
+    if (result == GyroBootResult::MODEL) {
+        calibration.gyro_offset_x = bias[0];
+        calibration.gyro_offset_y = bias[1];
+        calibration.gyro_offset_z = bias[2];
+        calibration.is_calibrated = true;
+    } else {
+        // Never still, no model here, or a model that is off: calibrate as
+        // before. A model that disagreed is relearned from this calibration.
+        if (result == GyroBootResult::DISAGREES) {
+            gyroBiasModel.clear();
+        }
+        if (!calibrate()) {
+            return result;
+        }
+        RawIMUData raw;
+        if (readRawData(raw)) {
+            float measured[3] = { calibration.gyro_offset_x, calibration.gyro_offset_y, calibration.gyro_offset_z };
+            gyroBiasModel.addObservation(measured, rawTemperature(raw.temp), GYRO_BIAS_CALIBRATION_WEIGHT);
+        }
+    }
+
+    if (store != nullptr) {
+        gyroBiasModel.save(*store);
+    }
+    return result;
+}
+
+void InertialMeasurementInterface::dataReadyIsr() {
+    // Stamp first: the sample was latched at this edge
+    dataReadyUs = TimerModule::nowUs();
+    dataReadyPending = true;
+    EventManager::postFromIsr(IsrEventSource::IMU_DATA_READY);
+}
+
+uint64_t InertialMeasurementInterface::takeSampleTime() {
+    // Without a fresh edge the best stamp is now
+    uint64_t stamp = TimerModule::nowUs();
+    noInterrupts();
+    if (dataReadyPending) {
+        stamp = dataReadyUs;
+        dataReadyPending = false;
+    }
+    interrupts();
+    return stamp;
+}
+
+void InertialMeasurementInterface::setInterruptPin(uint8_t pin) {
+    int interrupt = digitalPinToInterrupt(pin);
+    if (interrupt < 0) {
+        errorInfo.communication_error = true;
+        errorInfo.error_message = "IMU INT pin has no external interrupt";
+        return;
+    }
+    if (i2cBus.writeRegister(i2c_address, MPU6050_REG_INT_PIN_CFG, MPU6050_INT_PULSE_HIGH) != I2cResult::OK ||
+        i2cBus.writeRegister(i2c_address, MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_READY) != I2cResult::OK) {
+        errorInfo.communication_error = true;
+        errorInfo.error_message = "IMU data-ready interrupt not enabled";
+        return;
+    }
+    pinMode(pin, INPUT);
+    attachInterrupt(interrupt, dataReadyIsr, RISING);
+}
+
+bool InertialMeasurementInterface::read() {
+    TRACE_SCOPE(IMU_READ);
+    ScaledIMUData scaled;
+    if (!readScaledData(scaled)) {
+        currentData.is_valid = false;
+        return false;
+    }
+    currentData.sample_us = takeSampleTime();
+    currentData.timestamp = millis();
+    currentData.accel_x = scaled.accel_x;
+    currentData.accel_y = scaled.accel_y;
+    currentData.accel_z = scaled.accel_z;
+    currentData.gyro_x = scaled.gyro_x - calibration.gyro_offset_x;
+    currentData.gyro_y = scaled.gyro_y - calibration.gyro_offset_y;
+    currentData.gyro_z = scaled.gyro_z - calibration.gyro_offset_z;
+    currentData.temp = scaled.temp;
+    calculateAngles();
+    currentData.is_valid = true;
+    return true;
+}
@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "../extended_computer/config_store.h"
+#include "gyro_bias_model.h"
 
 // IMU States
 enum class IMUState {
@@ -59,6 +62,7 @@ struct IMUData {
     float angle_pitch, angle_roll, angle_yaw;
     float accel_angle_x, accel_angle_y;
     uint32_t timestamp;
+    uint64_t sample_us;     // TimerModule::nowUs() at the data-ready edge, or at the read without one
     bool is_valid;
 };
 
@@ -96,7 +100,7 @@ struct Quaternion {
     float z;          ///< Z component
 };
 
-// IMU Calibration Data
+// IMU Calibration Data; gyro offsets in deg/s
 struct IMUCalibration {
     float accel_offset_x, accel_offset_y, accel_offset_z;
     float gyro_offset_x, gyro_offset_y, gyro_offset_z;
@@ -104,6 +108,9 @@ struct IMUCalibration {
     bool is_calibrated;
 };
 
+// Bump when IMUCalibration changes layout; older stored images are ignored
+static const uint8_t IMU_CALIBRATION_VERSION = 1;
+
 // Advanced MPU6050 calibration structure
 struct CalibrationOffsets {
     int16_t accel_x_offset;   ///< Accelerometer X-axis offset
@@ -120,7 +127,7 @@ struct IMUError {
     bool accel_error;
     bool temp_error;
     bool communication_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class InertialMeasurementInterface {
@@ -135,6 +142,7 @@ private:
     IMUState currentState;
     IMUData currentData;
     IMUCalibration calibration;
+    GyroBiasModel gyroBiasModel;
     IMUError errorInfo;
     
     // Timing
@@ -143,6 +151,13 @@ private:
     // Error Tracking
     float acc_err_x, acc_err_y, gyro_err_x, gyro_err_y, gyro_err_z;
     
+    // Data-ready interrupt (setInterruptPin): the ISR stamps the sample it
+    // announces, and read() takes that stamp
+    static volatile uint64_t dataReadyUs;
+    static volatile bool dataReadyPending;
+    static void dataReadyIsr();         // Also posts an IsrEventSource::IMU_DATA_READY event
+    static uint64_t takeSampleTime();
+    
     // Private Methods
     bool initializeHardware();
     bool configureSensors();
@@ -174,6 +189,8 @@ public:
     void setAccelRange(AccelRange range);
     void setDLPF(DLPF setting);
     void setSampleRate(uint8_t rate_hz);
+    // MPU6050 INT on an external interrupt pin; samples are then stamped at
+    // the data-ready edge instead of when read() gets to them
     void setInterruptPin(uint8_t pin);
     
     // Data Access
@@ -205,6 +222,24 @@ public:
     void resetCalibration();
     IMUCalibration getCalibration() const { return calibration; }
     void setCalibration(const IMUCalibration& cal);
+    // The gyro bias model is stored alongside; a missing model is not an error
+    bool saveCalibration(ConfigStore& store) const {
+        return store.saveImage(CONFIG_KEY_IMU_CALIBRATION, IMU_CALIBRATION_VERSION, calibration) &&
+               gyroBiasModel.save(store);
+    }
+    bool loadCalibration(const ConfigStore& store) {
+        gyroBiasModel.load(store);
+        return store.loadImage(CONFIG_KEY_IMU_CALIBRATION, IMU_CALIBRATION_VERSION, calibration);
+    }
+    
+    // Boot gyro bias: a short still window checked against the learned
+    // bias-temperature model, with calibrate() only when they disagree or
+    // the model has nothing for this temperature. Either way the result is
+    // learned, and saved if a store is given.
+    GyroBootResult startupGyroBias(ConfigStore* store = nullptr, uint16_t window_samples = GYRO_BIAS_BOOT_SAMPLES, uint8_t delay_ms = 4);
+    // More learning, e.g. from still windows while disarmed
+    bool learnGyroBias(const CalibrationStats& window) { return gyroBiasModel.addStillWindow(window); }
+    const GyroBiasModel& getGyroBiasModel() const { return gyroBiasModel; }
     
     // Advanced MPU6050 Calibration
     CalibrationOffsets getCalibrationOffsets() const;
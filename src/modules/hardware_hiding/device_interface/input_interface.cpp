@@ -0,0 +1,68 @@
+#include "input_interface.h"
+
+// Serial receiver input. The remaining InputInterface operations are
+// implemented against these; processRadioInput() is the once-per-loop
+// radio step and reads the serial receiver when one is attached.
+
+static const unsigned long RADIO_DEFAULT_FAILSAFE_MS = 500;
+static const int RADIO_DEFAULT_CENTER_US = 1500;
+static const int RADIO_DEFAULT_RANGE_US = 500;
+
+bool InputInterface::beginSerialRadio(HardwareSerial& port, RcProtocol protocol) {
+    rcDecoder.begin(protocol);
+    radioSerial = &port;
+    // SBUS is inverted on the wire; the AVR UART expects an inverter in front
+    port.begin(rcDecoder.getBaud(), protocol == RcProtocol::SBUS ? SERIAL_8E2 : SERIAL_8N1);
+    config.type = InputType::RADIO;
+    radioInitialized = true;
+    return true;
+}
+
+void InputInterface::processRadioInput() {
+    if (radioSerial != nullptr) {
+        readSerialRadio();
+    }
+}
+
+void InputInterface::readSerialRadio() {
+    if (radioSerial == nullptr) {
+        return;
+    }
+    uint32_t now = micros();
+    bool newFrame = false;
+    // Drain the receive ring; a frame is at most 32 bytes and they arrive
+    // far slower than they are read
+    while (radioSerial->available() > 0) {
+        newFrame |= rcDecoder.feed((uint8_t)radioSerial->read(), now);
+    }
+    rcDecoder.idle(now);
+
+    if (newFrame) {
+        for (uint8_t i = 0; i < (uint8_t)ChannelId::CHANNEL_COUNT; i++) {
+            int raw = rcDecoder.getChannel(i);
+            int center = config.channel_center_us[i] ? config.channel_center_us[i] : RADIO_DEFAULT_CENTER_US;
+            int range = config.channel_range_us[i] ? config.channel_range_us[i] : RADIO_DEFAULT_RANGE_US;
+            currentData.radio_channels[i] = raw;
+            currentData.normalized_channels[i] = constrain((float)(raw - center) / range, -1.0f, 1.0f);
+        }
+        // When the frame arrived, not when this loop got to it
+        currentData.timestamp = millis() - (now - rcDecoder.getFrameUs()) / 1000UL;
+        currentData.last_signal_time = currentData.timestamp;
+    }
+
+    unsigned long timeoutMs = config.failsafe_timeout_ms ? config.failsafe_timeout_ms : RADIO_DEFAULT_FAILSAFE_MS;
+    bool signal = rcDecoder.hasSignal(now, timeoutMs * 1000UL);
+    currentData.radio_status = signal ? RadioStatus::RADIO_ON : RadioStatus::RADIO_FAILSAFE;
+    currentData.is_valid = signal;
+}
+
+uint8_t InputInterface::getRadioChannelCount() const {
+    return radioSerial != nullptr ? rcDecoder.getChannelCount() : (uint8_t)ChannelId::CHANNEL_COUNT;
+}
+
+int InputInterface::getRadioChannelUs(uint8_t index) const {
+    if (radioSerial != nullptr) {
+        return rcDecoder.getChannel(index);
+    }
+    return index < (uint8_t)ChannelId::CHANNEL_COUNT ? currentData.radio_channels[index] : 0;
+}
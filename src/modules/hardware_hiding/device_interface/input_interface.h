@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <Keypad.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "rc_serial_decoder.h"
 
 // Input States
 enum class InputState {
@@ -59,7 +61,7 @@ struct InputData {
     int radio_channels[8];           // Raw PWM values for each channel
     float normalized_channels[8];    // Normalized values (-1.0 to 1.0)
     RadioStatus radio_status;       // Current radio status
-    unsigned long last_signal_time; // Time since last signal received
+    unsigned long last_signal_time; // millis() when the last frame was received
 };
 
 // Input Configuration
@@ -89,7 +91,7 @@ struct InputError {
     bool communication_error;
     bool debounce_error;
     bool memory_error;
-    String error_message;
+    ErrorText error_message;
 };
 
 class InputInterface {
@@ -131,6 +133,10 @@ private:
     unsigned long lastRadioCheck;
     unsigned long radioCheckInterval;
     
+    // Serial receiver (SBUS/iBus); null when channels come from PPM
+    HardwareSerial* radioSerial = nullptr;
+    RcSerialDecoder rcDecoder;
+    
     // Private Methods
     bool initializeHardware();
     bool configureInput();
@@ -141,6 +147,7 @@ private:
     // Radio-specific private methods
     bool initializeRadio();
     void processRadioInput();
+    void readSerialRadio();
     void updateRadioStatus();
     void checkRadioFailsafe();
     int normalizeChannelValue(int raw_value, ChannelId channel);
@@ -199,7 +206,16 @@ public:
     RadioStatus getRadioStatus() const { return currentData.radio_status; }
     bool isRadioOn() const { return currentData.radio_status == RadioStatus::RADIO_ON; }
     bool isRadioFailsafe() const { return currentData.radio_status == RadioStatus::RADIO_FAILSAFE; }
-    unsigned long getTimeSinceLastSignal() const { return currentData.last_signal_time; }
+    unsigned long getTimeSinceLastSignal() const { return millis() - currentData.last_signal_time; }
+    
+    // Serial receiver: all channels of a frame from one UART instead of
+    // timing pulses. Opens the port with the protocol's framing.
+    bool beginSerialRadio(HardwareSerial& port, RcProtocol protocol);
+    bool isSerialRadio() const { return radioSerial != nullptr; }
+    uint8_t getRadioChannelCount() const;
+    // Any channel the receiver sends, in microseconds (index from 0)
+    int getRadioChannelUs(uint8_t index) const;
+    const RcSerialDecoder& getRcDecoder() const { return rcDecoder; }
     
     // Radio Control
     void switchRadioOn();
@@ -0,0 +1,59 @@
+#include "input_output_representation_interface.h"
+#include <string.h>
+
+// Calibration on the shared arena. The remaining
+// InputOutputRepresentationInterface operations are implemented against
+// these; calibrationStats is nullptr whenever this module does not hold
+// the arena.
+
+static const uint16_t IO_CALIBRATION_SAMPLES = 100;     // Per channel, for a complete calibration
+
+void InputOutputRepresentationInterface::startCalibration(uint8_t ioId) {
+    if (ioId >= MAX_IO_CHANNELS) {
+        return;
+    }
+    // Channels are calibrated one after another on one lease; starting a
+    // channel clears only its own statistics
+    if (calibrationStats == nullptr) {
+        // Refused while another module calibrates; isCalibrating() stays false
+        calibrationStats = calibrationArena.leaseChannels(this, MAX_IO_CHANNELS);
+        if (calibrationStats == nullptr) {
+            return;
+        }
+    } else {
+        memset(&calibrationStats[ioId], 0, sizeof(ChannelStats));
+    }
+    calibrationInProgress = true;
+    calibrationStartTime = millis();
+    calibrationSamples = 0;
+}
+
+void InputOutputRepresentationInterface::stopCalibration() {
+    calibrationArena.release(this);
+    calibrationStats = nullptr;
+    calibrationInProgress = false;
+}
+
+bool InputOutputRepresentationInterface::addCalibrationSample(uint8_t ioId, double value) {
+    if (!calibrationInProgress || calibrationStats == nullptr || ioId >= MAX_IO_CHANNELS) {
+        return false;
+    }
+    calibrationStats[ioId].add((float)value);
+    calibrationSamples++;
+    return true;
+}
+
+double InputOutputRepresentationInterface::getCalibrationProgress() const {
+    // Samples since the last channel was started
+    if (calibrationSamples >= IO_CALIBRATION_SAMPLES) {
+        return 1.0;
+    }
+    return (double)calibrationSamples / IO_CALIBRATION_SAMPLES;
+}
+
+const ChannelStats* InputOutputRepresentationInterface::getCalibrationStats(uint8_t ioId) const {
+    if (calibrationStats == nullptr || ioId >= MAX_IO_CHANNELS) {
+        return nullptr;
+    }
+    return &calibrationStats[ioId];
+}
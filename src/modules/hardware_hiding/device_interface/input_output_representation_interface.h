@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include "../../software_decision/application_data_types/numeric_types.h"
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "../../software_decision/software_utility/calibration_arena.h"
 
 // IO states
 enum class IORepresentationState {
@@ -74,7 +76,7 @@ struct IORepresentationData {
     unsigned long timestamp;
     unsigned long lastUpdate;
     uint8_t errorCount;
-    String errorMessage;
+    ErrorText errorMessage;
 };
 
 // IO event types
@@ -206,7 +208,7 @@ private:
     bool calibrationInProgress;
     unsigned long calibrationStartTime;
     uint16_t calibrationSamples;
-    double calibrationData[MAX_IO_CHANNELS][100];
+    ChannelStats* calibrationStats;     // Leased from calibrationArena while calibrating, one per IO channel
     
     // Component interfaces
     NumericTypes* numericTypes;
@@ -303,12 +305,16 @@ public:
     void processPWMIO();
     void processSerialIO();
     
-    // Calibration
+    // Calibration. The first startCalibration() leases the shared arena and
+    // is refused while another module holds it; later ones restart just
+    // that channel. stopCalibration() releases the arena.
     void startCalibration(uint8_t ioId);
     void stopCalibration();
     bool isCalibrating() const { return calibrationInProgress; }
     bool addCalibrationSample(uint8_t ioId, double value);
     double getCalibrationProgress() const;
+    // nullptr unless calibrating
+    const ChannelStats* getCalibrationStats(uint8_t ioId) const;
     bool calibrateIO(uint8_t ioId, double knownValue);
     
     // Filtering and averaging
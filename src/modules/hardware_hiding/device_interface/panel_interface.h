@@ -2,6 +2,7 @@
 #define PANEL_INTERFACE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Panel device types
 enum class PanelDeviceType {
@@ -139,7 +140,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeHardware();
@@ -216,7 +217,7 @@ public:
     uint8_t getErrorFlags() const { return errorFlags; }
     
     // Error handling
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
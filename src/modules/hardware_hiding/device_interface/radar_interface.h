@@ -2,6 +2,7 @@
 #define RADAR_INTERFACE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Radar system types
 enum class RadarType {
@@ -89,7 +90,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeHardware();
@@ -150,7 +151,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
@@ -0,0 +1,143 @@
+#include "rc_serial_decoder.h"
+#include "../../software_decision/software_utility/trace.h"
+
+// SBUS flags byte
+static const uint8_t SBUS_FLAG_CH17 = 0x01;
+static const uint8_t SBUS_FLAG_CH18 = 0x02;
+static const uint8_t SBUS_FLAG_FRAME_LOST = 0x04;
+static const uint8_t SBUS_FLAG_FAILSAFE = 0x08;
+static const uint16_t SBUS_DIGITAL_LOW = 172;
+static const uint16_t SBUS_DIGITAL_HIGH = 1811;
+
+static const uint8_t IBUS_SLOTS = 14;
+
+RcSerialDecoder::RcSerialDecoder() {
+    begin(RcProtocol::SBUS);
+}
+
+void RcSerialDecoder::begin(RcProtocol rcProtocol) {
+    protocol = rcProtocol;
+    if (protocol == RcProtocol::SBUS) {
+        frameLength = SBUS_FRAME_LENGTH;
+        frameGapUs = SBUS_FRAME_GAP_US;
+    } else {
+        frameLength = IBUS_FRAME_LENGTH;
+        frameGapUs = IBUS_FRAME_GAP_US;
+    }
+    for (uint8_t i = 0; i < RC_SERIAL_MAX_CHANNELS; i++) {
+        channels[i] = 0;
+    }
+    channelCount = 0;
+    frameLost = false;
+    failsafe = false;
+    frameUs = 0;
+    frames = 0;
+    lostFrames = 0;
+    frameErrors = 0;
+    syncErrors = 0;
+    skippedBytes = 0;
+    lastByteUs = 0;
+    reset();
+}
+
+void RcSerialDecoder::reset() {
+    length = 0;
+}
+
+void RcSerialDecoder::idle(uint32_t nowUs) {
+    if (length > 0 && nowUs - lastByteUs > frameGapUs) {
+        syncErrors++;
+        length = 0;
+    }
+}
+
+bool RcSerialDecoder::feed(uint8_t byte, uint32_t nowUs) {
+    idle(nowUs);
+    lastByteUs = nowUs;
+
+    if (length == 0) {
+        // A frame starts with its header; outside one, bytes are skipped
+        // until the next header
+        bool header = protocol == RcProtocol::SBUS ? byte == SBUS_HEADER : byte == IBUS_FRAME_LENGTH;
+        if (!header) {
+            skippedBytes++;
+            return false;
+        }
+    } else if (length == 1 && protocol == RcProtocol::IBUS && byte != IBUS_COMMAND) {
+        // Not a servo frame, or a false header: look for the next one
+        skippedBytes += 2;
+        length = 0;
+        return false;
+    }
+
+    frame[length++] = byte;
+    if (length < frameLength) {
+        return false;
+    }
+    length = 0;
+    if (!decode()) {
+        frameErrors++;
+        return false;
+    }
+    frameUs = nowUs;
+    frames++;
+    return true;
+}
+
+bool RcSerialDecoder::decode() {
+    TRACE_SCOPE(RADIO_READ);
+    return protocol == RcProtocol::SBUS ? decodeSbus() : decodeIbus();
+}
+
+bool RcSerialDecoder::decodeSbus() {
+    uint8_t end = frame[SBUS_FRAME_LENGTH - 1];
+    if (end != 0x00 && (end & 0xCF) != 0x04) {
+        return false;
+    }
+    // 16 channels of 11 bits packed LSB first into bytes 1..22
+    uint32_t bits = 0;
+    uint8_t bitCount = 0;
+    uint8_t channel = 0;
+    for (uint8_t i = 1; i <= 22; i++) {
+        bits |= (uint32_t)frame[i] << bitCount;
+        bitCount += 8;
+        if (bitCount >= 11) {
+            channels[channel++] = sbusToUs((uint16_t)(bits & 0x07FF));
+            bits >>= 11;
+            bitCount -= 11;
+        }
+    }
+    uint8_t flags = frame[23];
+    channels[16] = sbusToUs((flags & SBUS_FLAG_CH17) ? SBUS_DIGITAL_HIGH : SBUS_DIGITAL_LOW);
+    channels[17] = sbusToUs((flags & SBUS_FLAG_CH18) ? SBUS_DIGITAL_HIGH : SBUS_DIGITAL_LOW);
+    channelCount = 18;
+    frameLost = (flags & SBUS_FLAG_FRAME_LOST) != 0;
+    failsafe = (flags & SBUS_FLAG_FAILSAFE) != 0;
+    if (frameLost) {
+        lostFrames++;
+    }
+    return true;
+}
+
+bool RcSerialDecoder::decodeIbus() {
+    uint16_t sum = 0xFFFF;
+    for (uint8_t i = 0; i < IBUS_FRAME_LENGTH - 2; i++) {
+        sum -= frame[i];
+    }
+    if (sum != (uint16_t)(frame[30] | (frame[31] << 8))) {
+        return false;
+    }
+    const uint8_t* slot = frame + 2;
+    for (uint8_t i = 0; i < IBUS_SLOTS; i++) {
+        channels[i] = (uint16_t)(slot[2 * i] | ((slot[2 * i + 1] & 0x0F) << 8));
+    }
+    // Channels 15..18: one nibble from each of three consecutive slots
+    for (uint8_t i = IBUS_SLOTS; i < RC_SERIAL_MAX_CHANNELS; i++) {
+        const uint8_t* high = slot + 6 * (i - IBUS_SLOTS) + 1;
+        channels[i] = (uint16_t)((high[0] >> 4) | (high[2] & 0xF0) | ((high[4] & 0xF0) << 4));
+    }
+    channelCount = RC_SERIAL_MAX_CHANNELS;
+    frameLost = false;
+    failsafe = false;
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef RC_SERIAL_DECODER_H
+#define RC_SERIAL_DECODER_H
+
+#include <stdint.h>
+
+// Serial RC receiver decoder: Futaba SBUS and FlySky iBus on a hardware
+// UART, as an alternative to timing PWM or PPM pulses with interrupts. The
+// UART's own receive ring is the only buffer: the receive interrupt stores
+// one byte at a time and the decoder takes bytes from it in the loop, so
+// a whole frame of channels costs no pulse-timing interrupts and jitter
+// from other ISRs does not reach the channel values.
+//
+// SBUS: 100000 baud 8E2, logically inverted (the AVR UART needs an
+// external inverter). 25 bytes: 0x0F | 16 channels x 11 bits, LSB first |
+// flags | end byte (0x00, or 0x04/0x14/0x24/0x34 for SBUS2). The flags hold
+// digital channels 17 and 18, frame lost and failsafe. Every 7 or 14 ms.
+//
+// iBus: 115200 baud 8N1. 32 bytes: 0x20 0x40 | 14 channels as LE16 |
+// checksum 0xFFFF - sum of the first 30 bytes. Channels are 12 bits;
+// newer receivers carry channels 15..18 in the top nibbles of the first
+// twelve (0 from older ones). Every 7 ms, with no failsafe flag: receivers
+// either stop sending or send their failsafe positions.
+//
+// Frames are synchronised on the gap between them. A byte arriving after
+// a silence longer than the protocol's gap starts a new frame, and a frame
+// cut short by a gap is dropped. When the loop is too slow to see gaps,
+// the header bytes and the end byte or checksum still resync. Channel
+// values are only replaced by a complete, checked frame, in microseconds.
+//
+// The AVR default receive buffer is 64 bytes, two SBUS frames or 5.5 ms
+// of iBus, so the decoder must be fed at least that often.
+
+static const uint8_t RC_SERIAL_MAX_CHANNELS = 18;
+static const uint8_t RC_SERIAL_MAX_FRAME = 32;
+
+static const uint32_t SBUS_BAUD = 100000;
+static const uint8_t SBUS_FRAME_LENGTH = 25;
+static const uint8_t SBUS_HEADER = 0x0F;
+static const uint32_t SBUS_FRAME_GAP_US = 3000;     // Frame takes 3 ms, gap is 4 ms or more
+
+static const uint32_t IBUS_BAUD = 115200;
+static const uint8_t IBUS_FRAME_LENGTH = 32;
+static const uint8_t IBUS_COMMAND = 0x40;           // Servo channels
+static const uint32_t IBUS_FRAME_GAP_US = 500;      // Bytes are 87 us apart within a frame
+
+enum class RcProtocol : uint8_t {
+    SBUS,
+    IBUS
+};
+
+class RcSerialDecoder {
+private:
+    RcProtocol protocol;
+    uint8_t frameLength;
+    uint32_t frameGapUs;
+
+    // Frame being received
+    uint8_t frame[RC_SERIAL_MAX_FRAME];
+    uint8_t length;
+    uint32_t lastByteUs;
+
+    // Last complete frame
+    uint16_t channels[RC_SERIAL_MAX_CHANNELS];
+    uint8_t channelCount;
+    bool frameLost;
+    bool failsafe;
+    uint32_t frameUs;
+
+    // Statistics
+    uint32_t frames;
+    uint32_t lostFrames;        // Frames the receiver flagged as lost
+    uint32_t frameErrors;       // Bad end byte or checksum
+    uint32_t syncErrors;        // Frames cut short by a gap
+    uint32_t skippedBytes;      // Bytes outside a frame
+
+    bool decode();
+    bool decodeSbus();
+    bool decodeIbus();
+
+public:
+    RcSerialDecoder();
+
+    // Selects the protocol and clears the frame and channels
+    void begin(RcProtocol rcProtocol);
+    void reset();
+
+    // Feeds one byte received at nowUs; true when it completes a good frame
+    bool feed(uint8_t byte, uint32_t nowUs);
+    // Called when the receive buffer is empty, so a gap is seen even before
+    // the next byte arrives
+    void idle(uint32_t nowUs);
+
+    RcProtocol getProtocol() const { return protocol; }
+    uint32_t getBaud() const { return protocol == RcProtocol::SBUS ? SBUS_BAUD : IBUS_BAUD; }
+
+    // Last complete frame; channel values in microseconds, index from 0
+    bool hasFrame() const { return frames > 0; }
+    uint8_t getChannelCount() const { return channelCount; }
+    uint16_t getChannel(uint8_t index) const { return index < channelCount ? channels[index] : 0; }
+    const uint16_t* getChannels() const { return channels; }
+    bool isFrameLost() const { return frameLost; }
+    bool isFailsafe() const { return failsafe; }
+    uint32_t getFrameUs() const { return frameUs; }
+    // True when a good frame without the failsafe flag arrived within timeoutUs
+    bool hasSignal(uint32_t nowUs, uint32_t timeoutUs) const {
+        return frames > 0 && !failsafe && nowUs - frameUs < timeoutUs;
+    }
+
+    uint32_t getFrames() const { return frames; }
+    uint32_t getLostFrames() const { return lostFrames; }
+    uint32_t getFrameErrors() const { return frameErrors; }
+    uint32_t getSyncErrors() const { return syncErrors; }
+    uint32_t getSkippedBytes() const { return skippedBytes; }
+
+    // SBUS 11-bit value to microseconds: 172..1811 is 988..2012 us
+    static uint16_t sbusToUs(uint16_t value) { return (uint16_t)(880 + ((value * 5) >> 3)); }
+};
+
+#endif // RC_SERIAL_DECODER_H
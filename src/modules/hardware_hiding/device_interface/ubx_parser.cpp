@@ -0,0 +1,240 @@
+#include "ubx_parser.h"
+#include <string.h>
+
+// Payload lengths of the messages we decode; NAV-PVT is 84 bytes on
+// protocol 14 receivers and 92 from protocol 15 on, the fields used here
+// are common to both
+static const uint8_t UBX_PVT_MIN_LENGTH = 84;
+static const uint8_t UBX_STATUS_LENGTH = 16;
+static const uint8_t UBX_DOP_LENGTH = 18;
+static const uint8_t UBX_ACK_LENGTH = 2;
+// Longer lengths are taken as a false sync rather than waited out
+static const uint16_t UBX_MAX_LENGTH = 2048;
+
+static inline uint16_t readU2(const uint8_t* p) {
+    return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+static inline uint32_t readU4(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline int32_t readI4(const uint8_t* p) {
+    return (int32_t)readU4(p);
+}
+
+UbxParser::UbxParser() {
+    memset(&solution, 0, sizeof(solution));
+    // No epoch seen yet: keep the three stamps apart
+    solution.statusITOW = solution.dopITOW = 0xFFFFFFFFUL;
+    ackClass = ackId = 0xFF;
+    frames = 0;
+    checksumErrors = 0;
+    skippedFrames = 0;
+    reset();
+}
+
+void UbxParser::reset() {
+    state = UbxState::SYNC1;
+    index = 0;
+}
+
+uint8_t UbxParser::encode(uint8_t byte) {
+    switch (state) {
+        case UbxState::SYNC1:
+            if (byte == UBX_SYNC1) {
+                state = UbxState::SYNC2;
+            }
+            return 0;
+        case UbxState::SYNC2:
+            // B5 B5 62 must still sync
+            state = byte == UBX_SYNC2 ? UbxState::CLASS : (byte == UBX_SYNC1 ? UbxState::SYNC2 : UbxState::SYNC1);
+            return 0;
+        case UbxState::CLASS:
+            ckA = ckB = 0;
+            checksum(byte);
+            msgClass = byte;
+            state = UbxState::ID;
+            return 0;
+        case UbxState::ID:
+            checksum(byte);
+            msgId = byte;
+            state = UbxState::LENGTH1;
+            return 0;
+        case UbxState::LENGTH1:
+            checksum(byte);
+            length = byte;
+            state = UbxState::LENGTH2;
+            return 0;
+        case UbxState::LENGTH2:
+            checksum(byte);
+            length |= (uint16_t)byte << 8;
+            index = 0;
+            if (length > UBX_MAX_LENGTH) {
+                checksumErrors++;
+                state = UbxState::SYNC1;
+                return 0;
+            }
+            state = length > 0 ? UbxState::PAYLOAD : UbxState::CK_A;
+            return 0;
+        case UbxState::PAYLOAD:
+            checksum(byte);
+            if (index < UBX_MAX_PAYLOAD) {
+                payload[index] = byte;
+            }
+            if (++index == length) {
+                state = UbxState::CK_A;
+            }
+            return 0;
+        case UbxState::CK_A:
+            if (byte != ckA) {
+                checksumErrors++;
+                state = byte == UBX_SYNC1 ? UbxState::SYNC2 : UbxState::SYNC1;
+                return 0;
+            }
+            state = UbxState::CK_B;
+            return 0;
+        case UbxState::CK_B:
+            state = UbxState::SYNC1;
+            if (byte != ckB) {
+                checksumErrors++;
+                if (byte == UBX_SYNC1) {
+                    state = UbxState::SYNC2;
+                }
+                return 0;
+            }
+            frames++;
+            if (length > UBX_MAX_PAYLOAD) {
+                skippedFrames++;
+                return UBX_GOT_OTHER;
+            }
+            return dispatch();
+    }
+    return 0;
+}
+
+uint8_t UbxParser::dispatch() {
+    if (msgClass == UBX_CLASS_NAV) {
+        if (msgId == UBX_NAV_PVT && length >= UBX_PVT_MIN_LENGTH) {
+            decodePvt();
+            return UBX_GOT_PVT;
+        }
+        if (msgId == UBX_NAV_STATUS && length == UBX_STATUS_LENGTH) {
+            decodeStatus();
+            return UBX_GOT_STATUS;
+        }
+        if (msgId == UBX_NAV_DOP && length == UBX_DOP_LENGTH) {
+            decodeDop();
+            return UBX_GOT_DOP;
+        }
+    } else if (msgClass == UBX_CLASS_ACK && length == UBX_ACK_LENGTH) {
+        ackClass = payload[0];
+        ackId = payload[1];
+        return msgId == UBX_ACK_ACK ? UBX_GOT_ACK : UBX_GOT_NAK;
+    }
+    return UBX_GOT_OTHER;
+}
+
+void UbxParser::decodePvt() {
+    const uint8_t* p = payload;
+    solution.iTOW = readU4(p + 0);
+    solution.year = readU2(p + 4);
+    solution.month = p[6];
+    solution.day = p[7];
+    solution.hour = p[8];
+    solution.minute = p[9];
+    solution.second = p[10];
+    solution.validFlags = p[11];
+    solution.fixType = p[20];
+    solution.fixFlags = p[21];
+    solution.numSV = p[23];
+    solution.lon = readI4(p + 24);
+    solution.lat = readI4(p + 28);
+    solution.height = readI4(p + 32);
+    solution.hMSL = readI4(p + 36);
+    solution.hAcc = readU4(p + 40);
+    solution.vAcc = readU4(p + 44);
+    solution.velN = readI4(p + 48);
+    solution.velE = readI4(p + 52);
+    solution.velD = readI4(p + 56);
+    solution.gSpeed = readI4(p + 60);
+    solution.headMot = readI4(p + 64);
+    solution.sAcc = readU4(p + 68);
+    solution.headAcc = readU4(p + 72);
+    solution.pvtITOW = solution.iTOW;
+}
+
+void UbxParser::decodeStatus() {
+    solution.statusITOW = readU4(payload + 0);
+    solution.gpsFix = payload[4];
+    solution.statusFlags = payload[5];
+    solution.ttff = readU4(payload + 8);
+    solution.msss = readU4(payload + 12);
+}
+
+void UbxParser::decodeDop() {
+    solution.dopITOW = readU4(payload + 0);
+    solution.gDOP = readU2(payload + 4);
+    solution.pDOP = readU2(payload + 6);
+    solution.tDOP = readU2(payload + 8);
+    solution.vDOP = readU2(payload + 10);
+    solution.hDOP = readU2(payload + 12);
+}
+
+void ubxChecksum(const uint8_t* data, uint16_t length, uint8_t& ckA, uint8_t& ckB) {
+    ckA = 0;
+    ckB = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        ckA += data[i];
+        ckB += ckA;
+    }
+}
+
+uint16_t ubxFrame(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length,
+                  uint8_t* out, uint16_t outSize) {
+    if (outSize < UBX_FRAME_OVERHEAD || length > outSize - UBX_FRAME_OVERHEAD) {
+        return 0;
+    }
+    out[0] = UBX_SYNC1;
+    out[1] = UBX_SYNC2;
+    out[2] = cls;
+    out[3] = id;
+    out[4] = length & 0xFF;
+    out[5] = length >> 8;
+    if (length > 0) {
+        memcpy(out + 6, payload, length);
+    }
+    ubxChecksum(out + 2, length + 4, out[6 + length], out[7 + length]);
+    return length + UBX_FRAME_OVERHEAD;
+}
+
+uint16_t ubxCfgPrtUart(uint32_t baud, uint8_t* out, uint16_t outSize) {
+    uint8_t payload[20];
+    memset(payload, 0, sizeof(payload));
+    payload[0] = 1;                 // UART1
+    payload[4] = 0xD0;              // mode: 8 data bits, no parity, 1 stop bit
+    payload[5] = 0x08;
+    payload[8] = baud & 0xFF;
+    payload[9] = (baud >> 8) & 0xFF;
+    payload[10] = (baud >> 16) & 0xFF;
+    payload[11] = (baud >> 24) & 0xFF;
+    payload[12] = 0x01;             // inProtoMask: UBX
+    payload[14] = 0x01;             // outProtoMask: UBX
+    return ubxFrame(UBX_CLASS_CFG, UBX_CFG_PRT, payload, sizeof(payload), out, outSize);
+}
+
+uint16_t ubxCfgRate(uint16_t periodMs, uint8_t* out, uint16_t outSize) {
+    uint8_t payload[6];
+    payload[0] = periodMs & 0xFF;
+    payload[1] = periodMs >> 8;
+    payload[2] = 1;                 // navRate: every measurement
+    payload[3] = 0;
+    payload[4] = 1;                 // timeRef: GPS time
+    payload[5] = 0;
+    return ubxFrame(UBX_CLASS_CFG, UBX_CFG_RATE, payload, sizeof(payload), out, outSize);
+}
+
+uint16_t ubxCfgMsg(uint8_t cls, uint8_t id, uint8_t rate, uint8_t* out, uint16_t outSize) {
+    uint8_t payload[3] = { cls, id, rate };
+    return ubxFrame(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload), out, outSize);
+}
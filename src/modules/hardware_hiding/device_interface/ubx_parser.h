@@ -0,0 +1,156 @@
+#ifndef UBX_PARSER_H
+#define UBX_PARSER_H
+
+#include <stdint.h>
+
+// u-blox UBX binary protocol: frame parser for NAV-PVT, NAV-STATUS and
+// NAV-DOP, and builders for the configuration frames GPSInterface sends.
+//
+// Frame: 0xB5 0x62 | class | id | length (LE16) | payload | CK_A CK_B, with
+// an 8-bit Fletcher checksum over class..payload. The parser takes one byte
+// at a time straight from the UART receive buffer, keeps the checksum as it
+// goes and copies at most UBX_MAX_PAYLOAD bytes into a fixed buffer; longer
+// frames are checksummed and skipped. Fields are read from the payload at
+// their documented offsets as little-endian integers, so nothing depends on
+// struct packing and there are no floats or string conversions on the way.
+//
+// A navigation epoch arrives as NAV-STATUS, NAV-DOP, NAV-PVT (ascending
+// message ID); NAV-PVT completing is the point to read the solution.
+
+static const uint8_t UBX_SYNC1 = 0xB5;
+static const uint8_t UBX_SYNC2 = 0x62;
+static const uint8_t UBX_FRAME_OVERHEAD = 8;
+static const uint8_t UBX_MAX_PAYLOAD = 92;      // NAV-PVT, the largest we keep
+
+// Classes and message IDs
+static const uint8_t UBX_CLASS_NAV = 0x01;
+static const uint8_t UBX_CLASS_ACK = 0x05;
+static const uint8_t UBX_CLASS_CFG = 0x06;
+static const uint8_t UBX_NAV_STATUS = 0x03;
+static const uint8_t UBX_NAV_DOP = 0x04;
+static const uint8_t UBX_NAV_PVT = 0x07;
+static const uint8_t UBX_ACK_NAK = 0x00;
+static const uint8_t UBX_ACK_ACK = 0x01;
+static const uint8_t UBX_CFG_PRT = 0x00;
+static const uint8_t UBX_CFG_MSG = 0x01;
+static const uint8_t UBX_CFG_RATE = 0x08;
+
+// encode() results, one bit per message kind
+static const uint8_t UBX_GOT_PVT = 0x01;
+static const uint8_t UBX_GOT_STATUS = 0x02;
+static const uint8_t UBX_GOT_DOP = 0x04;
+static const uint8_t UBX_GOT_ACK = 0x08;
+static const uint8_t UBX_GOT_NAK = 0x10;
+static const uint8_t UBX_GOT_OTHER = 0x80;
+
+// NAV-PVT fixType
+static const uint8_t UBX_FIX_NONE = 0;
+static const uint8_t UBX_FIX_2D = 2;
+static const uint8_t UBX_FIX_3D = 3;
+static const uint8_t UBX_FIX_GNSS_DR = 4;
+
+// Latest navigation solution, in the receiver's integer units
+struct UbxNavSolution {
+    // NAV-PVT
+    uint32_t iTOW;              // GPS time of week of the epoch, ms
+    uint16_t year;
+    uint8_t month, day, hour, minute, second;
+    uint8_t validFlags;         // Bit 0 date, bit 1 time, bit 2 fully resolved
+    uint8_t fixType;
+    uint8_t fixFlags;           // Bit 0 gnssFixOK
+    uint8_t numSV;
+    int32_t lon;                // 1e-7 deg
+    int32_t lat;                // 1e-7 deg
+    int32_t height;             // Above ellipsoid, mm
+    int32_t hMSL;               // Above mean sea level, mm
+    uint32_t hAcc;              // mm
+    uint32_t vAcc;              // mm
+    int32_t velN, velE, velD;   // mm/s
+    int32_t gSpeed;             // Ground speed, mm/s
+    int32_t headMot;            // Heading of motion, 1e-5 deg
+    uint32_t sAcc;              // mm/s
+    uint32_t headAcc;           // 1e-5 deg
+
+    // NAV-STATUS
+    uint8_t gpsFix;
+    uint8_t statusFlags;        // Bit 0 gpsFixOk, bit 1 diffSoln
+    uint32_t ttff;              // ms
+    uint32_t msss;              // ms since startup
+
+    // NAV-DOP, all 0.01
+    uint16_t gDOP, pDOP, tDOP, vDOP, hDOP;
+
+    uint32_t pvtITOW;           // iTOW of the last NAV-PVT
+    uint32_t statusITOW;        // Same for NAV-STATUS and NAV-DOP: equal to
+    uint32_t dopITOW;           // pvtITOW when they belong to the same epoch
+};
+
+enum class UbxState : uint8_t {
+    SYNC1,
+    SYNC2,
+    CLASS,
+    ID,
+    LENGTH1,
+    LENGTH2,
+    PAYLOAD,
+    CK_A,
+    CK_B
+};
+
+class UbxParser {
+private:
+    UbxState state;
+    uint8_t msgClass;
+    uint8_t msgId;
+    uint16_t length;
+    uint16_t index;
+    uint8_t ckA, ckB;
+    uint8_t payload[UBX_MAX_PAYLOAD];
+
+    UbxNavSolution solution;
+    uint8_t ackClass, ackId;    // Message the last ACK/NAK refers to
+
+    // Statistics
+    uint32_t frames;
+    uint32_t checksumErrors;
+    uint32_t skippedFrames;     // Valid but longer than the buffer
+
+    void checksum(uint8_t byte) { ckA += byte; ckB += ckA; }
+    uint8_t dispatch();
+    void decodePvt();
+    void decodeStatus();
+    void decodeDop();
+
+public:
+    UbxParser();
+    void reset();
+
+    // Feeds one byte; returns the UBX_GOT_* bit of a frame it completes with
+    // a good checksum, otherwise 0
+    uint8_t encode(uint8_t byte);
+
+    const UbxNavSolution& getSolution() const { return solution; }
+    // True when the last NAV-STATUS and NAV-DOP belong to the last NAV-PVT
+    bool isEpochComplete() const {
+        return solution.statusITOW == solution.pvtITOW && solution.dopITOW == solution.pvtITOW;
+    }
+    bool isAckFor(uint8_t cls, uint8_t id) const { return ackClass == cls && ackId == id; }
+
+    uint32_t getFrames() const { return frames; }
+    uint32_t getChecksumErrors() const { return checksumErrors; }
+    uint32_t getSkippedFrames() const { return skippedFrames; }
+};
+
+// Frame builders: write a complete frame into out and return its length,
+// or 0 if it does not fit
+void ubxChecksum(const uint8_t* data, uint16_t length, uint8_t& ckA, uint8_t& ckB);
+uint16_t ubxFrame(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length,
+                  uint8_t* out, uint16_t outSize);
+// UART1 at baud, 8N1, UBX only in both directions
+uint16_t ubxCfgPrtUart(uint32_t baud, uint8_t* out, uint16_t outSize);
+// Measurement period in ms, one navigation solution per measurement
+uint16_t ubxCfgRate(uint16_t periodMs, uint8_t* out, uint16_t outSize);
+// Output rate of a message on the port the frame arrives on (0: off)
+uint16_t ubxCfgMsg(uint8_t cls, uint8_t id, uint8_t rate, uint8_t* out, uint16_t outSize);
+
+#endif // UBX_PARSER_H
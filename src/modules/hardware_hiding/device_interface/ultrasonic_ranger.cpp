@@ -0,0 +1,145 @@
+#include "ultrasonic_ranger.h"
+
+UltrasonicRanger* UltrasonicRanger::slots[ULTRASONIC_RANGER_MAX] = { nullptr, nullptr };
+
+UltrasonicRanger::UltrasonicRanger() : trigPin(0), echoPin(0), slot(ULTRASONIC_RANGER_MAX) {
+    reset();
+}
+
+void UltrasonicRanger::reset() {
+    echoState = ECHO_IDLE;
+    riseUs = 0;
+    widthUs = 0;
+    triggerUs = 0;
+    windowCount = 0;
+    windowNext = 0;
+    distance = 0.0f;
+    echoes = 0;
+    misses = 0;
+    setTemperature(20.0f);
+}
+
+// One trampoline per slot, since attachInterrupt() takes no context
+void UltrasonicRanger::echoIsr0() {
+    UltrasonicRanger* ranger = slots[0];
+    ranger->onEchoEdge(digitalRead(ranger->echoPin) == HIGH, micros());
+}
+
+void UltrasonicRanger::echoIsr1() {
+    UltrasonicRanger* ranger = slots[1];
+    ranger->onEchoEdge(digitalRead(ranger->echoPin) == HIGH, micros());
+}
+
+bool UltrasonicRanger::attach(uint8_t trig_pin, uint8_t echo_pin) {
+    static void (* const isrs[ULTRASONIC_RANGER_MAX])() = { echoIsr0, echoIsr1 };
+    int interrupt = digitalPinToInterrupt(echo_pin);
+    if (interrupt < 0) {
+        return false;
+    }
+    detach();
+    for (uint8_t i = 0; i < ULTRASONIC_RANGER_MAX; i++) {
+        if (slots[i] == nullptr) {
+            slot = i;
+            slots[i] = this;
+            trigPin = trig_pin;
+            echoPin = echo_pin;
+            pinMode(trigPin, OUTPUT);
+            digitalWrite(trigPin, LOW);
+            pinMode(echoPin, INPUT);
+            echoState = ECHO_IDLE;
+            attachInterrupt(interrupt, isrs[i], CHANGE);
+            return true;
+        }
+    }
+    return false;
+}
+
+void UltrasonicRanger::detach() {
+    if (slot >= ULTRASONIC_RANGER_MAX) {
+        return;
+    }
+    detachInterrupt(digitalPinToInterrupt(echoPin));
+    slots[slot] = nullptr;
+    slot = ULTRASONIC_RANGER_MAX;
+    echoState = ECHO_IDLE;
+}
+
+void UltrasonicRanger::setTemperature(float celsius) {
+    // Round trip, so half of 331.3 + 0.606 T m/s
+    metresPerUs = (331.3f + 0.606f * celsius) * 0.5e-6f;
+}
+
+bool UltrasonicRanger::trigger(uint32_t nowUs) {
+    // Still inside the previous echo, or its no-target pulse
+    if (echoState == ECHO_HIGH) {
+        return false;
+    }
+    echoState = ECHO_ARMED;
+    triggerUs = nowUs;
+    if (slot < ULTRASONIC_RANGER_MAX) {
+        digitalWrite(trigPin, HIGH);
+        delayMicroseconds(ULTRASONIC_TRIGGER_PULSE_US);
+        digitalWrite(trigPin, LOW);
+    }
+    return true;
+}
+
+void UltrasonicRanger::onEchoEdge(bool high, uint32_t nowUs) {
+    if (high) {
+        if (echoState == ECHO_ARMED) {
+            riseUs = nowUs;
+            echoState = ECHO_HIGH;
+        }
+    } else if (echoState == ECHO_HIGH) {
+        widthUs = nowUs - riseUs;
+        echoState = ECHO_DONE;
+    }
+}
+
+UltrasonicResult UltrasonicRanger::poll(uint32_t nowUs) {
+    uint8_t state = echoState;
+    if (state == ECHO_DONE) {
+        // The interrupt is done with widthUs until the next trigger
+        uint32_t width = widthUs;
+        echoState = ECHO_IDLE;
+        if (width < ULTRASONIC_MIN_ECHO_US || width > ULTRASONIC_MAX_ECHO_US) {
+            misses++;
+            return UltrasonicResult::NO_ECHO;
+        }
+        window[windowNext] = (uint16_t)width;
+        windowNext = (uint8_t)((windowNext + 1) % ULTRASONIC_MEDIAN_WINDOW);
+        if (windowCount < ULTRASONIC_MEDIAN_WINDOW) {
+            windowCount++;
+        }
+        distance = median(window, windowCount) * metresPerUs;
+        echoes++;
+        return UltrasonicResult::ECHO;
+    }
+    if (state == ECHO_IDLE) {
+        return UltrasonicResult::NO_ECHO;
+    }
+    if (nowUs - triggerUs > ULTRASONIC_TIMEOUT_US) {
+        // A still-high echo is left to end on its own; trigger() waits
+        if (state == ECHO_ARMED) {
+            echoState = ECHO_IDLE;
+        }
+        misses++;
+        return UltrasonicResult::NO_ECHO;
+    }
+    return UltrasonicResult::PENDING;
+}
+
+uint16_t UltrasonicRanger::median(const uint16_t* values, uint8_t n) {
+    uint16_t sorted[ULTRASONIC_MEDIAN_WINDOW];
+    for (uint8_t i = 0; i < n; i++) {
+        uint16_t v = values[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    // Even counts take the mean of the middle two
+    return (n & 1) ? sorted[n / 2] : (uint16_t)((sorted[n / 2 - 1] + sorted[n / 2]) / 2);
+}
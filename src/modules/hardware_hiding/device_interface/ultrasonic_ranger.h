@@ -0,0 +1,101 @@
+#ifndef ULTRASONIC_RANGER_H
+#define ULTRASONIC_RANGER_H
+
+#include <Arduino.h>
+
+// HC-SR04 ranging without blocking on the echo.
+//
+// The echo pin's edges are timestamped in an external interrupt, so the
+// loop only ever issues the 10 us trigger pulse and later picks up the
+// result:
+//   trigger()     from the sensor scheduler's trigger step
+//   onEchoEdge()  from the interrupt: rising edge starts, falling ends
+//   poll()        from the scheduler's ready step: PENDING until the echo
+//                 has ended or timed out
+// Each in-range echo width goes into a median-of-N window, and the median
+// is published as the distance, so a single multipath or missed echo does
+// not reach the estimate.
+//
+// With nothing in range the HC-SR04 holds echo high for about 38 ms. That
+// is reported as NO_ECHO at ULTRASONIC_TIMEOUT_US, and the next trigger is
+// refused until the pin has dropped.
+//
+// The echo pin must have an external interrupt (digitalPinToInterrupt()).
+// Pin-change interrupts are left to SoftwareSerial, which owns those
+// vectors.
+
+static const uint8_t ULTRASONIC_RANGER_MAX = 2;             // Interrupt slots
+static const uint8_t ULTRASONIC_MEDIAN_WINDOW = 5;
+static const uint16_t ULTRASONIC_MIN_ECHO_US = 116;         // 2 cm
+static const uint16_t ULTRASONIC_MAX_ECHO_US = 23300;       // 4 m
+static const uint32_t ULTRASONIC_TIMEOUT_US = 30000;        // Trigger to give up
+static const uint32_t ULTRASONIC_MIN_CYCLE_MS = 60;         // Between triggers
+static const uint8_t ULTRASONIC_TRIGGER_PULSE_US = 10;
+
+enum class UltrasonicResult : uint8_t {
+    PENDING,
+    ECHO,           // In range; distance updated
+    NO_ECHO         // Timed out or out of range
+};
+
+class UltrasonicRanger {
+private:
+    enum EchoState : uint8_t {
+        ECHO_IDLE,
+        ECHO_ARMED,         // Triggered, waiting for the rising edge
+        ECHO_HIGH,
+        ECHO_DONE           // Falling edge seen, width ready
+    };
+
+    uint8_t trigPin;
+    uint8_t echoPin;
+    uint8_t slot;
+
+    // Interrupt side
+    volatile uint8_t echoState;
+    volatile uint32_t riseUs;
+    volatile uint32_t widthUs;
+
+    // Main loop side
+    uint32_t triggerUs;
+    uint16_t window[ULTRASONIC_MEDIAN_WINDOW];
+    uint8_t windowCount;
+    uint8_t windowNext;
+    float distance;                 // Metres, median of the window
+    float metresPerUs;              // Half the speed of sound
+    uint32_t echoes;
+    uint32_t misses;
+
+    static UltrasonicRanger* slots[ULTRASONIC_RANGER_MAX];
+    static void echoIsr0();
+    static void echoIsr1();
+
+public:
+    UltrasonicRanger();
+    void reset();
+
+    // Claims an interrupt slot; false if the echo pin has no external
+    // interrupt or all slots are taken
+    bool attach(uint8_t trig_pin, uint8_t echo_pin);
+    void detach();
+
+    // Main loop
+    bool trigger(uint32_t nowUs);
+    UltrasonicResult poll(uint32_t nowUs);
+    // Speed of sound from air temperature, in degrees C
+    void setTemperature(float celsius);
+
+    // Interrupt: an edge on the echo pin and when it happened
+    void onEchoEdge(bool high, uint32_t nowUs);
+
+    // Sorts a copy; n is at most ULTRASONIC_MEDIAN_WINDOW
+    static uint16_t median(const uint16_t* values, uint8_t n);
+
+    bool hasDistance() const { return windowCount > 0; }
+    float getDistance() const { return distance; }
+    uint32_t getLastEchoRiseUs() const { return riseUs; }
+    uint32_t getEchoes() const { return echoes; }
+    uint32_t getMisses() const { return misses; }
+};
+
+#endif // ULTRASONIC_RANGER_H
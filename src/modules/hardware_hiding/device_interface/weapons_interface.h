@@ -2,6 +2,7 @@
 #define WEAPONS_INTERFACE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Weapons system types
 enum class WeaponsSystemType {
@@ -94,7 +95,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeHardware();
@@ -160,7 +161,7 @@ public:
     bool performCalibration();
     
     // Error handling
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
@@ -2,6 +2,7 @@
 #define COMPUTER_STATE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Computer operating states
 enum class ComputerState {
@@ -96,7 +97,7 @@ struct ComputerStatus {
     uint32_t uptime;             // System uptime in seconds
     uint32_t bootCount;          // Number of system boots
     uint8_t errorFlags;          // Error status flags
-    String lastError;            // Last error message
+    ErrorText lastError;            // Last error message
     
     bool watchdogActive;         // Whether watchdog is active
     bool thermalProtectionActive; // Whether thermal protection is active
@@ -172,7 +173,7 @@ private:
     
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     void updateSystemResources();
@@ -258,7 +259,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     bool hasErrors() const;
     
@@ -0,0 +1,265 @@
+#include "config_store.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <EEPROM.h>
+#endif
+
+// CRC-16/CCITT-FALSE, bitwise: records are short and flash is not
+static uint16_t crc16(uint16_t crc, uint8_t value) {
+    crc ^= (uint16_t)value << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+ConfigStore::ConfigStore()
+    : readFn(nullptr), writeFn(nullptr), context(nullptr), base(0), size(0),
+      head(0), sequence(0), ready(false), bytesWritten(0), laps(0), writeFailures(0) {
+    for (uint8_t key = 0; key < CONFIG_MAX_KEYS; key++) {
+        live[key] = CONFIG_NO_RECORD;
+    }
+}
+
+void ConfigStore::attach(ConfigReadFn read, ConfigWriteFn write, void* ctx, uint16_t regionBase,
+                         uint16_t regionSize) {
+    readFn = read;
+    writeFn = write;
+    context = ctx;
+    base = regionBase;
+    size = regionSize;
+    ready = false;
+}
+
+#ifdef ARDUINO
+static uint8_t eepromRead(void*, uint16_t address) {
+    return EEPROM.read(address);
+}
+
+static void eepromWrite(void*, uint16_t address, uint8_t value) {
+    EEPROM.update(address, value);   // Skips cells that already hold the value
+}
+
+void ConfigStore::attachEEPROM(uint16_t regionBase, uint16_t regionSize) {
+    if (regionSize == 0) {
+        regionSize = EEPROM.length() - regionBase;
+    }
+    attach(eepromRead, eepromWrite, nullptr, regionBase, regionSize);
+}
+#endif
+
+void ConfigStore::writeByte(uint16_t offset, uint8_t value) {
+    writeFn(context, base + offset, value);
+    bytesWritten++;
+}
+
+bool ConfigStore::readRecord(uint16_t offset, ConfigRecordHeader& header) const {
+    if (offset + CONFIG_RECORD_OVERHEAD > size || readByte(offset) != CONFIG_RECORD_MARKER) {
+        return false;
+    }
+    header.key = readByte(offset + 1);
+    header.version = readByte(offset + 2);
+    header.length = readByte(offset + 3);
+    if (header.key >= CONFIG_MAX_KEYS || header.length > CONFIG_MAX_PAYLOAD ||
+        offset + CONFIG_RECORD_OVERHEAD + header.length > size) {
+        return false;
+    }
+
+    uint16_t crc = 0xFFFF;
+    header.sequence = 0;
+    for (uint8_t i = 0; i < CONFIG_RECORD_HEADER + header.length; i++) {
+        uint8_t value = readByte(offset + i);
+        if (i >= 4 && i < CONFIG_RECORD_HEADER) {
+            header.sequence |= (uint32_t)value << (8 * (i - 4));
+        }
+        crc = crc16(crc, value);
+    }
+    uint16_t end = offset + CONFIG_RECORD_HEADER + header.length;
+    uint16_t stored = readByte(end) | ((uint16_t)readByte(end + 1) << 8);
+    return stored == crc;
+}
+
+uint16_t ConfigStore::recordSize(uint16_t offset) const {
+    return CONFIG_RECORD_OVERHEAD + readByte(offset + 3);
+}
+
+bool ConfigStore::begin() {
+    ready = false;
+    if (!readFn || !writeFn || size < CONFIG_RECORD_OVERHEAD + CONFIG_MAX_PAYLOAD) {
+        return false;
+    }
+
+    for (uint8_t key = 0; key < CONFIG_MAX_KEYS; key++) {
+        live[key] = CONFIG_NO_RECORD;
+    }
+    head = 0;
+    sequence = 0;
+
+    // One pass: valid records are stepped over whole, anything else
+    // (erased cells, stale or torn records) a byte at a time
+    ConfigRecordHeader header;
+    uint16_t offset = 0;
+    while (offset + CONFIG_RECORD_OVERHEAD <= size) {
+        if (!readRecord(offset, header)) {
+            offset++;
+            continue;
+        }
+        uint16_t current = live[header.key];
+        if (current == CONFIG_NO_RECORD) {
+            live[header.key] = offset;
+        } else {
+            uint32_t currentSequence = 0;
+            for (uint8_t i = 0; i < 4; i++) {
+                currentSequence |= (uint32_t)readByte(current + 4 + i) << (8 * i);
+            }
+            if (header.sequence > currentSequence) {
+                live[header.key] = offset;
+            }
+        }
+        offset += CONFIG_RECORD_OVERHEAD + header.length;
+        if (header.sequence > sequence) {
+            sequence = header.sequence;
+            head = offset;
+        }
+    }
+    ready = true;
+    return true;
+}
+
+void ConfigStore::format() {
+    for (uint16_t offset = 0; offset < size; offset++) {
+        if (readByte(offset) != 0xFF) {
+            writeByte(offset, 0xFF);
+        }
+    }
+    for (uint8_t key = 0; key < CONFIG_MAX_KEYS; key++) {
+        live[key] = CONFIG_NO_RECORD;
+    }
+    head = 0;
+}
+
+uint16_t ConfigStore::findSpace(uint16_t length) {
+    // Each step passes at least one live record, so two laps' worth of
+    // steps either finds a gap or proves there is none
+    uint16_t start = head;
+    for (uint8_t step = 0; step < 2 * CONFIG_MAX_KEYS + 2; step++) {
+        if (start + length > size) {
+            start = 0;
+            laps++;
+        }
+        uint16_t blockedUntil = 0;
+        for (uint8_t key = 0; key < CONFIG_MAX_KEYS; key++) {
+            uint16_t offset = live[key];
+            if (offset == CONFIG_NO_RECORD) {
+                continue;
+            }
+            uint16_t end = offset + recordSize(offset);
+            if (offset < start + length && end > start && end > blockedUntil) {
+                blockedUntil = end;
+            }
+        }
+        if (blockedUntil == 0) {
+            return start;
+        }
+        start = blockedUntil;
+    }
+    return CONFIG_NO_RECORD;
+}
+
+bool ConfigStore::save(uint8_t key, uint8_t version, const void* data, uint8_t length) {
+    if (!ready || key >= CONFIG_MAX_KEYS || length > CONFIG_MAX_PAYLOAD) {
+        return false;
+    }
+    uint16_t offset = findSpace(CONFIG_RECORD_OVERHEAD + length);
+    if (offset == CONFIG_NO_RECORD) {
+        writeFailures++;
+        return false;
+    }
+
+    uint32_t next = sequence + 1;
+    uint8_t header[CONFIG_RECORD_HEADER] = {
+        CONFIG_RECORD_MARKER, key, version, length,
+        (uint8_t)next, (uint8_t)(next >> 8), (uint8_t)(next >> 16), (uint8_t)(next >> 24)
+    };
+    const uint8_t* payload = static_cast<const uint8_t*>(data);
+
+    // Written front to back; the record only becomes valid with the last CRC byte
+    uint16_t crc = 0xFFFF;
+    uint16_t at = offset;
+    for (uint8_t i = 0; i < CONFIG_RECORD_HEADER; i++) {
+        crc = crc16(crc, header[i]);
+        writeByte(at++, header[i]);
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        crc = crc16(crc, payload[i]);
+        writeByte(at++, payload[i]);
+    }
+    writeByte(at++, (uint8_t)crc);
+    writeByte(at++, (uint8_t)(crc >> 8));
+
+    // The sequence number is spent either way so a retry never repeats it,
+    // and the head moves past cells that failed to verify
+    sequence = next;
+    head = at;
+
+    ConfigRecordHeader check;
+    if (!readRecord(offset, check) || check.sequence != next) {
+        writeFailures++;
+        return false;
+    }
+    live[key] = offset;
+    return true;
+}
+
+uint8_t ConfigStore::load(uint8_t key, void* buffer, uint8_t maxLength, uint8_t& version) const {
+    if (!has(key)) {
+        return 0;
+    }
+    uint16_t offset = live[key];
+    uint8_t length = readByte(offset + 3);
+    if (length > maxLength) {
+        return 0;
+    }
+
+    // Re-check the CRC while copying: the cells may have decayed since boot
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < CONFIG_RECORD_HEADER; i++) {
+        crc = crc16(crc, readByte(offset + i));
+    }
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    for (uint8_t i = 0; i < length; i++) {
+        out[i] = readByte(offset + CONFIG_RECORD_HEADER + i);
+        crc = crc16(crc, out[i]);
+    }
+    uint16_t end = offset + CONFIG_RECORD_HEADER + length;
+    if ((readByte(end) | ((uint16_t)readByte(end + 1) << 8)) != crc) {
+        return 0;
+    }
+    version = readByte(offset + 2);
+    return length;
+}
+
+bool ConfigStore::importLegacySetup() {
+    if (!ready || has(CONFIG_KEY_RECEIVER_SETUP) || base < CONFIG_LEGACY_SETUP_SIZE) {
+        return false;
+    }
+    uint8_t setup[CONFIG_LEGACY_SETUP_SIZE];
+    for (uint8_t i = 0; i < CONFIG_LEGACY_SETUP_SIZE; i++) {
+        setup[i] = readFn(context, i);
+    }
+    if (setup[33] != 'J' || setup[34] != 'M' || setup[35] != 'B') {
+        return false;
+    }
+    return save(CONFIG_KEY_RECEIVER_SETUP, 0, setup, sizeof(setup));
+}
+
+uint16_t ConfigStore::getLiveBytes() const {
+    uint16_t total = 0;
+    for (uint8_t key = 0; key < CONFIG_MAX_KEYS; key++) {
+        if (live[key] != CONFIG_NO_RECORD) {
+            total += recordSize(live[key]);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,135 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Log-structured configuration store in EEPROM.
+//
+// Configuration is kept as records appended at a write head that rotates
+// through the region:
+//
+//   0xA5 | key | version | length | sequence (4, LE) | payload | CRC-16 (LE)
+//
+// A save never overwrites the record it replaces; the new copy goes to the
+// head and the old one simply becomes stale. The head skips over every
+// key's current record, so a save that is cut short by a power loss leaves
+// a record whose CRC fails and the previous copy is still found at boot.
+// Cells are rewritten once per lap of the head, not once per save.
+//
+// begin() reads the region once from start to end, keeps the highest
+// sequence number per key and puts the head after the newest record. The
+// RAM index is one offset per key.
+//
+// Keep the region at least twice the size of the live records so the head
+// has room to move; a 14-byte parameter record takes ~45 ms to write on
+// AVR, so saves belong outside the control loop.
+
+static const uint8_t CONFIG_RECORD_MARKER = 0xA5;
+static const uint8_t CONFIG_RECORD_HEADER = 8;
+static const uint8_t CONFIG_RECORD_OVERHEAD = CONFIG_RECORD_HEADER + 2;
+static const uint8_t CONFIG_MAX_PAYLOAD = 64;
+static const uint16_t CONFIG_NO_RECORD = 0xFFFF;
+
+// Record keys. Images get fixed keys; SystemParams stores one record per
+// Param from CONFIG_KEY_PARAM_BASE. Never renumber: keys are on disk.
+static const uint8_t CONFIG_KEY_IMU_CALIBRATION = 1;
+static const uint8_t CONFIG_KEY_RECEIVER_SETUP = 2;    // YMFC setup bytes, imported once
+static const uint8_t CONFIG_KEY_GYRO_BIAS_MODEL = 3;   // Bias against temperature
+static const uint8_t CONFIG_KEY_BOOT_EPOCH = 4;        // Parameter sync epoch, one per boot
+static const uint8_t CONFIG_KEY_PARAM_BASE = 16;
+static const uint8_t CONFIG_MAX_KEYS = 48;
+
+// The YMFC setup program writes 36 bytes at address 0 ending in "JMB";
+// the store starts after them so those tools keep working
+static const uint16_t CONFIG_LEGACY_SETUP_SIZE = 36;
+static const uint16_t CONFIG_STORE_BASE = 64;
+
+// Byte access to the backing memory; addresses are absolute
+typedef uint8_t (*ConfigReadFn)(void* context, uint16_t address);
+typedef void (*ConfigWriteFn)(void* context, uint16_t address, uint8_t value);
+
+struct ConfigRecordHeader {
+    uint8_t key;
+    uint8_t version;
+    uint8_t length;
+    uint32_t sequence;
+};
+
+class ConfigStore {
+private:
+    ConfigReadFn readFn;
+    ConfigWriteFn writeFn;
+    void* context;
+    uint16_t base;
+    uint16_t size;
+
+    uint16_t live[CONFIG_MAX_KEYS];     // Offset of each key's newest record
+    uint16_t head;
+    uint32_t sequence;                  // Newest sequence number in the region
+    bool ready;
+
+    // Statistics
+    uint32_t bytesWritten;
+    uint16_t laps;
+    uint16_t writeFailures;
+
+    uint8_t readByte(uint16_t offset) const { return readFn(context, base + offset); }
+    void writeByte(uint16_t offset, uint8_t value);
+    bool readRecord(uint16_t offset, ConfigRecordHeader& header) const;   // Checks the CRC
+    uint16_t recordSize(uint16_t offset) const;
+    uint16_t findSpace(uint16_t length);
+
+public:
+    ConfigStore();
+
+    void attach(ConfigReadFn read, ConfigWriteFn write, void* context, uint16_t base, uint16_t size);
+#ifdef ARDUINO
+    // Size 0 uses the rest of the EEPROM
+    void attachEEPROM(uint16_t base = CONFIG_STORE_BASE, uint16_t size = 0);
+#endif
+
+    // Boot scan; false if nothing is attached
+    bool begin();
+    bool isReady() const { return ready; }
+    // Invalidates every record (factory reset)
+    void format();
+
+    // Appends a new copy of key; false if it could not be written and verified
+    bool save(uint8_t key, uint8_t version, const void* data, uint8_t length);
+    // Copies the newest payload; returns its length, 0 if missing, too long
+    // or failing its CRC (buffer contents are then undefined)
+    uint8_t load(uint8_t key, void* buffer, uint8_t maxLength, uint8_t& version) const;
+    bool has(uint8_t key) const { return key < CONFIG_MAX_KEYS && live[key] != CONFIG_NO_RECORD; }
+
+    // Fixed-layout images; a different version or size reads as missing
+    template <typename T>
+    bool saveImage(uint8_t key, uint8_t version, const T& image) {
+        static_assert(sizeof(T) <= CONFIG_MAX_PAYLOAD, "Config image too large for one record");
+        return save(key, version, &image, sizeof(T));
+    }
+    template <typename T>
+    bool loadImage(uint8_t key, uint8_t version, T& image) const {
+        T copy;
+        uint8_t stored;
+        if (load(key, &copy, sizeof(T), stored) != sizeof(T) || stored != version) {
+            return false;
+        }
+        image = copy;
+        return true;
+    }
+
+    // Copies the YMFC setup bytes into CONFIG_KEY_RECEIVER_SETUP if they
+    // carry the "JMB" signature and have not been imported yet
+    bool importLegacySetup();
+
+    // Statistics
+    uint16_t getHead() const { return head; }
+    uint32_t getSequence() const { return sequence; }
+    uint32_t getBytesWritten() const { return bytesWritten; }
+    uint16_t getLaps() const { return laps; }
+    uint16_t getWriteFailures() const { return writeFailures; }
+    uint16_t getLiveBytes() const;
+};
+
+#endif // CONFIG_STORE_H
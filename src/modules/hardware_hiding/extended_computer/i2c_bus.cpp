@@ -0,0 +1,253 @@
+#include "i2c_bus.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+I2cBus i2cBus;
+
+#ifdef ARDUINO
+static uint32_t wireClockHz = I2C_DEFAULT_CLOCK_HZ;
+static uint32_t wireTimeoutUs = I2C_DEFAULT_TIMEOUT_US;
+
+static void wireStart() {
+    Wire.begin();
+    Wire.setClock(wireClockHz);
+    Wire.setWireTimeout(wireTimeoutUs, true);   // Also resets the TWI on a timeout
+}
+
+static uint8_t wireWrite(void*, uint8_t address, const uint8_t* data, uint8_t length, bool stop) {
+    Wire.beginTransmission(address);
+    for (uint8_t i = 0; i < length; i++) {
+        Wire.write(data[i]);
+    }
+    return Wire.endTransmission(stop);
+}
+
+static uint8_t wireRead(void*, uint8_t address, uint8_t* data, uint8_t length) {
+    uint8_t received = Wire.requestFrom(address, length);
+    for (uint8_t i = 0; i < received; i++) {
+        data[i] = (uint8_t)Wire.read();
+    }
+    return received;
+}
+
+// The lines are driven open-drain: pulled low as outputs, released to
+// their pull-ups as inputs
+static void releaseLine(uint8_t pin) {
+    pinMode(pin, INPUT_PULLUP);
+    delayMicroseconds(5);
+}
+
+static void pullLine(uint8_t pin) {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+    delayMicroseconds(5);
+}
+
+static bool wireRecover(void*) {
+    Wire.end();
+    releaseLine(SDA);
+    releaseLine(SCL);
+    // A slave holding SDA low is part way through a byte; each clock lets
+    // it shift out a bit until it reaches the acknowledge and lets go
+    for (uint8_t i = 0; i < I2C_RECOVERY_CLOCKS && digitalRead(SDA) == LOW; i++) {
+        pullLine(SCL);
+        releaseLine(SCL);
+    }
+    // STOP: SDA rises while SCL is high
+    pullLine(SDA);
+    releaseLine(SDA);
+    bool released = digitalRead(SDA) == HIGH && digitalRead(SCL) == HIGH;
+    wireStart();
+    return released;
+}
+
+static const I2cTransport WIRE_TRANSPORT = { wireWrite, wireRead, wireRecover };
+
+bool I2cBus::beginWire(uint32_t clockHz, uint32_t timeoutUs) {
+    wireClockHz = clockHz;
+    wireTimeoutUs = timeoutUs;
+    wireStart();
+    attach(&WIRE_TRANSPORT, nullptr);
+    return true;
+}
+#endif
+
+I2cBus::I2cBus()
+    : transport(nullptr), context(nullptr), deviceCount(0), probeNext(0),
+      consecutiveFaults(0), recoveries(0), failedRecoveries(0) {
+    memset(&unregistered, 0, sizeof(unregistered));
+}
+
+void I2cBus::attach(const I2cTransport* busTransport, void* busContext) {
+    transport = busTransport;
+    context = busContext;
+    consecutiveFaults = 0;
+}
+
+uint8_t I2cBus::addDevice(const I2cDeviceSpec& spec) {
+    uint8_t handle = findDevice(spec.address);
+    if (handle != I2C_NO_DEVICE) {
+        return handle;
+    }
+    if (deviceCount >= I2C_MAX_DEVICES) {
+        return I2C_NO_DEVICE;
+    }
+    I2cDevice& device = devices[deviceCount];
+    device.spec = spec;
+    device.state = I2cDeviceState::UNKNOWN;
+    device.lastId = 0;
+    memset(&device.stats, 0, sizeof(device.stats));
+    return deviceCount++;
+}
+
+uint8_t I2cBus::findDevice(uint8_t address) const {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        if (devices[i].spec.address == address) {
+            return i;
+        }
+    }
+    return I2C_NO_DEVICE;
+}
+
+I2cDeviceState I2cBus::probe(uint8_t handle) {
+    if (handle >= deviceCount) {
+        return I2cDeviceState::UNKNOWN;
+    }
+    I2cDevice& device = devices[handle];
+    if (!device.spec.checkId) {
+        device.state = ping(device.spec.address) == I2cResult::OK ? I2cDeviceState::PRESENT : I2cDeviceState::MISSING;
+        return device.state;
+    }
+    // One register read answers both questions
+    uint8_t id;
+    I2cResult result = readRegisters(device.spec.address, device.spec.idRegister, &id, 1);
+    if (result != I2cResult::OK) {
+        device.state = I2cDeviceState::MISSING;
+    } else {
+        device.lastId = id;
+        device.state = (id == device.spec.id || id == device.spec.altId) ? I2cDeviceState::PRESENT : I2cDeviceState::WRONG_ID;
+    }
+    return device.state;
+}
+
+bool I2cBus::probeStep() {
+    while (probeNext < deviceCount) {
+        if (devices[probeNext].state == I2cDeviceState::UNKNOWN) {
+            probe(probeNext++);
+            return true;
+        }
+        probeNext++;
+    }
+    return false;
+}
+
+I2cDeviceState I2cBus::awaitProbe(uint8_t handle) {
+    if (handle >= deviceCount) {
+        return I2cDeviceState::UNKNOWN;
+    }
+    while (devices[handle].state == I2cDeviceState::UNKNOWN && probeStep()) {
+    }
+    return devices[handle].state;
+}
+
+void I2cBus::probeAll() {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        probe(i);
+    }
+    probeNext = deviceCount;
+}
+
+I2cDeviceStats& I2cBus::statsFor(uint8_t address) {
+    uint8_t handle = findDevice(address);
+    return handle == I2C_NO_DEVICE ? unregistered : devices[handle].stats;
+}
+
+I2cResult I2cBus::finish(uint8_t address, I2cResult result, uint32_t startUs) {
+    uint32_t elapsed = micros() - startUs;
+    I2cDeviceStats& stats = statsFor(address);
+    stats.transactions++;
+    stats.totalUs += elapsed;
+    if (elapsed > stats.maxUs) {
+        stats.maxUs = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+    }
+
+    switch (result) {
+        case I2cResult::OK:
+            consecutiveFaults = 0;
+            break;
+        case I2cResult::NAK_ADDRESS:
+        case I2cResult::NAK_DATA:
+            // An absent device says nothing about the bus
+            stats.naks++;
+            break;
+        case I2cResult::TIMEOUT:
+            stats.timeouts++;
+            consecutiveFaults++;
+            break;
+        case I2cResult::BUS_ERROR:
+            stats.errors++;
+            consecutiveFaults++;
+            break;
+        default:
+            stats.errors++;
+            break;
+    }
+    if (consecutiveFaults >= I2C_RECOVERY_FAULTS) {
+        recover();
+    }
+    return result;
+}
+
+I2cResult I2cBus::ping(uint8_t address) {
+    return write(address, nullptr, 0);
+}
+
+I2cResult I2cBus::write(uint8_t address, const uint8_t* data, uint8_t length) {
+    if (transport == nullptr) {
+        return I2cResult::NOT_ATTACHED;
+    }
+    uint32_t start = micros();
+    return finish(address, (I2cResult)transport->write(context, address, data, length, true), start);
+}
+
+I2cResult I2cBus::writeRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    uint8_t data[2] = { reg, value };
+    return write(address, data, 2);
+}
+
+I2cResult I2cBus::readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length) {
+    if (transport == nullptr) {
+        return I2cResult::NOT_ATTACHED;
+    }
+    uint32_t start = micros();
+    I2cResult result = (I2cResult)transport->write(context, address, &reg, 1, false);
+    if (result == I2cResult::OK && transport->read(context, address, data, length) != length) {
+        result = I2cResult::SHORT_READ;
+    }
+    return finish(address, result, start);
+}
+
+void I2cBus::resetStats() {
+    for (uint8_t i = 0; i < deviceCount; i++) {
+        memset(&devices[i].stats, 0, sizeof(devices[i].stats));
+    }
+    memset(&unregistered, 0, sizeof(unregistered));
+    recoveries = 0;
+    failedRecoveries = 0;
+}
+
+bool I2cBus::recover() {
+    consecutiveFaults = 0;
+    if (transport == nullptr || transport->recover == nullptr) {
+        return false;
+    }
+    recoveries++;
+    if (!transport->recover(context)) {
+        failedRecoveries++;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,169 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+
+// Shared I2C bus manager. Drivers go through i2cBus instead of driving
+// Wire themselves, so the bus is started once, every transfer is timed
+// and counted against the device it addressed, and a stuck bus is
+// recovered in one place.
+//
+// Devices are registered up front with the address they are expected at
+// and, where the chip has one, a WHO_AM_I register and value. Boot then
+// checks only those addresses instead of scanning 0x08..0x77. probeStep()
+// checks one device per call, so it can be interleaved with other
+// start-up work. The outcome stays in the registry, and modules ask it
+// rather than probing again.
+//
+// Recovery: a slave reset mid-byte can hold SDA low indefinitely, and
+// every later transfer then times out. After I2C_RECOVERY_FAULTS timeouts
+// or bus errors in a row, SCL is clocked by hand until the slave releases
+// SDA (at most nine clocks). Then a STOP is sent and the controller is
+// restarted.
+//
+// The bus is reached through an I2cTransport so the manager can be driven
+// without hardware; beginWire() attaches the Wire library.
+
+static const uint8_t I2C_MAX_DEVICES = 12;
+static const uint8_t I2C_NO_DEVICE = 0xFF;
+static const uint8_t I2C_RECOVERY_FAULTS = 2;
+static const uint8_t I2C_RECOVERY_CLOCKS = 9;
+static const uint32_t I2C_DEFAULT_CLOCK_HZ = 400000;
+static const uint32_t I2C_DEFAULT_TIMEOUT_US = 3000;
+
+// Transfer outcome; the first six are Wire's endTransmission() codes
+enum class I2cResult : uint8_t {
+    OK = 0,
+    TOO_LONG = 1,
+    NAK_ADDRESS = 2,
+    NAK_DATA = 3,
+    BUS_ERROR = 4,
+    TIMEOUT = 5,
+    SHORT_READ = 6,
+    NOT_ATTACHED = 7
+};
+
+enum class I2cDeviceState : uint8_t {
+    UNKNOWN,            // Not probed yet
+    PRESENT,            // Acknowledged, and WHO_AM_I matched if it has one
+    MISSING,            // No acknowledge
+    WRONG_ID            // Something else answers at the address
+};
+
+// What is expected at an address
+struct I2cDeviceSpec {
+    uint8_t address;
+    bool checkId;       // false: an acknowledge is enough
+    uint8_t idRegister;
+    uint8_t id;
+    uint8_t altId;      // Second accepted WHO_AM_I (e.g. BME280), or id
+};
+
+static const I2cDeviceSpec I2C_DEVICE_MPU6050 = { 0x68, true, 0x75, 0x68, 0x68 };
+static const I2cDeviceSpec I2C_DEVICE_HMC5883L = { 0x1E, true, 0x0A, 'H', 'H' };
+static const I2cDeviceSpec I2C_DEVICE_BMP280 = { 0x76, true, 0xD0, 0x58, 0x60 };
+static const I2cDeviceSpec I2C_DEVICE_BMP280_SECONDARY = { 0x77, true, 0xD0, 0x58, 0x60 };
+
+struct I2cDeviceStats {
+    uint32_t transactions;
+    uint32_t naks;          // Address or data not acknowledged
+    uint32_t timeouts;
+    uint32_t errors;        // Bus errors and short reads
+    uint32_t totalUs;       // Time spent in transfers
+    uint16_t maxUs;
+};
+
+struct I2cDevice {
+    I2cDeviceSpec spec;
+    I2cDeviceState state;
+    uint8_t lastId;         // WHO_AM_I read at the last probe
+    I2cDeviceStats stats;
+};
+
+// Bus access. Results are I2cResult codes.
+struct I2cTransport {
+    // Sends length bytes (only the address when 0); no STOP if stop is false
+    uint8_t (*write)(void* context, uint8_t address, const uint8_t* data, uint8_t length, bool stop);
+    // Reads length bytes; returns the number received
+    uint8_t (*read)(void* context, uint8_t address, uint8_t* data, uint8_t length);
+    // Frees a stuck bus and restarts the controller; true if SDA and SCL are high
+    bool (*recover)(void* context);
+};
+
+class I2cBus {
+private:
+    const I2cTransport* transport;
+    void* context;
+
+    I2cDevice devices[I2C_MAX_DEVICES];
+    uint8_t deviceCount;
+    I2cDeviceStats unregistered;    // Transfers to addresses not in the registry
+
+    uint8_t probeNext;              // probeStep() position
+    uint8_t consecutiveFaults;
+    uint16_t recoveries;
+    uint16_t failedRecoveries;
+
+    I2cDeviceStats& statsFor(uint8_t address);
+    I2cResult finish(uint8_t address, I2cResult result, uint32_t startUs);
+
+public:
+    I2cBus();
+
+    void attach(const I2cTransport* busTransport, void* busContext);
+#ifdef ARDUINO
+    // Starts Wire once, with a transfer timeout so a stuck bus cannot hang
+    // the loop, and attaches it
+    bool beginWire(uint32_t clockHz = I2C_DEFAULT_CLOCK_HZ, uint32_t timeoutUs = I2C_DEFAULT_TIMEOUT_US);
+#endif
+    bool isAttached() const { return transport != nullptr; }
+
+    // Registry. Adding an address that is already registered returns its
+    // handle; I2C_NO_DEVICE when full.
+    uint8_t addDevice(const I2cDeviceSpec& spec);
+    uint8_t findDevice(uint8_t address) const;
+    uint8_t getDeviceCount() const { return deviceCount; }
+    const I2cDevice& getDevice(uint8_t handle) const { return devices[handle]; }
+    bool isPresent(uint8_t handle) const { return handle < deviceCount && devices[handle].state == I2cDeviceState::PRESENT; }
+
+    // Checks one device now
+    I2cDeviceState probe(uint8_t handle);
+    // Checks the next unprobed device; false once all have been checked
+    bool probeStep();
+    // Steps until handle has been checked; devices registered before it
+    // are checked on the way, later ones are left for later steps
+    I2cDeviceState awaitProbe(uint8_t handle);
+    // Checks every device again
+    void probeAll();
+
+    // Transfers
+    I2cResult ping(uint8_t address);
+    I2cResult write(uint8_t address, const uint8_t* data, uint8_t length);
+    I2cResult writeRegister(uint8_t address, uint8_t reg, uint8_t value);
+    // Register read with a repeated start
+    I2cResult readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint8_t length);
+
+    // Statistics; the registry's, or the unregistered bucket for I2C_NO_DEVICE
+    const I2cDeviceStats& getStats(uint8_t handle) const {
+        return handle < deviceCount ? devices[handle].stats : unregistered;
+    }
+    static uint16_t averageUs(const I2cDeviceStats& stats) {
+        return stats.transactions ? (uint16_t)(stats.totalUs / stats.transactions) : 0;
+    }
+    // Failed transfers in percent
+    static uint8_t failurePercent(const I2cDeviceStats& stats) {
+        uint32_t failed = stats.naks + stats.timeouts + stats.errors;
+        return stats.transactions ? (uint8_t)(failed * 100 / stats.transactions) : 0;
+    }
+    void resetStats();
+
+    // Recovery; also run automatically after repeated bus faults
+    bool recover();
+    uint16_t getRecoveries() const { return recoveries; }
+    uint16_t getFailedRecoveries() const { return failedRecoveries; }
+};
+
+// The board's bus
+extern I2cBus i2cBus;
+
+#endif // I2C_BUS_H
@@ -2,6 +2,7 @@
 #define INTERRUPT_HANDLER_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
 
 // Interrupt types
 enum class InterruptType {
@@ -106,7 +107,7 @@ private:
     bool initialized;
     bool globalInterruptsEnabled;
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Timing
     unsigned long lastUpdateTime;
@@ -169,7 +170,7 @@ public:
     // Status and health
     bool isInitialized() const { return initialized; }
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
@@ -0,0 +1,153 @@
+#include "time_base.h"
+
+TimeBase::TimeBase() {
+    reset();
+}
+
+void TimeBase::reset() {
+    high = 0;
+    lastLow = 0;
+    ppsEdges.clear();
+    lastPulse = 0;
+    anchorLocal = 0;
+    anchorCorrected = 0;
+    rateErrorPpb = 0;
+    goodPulses = 0;
+    havePulse = false;
+    rateValid = false;
+    pulses = 0;
+    rejectedPulses = 0;
+    pulseTowUs = 0;
+    towValid = false;
+}
+
+uint64_t TimeBase::extend(uint32_t raw) const {
+    uint32_t h = high;
+    uint32_t last = lastLow;
+    // Below lastLow by more than half the range: the counter wrapped since
+    // the last advance. Otherwise the reading is just older, which it
+    // cannot be by a whole wrap before the first one.
+    if (raw < last && last - raw > 0x80000000UL) {
+        h++;
+    } else if (raw > last && raw - last > 0x80000000UL && h > 0) {
+        h--;
+    }
+    return ((uint64_t)h << 32) | raw;
+}
+
+void TimeBase::advance(uint32_t raw) {
+    uint64_t now = extend(raw);
+    high = (uint32_t)(now >> 32);
+    lastLow = raw;
+}
+
+int64_t TimeBase::removeRate(int64_t elapsed, int32_t ppb) {
+    // true = local / (1 + e); exact to the microsecond for spans of weeks
+    return elapsed - elapsed * ppb / (1000000000LL + ppb);
+}
+
+uint64_t TimeBase::correctedUs(uint64_t localUs) const {
+    return anchorCorrected + removeRate((int64_t)(localUs - anchorLocal), rateErrorPpb);
+}
+
+void TimeBase::acceptPulse(uint64_t local) {
+    pulses++;
+    if (!havePulse) {
+        havePulse = true;
+        anchorCorrected = correctedUs(local);
+        anchorLocal = local;
+        lastPulse = local;
+        goodPulses = 1;
+        return;
+    }
+
+    int64_t interval = (int64_t)(local - lastPulse);
+    int64_t seconds = (interval + PPS_PERIOD_US / 2) / PPS_PERIOD_US;
+    int64_t deviation = interval - seconds * (int64_t)PPS_PERIOD_US;
+    if (deviation < 0) {
+        deviation = -deviation;
+    }
+    if (seconds <= 0 || deviation > seconds * (int64_t)PPS_TOLERANCE_PPM) {
+        rejectedPulses++;
+        goodPulses = 0;
+        // A spurious edge is dropped; after a long silence this pulse
+        // starts over, since the old one no longer says which second it is
+        if (interval > (int64_t)PPS_TIMEOUT_US) {
+            anchorCorrected = correctedUs(local);
+            anchorLocal = local;
+            lastPulse = local;
+            towValid = false;
+            goodPulses = 1;
+        }
+        return;
+    }
+
+    int32_t errorPpb = (int32_t)((interval - seconds * (int64_t)PPS_PERIOD_US) * 1000 / seconds);
+    // Close the current segment with the old rate, so corrected time is
+    // continuous at the pulse
+    anchorCorrected = correctedUs(local);
+    anchorLocal = local;
+    if (!rateValid) {
+        rateErrorPpb = errorPpb;
+        rateValid = true;
+    } else {
+        rateErrorPpb += (errorPpb - rateErrorPpb) / (1 << PPS_RATE_SHIFT);
+    }
+    if (goodPulses < 255) {
+        goodPulses++;
+    }
+    if (towValid) {
+        pulseTowUs = (pulseTowUs + (uint64_t)seconds * PPS_PERIOD_US) % GPS_WEEK_US;
+    }
+    lastPulse = local;
+}
+
+void TimeBase::processPps() {
+    uint64_t edge;
+    while (ppsEdges.pop(edge)) {
+        acceptPulse(edge);
+    }
+}
+
+void TimeBase::onGpsEpoch(uint32_t iTOW, uint64_t arrivalUs) {
+    // The pulse marks the top of the second; its epoch's solution arrives
+    // some tens of ms later
+    if (iTOW % 1000 != 0 || !havePulse || arrivalUs <= lastPulse || arrivalUs - lastPulse >= PPS_PERIOD_US) {
+        return;
+    }
+    pulseTowUs = (uint64_t)iTOW * 1000;
+    towValid = true;
+}
+
+bool TimeBase::toGpsTowUs(uint64_t localUs, uint64_t& towUs) const {
+    if (!towValid) {
+        return false;
+    }
+    int64_t elapsed = removeRate((int64_t)(localUs - lastPulse), rateErrorPpb);
+    int64_t tow = (int64_t)pulseTowUs + elapsed;
+    tow %= (int64_t)GPS_WEEK_US;
+    if (tow < 0) {
+        tow += GPS_WEEK_US;
+    }
+    towUs = (uint64_t)tow;
+    return true;
+}
+
+bool TimeBase::toLocalUs(uint64_t towUs, uint64_t& localUs) const {
+    if (!towValid) {
+        return false;
+    }
+    // Nearest instance of towUs to the pulse, across the week boundary
+    int64_t delta = (int64_t)towUs - (int64_t)pulseTowUs;
+    if (delta > (int64_t)(GPS_WEEK_US / 2)) {
+        delta -= GPS_WEEK_US;
+    } else if (delta < -(int64_t)(GPS_WEEK_US / 2)) {
+        delta += GPS_WEEK_US;
+    }
+    localUs = lastPulse + delta + delta * rateErrorPpb / 1000000000LL;
+    return true;
+}
+
+bool TimeBase::isLocked(uint64_t nowUs) const {
+    return goodPulses >= PPS_LOCK_PULSES && nowUs - lastPulse < PPS_TIMEOUT_US;
+}
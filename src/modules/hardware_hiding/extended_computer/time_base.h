@@ -0,0 +1,92 @@
+#ifndef TIME_BASE_H
+#define TIME_BASE_H
+
+#include <stdint.h>
+#include "../../software_decision/software_utility/spsc_ring.h"
+
+// Monotonic 64-bit microsecond clock, disciplined to the GPS time pulse.
+//
+// Local time extends the 32-bit micros() counter with a high word. Only
+// the main loop advances the high word (at least once per 35 minutes, in
+// practice every loop); anyone, interrupts included, can extend a fresh
+// reading against it. A reading just behind the last advance is taken as
+// slightly older, not as a wrap, so stamps taken before an advance and
+// extended after it stay right.
+//
+// Every sensor sample is stamped in local time at acquisition. Discipline
+// then maps local time onto the GPS timeline:
+//   - The PPS interrupt pushes the local time of each pulse into a ring.
+//   - The main loop measures the local length of each pulse interval and
+//     filters it into the oscillator's rate error, in ppb. Intervals
+//     spanning missed pulses are divided down; implausible ones are
+//     rejected.
+//   - correctedUs() is local time with that rate error taken out. It is
+//     piecewise linear, anchored at each pulse and continuous across
+//     anchors, so it stays monotonic.
+//   - A NAV-PVT epoch whose iTOW falls on a whole second, arriving within
+//     a second of a pulse, names that pulse's GPS second. From then on
+//     toGpsTowUs() and toLocalUs() convert between local time and GPS
+//     time of week.
+
+static const uint32_t PPS_PERIOD_US = 1000000UL;
+static const uint32_t PPS_TOLERANCE_PPM = 2000;     // Crystal plus capture jitter
+static const uint8_t PPS_LOCK_PULSES = 4;           // Consecutive good pulses to lock
+static const uint32_t PPS_TIMEOUT_US = 2500000UL;   // Lock lost after this without a pulse
+static const uint8_t PPS_RATE_SHIFT = 3;            // Rate filter gain 1/8
+static const uint64_t GPS_WEEK_US = 604800ULL * 1000000ULL;
+
+class TimeBase {
+private:
+    // 32-to-64-bit extension, written by the main loop only
+    volatile uint32_t high;
+    volatile uint32_t lastLow;
+
+    SpscRing<uint64_t, 4> ppsEdges;     // PPS interrupt -> main loop
+
+    // Discipline
+    uint64_t lastPulse;                 // Local time of the last good pulse
+    uint64_t anchorLocal;               // correctedUs segment start
+    uint64_t anchorCorrected;
+    int32_t rateErrorPpb;               // Local runs fast by this much
+    uint8_t goodPulses;
+    bool havePulse;
+    bool rateValid;
+    uint32_t pulses;
+    uint32_t rejectedPulses;
+
+    // GPS second of lastPulse
+    uint64_t pulseTowUs;
+    bool towValid;
+
+    static int64_t removeRate(int64_t elapsed, int32_t ppb);
+    void acceptPulse(uint64_t local);
+
+public:
+    TimeBase();
+    void reset();
+
+    // Extends a micros() value read just now
+    uint64_t extend(uint32_t raw) const;
+    // Main loop only, with interrupts masked around it
+    void advance(uint32_t raw);
+
+    // PPS interrupt: records the pulse's local time
+    bool capturePps(uint64_t localUs) { return ppsEdges.push(localUs); }
+    // Main loop: folds captured pulses into the discipline
+    void processPps();
+    // Main loop: a NAV-PVT epoch and the local time it arrived
+    void onGpsEpoch(uint32_t iTOW, uint64_t arrivalUs);
+
+    uint64_t correctedUs(uint64_t localUs) const;
+    bool toGpsTowUs(uint64_t localUs, uint64_t& towUs) const;
+    bool toLocalUs(uint64_t towUs, uint64_t& localUs) const;
+
+    bool isLocked(uint64_t nowUs) const;
+    bool hasGpsTime() const { return towValid; }
+    int32_t getRateErrorPpb() const { return rateErrorPpb; }
+    uint32_t getPulses() const { return pulses; }
+    uint32_t getRejectedPulses() const { return rejectedPulses; }
+    uint16_t getDroppedPulses() const { return ppsEdges.getDropped(); }
+};
+
+#endif // TIME_BASE_H
@@ -0,0 +1,10 @@
+#include "timer_module.h"
+
+// TimerModule's monotonic clock, kept apart from the rest of TimerModule so
+// drivers that only stamp samples with nowUs() link without it.
+
+TimeBase TimerModule::timeBase;
+
+uint64_t TimerModule::nowUs() {
+    return timeBase.extend(micros());
+}
@@ -0,0 +1,53 @@
+#include "timer_module.h"
+#include "../../software_decision/application_data_types/state_events.h"
+
+// PPS discipline of the time base (the clock itself is in timer_clock.cpp).
+// The remaining TimerModule operations are implemented against these.
+
+// Error flag definitions
+#define ERROR_PPS_PIN_INVALID       0x01
+
+void TimerModule::ppsIsr() {
+    // Stamp first: this is the sample-accurate edge time
+    timeBase.capturePps(timeBase.extend(micros()));
+    EventManager::postFromIsr(IsrEventSource::GPS_PPS);
+}
+
+bool TimerModule::attachPps(uint8_t pin) {
+    int interrupt = digitalPinToInterrupt(pin);
+    if (interrupt < 0) {
+        errorFlags |= ERROR_PPS_PIN_INVALID;
+        lastError = "PPS pin has no external interrupt";
+        return false;
+    }
+    pinMode(pin, INPUT);
+    attachInterrupt(interrupt, ppsIsr, RISING);
+    return true;
+}
+
+void TimerModule::detachPps(uint8_t pin) {
+    int interrupt = digitalPinToInterrupt(pin);
+    if (interrupt >= 0) {
+        detachInterrupt(interrupt);
+    }
+}
+
+void TimerModule::onGpsEpoch(uint32_t iTOW, uint64_t arrivalUs) {
+    timeBase.onGpsEpoch(iTOW, arrivalUs);
+}
+
+void TimerModule::updateTimeBase() {
+    // ISRs extend against high/lastLow, so move them together
+    uint32_t raw = micros();
+    noInterrupts();
+    timeBase.advance(raw);
+    interrupts();
+    timeBase.processPps();
+}
+
+void TimerModule::update() {
+    updateTimeBase();
+    updateHardwareTimers();
+    updateSoftwareTimers();
+    lastUpdateTime = millis();
+}
@@ -2,6 +2,8 @@
 #define TIMER_MODULE_H
 
 #include <Arduino.h>
+#include "../../software_decision/application_data_types/fixed_string.h"
+#include "time_base.h"
 
 // Timer types
 enum class TimerType {
@@ -93,9 +95,14 @@ private:
     unsigned long systemStartTime;
     unsigned long lastUpdateTime;
     
+    // Monotonic time base, shared so drivers and ISRs can stamp samples
+    // without a TimerModule reference
+    static TimeBase timeBase;
+    static void ppsIsr();               // Also posts an IsrEventSource::GPS_PPS event
+    
     // Error handling
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Private methods
     bool initializeHardwareTimer(TimerType type);
@@ -149,6 +156,17 @@ public:
     void delayMicroseconds(uint32_t microseconds);
     void delayMilliseconds(uint32_t milliseconds);
     
+    // 64-bit monotonic time. nowUs() is safe in ISRs; stamp samples with it
+    // at acquisition. update() must run at least every 35 minutes.
+    static uint64_t nowUs();
+    static const TimeBase& getTimeBase() { return timeBase; }
+    // GPS time pulse on an external interrupt pin (see GPS::configure_timepulse)
+    bool attachPps(uint8_t pin);
+    void detachPps(uint8_t pin);
+    // From GPSInterface when a NAV-PVT arrives
+    static void onGpsEpoch(uint32_t iTOW, uint64_t arrivalUs);
+    void updateTimeBase();
+    
     // PWM control
     bool setPWMFrequency(TimerType type, uint32_t frequency);
     bool setPWMDutyCycle(TimerType type, uint8_t dutyCycle);
@@ -176,7 +194,7 @@ public:
     // Status and health
     bool isInitialized() const { return initialized; }
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Diagnostics
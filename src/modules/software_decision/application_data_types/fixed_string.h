@@ -0,0 +1,223 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <Arduino.h>
+#include <string.h>
+#include <limits.h>
+
+// Inline, fixed-capacity replacement for String in module state.
+//
+// FixedString<N> holds up to N characters inside the object itself, so
+// storing, copying and clearing one never touches the heap. Anything past
+// N is dropped and isTruncated() reports it. StringView is a non-owning
+// pointer/length pair that accepts string literals, String and
+// FixedString, and is the parameter type for text that is only read or copied.
+// Use String only where the text leaves the aircraft (console, telemetry, files).
+
+class StringView {
+private:
+    const char* ptr;
+    uint16_t len;
+
+public:
+    StringView() : ptr(""), len(0) {}
+    StringView(const char* text) : ptr(text ? text : ""), len(text ? (uint16_t)strlen(text) : 0) {}
+    StringView(const char* text, uint16_t length) : ptr(text), len(length) {}
+    StringView(const String& text) : ptr(text.c_str()), len((uint16_t)text.length()) {}
+
+    const char* data() const { return ptr; }   // Not null-terminated in general
+    uint16_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    char operator[](uint16_t index) const { return index < len ? ptr[index] : '\0'; }
+
+    bool equals(StringView other) const {
+        return len == other.len && memcmp(ptr, other.ptr, len) == 0;
+    }
+    bool operator==(StringView other) const { return equals(other); }
+    bool operator!=(StringView other) const { return !equals(other); }
+
+    bool startsWith(StringView prefix) const {
+        return prefix.len <= len && memcmp(ptr, prefix.ptr, prefix.len) == 0;
+    }
+    int indexOf(char c, uint16_t from = 0) const {
+        for (uint16_t i = from; i < len; i++) {
+            if (ptr[i] == c) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    StringView substring(uint16_t begin, uint16_t end) const {
+        if (end > len) end = len;
+        if (begin > end) begin = end;
+        return StringView(ptr + begin, end - begin);
+    }
+    StringView substring(uint16_t begin) const { return substring(begin, len); }
+
+    // Allocates: console and telemetry boundaries only
+    String toString() const {
+        String text;
+        text.reserve(len);
+        for (uint16_t i = 0; i < len; i++) {
+            text += ptr[i];
+        }
+        return text;
+    }
+};
+
+template <uint8_t N>
+class FixedString {
+    static_assert(N > 0 && N < 255, "FixedString capacity must be 1..254");
+
+private:
+    char buffer[N + 1];
+    uint8_t len;
+    bool truncated;
+
+    void appendDigits(unsigned long value, bool negative) {
+        char digits[20];    // ULONG_MAX is 20 digits where long is 64-bit
+        uint8_t count = 0;
+        do {
+            digits[count++] = '0' + (value % 10);
+            value /= 10;
+        } while (value > 0);
+        if (negative) {
+            append('-');
+        }
+        while (count > 0) {
+            append(digits[--count]);
+        }
+    }
+
+public:
+    FixedString() : len(0), truncated(false) { buffer[0] = '\0'; }
+    FixedString(const char* text) : len(0), truncated(false) { assign(StringView(text)); }
+    FixedString(StringView text) : len(0), truncated(false) { assign(text); }
+    FixedString(const String& text) : len(0), truncated(false) { assign(StringView(text)); }
+
+    template <uint8_t M>
+    FixedString(const FixedString<M>& other) : len(0), truncated(false) { assign(other.view()); }
+
+    FixedString& assign(StringView text) {
+        len = 0;
+        truncated = false;
+        return append(text);
+    }
+
+    FixedString& operator=(const char* text) { return assign(StringView(text)); }
+    FixedString& operator=(StringView text) { return assign(text); }
+    FixedString& operator=(const String& text) { return assign(StringView(text)); }
+    template <uint8_t M>
+    FixedString& operator=(const FixedString<M>& other) { return assign(other.view()); }
+
+    // Appends as much as fits; the rest is dropped and flagged
+    FixedString& append(StringView text) {
+        uint16_t room = N - len;
+        uint16_t count = text.length();
+        if (count > room) {
+            count = room;
+            truncated = true;
+        }
+        // memmove: text may be a view of this buffer (s.assign(s.view().substring(n)))
+        memmove(buffer + len, text.data(), count);
+        len += count;
+        buffer[len] = '\0';
+        return *this;
+    }
+
+    FixedString& append(char c) {
+        if (len < N) {
+            buffer[len++] = c;
+            buffer[len] = '\0';
+        } else {
+            truncated = true;
+        }
+        return *this;
+    }
+
+    FixedString& append(long value) {
+        appendDigits(value < 0 ? 0UL - (unsigned long)value : (unsigned long)value, value < 0);
+        return *this;
+    }
+
+    FixedString& append(unsigned long value) {
+        appendDigits(value, false);
+        return *this;
+    }
+
+    FixedString& append(double value, uint8_t decimals) {
+        if (isnan(value)) return append(StringView("nan"));
+        if (isinf(value)) return append(StringView("inf"));
+        bool negative = value < 0;
+        if (negative) value = -value;
+
+        // Round half up at the last printed digit, as Print::printFloat does
+        double rounding = 0.5;
+        for (uint8_t i = 0; i < decimals; i++) rounding /= 10.0;
+        value += rounding;
+
+        // Past unsigned long the cast is undefined; print "ovf" like Print does
+        if (!(value < (double)ULONG_MAX)) {
+            if (negative) append('-');
+            return append(StringView("ovf"));
+        }
+
+        unsigned long whole = (unsigned long)value;
+        appendDigits(whole, negative);
+        if (decimals > 0) {
+            append('.');
+            double fraction = value - (double)whole;
+            for (uint8_t i = 0; i < decimals; i++) {
+                fraction *= 10.0;
+                uint8_t digit = (uint8_t)fraction;
+                append((char)('0' + digit));
+                fraction -= digit;
+            }
+        }
+        return *this;
+    }
+
+    FixedString& operator+=(StringView text) { return append(text); }
+    FixedString& operator+=(const char* text) { return append(StringView(text)); }
+    FixedString& operator+=(const String& text) { return append(StringView(text)); }
+    FixedString& operator+=(char c) { return append(c); }
+    FixedString& operator+=(int value) { return append((long)value); }
+    FixedString& operator+=(unsigned int value) { return append((unsigned long)value); }
+    FixedString& operator+=(long value) { return append(value); }
+    FixedString& operator+=(unsigned long value) { return append(value); }
+    FixedString& operator+=(float value) { return append((double)value, 2); }
+    FixedString& operator+=(double value) { return append(value, 2); }
+
+    const char* c_str() const { return buffer; }
+    uint8_t length() const { return len; }
+    static uint8_t capacity() { return N; }
+    bool isEmpty() const { return len == 0; }
+    bool isTruncated() const { return truncated; }
+    char operator[](uint8_t index) const { return index < len ? buffer[index] : '\0'; }
+
+    void clear() {
+        len = 0;
+        truncated = false;
+        buffer[0] = '\0';
+    }
+
+    StringView view() const { return StringView(buffer, len); }
+    operator StringView() const { return view(); }
+
+    bool equals(StringView other) const { return view().equals(other); }
+    bool operator==(StringView other) const { return equals(other); }
+    bool operator!=(StringView other) const { return !equals(other); }
+    bool startsWith(StringView prefix) const { return view().startsWith(prefix); }
+    int indexOf(char c, uint8_t from = 0) const { return view().indexOf(c, from); }
+
+    // Allocates: console and telemetry boundaries only
+    String toString() const { return String(buffer); }
+};
+
+// Common capacities for module state
+typedef FixedString<47> ErrorText;      // lastError and error_message fields
+typedef FixedString<31> EventText;      // Event and alert descriptions
+typedef FixedString<15> NameText;       // Sources, codes, operator names
+typedef FixedString<16> DisplayLine;    // One row of the 16x2 console LCD
+
+#endif // FIXED_STRING_H
@@ -3,12 +3,14 @@
 
 #include <Arduino.h>
 #include <math.h>
+#include "fixed_string.h"
 
-// Precision levels for floating point operations
+// Precision levels for floating point operations (not LOW/HIGH: Arduino.h
+// defines those as macros)
 enum class Precision {
-    LOW = 3,      // 3 decimal places
+    COARSE = 3,   // 3 decimal places
     MEDIUM = 6,   // 6 decimal places
-    HIGH = 9,     // 9 decimal places
+    FINE = 9,     // 9 decimal places
     EXTREME = 12  // 12 decimal places
 };
 
@@ -202,12 +204,12 @@ class NumericTypes {
 private:
     // Configuration
     Precision defaultPrecision;
-    bool enableErrorChecking;
-    bool enableOverflowProtection;
+    bool errorCheckingEnabled;
+    bool overflowProtectionEnabled;
     
     // Error tracking
     uint32_t errorCount;
-    String lastError;
+    ErrorText lastError;
     
     // Performance metrics
     uint32_t operationCount;
@@ -251,7 +253,7 @@ public:
     
     // Error handling
     uint32_t getErrorCount() const { return errorCount; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Performance monitoring
@@ -0,0 +1,78 @@
+#include "state_events.h"
+#include "../../hardware_hiding/extended_computer/timer_module.h"
+
+// Interrupt event hand-off and queue processing. The remaining EventManager
+// operations are implemented against these.
+
+SpscRing<IsrEvent, EventManager::ISR_RING_SIZE> EventManager::isrEvents;
+
+bool EventManager::postFromIsr(IsrEventSource source, uint8_t code, uint16_t value) {
+    IsrEvent raw;
+    raw.source = source;
+    raw.code = code;
+    raw.value = value;
+    raw.timestampUs = TimerModule::nowUs();
+    return isrEvents.push(raw);
+}
+
+void EventManager::dispatchIsrEvent(const IsrEvent& raw) {
+    EventData event;
+    event.type = EventType::INTERRUPT_EVENT;
+    event.severity = EventSeverity::INFO;
+    event.source = EventSource::INTERRUPT;
+    event.status = EventStatus::PENDING;
+    event.priority = EventPriority::NORMAL;
+    switch (raw.source) {
+        case IsrEventSource::RECEIVER_PCINT: event.category = EventCategory::FLIGHT_CONTROL; break;
+        case IsrEventSource::IMU_DATA_READY: event.category = EventCategory::SENSORS; break;
+        case IsrEventSource::UART_RX:        event.category = EventCategory::COMMUNICATION; break;
+        case IsrEventSource::GPS_PPS:        event.category = EventCategory::NAVIGATION; break;
+        default:                             event.category = EventCategory::SYSTEM; break;
+    }
+    event.sourceId = static_cast<uint8_t>(raw.source);
+    event.targetId = raw.code;
+    event.timestamp = (unsigned long)(raw.timestampUs / 1000);
+    event.duration = 0;
+    event.retryCount = 0;
+    event.maxRetries = 0;
+    event.acknowledged = false;
+    event.logged = false;
+    event.persistent = false;
+    event.numericValue = raw.value;
+    event.booleanValue = false;
+    memset(event.dataArray, 0, sizeof(event.dataArray));
+    event.dataArray[0] = raw.code;
+    event.dataArray[1] = raw.value & 0xFF;
+    event.dataArray[2] = raw.value >> 8;
+
+    addEventToHistory(event);
+    updateStatistics(event);
+    notifyListeners(event);
+}
+
+void EventManager::processEventQueue() {
+    // Interrupt events first, bounded so an interrupt storm cannot hold up
+    // the loop; whatever is left waits for the next call. Popping only
+    // moves the consumer index, so interrupts stay enabled throughout.
+    IsrEvent raw;
+    for (uint8_t handled = 0; handled < ISR_DRAIN_LIMIT && isrEvents.pop(raw); handled++) {
+        dispatchIsrEvent(raw);
+    }
+
+    // eventQueue is filled and drained by the main loop only
+    while (queueLength > 0) {
+        EventQueueItem& item = eventQueue[queueHead];
+        if (!item.processed) {
+            if (item.listener) {
+                if (item.listener->active) {
+                    item.listener->callback(item.event, item.listener->userData);
+                }
+            } else {
+                notifyListeners(item.event);
+            }
+            item.processed = true;
+        }
+        queueHead = (queueHead + 1) % MAX_QUEUE_ITEMS;
+        queueLength--;
+    }
+}
@@ -2,6 +2,7 @@
 #define STATE_EVENTS_H
 
 #include <Arduino.h>
+#include "../software_utility/spsc_ring.h"
 
 // Event types
 enum class EventType {
@@ -23,12 +24,12 @@ enum class EventType {
     CONFIGURATION_EVENT
 };
 
-// Event severity levels
+// Event severity levels (not LOW/HIGH: Arduino.h defines those as macros)
 enum class EventSeverity {
     INFO,
-    LOW,
+    MINOR,
     MEDIUM,
-    HIGH,
+    MAJOR,
     CRITICAL,
     EMERGENCY
 };
@@ -74,9 +75,9 @@ enum class EventStatus {
 
 // Event priority
 enum class EventPriority {
-    LOW,
+    BACKGROUND,
     NORMAL,
-    HIGH,
+    ELEVATED,
     CRITICAL,
     EMERGENCY
 };
@@ -215,12 +216,32 @@ struct EventQueueItem {
     EventListener* listener;
 };
 
+// Interrupt sources that post into EventManager
+enum class IsrEventSource : uint8_t {
+    RECEIVER_PCINT,
+    IMU_DATA_READY,                 // InertialMeasurementInterface, per MPU6050 sample
+    UART_RX,
+    TIMER,
+    EXTERNAL,
+    GPS_PPS                         // TimerModule::ppsIsr(), once a second
+};
+
+// What an ISR posts: fixed size, no String, nothing allocated
+struct IsrEvent {
+    IsrEventSource source;
+    uint8_t code;                   // Source specific: channel, received byte
+    uint16_t value;                 // Source specific: pulse width, count
+    uint64_t timestampUs;           // TimerModule::nowUs() in the ISR
+};
+
 // Event management class
 class EventManager {
 private:
     static const uint8_t MAX_EVENTS = 128;
     static const uint8_t MAX_LISTENERS = 32;
     static const uint8_t MAX_QUEUE_ITEMS = 64;
+    static const uint8_t ISR_RING_SIZE = 32;
+    static const uint8_t ISR_DRAIN_LIMIT = 16;     // ISR events handled per processEventQueue()
     
     // Event storage
     EventData events[MAX_EVENTS];
@@ -237,6 +258,10 @@ private:
     uint8_t queueTail;
     uint8_t queueLength;
     
+    // Interrupt events: ISRs push, processEventQueue() pops. Static so an
+    // ISR needs no EventManager pointer; the ring needs no critical section.
+    static SpscRing<IsrEvent, ISR_RING_SIZE> isrEvents;
+    
     // Statistics
     EventStatistics statistics;
     
@@ -247,7 +272,8 @@ private:
     
     // Private methods
     void addEventToHistory(const EventData& event);
-    void processEventQueue();
+    void processEventQueue();           // Main loop only
+    void dispatchIsrEvent(const IsrEvent& raw);
     void notifyListeners(const EventData& event);
     bool matchesFilter(const EventData& event, const EventFilter& filter);
     void updateStatistics(const EventData& event);
@@ -264,6 +290,11 @@ public:
     bool resolveEvent(uint8_t eventId);
     bool cancelEvent(uint8_t eventId);
     
+    // Interrupt side: stamps the event and queues it; drops it and counts
+    // the drop when the ring is full. Safe from any ISR, not from loop().
+    static bool postFromIsr(IsrEventSource source, uint8_t code = 0, uint16_t value = 0);
+    static uint16_t getDroppedIsrEvents() { return isrEvents.getDropped(); }
+    
     // Event querying
     uint8_t getEventCount() const { return eventCount; }
     bool getEvent(uint8_t eventId, EventData& event) const;
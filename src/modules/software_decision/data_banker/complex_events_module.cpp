@@ -0,0 +1,358 @@
+#include "complex_events_module.h"
+
+// Correlation rule and event pattern registration, and per-event matching
+// through EventCorrelator and PatternAutomaton. The remaining operations are
+// implemented against these.
+
+// Error flag definitions
+#define ERROR_RULE_TABLE_FULL       0x01
+#define ERROR_RULE_NOT_COMPILED     0x02
+#define ERROR_PATTERN_TABLE_FULL    0x04
+#define ERROR_PATTERN_NOT_COMPILED  0x08
+#define ERROR_DUPLICATE_RULE        0x10
+#define ERROR_DUPLICATE_PATTERN     0x20
+
+ComplexEventsModule::ComplexEventsModule()
+    : eventCount(0),
+      ruleCount(0),
+      correlator(eventNames),
+      patternCount(0),
+      automaton(eventNames),
+      analysisCount(0),
+      config(),
+      lastUpdateTime(0),
+      lastAnalysisTime(0),
+      lastLogTime(0),
+      errorFlags(0) {
+}
+
+ComplexEventsModule::~ComplexEventsModule() {
+}
+
+uint16_t ComplexEventsModule::findRuleIndex(const String& ruleId) const {
+    for (uint16_t i = 0; i < ruleCount; i++) {
+        if (rules[i].ruleId == ruleId) {
+            return i;
+        }
+    }
+    return MAX_CORRELATION_RULES;
+}
+
+uint16_t ComplexEventsModule::findPatternIndex(const String& patternId) const {
+    for (uint16_t i = 0; i < patternCount; i++) {
+        if (patterns[i].patternId == patternId) {
+            return i;
+        }
+    }
+    return MAX_EVENT_PATTERNS;
+}
+
+static uint8_t viewList(const String* names, uint16_t count, StringView* views) {
+    if (!names || count > EVENT_RULE_LIST_MAX) {
+        return 0;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        views[i] = StringView(names[i]);
+    }
+    return (uint8_t)count;
+}
+
+bool ComplexEventsModule::compileRule(const CorrelationRule& rule) {
+    if (rule.triggerCount > EVENT_RULE_LIST_MAX || rule.requiredCount > EVENT_RULE_LIST_MAX ||
+        rule.excludedCount > EVENT_RULE_LIST_MAX) {
+        return false;
+    }
+    StringView triggers[EVENT_RULE_LIST_MAX];
+    StringView required[EVENT_RULE_LIST_MAX];
+    StringView excluded[EVENT_RULE_LIST_MAX];
+
+    EventRuleSpec spec;
+    spec.triggers = triggers;
+    spec.triggerCount = viewList(rule.triggerEvents, rule.triggerCount, triggers);
+    spec.required = required;
+    spec.requiredCount = viewList(rule.requiredEvents, rule.requiredCount, required);
+    spec.excluded = excluded;
+    spec.excludedCount = viewList(rule.excludedEvents, rule.excludedCount, excluded);
+    spec.minDelay = rule.minDelay;
+    spec.maxDelay = rule.maxDelay;
+    spec.timeout = rule.timeout;
+
+    uint8_t index = correlator.addRule(spec);
+    if (index == EVENT_ID_NONE) {
+        return false;
+    }
+    correlator.enableRule(index, rule.enabled);
+    return true;
+}
+
+uint16_t ComplexEventsModule::compileRules() {
+    // Correlator rule i must stay rules[i], so stop at the first rule that
+    // does not compile
+    for (uint16_t i = 0; i < ruleCount; i++) {
+        if (!compileRule(rules[i])) {
+            return i;
+        }
+    }
+    return ruleCount;
+}
+
+void ComplexEventsModule::reinternNames() {
+    // Names that only removed rules or patterns used stay interned until
+    // the table fills. Interning again from scratch drops them; the IDs
+    // change, so both tables are recompiled and the history is forgotten.
+    eventNames.clear();
+    correlator.clear();
+    automaton.clear();
+    compileRules();
+    compilePatterns();
+}
+
+bool ComplexEventsModule::rebuildCorrelator() {
+    // Event IDs and the events seen survive a rebuild, so rules that did
+    // not change keep matching against the history
+    correlator.clearRules();
+    uint16_t failed = compileRules();
+    if (failed < ruleCount) {
+        reinternNames();
+        failed = correlator.getRuleCount();
+    }
+    if (failed < ruleCount) {
+        errorFlags |= ERROR_RULE_NOT_COMPILED;
+        lastError = "Rule not compiled: ";
+        lastError += rules[failed].ruleId;
+        return false;
+    }
+    return true;
+}
+
+bool ComplexEventsModule::addCorrelationRule(const CorrelationRule& rule) {
+    if (findRuleIndex(rule.ruleId) < ruleCount) {
+        errorFlags |= ERROR_DUPLICATE_RULE;
+        lastError = "Duplicate rule: ";
+        lastError += rule.ruleId;
+        return false;
+    }
+    if (ruleCount >= MAX_CORRELATION_RULES) {
+        errorFlags |= ERROR_RULE_TABLE_FULL;
+        lastError = "Rule table full";
+        return false;
+    }
+    if (!compileRule(rule)) {
+        // Names left by removed rules or patterns may fill the table
+        reinternNames();
+        if (!compileRule(rule)) {
+            errorFlags |= ERROR_RULE_NOT_COMPILED;
+            lastError = "Rule names exceed the event table";
+            return false;
+        }
+    }
+    rules[ruleCount] = rule;
+    rules[ruleCount].creationTime = millis();
+    rules[ruleCount].firedCount = 0;
+    ruleCount++;
+    return true;
+}
+
+bool ComplexEventsModule::updateCorrelationRule(const String& ruleId, const CorrelationRule& newRule) {
+    uint16_t index = findRuleIndex(ruleId);
+    if (index >= ruleCount) {
+        return false;
+    }
+    CorrelationRule previous = rules[index];
+    rules[index] = newRule;
+    if (!rebuildCorrelator()) {
+        // The old rule set compiled before, so it compiles again
+        rules[index] = previous;
+        rebuildCorrelator();
+        return false;
+    }
+    return true;
+}
+
+bool ComplexEventsModule::removeCorrelationRule(const String& ruleId) {
+    uint16_t index = findRuleIndex(ruleId);
+    if (index >= ruleCount) {
+        return false;
+    }
+    for (uint16_t i = index + 1; i < ruleCount; i++) {
+        rules[i - 1] = rules[i];
+    }
+    ruleCount--;
+    rebuildCorrelator();
+    return true;
+}
+
+bool ComplexEventsModule::enableCorrelationRule(const String& ruleId, bool enable) {
+    uint16_t index = findRuleIndex(ruleId);
+    if (index >= ruleCount) {
+        return false;
+    }
+    rules[index].enabled = enable;
+    return correlator.enableRule((uint8_t)index, enable);
+}
+
+bool ComplexEventsModule::compilePattern(const EventPattern& pattern) {
+    uint16_t length = pattern.sequenceLength;
+    if (length == 0 || length > PATTERN_STEPS_MAX) {
+        return false;
+    }
+    StringView steps[PATTERN_STEPS_MAX];
+    if (viewList(pattern.eventSequence, length, steps) != length) {
+        return false;
+    }
+
+    // Step k's window applies to the gap from step k - 1
+    uint32_t minDelay[PATTERN_STEPS_MAX] = { 0 };
+    uint32_t maxDelay[PATTERN_STEPS_MAX] = { 0 };
+    uint16_t gaps = length - 1;
+    if (pattern.timeConstraints && gaps > 0) {
+        if (pattern.constraintCount == gaps) {
+            for (uint16_t k = 1; k < length; k++) {
+                maxDelay[k] = pattern.timeConstraints[k - 1];
+            }
+        } else if (pattern.constraintCount == 2 * gaps) {
+            for (uint16_t k = 1; k < length; k++) {
+                minDelay[k] = pattern.timeConstraints[2 * (k - 1)];
+                maxDelay[k] = pattern.timeConstraints[2 * (k - 1) + 1];
+            }
+        } else if (pattern.constraintCount != 0) {
+            return false;
+        }
+    }
+
+    PatternSpec spec;
+    spec.steps = steps;
+    spec.stepCount = (uint8_t)length;
+    spec.minDelay = minDelay;
+    spec.maxDelay = maxDelay;
+    spec.contiguous = pattern.continuous;
+
+    uint8_t index = automaton.addPattern(spec);
+    if (index == EVENT_ID_NONE) {
+        return false;
+    }
+    automaton.enablePattern(index, pattern.enabled);
+    return true;
+}
+
+uint16_t ComplexEventsModule::compilePatterns() {
+    // Automaton pattern i must stay patterns[i], as for the rules
+    for (uint16_t i = 0; i < patternCount; i++) {
+        if (!compilePattern(patterns[i])) {
+            return i;
+        }
+    }
+    return patternCount;
+}
+
+bool ComplexEventsModule::rebuildAutomaton() {
+    // Partial matches are dropped; patterns restart from their first step
+    automaton.clear();
+    uint16_t failed = compilePatterns();
+    if (failed < patternCount) {
+        reinternNames();
+        failed = automaton.getPatternCount();
+    }
+    if (failed < patternCount) {
+        errorFlags |= ERROR_PATTERN_NOT_COMPILED;
+        lastError = "Pattern not compiled: ";
+        lastError += patterns[failed].patternId;
+        return false;
+    }
+    return true;
+}
+
+bool ComplexEventsModule::addEventPattern(const EventPattern& pattern) {
+    if (findPatternIndex(pattern.patternId) < patternCount) {
+        errorFlags |= ERROR_DUPLICATE_PATTERN;
+        lastError = "Duplicate pattern: ";
+        lastError += pattern.patternId;
+        return false;
+    }
+    if (patternCount >= MAX_EVENT_PATTERNS) {
+        errorFlags |= ERROR_PATTERN_TABLE_FULL;
+        lastError = "Pattern table full";
+        return false;
+    }
+    if (!compilePattern(pattern)) {
+        reinternNames();
+        if (!compilePattern(pattern)) {
+            errorFlags |= ERROR_PATTERN_NOT_COMPILED;
+            lastError = "Pattern exceeds the automaton";
+            return false;
+        }
+    }
+    patterns[patternCount] = pattern;
+    patterns[patternCount].matchCount = 0;
+    patterns[patternCount].lastMatch = 0;
+    patternCount++;
+    return true;
+}
+
+bool ComplexEventsModule::updateEventPattern(const String& patternId, const EventPattern& newPattern) {
+    uint16_t index = findPatternIndex(patternId);
+    if (index >= patternCount) {
+        return false;
+    }
+    EventPattern previous = patterns[index];
+    patterns[index] = newPattern;
+    if (!rebuildAutomaton()) {
+        patterns[index] = previous;
+        rebuildAutomaton();
+        return false;
+    }
+    return true;
+}
+
+bool ComplexEventsModule::removeEventPattern(const String& patternId) {
+    uint16_t index = findPatternIndex(patternId);
+    if (index >= patternCount) {
+        return false;
+    }
+    for (uint16_t i = index + 1; i < patternCount; i++) {
+        patterns[i - 1] = patterns[i];
+    }
+    patternCount--;
+    rebuildAutomaton();
+    return true;
+}
+
+bool ComplexEventsModule::enableEventPattern(const String& patternId, bool enable) {
+    uint16_t index = findPatternIndex(patternId);
+    if (index >= patternCount) {
+        return false;
+    }
+    patterns[index].enabled = enable;
+    return automaton.enablePattern((uint8_t)index, enable);
+}
+
+void ComplexEventsModule::processEventPatterns(const String& componentEvent) {
+    // Each pattern the event appears in moves one step; nothing is rescanned
+    unsigned long now = millis();
+    EventSet matched;
+    if (automaton.onEvent(StringView(componentEvent), now, matched) == 0) {
+        return;
+    }
+    for (uint8_t p = matched.next(0); p != EVENT_ID_NONE; p = matched.next(p + 1)) {
+        patterns[p].matchCount++;
+        patterns[p].lastMatch = now;
+    }
+}
+
+bool ComplexEventsModule::processComponentEvent(const String& componentEvent, const String& eventData) {
+    (void)eventData;
+    unsigned long now = millis();
+
+    // One name lookup, then only the rules this event triggers
+    EventSet fired;
+    if (correlator.onEvent(StringView(componentEvent), now, fired) > 0) {
+        for (uint8_t r = fired.next(0); r != EVENT_ID_NONE; r = fired.next(r + 1)) {
+            rules[r].lastTriggered = now;
+            rules[r].firedCount++;
+            createComplexEvent(rules[r], componentEvent);
+        }
+    }
+
+    processEventPatterns(componentEvent);
+    return true;
+}
@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include "../application_data_types/state_events.h"
 #include "../application_data_types/numeric_types.h"
+#include "../application_data_types/fixed_string.h"
+#include "event_correlator.h"
+#include "pattern_automaton.h"
 
 // Event correlation types
 enum class CorrelationType {
@@ -17,17 +20,10 @@ enum class CorrelationType {
     ANOMALY
 };
 
-// Event priority levels
-enum class EventPriority {
-    LOW,
-    NORMAL,
-    HIGH,
-    CRITICAL,
-    EMERGENCY
-};
+// Complex event priorities are EventPriority from state_events.h
 
-// Event status
-enum class EventStatus {
+// Complex event status (EventStatus in state_events.h is for single events)
+enum class ComplexEventStatus {
     PENDING,
     ACTIVE,
     COMPLETED,
@@ -68,7 +64,7 @@ struct CorrelationRule {
     // Rule metadata
     unsigned long creationTime;
     unsigned long lastTriggered;
-    uint16_t triggerCount;
+    uint16_t firedCount;
     bool persistent;
 };
 
@@ -80,7 +76,7 @@ struct ComplexEvent {
     String description;
     CorrelationType correlationType;
     EventPriority priority;
-    EventStatus status;
+    ComplexEventStatus status;
     
     // Event data
     String* componentEvents;
@@ -110,7 +106,9 @@ struct EventPattern {
     CorrelationType type;
     bool enabled;
     
-    // Pattern definition
+    // Pattern definition. timeConstraints holds sequenceLength - 1 maxDelay
+    // values (ms between consecutive steps), or sequenceLength - 1
+    // minDelay/maxDelay pairs; 0 maxDelay is no limit
     String* eventSequence;
     uint16_t sequenceLength;
     uint32_t* timeConstraints;
@@ -120,7 +118,7 @@ struct EventPattern {
     float confidence;
     uint16_t matchCount;
     unsigned long lastMatch;
-    bool continuous;
+    bool continuous;        // Steps must be consecutive events
 };
 
 // Event analysis result
@@ -161,21 +159,31 @@ struct ComplexEventsConfig {
 class ComplexEventsModule {
 private:
     static const uint16_t MAX_COMPLEX_EVENTS = 256;
-    static const uint16_t MAX_CORRELATION_RULES = 128;
-    static const uint16_t MAX_EVENT_PATTERNS = 64;
+    static const uint16_t MAX_CORRELATION_RULES = 32;
+    static const uint16_t MAX_EVENT_PATTERNS = 32;
     static const uint16_t MAX_ANALYSIS_RESULTS = 128;
     
     // Event storage
     ComplexEvent events[MAX_COMPLEX_EVENTS];
     uint16_t eventCount;
     
-    // Correlation rules
+    // Event names, interned once for both correlator and automaton
+    EventInterner eventNames;
+    
+    // Correlation rules. correlator holds them compiled to interned event
+    // IDs, rule i of correlator being rules[i]; it is rebuilt whenever a
+    // rule is added, changed or removed, never per event.
     CorrelationRule rules[MAX_CORRELATION_RULES];
     uint16_t ruleCount;
+    EventCorrelator correlator;
+    static_assert(MAX_CORRELATION_RULES <= EVENT_RULE_MAX, "EventCorrelator too small for the rule table");
     
-    // Event patterns
+    // Event patterns, compiled into automaton the same way: pattern i of
+    // automaton is patterns[i]
     EventPattern patterns[MAX_EVENT_PATTERNS];
     uint16_t patternCount;
+    PatternAutomaton automaton;
+    static_assert(MAX_EVENT_PATTERNS <= PATTERN_MAX, "PatternAutomaton too small for the pattern table");
     
     // Analysis results
     EventAnalysisResult analyses[MAX_ANALYSIS_RESULTS];
@@ -191,7 +199,7 @@ private:
     
     // Error tracking
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Helper methods
     uint16_t findEventIndex(const String& eventId) const;
@@ -199,12 +207,16 @@ private:
     uint16_t findPatternIndex(const String& patternId) const;
     uint16_t findAnalysisIndex(const String& analysisId) const;
     
-    bool evaluateCorrelationRule(const CorrelationRule& rule, const String& triggerEvent);
-    bool checkEventConditions(const CorrelationRule& rule, const String* events, uint16_t count);
-    bool checkTimingConstraints(const CorrelationRule& rule, unsigned long eventTime);
+    bool compileRule(const CorrelationRule& rule);
+    uint16_t compileRules();            // Index of the first rule that fails, or ruleCount
+    bool rebuildCorrelator();
+    bool compilePattern(const EventPattern& pattern);
+    uint16_t compilePatterns();         // Index of the first pattern that fails, or patternCount
+    bool rebuildAutomaton();
+    void reinternNames();
     
     void createComplexEvent(const CorrelationRule& rule, const String& triggerEvent);
-    void updateEventStatus(const String& eventId, EventStatus status);
+    void updateEventStatus(const String& eventId, ComplexEventStatus status);
     void processEventPatterns(const String& componentEvent);
     
     bool persistEvent(const ComplexEvent& event);
@@ -247,7 +259,7 @@ public:
     
     ComplexEvent getComplexEvent(const String& eventId) const;
     bool isComplexEventActive(const String& eventId) const;
-    EventStatus getEventStatus(const String& eventId) const;
+    ComplexEventStatus getEventStatus(const String& eventId) const;
     uint16_t getComplexEventCount() const { return eventCount; }
     
     // Event correlation and analysis
@@ -263,14 +275,14 @@ public:
     bool addEventNote(const String& eventId, const String& note);
     
     // Event search and filtering
-    bool findEventsByStatus(EventStatus status, String* eventIds, uint16_t& count) const;
+    bool findEventsByStatus(ComplexEventStatus status, String* eventIds, uint16_t& count) const;
     bool findEventsByPriority(EventPriority priority, String* eventIds, uint16_t& count) const;
     bool findEventsBySource(const String& source, String* eventIds, uint16_t& count) const;
     bool findEventsByCategory(const String& category, String* eventIds, uint16_t& count) const;
     bool findEventsByTimeRange(unsigned long startTime, unsigned long endTime, String* eventIds, uint16_t& count) const;
     
     // Event statistics and monitoring
-    uint16_t getEventCountByStatus(EventStatus status) const;
+    uint16_t getEventCountByStatus(ComplexEventStatus status) const;
     uint16_t getEventCountByPriority(EventPriority priority) const;
     uint16_t getEventCountBySource(const String& source) const;
     uint16_t getEventCountByCategory(const String& category) const;
@@ -297,7 +309,7 @@ public:
     // Status and monitoring
     bool isHealthy() const;
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Utility methods
@@ -0,0 +1,211 @@
+#include "event_correlator.h"
+#include <string.h>
+
+uint8_t EventSet::count() const {
+    uint8_t total = 0;
+    for (uint8_t w = 0; w < EVENT_SET_WORDS; w++) {
+        for (uint32_t bits = words[w]; bits; bits &= bits - 1) {
+            total++;
+        }
+    }
+    return total;
+}
+
+uint8_t EventSet::next(uint8_t from) const {
+    if (from >= 32 * EVENT_SET_WORDS) {
+        return EVENT_ID_NONE;
+    }
+    uint8_t w = from >> 5;
+    uint32_t bits = words[w] & (0xFFFFFFFFUL << (from & 31));
+    for (;;) {
+        if (bits) {
+            return (uint8_t)(w * 32 + __builtin_ctzl(bits));
+        }
+        if (++w == EVENT_SET_WORDS) {
+            return EVENT_ID_NONE;
+        }
+        bits = words[w];
+    }
+}
+
+EventInterner::EventInterner() {
+    clear();
+}
+
+void EventInterner::clear() {
+    poolUsed = 0;
+    count = 0;
+    memset(slots, 0, sizeof(slots));
+}
+
+uint16_t EventInterner::hash(StringView name) {
+    uint16_t h = 0x811C;
+    for (uint16_t i = 0; i < name.length(); i++) {
+        h = (h ^ (uint8_t)name[i]) * 0x0103;
+    }
+    return h;
+}
+
+uint8_t EventInterner::locate(StringView name) const {
+    const uint8_t mask = sizeof(slots) - 1;
+    uint8_t slot = hash(name) & mask;
+    while (slots[slot] != 0) {
+        const char* stored = pool + nameOffset[slots[slot] - 1];
+        if (strncmp(stored, name.data(), name.length()) == 0 && stored[name.length()] == '\0') {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+uint8_t EventInterner::find(StringView name) const {
+    if (name.length() > EVENT_NAME_MAX) {
+        return EVENT_ID_NONE;
+    }
+    uint8_t slot = locate(name);
+    return slots[slot] ? slots[slot] - 1 : EVENT_ID_NONE;
+}
+
+uint8_t EventInterner::intern(StringView name) {
+    if (name.isEmpty() || name.length() > EVENT_NAME_MAX) {
+        return EVENT_ID_NONE;
+    }
+    uint8_t slot = locate(name);
+    if (slots[slot]) {
+        return slots[slot] - 1;
+    }
+    if (count == EVENT_ID_MAX || poolUsed + name.length() + 1 > EVENT_NAME_POOL) {
+        return EVENT_ID_NONE;
+    }
+    nameOffset[count] = poolUsed;
+    memcpy(pool + poolUsed, name.data(), name.length());
+    pool[poolUsed + name.length()] = '\0';
+    poolUsed += name.length() + 1;
+    slots[slot] = ++count;
+    return count - 1;
+}
+
+EventCorrelator::EventCorrelator(EventInterner& eventNames) : names(&eventNames) {
+    clear();
+}
+
+void EventCorrelator::clearRules() {
+    ruleCount = 0;
+    for (uint8_t id = 0; id < EVENT_ID_MAX; id++) {
+        triggeredBy[id].clear();
+    }
+    evaluations = 0;
+}
+
+void EventCorrelator::clear() {
+    clearRules();
+    resetHistory();
+}
+
+void EventCorrelator::resetHistory() {
+    seen.clear();
+    memset(lastSeen, 0, sizeof(lastSeen));
+}
+
+bool EventCorrelator::compileNames(const StringView* list, uint8_t count, EventSet& set) {
+    set.clear();
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t id = names->intern(list[i]);
+        if (id == EVENT_ID_NONE) {
+            return false;
+        }
+        set.set(id);
+    }
+    return true;
+}
+
+uint8_t EventCorrelator::addRule(const EventRuleSpec& spec) {
+    if (ruleCount == EVENT_RULE_MAX || spec.triggerCount == 0) {
+        return EVENT_ID_NONE;
+    }
+    CompiledRule& rule = rules[ruleCount];
+    if (!compileNames(spec.triggers, spec.triggerCount, rule.trigger) ||
+        !compileNames(spec.required, spec.requiredCount, rule.required) ||
+        !compileNames(spec.excluded, spec.excludedCount, rule.excluded)) {
+        return EVENT_ID_NONE;
+    }
+    rule.minDelay = spec.minDelay;
+    rule.maxDelay = spec.maxDelay;
+    rule.timeout = spec.timeout;
+    rule.enabled = true;
+
+    for (uint8_t id = rule.trigger.next(0); id != EVENT_ID_NONE; id = rule.trigger.next(id + 1)) {
+        triggeredBy[id].set(ruleCount);
+    }
+    return ruleCount++;
+}
+
+bool EventCorrelator::enableRule(uint8_t rule, bool enable) {
+    if (rule >= ruleCount) {
+        return false;
+    }
+    rules[rule].enabled = enable;
+    return true;
+}
+
+bool EventCorrelator::matches(const CompiledRule& rule, uint32_t now) const {
+    // Set tests first: most candidates fail here without touching times
+    if (!seen.covers(rule.required)) {
+        return false;
+    }
+    if (rule.excluded.intersects(seen)) {
+        for (uint8_t id = rule.excluded.next(0); id != EVENT_ID_NONE; id = rule.excluded.next(id + 1)) {
+            if (seen.test(id) && (rule.timeout == 0 || now - lastSeen[id] <= rule.timeout)) {
+                return false;
+            }
+        }
+    }
+    if (!rule.required.any()) {
+        return true;
+    }
+
+    uint32_t newestAge = 0xFFFFFFFFUL;
+    for (uint8_t id = rule.required.next(0); id != EVENT_ID_NONE; id = rule.required.next(id + 1)) {
+        uint32_t age = now - lastSeen[id];
+        if (rule.timeout != 0 && age > rule.timeout) {
+            return false;
+        }
+        if (age < newestAge) {
+            newestAge = age;
+        }
+    }
+    return newestAge >= rule.minDelay && (rule.maxDelay == 0 || newestAge <= rule.maxDelay);
+}
+
+uint8_t EventCorrelator::onEvent(uint8_t eventId, uint32_t now, EventSet& fired) {
+    fired.clear();
+    if (eventId >= names->getCount()) {
+        return 0;
+    }
+
+    // Only the rules this event triggers; the event itself is recorded
+    // afterwards so it cannot satisfy or block its own trigger
+    uint8_t firedCount = 0;
+    const EventSet& candidates = triggeredBy[eventId];
+    for (uint8_t r = candidates.next(0); r != EVENT_ID_NONE; r = candidates.next(r + 1)) {
+        evaluations++;
+        if (rules[r].enabled && matches(rules[r], now)) {
+            fired.set(r);
+            firedCount++;
+        }
+    }
+
+    seen.set(eventId);
+    lastSeen[eventId] = now;
+    return firedCount;
+}
+
+uint8_t EventCorrelator::onEvent(StringView name, uint32_t now, EventSet& fired) {
+    uint8_t id = names->find(name);
+    if (id == EVENT_ID_NONE) {
+        fired.clear();
+        return 0;
+    }
+    return onEvent(id, now, fired);
+}
@@ -0,0 +1,150 @@
+#ifndef EVENT_CORRELATOR_H
+#define EVENT_CORRELATOR_H
+
+#include <stdint.h>
+#include "../application_data_types/fixed_string.h"
+
+// Rule matching for ComplexEventsModule on interned event IDs.
+//
+// Event names are interned once, when a rule is registered: every name a
+// rule mentions gets a small integer ID, and the rule is stored as three
+// 64-bit sets (trigger, required, excluded). An incoming event costs one
+// hashed name lookup; names no rule mentions stop there.
+//
+// triggeredBy[id] is the inverted index: the set of rules that event id
+// triggers. Only those rules are evaluated, and for each one the
+// required/excluded test is a handful of word ANDs against the set of
+// events seen so far, plus a time check on the few bits that survive.
+//
+// Timing, per rule:
+//   timeout   required events count only if seen within timeout ms before
+//             the trigger, excluded events only block within the same
+//             window (0: since reset)
+//   minDelay, the newest required event must precede the trigger by at
+//   maxDelay  least minDelay and at most maxDelay ms (maxDelay 0: no limit)
+//
+// Names live in an EventInterner the caller owns, so PatternAutomaton can
+// share it: each name is stored once and has one ID in both.
+//
+// Sized for the Mega's 8 KB of SRAM: the correlator is about 2 KB, the
+// interner under 800 bytes, of which the name pool is 512 bytes (64 names
+// of up to 7 characters on average).
+
+static const uint8_t EVENT_SET_WORDS = 2;       // EventSet width, 32 bits each
+static const uint8_t EVENT_ID_MAX = 64;         // Distinct names across all rules
+static const uint8_t EVENT_RULE_MAX = 32;       // MAX_CORRELATION_RULES
+static const uint8_t EVENT_ID_NONE = 0xFF;
+static const uint16_t EVENT_NAME_POOL = 512;    // Bytes for interned names
+static const uint8_t EVENT_NAME_MAX = 31;
+static const uint8_t EVENT_RULE_LIST_MAX = 16;  // Names per trigger/required/excluded list
+
+// 64-bit set of event IDs, rule or pattern indexes
+struct EventSet {
+    uint32_t words[EVENT_SET_WORDS];
+
+    void clear() { words[0] = words[1] = 0; }
+    void set(uint8_t bit) { words[bit >> 5] |= 1UL << (bit & 31); }
+    void reset(uint8_t bit) { words[bit >> 5] &= ~(1UL << (bit & 31)); }
+    bool test(uint8_t bit) const { return words[bit >> 5] & (1UL << (bit & 31)); }
+    bool any() const { return (words[0] | words[1]) != 0; }
+    bool intersects(const EventSet& other) const {
+        return ((words[0] & other.words[0]) | (words[1] & other.words[1])) != 0;
+    }
+    // True if every bit of other is set here
+    bool covers(const EventSet& other) const {
+        return ((other.words[0] & ~words[0]) | (other.words[1] & ~words[1])) == 0;
+    }
+    uint8_t count() const;
+    // Lowest set bit at or after from, or EVENT_ID_NONE
+    uint8_t next(uint8_t from) const;
+};
+static_assert(EVENT_ID_MAX <= 32 * EVENT_SET_WORDS && EVENT_RULE_MAX <= 32 * EVENT_SET_WORDS,
+              "EventSet too narrow for the event and rule tables");
+
+class EventInterner {
+private:
+    char pool[EVENT_NAME_POOL];         // Null-terminated names back to back
+    uint16_t poolUsed;
+    uint16_t nameOffset[EVENT_ID_MAX];
+    uint8_t slots[2 * EVENT_ID_MAX];    // Open addressing: id + 1, 0 is empty
+    uint8_t count;
+
+    static uint16_t hash(StringView name);
+    uint8_t locate(StringView name) const;  // Slot holding name, or the empty slot ending its probe
+
+public:
+    EventInterner();
+    void clear();
+
+    // Returns the existing or new ID; EVENT_ID_NONE when full or name too long
+    uint8_t intern(StringView name);
+    uint8_t find(StringView name) const;
+    const char* getName(uint8_t id) const { return id < count ? pool + nameOffset[id] : ""; }
+    uint8_t getCount() const { return count; }
+};
+
+struct EventRuleSpec {
+    const StringView* triggers;
+    uint8_t triggerCount;
+    const StringView* required;
+    uint8_t requiredCount;
+    const StringView* excluded;
+    uint8_t excludedCount;
+    uint32_t minDelay;
+    uint32_t maxDelay;
+    uint32_t timeout;
+};
+
+struct CompiledRule {
+    EventSet trigger;
+    EventSet required;
+    EventSet excluded;
+    uint32_t minDelay;
+    uint32_t maxDelay;
+    uint32_t timeout;
+    bool enabled;
+};
+
+class EventCorrelator {
+private:
+    EventInterner* names;                   // Shared, owned by the caller
+    CompiledRule rules[EVENT_RULE_MAX];
+    uint8_t ruleCount;
+
+    EventSet triggeredBy[EVENT_ID_MAX];     // Event ID -> rules it triggers
+    EventSet seen;                          // Events seen since reset
+    uint32_t lastSeen[EVENT_ID_MAX];
+    uint32_t evaluations;                   // Rules evaluated, for tuning
+
+    bool compileNames(const StringView* list, uint8_t count, EventSet& set);
+    bool matches(const CompiledRule& rule, uint32_t now) const;
+
+public:
+    explicit EventCorrelator(EventInterner& eventNames);
+
+    // Interns the rule's names and indexes it; returns the rule index, or
+    // EVENT_ID_NONE when rules or names run out (the rule is not added)
+    uint8_t addRule(const EventRuleSpec& spec);
+    bool enableRule(uint8_t rule, bool enable);
+    // Drops the rules but keeps the history, so rules added again see the
+    // events already seen. Event IDs stay valid as long as the interner
+    // is not cleared.
+    void clearRules();
+    // Drops rules and history; call after clearing the interner
+    void clear();
+
+    // Records the event and fills fired with the rules it completes;
+    // returns how many fired
+    uint8_t onEvent(uint8_t eventId, uint32_t now, EventSet& fired);
+    uint8_t onEvent(StringView name, uint32_t now, EventSet& fired);
+    // Forgets every event seen (rules stay)
+    void resetHistory();
+
+    uint8_t findEvent(StringView name) const { return names->find(name); }
+    const char* getEventName(uint8_t id) const { return names->getName(id); }
+    uint8_t getEventCount() const { return names->getCount(); }
+    uint8_t getRuleCount() const { return ruleCount; }
+    uint32_t getEvaluations() const { return evaluations; }
+};
+
+#endif // EVENT_CORRELATOR_H
@@ -0,0 +1,187 @@
+#include "pattern_automaton.h"
+#include <string.h>
+
+PatternAutomaton::PatternAutomaton(EventInterner& eventNames) : names(&eventNames) {
+    clear();
+}
+
+void PatternAutomaton::clear() {
+    patternCount = 0;
+    stepCount = 0;
+    edgeCount = 0;
+    memset(edgeStart, 0, sizeof(edgeStart));
+    advances = 0;
+    resetState();
+}
+
+void PatternAutomaton::resetState() {
+    for (uint8_t p = 0; p < patternCount; p++) {
+        patterns[p].reached = 0;
+        patterns[p].lastSequence = 0;
+    }
+    memset(stepTime, 0, sizeof(stepTime));
+    // Starts above every lastSequence so no run looks contiguous
+    sequence = 1;
+}
+
+bool PatternAutomaton::insertEdge(uint8_t id, uint8_t pattern, uint16_t steps) {
+    if (edgeCount == PATTERN_EDGE_MAX) {
+        return false;
+    }
+    // Append to the end of id's group, shifting the later groups up one
+    uint16_t at = edgeStart[id + 1];
+    memmove(edges + at + 1, edges + at, (edgeCount - at) * sizeof(Edge));
+    edges[at].pattern = pattern;
+    edges[at].steps = steps;
+    edgeCount++;
+    for (uint16_t next = id + 1; next <= EVENT_ID_MAX; next++) {
+        edgeStart[next]++;
+    }
+    return true;
+}
+
+uint8_t PatternAutomaton::addPattern(const PatternSpec& spec) {
+    if (patternCount == PATTERN_MAX || spec.stepCount == 0 || spec.stepCount > PATTERN_STEPS_MAX ||
+        stepCount + spec.stepCount > PATTERN_STEP_POOL) {
+        return EVENT_ID_NONE;
+    }
+
+    // Intern the steps and collect each distinct event's step mask
+    uint8_t ids[PATTERN_STEPS_MAX];
+    uint16_t masks[PATTERN_STEPS_MAX];
+    uint8_t distinct = 0;
+    for (uint8_t k = 0; k < spec.stepCount; k++) {
+        uint8_t id = names->intern(spec.steps[k]);
+        if (id == EVENT_ID_NONE) {
+            return EVENT_ID_NONE;
+        }
+        uint8_t d = 0;
+        while (d < distinct && ids[d] != id) {
+            d++;
+        }
+        if (d == distinct) {
+            ids[distinct] = id;
+            masks[distinct++] = 0;
+        }
+        masks[d] |= 1U << k;
+    }
+    if (edgeCount + distinct > PATTERN_EDGE_MAX) {
+        return EVENT_ID_NONE;
+    }
+
+    Pattern& pattern = patterns[patternCount];
+    pattern.firstStep = stepCount;
+    pattern.length = spec.stepCount;
+    pattern.reached = 0;
+    pattern.timed = 0;
+    pattern.lastSequence = 0;
+    pattern.contiguous = spec.contiguous;
+    pattern.enabled = true;
+    for (uint8_t k = 0; k < spec.stepCount; k++) {
+        uint16_t step = stepCount + k;
+        stepTime[step] = 0;
+        minDelay[step] = (k > 0 && spec.minDelay) ? spec.minDelay[k] : 0;
+        maxDelay[step] = (k > 0 && spec.maxDelay) ? spec.maxDelay[k] : 0;
+        if (minDelay[step] != 0 || maxDelay[step] != 0) {
+            pattern.timed |= 1U << k;
+        }
+    }
+    stepCount += spec.stepCount;
+
+    for (uint8_t d = 0; d < distinct; d++) {
+        insertEdge(ids[d], patternCount, masks[d]);
+    }
+    return patternCount++;
+}
+
+bool PatternAutomaton::enablePattern(uint8_t pattern, bool enable) {
+    if (pattern >= patternCount) {
+        return false;
+    }
+    patterns[pattern].enabled = enable;
+    patterns[pattern].reached = 0;
+    return true;
+}
+
+bool PatternAutomaton::advance(Pattern& pattern, uint16_t steps, uint32_t now) {
+    uint16_t reached = pattern.reached;
+    if (pattern.contiguous && pattern.lastSequence + 1 != sequence) {
+        reached = 0;
+    }
+    uint16_t next = ((reached << 1) | 1) & steps;
+
+    // Windows only for the steps that survived; step 0 has none
+    const uint16_t first = pattern.firstStep;
+    for (uint16_t bits = next & pattern.timed; bits; bits &= bits - 1) {
+        uint8_t k = __builtin_ctz(bits);
+        uint32_t elapsed = now - stepTime[first + k - 1];
+        if (elapsed < minDelay[first + k] || (maxDelay[first + k] != 0 && elapsed > maxDelay[first + k])) {
+            next &= ~(1U << k);
+        }
+    }
+    for (uint16_t bits = next; bits; bits &= bits - 1) {
+        stepTime[first + __builtin_ctz(bits)] = now;
+    }
+
+    pattern.lastSequence = sequence;
+    if (next & (1U << (pattern.length - 1))) {
+        pattern.reached = 0;
+        return true;
+    }
+    pattern.reached = pattern.contiguous ? next : (reached | next);
+    return false;
+}
+
+uint8_t PatternAutomaton::onEvent(uint8_t eventId, uint32_t now, EventSet& matched) {
+    matched.clear();
+    sequence++;
+    if (eventId >= names->getCount()) {
+        return 0;
+    }
+
+    uint8_t matchedCount = 0;
+    for (uint16_t e = edgeStart[eventId]; e < edgeStart[eventId + 1]; e++) {
+        Pattern& pattern = patterns[edges[e].pattern];
+        if (!pattern.enabled) {
+            continue;
+        }
+        advances++;
+        if (advance(pattern, edges[e].steps, now)) {
+            matched.set(edges[e].pattern);
+            matchedCount++;
+        }
+    }
+    return matchedCount;
+}
+
+uint8_t PatternAutomaton::onEvent(StringView name, uint32_t now, EventSet& matched) {
+    return onEvent(names->find(name), now, matched);
+}
+
+uint32_t PatternAutomaton::replay(const PatternEvent* log, uint32_t count, PatternMatchFn onMatch, void* context) {
+    uint32_t total = 0;
+    EventSet matched;
+    for (uint32_t i = 0; i < count; i++) {
+        if (onEvent(log[i].id, log[i].time, matched) == 0) {
+            continue;
+        }
+        for (uint8_t p = matched.next(0); p != EVENT_ID_NONE; p = matched.next(p + 1)) {
+            total++;
+            if (onMatch) {
+                onMatch(p, i, context);
+            }
+        }
+    }
+    return total;
+}
+
+uint8_t PatternAutomaton::getProgress(uint8_t pattern) const {
+    if (pattern >= patternCount) {
+        return 0;
+    }
+    uint8_t progress = 0;
+    for (uint16_t bits = patterns[pattern].reached; bits; bits >>= 1) {
+        progress++;
+    }
+    return progress;
+}
@@ -0,0 +1,124 @@
+#ifndef PATTERN_AUTOMATON_H
+#define PATTERN_AUTOMATON_H
+
+#include <stdint.h>
+#include "event_correlator.h"
+
+// Incremental matching of EventPattern sequences on interned event IDs.
+//
+// All patterns are compiled into one automaton. Its states are the pattern
+// steps, held back to back in a shared step pool, and its transitions are
+// indexed by event ID: edges[edgeStart[id]..edgeStart[id + 1]) lists every
+// pattern that event appears in, with a mask of the steps it occupies. An
+// event follows only its own edges, so patterns that do not mention it cost
+// nothing.
+//
+// Each pattern keeps its NFA state as a bit mask, bit k meaning "steps 0..k
+// matched, step k last" (shift-and). Advancing a pattern is
+//
+//     next = ((reached << 1) | 1) & steps
+//
+// which tracks every partial match at once, so repeated steps (A, A, B)
+// need no backtracking. Time windows are checked only for the bits that
+// survive. The window of step k is measured from the most recent time step
+// k - 1 was reached:
+//   minDelay  at least this many ms after step k - 1
+//   maxDelay  at most this many ms after step k - 1 (0: no limit)
+//
+// A contiguous pattern must see its steps as consecutive events (any other
+// event in between breaks the run); otherwise other events may interleave.
+// A completed match resets the pattern, so matches do not overlap.
+//
+// Event names come from an EventInterner shared with EventCorrelator, so a
+// name both use is stored once. Names the other user interned simply have
+// no edges here. The tables take about 2.7 KB, sized for 32 patterns of
+// four steps on average.
+
+static const uint8_t PATTERN_MAX = 32;          // MAX_EVENT_PATTERNS
+static const uint8_t PATTERN_STEPS_MAX = 16;    // Steps per pattern (one mask bit each)
+static const uint16_t PATTERN_STEP_POOL = 128;  // Steps across all patterns
+static const uint16_t PATTERN_EDGE_MAX = 128;   // (event, pattern) pairs
+
+struct PatternSpec {
+    const StringView* steps;
+    uint8_t stepCount;
+    const uint32_t* minDelay;       // stepCount entries, [0] unused; NULL: none
+    const uint32_t* maxDelay;       // Same layout
+    bool contiguous;
+};
+
+// Logged event for replay
+struct PatternEvent {
+    uint8_t id;                     // From findEvent
+    uint32_t time;
+};
+
+typedef void (*PatternMatchFn)(uint8_t pattern, uint32_t logIndex, void* context);
+
+class PatternAutomaton {
+private:
+    struct Pattern {
+        uint16_t firstStep;         // Into the step pool
+        uint8_t length;
+        uint16_t reached;           // Shift-and state
+        uint16_t timed;             // Steps with a window
+        uint32_t lastSequence;      // Event count when last advanced
+        bool contiguous;
+        bool enabled;
+    };
+
+    struct Edge {
+        uint8_t pattern;
+        uint16_t steps;             // Steps of pattern this event occupies
+    };
+
+    EventInterner* names;           // Shared, owned by the caller
+    Pattern patterns[PATTERN_MAX];
+    uint8_t patternCount;
+
+    // Step pool
+    uint32_t stepTime[PATTERN_STEP_POOL];
+    uint32_t minDelay[PATTERN_STEP_POOL];
+    uint32_t maxDelay[PATTERN_STEP_POOL];
+    uint16_t stepCount;
+
+    // Transitions, grouped by event ID
+    Edge edges[PATTERN_EDGE_MAX];
+    uint16_t edgeStart[EVENT_ID_MAX + 1];
+    uint16_t edgeCount;
+
+    uint32_t sequence;              // Events seen, for contiguity
+    uint32_t advances;              // Pattern advances, for tuning
+
+    bool insertEdge(uint8_t id, uint8_t pattern, uint16_t steps);
+    bool advance(Pattern& pattern, uint16_t steps, uint32_t now);
+
+public:
+    explicit PatternAutomaton(EventInterner& eventNames);
+
+    // Interns the steps and links them in; returns the pattern index, or
+    // EVENT_ID_NONE when patterns, steps, edges or names run out (the
+    // pattern is not added)
+    uint8_t addPattern(const PatternSpec& spec);
+    bool enablePattern(uint8_t pattern, bool enable);
+    // Drops the patterns; the shared names stay
+    void clear();
+    // Drops partial matches (patterns stay)
+    void resetState();
+
+    // Advances the patterns this event appears in and fills matched with
+    // the ones it completes; returns how many completed
+    uint8_t onEvent(uint8_t eventId, uint32_t now, EventSet& matched);
+    uint8_t onEvent(StringView name, uint32_t now, EventSet& matched);
+
+    // Feeds a log of pre-interned events straight through; returns the
+    // number of matches. onMatch may be NULL.
+    uint32_t replay(const PatternEvent* log, uint32_t count, PatternMatchFn onMatch, void* context);
+
+    uint8_t findEvent(StringView name) const { return names->find(name); }
+    uint8_t getPatternCount() const { return patternCount; }
+    uint8_t getProgress(uint8_t pattern) const;     // Longest partial match, in steps
+    uint32_t getAdvances() const { return advances; }
+};
+
+#endif // PATTERN_AUTOMATON_H
@@ -0,0 +1,369 @@
+#include "singular_values.h"
+
+// Setup, type registration, validation, slot management, value generation,
+// reservation, locking and expiry. The remaining operations are implemented
+// against these helpers.
+
+// Error flag definitions
+#define ERROR_TABLE_FULL            0x01
+#define ERROR_VALUES_EXHAUSTED      0x02
+#define ERROR_UNKNOWN_TYPE          0x04
+#define ERROR_TYPE_TABLE_FULL       0x08
+#define ERROR_RULE_TABLE_FULL       0x10
+
+SingularValues::SingularValues()
+    : valueCount(0),
+      typeCount(0),
+      ruleCount(0),
+      config(),
+      lastCleanupTime(0),
+      lastLogTime(0),
+      errorFlags(0) {
+    for (uint16_t slot = 0; slot < MAX_SINGULAR_VALUES; slot++) {
+        values[slot].value = 0;
+        values[slot].status = SingularValueStatus::AVAILABLE;
+        values[slot].expirationTime = 0;
+    }
+}
+
+SingularValues::~SingularValues() {
+}
+
+bool SingularValues::initialize(const SingularValuesConfig& newConfig) {
+    config = newConfig;
+    for (uint16_t slot = 0; slot < MAX_SINGULAR_VALUES; slot++) {
+        if (values[slot].status != SingularValueStatus::AVAILABLE) {
+            freeSlot(slot);
+        }
+    }
+    typeCount = 0;
+    ruleCount = 0;
+    errorFlags = 0;
+    lastError = "";
+    lastCleanupTime = millis();
+    lastLogTime = lastCleanupTime;
+    return true;
+}
+
+uint16_t SingularValues::findTypeIndex(SingularValueType type) const {
+    for (uint16_t i = 0; i < typeCount; i++) {
+        if (typeRegistry[i] == type) {
+            return i;
+        }
+    }
+    return typeCount;
+}
+
+bool SingularValues::registerValueType(SingularValueType type, const String& description,
+                                       uint32_t startValue, uint32_t endValue,
+                                       uint16_t increment, bool circular) {
+    (void)description;
+    if (startValue > endValue || increment == 0) {
+        lastError = "Invalid value range";
+        return false;
+    }
+    uint16_t index = findTypeIndex(type);
+    if (index == typeCount) {
+        if (typeCount >= MAX_VALUE_TYPES) {
+            errorFlags |= ERROR_TYPE_TABLE_FULL;
+            lastError = "Value type table full";
+            return false;
+        }
+        typeRegistry[typeCount++] = type;
+    }
+
+    ValueGenerationConfig& generator = typeConfigs[index];
+    generator.startValue = startValue;
+    generator.endValue = endValue;
+    generator.currentValue = startValue;
+    generator.increment = increment;
+    generator.circular = circular;
+    generator.random = false;
+    generator.seed = 0;
+    generator.maxRetries = 16;
+    return true;
+}
+
+bool SingularValues::isValueTypeRegistered(SingularValueType type) const {
+    return findTypeIndex(type) < typeCount;
+}
+
+bool SingularValues::addValidationRule(const String& name, bool (*validator)(uint32_t value),
+                                       const String& errorMessage, uint8_t priority) {
+    if (validator == nullptr || findRuleIndex(name) < ruleCount) {
+        lastError = "Invalid or duplicate validation rule";
+        return false;
+    }
+    if (ruleCount >= MAX_VALIDATION_RULES) {
+        errorFlags |= ERROR_RULE_TABLE_FULL;
+        lastError = "Validation rule table full";
+        return false;
+    }
+    ValueValidationRule& rule = validationRules[ruleCount++];
+    rule.name = name;
+    rule.validator = validator;
+    rule.errorMessage = errorMessage;
+    rule.priority = priority;
+    rule.enabled = true;
+    return true;
+}
+
+uint16_t SingularValues::findRuleIndex(const String& ruleName) const {
+    for (uint16_t i = 0; i < ruleCount; i++) {
+        if (validationRules[i].name == ruleName) {
+            return i;
+        }
+    }
+    return ruleCount;
+}
+
+bool SingularValues::validateValue(uint32_t value, SingularValueType type) const {
+    (void)type;
+    for (uint16_t i = 0; i < ruleCount; i++) {
+        if (validationRules[i].enabled && !validationRules[i].validator(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint16_t SingularValues::findValueIndex(uint32_t value) const {
+    return valueIndex.find(value, [this](uint16_t slot) { return values[slot].value; });
+}
+
+uint16_t SingularValues::claimSlot(uint32_t value, SingularValueType type) {
+    uint16_t slot = freeSlots.acquire();
+    if (slot == ID_NONE) {
+        errorFlags |= ERROR_TABLE_FULL;
+        lastError = "Singular value table full";
+        return ID_NONE;
+    }
+
+    SingularValueMetadata& entry = values[slot];
+    entry.value = value;
+    entry.type = type;
+    entry.status = SingularValueStatus::IN_USE;
+    entry.description = "";
+    entry.owner = "";
+    entry.creationTime = millis();
+    entry.lastUsedTime = entry.creationTime;
+    entry.expirationTime = 0;
+    entry.useCount = 0;
+    entry.persistent = false;
+    entry.encrypted = false;
+    if (config.defaultExpiration > 0) {
+        entry.expirationTime = entry.creationTime + config.defaultExpiration;
+        expiries.schedule(slot, entry.expirationTime);
+    }
+
+    valueIndex.insert(value, slot);
+    valueCount++;
+    return slot;
+}
+
+void SingularValues::freeSlot(uint16_t slot) {
+    SingularValueMetadata& entry = values[slot];
+    valueIndex.erase(entry.value, [this](uint16_t other) { return values[other].value; });
+    expiries.cancel(slot);
+    entry.status = SingularValueStatus::AVAILABLE;
+    entry.description = "";
+    entry.owner = "";
+    entry.expirationTime = 0;
+    freeSlots.release(slot);
+    valueCount--;
+}
+
+uint32_t SingularValues::generateNextValue(SingularValueType type) {
+    uint16_t typeIndex = findTypeIndex(type);
+    if (typeIndex >= typeCount) {
+        errorFlags |= ERROR_UNKNOWN_TYPE;
+        lastError = "Value type not registered";
+        return 0;
+    }
+
+    // Each candidate costs one index probe; 0 is never handed out
+    ValueGenerationConfig& generator = typeConfigs[typeIndex];
+    for (uint16_t attempt = 0; attempt <= generator.maxRetries; attempt++) {
+        uint32_t candidate;
+        if (generator.random) {
+            uint32_t x = generator.seed ? generator.seed : 1;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            generator.seed = x;
+            uint32_t span = generator.endValue - generator.startValue;
+            candidate = generator.startValue + (span == 0xFFFFFFFFUL ? x : x % (span + 1));
+        } else {
+            candidate = generator.currentValue;
+            if (candidate < generator.startValue || candidate > generator.endValue) {
+                candidate = generator.startValue;
+            }
+            if (generator.endValue - candidate >= generator.increment) {
+                generator.currentValue = candidate + generator.increment;
+            } else if (generator.circular) {
+                generator.currentValue = generator.startValue;
+            }
+        }
+
+        if (candidate != 0 && findValueIndex(candidate) == ID_NONE &&
+            (!config.enableValidation || validateValue(candidate, type))) {
+            return candidate;
+        }
+    }
+
+    errorFlags |= ERROR_VALUES_EXHAUSTED;
+    lastError = "No free value for type";
+    return 0;
+}
+
+uint32_t SingularValues::generateValue(SingularValueType type, const String& description,
+                                       const String& owner) {
+    // A full table must not use up a value from the generator
+    if (freeSlots.getFreeCount() == 0) {
+        errorFlags |= ERROR_TABLE_FULL;
+        lastError = "Singular value table full";
+        return 0;
+    }
+    uint32_t value = generateNextValue(type);
+    if (value == 0) {
+        return 0;
+    }
+    uint16_t slot = claimSlot(value, type);
+    if (slot == ID_NONE) {
+        return 0;
+    }
+    values[slot].description = description;
+    values[slot].owner = owner;
+    return value;
+}
+
+uint32_t SingularValues::generateValue(SingularValueType type, uint32_t specificValue,
+                                       const String& description, const String& owner) {
+    if (specificValue == 0 || findValueIndex(specificValue) != ID_NONE) {
+        lastError = "Value already in use";
+        return 0;
+    }
+    uint16_t slot = claimSlot(specificValue, type);
+    if (slot == ID_NONE) {
+        return 0;
+    }
+    values[slot].description = description;
+    values[slot].owner = owner;
+    return specificValue;
+}
+
+bool SingularValues::reserveValue(uint32_t value, const String& owner) {
+    uint16_t slot = findValueIndex(value);
+    if (slot == ID_NONE) {
+        // Not handed out yet: enter it under the registered type whose
+        // range holds it, so generation skips it
+        uint16_t typeIndex = MAX_VALUE_TYPES;
+        SingularValueType type = SingularValueType::SYSTEM_ID;
+        for (uint8_t t = 0; t <= static_cast<uint8_t>(SingularValueType::NETWORK_ID); t++) {
+            uint16_t index = findTypeIndex(static_cast<SingularValueType>(t));
+            if (index < typeCount && value >= typeConfigs[index].startValue &&
+                value <= typeConfigs[index].endValue) {
+                typeIndex = index;
+                type = static_cast<SingularValueType>(t);
+                break;
+            }
+        }
+        if (value == 0 || typeIndex == MAX_VALUE_TYPES) {
+            lastError = "Value outside every registered type";
+            return false;
+        }
+        slot = claimSlot(value, type);
+        if (slot == ID_NONE) {
+            return false;
+        }
+    } else if (values[slot].status == SingularValueStatus::LOCKED ||
+               (values[slot].status == SingularValueStatus::RESERVED && values[slot].owner != owner)) {
+        lastError = "Value held by another owner";
+        return false;
+    }
+
+    values[slot].status = SingularValueStatus::RESERVED;
+    values[slot].owner = owner;
+    values[slot].lastUsedTime = millis();
+    return true;
+}
+
+bool SingularValues::lockValue(uint32_t value, const String& owner) {
+    if (!reserveValue(value, owner)) {
+        return false;
+    }
+    values[findValueIndex(value)].status = SingularValueStatus::LOCKED;
+    return true;
+}
+
+bool SingularValues::unlockValue(uint32_t value) {
+    uint16_t slot = findValueIndex(value);
+    if (slot == ID_NONE || values[slot].status != SingularValueStatus::LOCKED) {
+        return false;
+    }
+    values[slot].status = SingularValueStatus::RESERVED;
+    return true;
+}
+
+SingularValueStatus SingularValues::getValueStatus(uint32_t value) const {
+    uint16_t slot = findValueIndex(value);
+    return slot == ID_NONE ? SingularValueStatus::AVAILABLE : values[slot].status;
+}
+
+String SingularValues::getValueOwner(uint32_t value) const {
+    uint16_t slot = findValueIndex(value);
+    return slot == ID_NONE ? String("") : values[slot].owner;
+}
+
+bool SingularValues::releaseValue(uint32_t value) {
+    uint16_t slot = findValueIndex(value);
+    if (slot == ID_NONE || values[slot].status == SingularValueStatus::LOCKED) {
+        return false;
+    }
+    freeSlot(slot);
+    return true;
+}
+
+bool SingularValues::setValueExpiration(uint32_t value, unsigned long expirationTime) {
+    uint16_t slot = findValueIndex(value);
+    if (slot == ID_NONE) {
+        return false;
+    }
+    values[slot].expirationTime = expirationTime;
+    if (expirationTime == 0) {
+        expiries.cancel(slot);
+    } else {
+        expiries.schedule(slot, expirationTime);
+    }
+    return true;
+}
+
+bool SingularValues::extendValueExpiration(uint32_t value, unsigned long additionalTime) {
+    uint16_t slot = findValueIndex(value);
+    if (slot == ID_NONE) {
+        return false;
+    }
+    unsigned long from = values[slot].expirationTime ? values[slot].expirationTime : millis();
+    return setValueExpiration(value, from + additionalTime);
+}
+
+bool SingularValues::removeValueExpiration(uint32_t value) {
+    return setValueExpiration(value, 0);
+}
+
+bool SingularValues::cleanupExpiredValues() {
+    // Only values that are due come off the heap
+    unsigned long now = millis();
+    bool released = false;
+    uint16_t slot;
+    while (expiries.popDue(now, slot)) {
+        if (values[slot].status == SingularValueStatus::LOCKED) {
+            values[slot].expirationTime = 0;    // A lock outlives the expiry
+            continue;
+        }
+        freeSlot(slot);
+        released = true;
+    }
+    lastCleanupTime = now;
+    return released;
+}
@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include "../application_data_types/numeric_types.h"
+#include "../application_data_types/fixed_string.h"
+#include "../software_utility/id_allocator.h"
 
 // Value types for singular values
 enum class SingularValueType {
@@ -59,7 +61,7 @@ struct ValueGenerationConfig {
 struct ValueValidationRule {
     String name;
     bool (*validator)(uint32_t value);
-    String errorMessage;
+    ErrorText errorMessage;
     uint8_t priority;
     bool enabled;
 };
@@ -78,16 +80,29 @@ struct SingularValuesConfig {
 
 class SingularValues {
 private:
-    static const uint16_t MAX_SINGULAR_VALUES = 1024;
+    // Sized for the Mega's 8 KB of SRAM. A metadata entry is about 30 B
+    // on AVR, so 64 slots take about 2 KB and their indexes under 1 KB
+    // (heap ~512 B, value index 256 B, bitmap 14 B).
+    static const uint16_t MAX_SINGULAR_VALUES = 64;
+    static const uint16_t MAX_INDEX_BYTES = 1024;
     static const uint16_t MAX_VALUE_TYPES = 32;
     static const uint16_t MAX_VALIDATION_RULES = 64;
     
-    // Value storage
+    // Value storage. Slots are handed out by freeSlots and found by value
+    // through valueIndex; expiring values sit in expiries by due time, so
+    // no operation scans the table.
     SingularValueMetadata values[MAX_SINGULAR_VALUES];
     uint16_t valueCount;
-    
-    // Type configurations
+    IdBitmap<MAX_SINGULAR_VALUES> freeSlots;
+    ValueIndex<MAX_SINGULAR_VALUES> valueIndex;
+    ExpiryHeap<MAX_SINGULAR_VALUES> expiries;
+    static_assert(sizeof(IdBitmap<MAX_SINGULAR_VALUES>) + sizeof(ValueIndex<MAX_SINGULAR_VALUES>) +
+                  sizeof(ExpiryHeap<MAX_SINGULAR_VALUES>) <= MAX_INDEX_BYTES,
+                  "SingularValues indexes exceed their SRAM budget");
+    
+    // Type configurations; typeRegistry[i] is the type typeConfigs[i] generates
     ValueGenerationConfig typeConfigs[MAX_VALUE_TYPES];
+    SingularValueType typeRegistry[MAX_VALUE_TYPES];
     uint16_t typeCount;
     
     // Validation rules
@@ -103,16 +118,17 @@ private:
     
     // Error tracking
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Helper methods
-    uint16_t findValueIndex(uint32_t value) const;
+    uint16_t findValueIndex(uint32_t value) const;     // ID_NONE if not in the table
+    uint16_t claimSlot(uint32_t value, SingularValueType type);
+    void freeSlot(uint16_t slot);
     uint16_t findTypeIndex(SingularValueType type) const;
     uint16_t findRuleIndex(const String& ruleName) const;
     bool validateValue(uint32_t value, SingularValueType type) const;
     uint32_t generateNextValue(SingularValueType type);
     bool isValueExpired(const SingularValueMetadata& metadata) const;
-    void cleanupExpiredValues();
     bool persistValue(const SingularValueMetadata& metadata);
     bool loadPersistedValue(SingularValueMetadata& metadata);
     void logValueOperation(const String& operation, uint32_t value, const String& details);
@@ -201,7 +217,7 @@ public:
     // Status and monitoring
     bool isHealthy() const;
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Utility methods
@@ -213,7 +229,7 @@ public:
     void printStatistics();
     
     // Cleanup and maintenance
-    bool cleanupExpiredValues();
+    bool cleanupExpiredValues();        // Releases values whose expiration has passed
     bool cleanupUnusedValues(uint16_t maxAge);
     bool defragmentValueSpace();
     bool validateAllValues();
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../application_data_types/numeric_types.h"
 #include "../software_utility/numerical_algorithms.h"
+#include "../application_data_types/fixed_string.h"
 
 // Flight regimes
 enum class FlightRegime {
@@ -206,7 +207,7 @@ private:
     
     // Error tracking
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
     
     // Helper methods
     void updateAtmosphericModel(float altitude);
@@ -321,7 +322,7 @@ public:
     // Status and monitoring
     bool isHealthy() const;
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // Utility methods
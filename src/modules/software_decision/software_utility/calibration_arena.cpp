@@ -0,0 +1,44 @@
+#include "calibration_arena.h"
+#include <string.h>
+
+static_assert(CALIBRATION_ARENA_CHANNELS <= 255, "Channel leases are counted in uint8_t");
+
+CalibrationArena calibrationArena;
+
+CalibrationArena::CalibrationArena() : owner(nullptr), leasedBytes(0), highWater(0) {
+}
+
+void* CalibrationArena::lease(const void* requester, uint16_t bytes) {
+    if (requester == nullptr || bytes > CALIBRATION_ARENA_SIZE) {
+        return nullptr;
+    }
+    if (owner != nullptr && owner != requester) {
+        return nullptr;
+    }
+    owner = requester;
+    leasedBytes = bytes;
+    if (bytes > highWater) {
+        highWater = bytes;
+    }
+    memset(storage.bytes, 0, bytes);
+    return storage.bytes;
+}
+
+void CalibrationArena::release(const void* requester) {
+    if (owner == requester) {
+        owner = nullptr;
+        leasedBytes = 0;
+    }
+}
+
+CalibrationStats* CalibrationArena::leaseStats(const void* requester, uint8_t dimensions) {
+    CalibrationStats* stats = static_cast<CalibrationStats*>(lease(requester, sizeof(CalibrationStats)));
+    if (stats) {
+        stats->begin(dimensions);
+    }
+    return stats;
+}
+
+ChannelStats* CalibrationArena::leaseChannels(const void* requester, uint8_t channels) {
+    return static_cast<ChannelStats*>(lease(requester, (uint16_t)(sizeof(ChannelStats) * channels)));
+}
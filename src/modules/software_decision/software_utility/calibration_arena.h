@@ -0,0 +1,96 @@
+#ifndef CALIBRATION_ARENA_H
+#define CALIBRATION_ARENA_H
+
+#include <stdint.h>
+
+// Shared calibration scratch space.
+//
+// Calibration runs on the ground, one module at a time, so modules no longer
+// keep their own sample tables. A module leases the arena when it starts
+// calibrating and releases it when done; a second module asking while the
+// arena is leased gets nullptr and must retry later. The arena holds
+// streaming accumulators instead of raw samples:
+//
+//   CalibrationStats  one sample vector of up to CALIBRATION_MAX_DIMS values,
+//                     with running mean, covariance, minimum and maximum
+//   ChannelStats      one scalar per channel, for IO channel calibration
+//
+// Both use Welford's update in float (double is float on AVR anyway). Values
+// are accumulated relative to the first sample so that large offsets such
+// as latitude do not swamp the spread being measured.
+
+#ifndef CALIBRATION_ARENA_CHANNELS
+#define CALIBRATION_ARENA_CHANNELS 64   // Largest channel lease (panel IO)
+#endif
+
+static const uint8_t CALIBRATION_MAX_DIMS = 6;
+
+struct CalibrationStats {
+    uint16_t count;
+    uint8_t dims;
+    float origin[CALIBRATION_MAX_DIMS];    // First sample
+    float mean[CALIBRATION_MAX_DIMS];      // Relative to origin
+    float minimum[CALIBRATION_MAX_DIMS];
+    float maximum[CALIBRATION_MAX_DIMS];
+    float comoment[CALIBRATION_MAX_DIMS * (CALIBRATION_MAX_DIMS + 1) / 2];  // Upper triangle
+
+    void begin(uint8_t dimensions);
+    void add(const float* sample);
+    void add(float a, float b, float c, float d, float e, float f);
+
+    float getMean(uint8_t dim) const;
+    float getVariance(uint8_t dim) const;
+    float getCovariance(uint8_t row, uint8_t col) const;
+    float getStdDev(uint8_t dim) const;
+};
+
+struct ChannelStats {
+    uint16_t count;
+    float origin;
+    float mean;       // Relative to origin
+    float m2;
+    float minimum;
+    float maximum;
+
+    void add(float value);
+    float getMean() const { return origin + mean; }
+    float getVariance() const { return count > 1 ? m2 / (count - 1) : 0.0f; }
+};
+
+// The arena is sized for whichever lease is larger (1408 bytes on AVR)
+static const uint16_t CALIBRATION_ARENA_SIZE =
+    sizeof(ChannelStats) * CALIBRATION_ARENA_CHANNELS > sizeof(CalibrationStats)
+        ? sizeof(ChannelStats) * CALIBRATION_ARENA_CHANNELS
+        : sizeof(CalibrationStats);
+
+class CalibrationArena {
+private:
+    union {
+        uint8_t bytes[CALIBRATION_ARENA_SIZE];
+        float alignment;
+    } storage;
+    const void* owner;
+    uint16_t leasedBytes;
+    uint16_t highWater;
+
+public:
+    CalibrationArena();
+
+    // Zeroed scratch for requester, or nullptr if another owner holds the
+    // arena or the request does not fit. The current owner may re-lease.
+    void* lease(const void* requester, uint16_t bytes);
+    void release(const void* requester);
+
+    CalibrationStats* leaseStats(const void* requester, uint8_t dimensions);
+    ChannelStats* leaseChannels(const void* requester, uint8_t channels);
+
+    bool isLeased() const { return owner != nullptr; }
+    bool isOwner(const void* requester) const { return owner == requester; }
+    uint16_t getLeasedBytes() const { return leasedBytes; }
+    uint16_t getHighWater() const { return highWater; }
+    static uint16_t getCapacity() { return CALIBRATION_ARENA_SIZE; }
+};
+
+extern CalibrationArena calibrationArena;
+
+#endif // CALIBRATION_ARENA_H
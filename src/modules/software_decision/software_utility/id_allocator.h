@@ -0,0 +1,292 @@
+#ifndef ID_ALLOCATOR_H
+#define ID_ALLOCATOR_H
+
+#include <stdint.h>
+
+// Fixed-capacity index structures for tables addressed by slot number.
+//
+// IdBitmap hands out free slot numbers. A set bit marks a free slot; a
+// summary word has one bit per 32-slot word that still has a free slot,
+// so the lowest free slot is two count-trailing-zeros away for up to
+// 1024 slots, with no scan.
+//
+// ExpiryHeap is a binary min-heap of (due time, slot) with a slot -> heap
+// position map, so scheduling, rescheduling and cancelling are O(log n) and
+// the next expiry is at the top. Times compare wrap-aware, like millis();
+// due times must lie within 2^31 ms of each other.
+//
+// ValueIndex maps an external 32-bit value to its slot with linear probing
+// in a power-of-two table at most half full. It stores only slot numbers;
+// the caller supplies the slot -> value lookup, so the value lives once, in
+// the caller's table. Erase shifts entries back instead of leaving
+// tombstones, so probe lengths stay short under churn.
+
+static const uint16_t ID_NONE = 0xFFFF;
+
+inline uint8_t lowestSetBit(uint32_t word) {
+    return (uint8_t)__builtin_ctzl(word);
+}
+
+template <uint16_t N>
+class IdBitmap {
+private:
+    static const uint16_t WORDS = (N + 31) / 32;
+    static_assert(N > 0 && WORDS <= 32, "IdBitmap holds 1 to 1024 ids");
+
+    uint32_t summary;           // Bit w: words[w] has a free id
+    uint32_t words[WORDS];      // Bit b: id 32 * w + b is free
+    uint16_t freeCount;
+
+    void take(uint16_t id) {
+        uint8_t w = id >> 5;
+        words[w] &= ~(1UL << (id & 31));
+        if (words[w] == 0) {
+            summary &= ~(1UL << w);
+        }
+        freeCount--;
+    }
+
+public:
+    IdBitmap() { reset(); }
+
+    void reset() {
+        summary = 0;
+        for (uint8_t w = 0; w < WORDS; w++) {
+            uint16_t remaining = N - w * 32;
+            words[w] = remaining >= 32 ? 0xFFFFFFFFUL : (1UL << remaining) - 1;
+            summary |= 1UL << w;
+        }
+        freeCount = N;
+    }
+
+    // Lowest free id, or ID_NONE when full
+    uint16_t acquire() {
+        if (summary == 0) {
+            return ID_NONE;
+        }
+        uint8_t w = lowestSetBit(summary);
+        uint16_t id = (uint16_t)w * 32 + lowestSetBit(words[w]);
+        take(id);
+        return id;
+    }
+
+    // Claims a specific id; false if it is taken or out of range
+    bool acquire(uint16_t id) {
+        if (!isFree(id)) {
+            return false;
+        }
+        take(id);
+        return true;
+    }
+
+    bool release(uint16_t id) {
+        if (id >= N || isFree(id)) {
+            return false;
+        }
+        words[id >> 5] |= 1UL << (id & 31);
+        summary |= 1UL << (id >> 5);
+        freeCount++;
+        return true;
+    }
+
+    bool isFree(uint16_t id) const {
+        return id < N && (words[id >> 5] & (1UL << (id & 31)));
+    }
+    uint16_t getFreeCount() const { return freeCount; }
+    uint16_t getUsedCount() const { return N - freeCount; }
+};
+
+template <uint16_t N>
+class ExpiryHeap {
+private:
+    struct Entry {
+        uint32_t due;
+        uint16_t id;
+    };
+
+    Entry heap[N];
+    uint16_t position[N];       // id -> heap index, ID_NONE if not scheduled
+    uint16_t count;
+
+    static bool earlier(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+    void place(uint16_t index, const Entry& entry) {
+        heap[index] = entry;
+        position[entry.id] = index;
+    }
+
+    void siftUp(uint16_t index) {
+        Entry entry = heap[index];
+        while (index > 0) {
+            uint16_t parent = (index - 1) / 2;
+            if (!earlier(entry.due, heap[parent].due)) {
+                break;
+            }
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, entry);
+    }
+
+    void siftDown(uint16_t index) {
+        Entry entry = heap[index];
+        for (;;) {
+            uint16_t child = 2 * index + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && earlier(heap[child + 1].due, heap[child].due)) {
+                child++;
+            }
+            if (!earlier(heap[child].due, entry.due)) {
+                break;
+            }
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, entry);
+    }
+
+    void removeAt(uint16_t index) {
+        position[heap[index].id] = ID_NONE;
+        if (--count == index) {
+            return;
+        }
+        Entry last = heap[count];
+        place(index, last);
+        siftUp(index);
+        siftDown(position[last.id]);
+    }
+
+public:
+    ExpiryHeap() : count(0) {
+        for (uint16_t id = 0; id < N; id++) {
+            position[id] = ID_NONE;
+        }
+    }
+
+    // Adds id or moves it to a new due time
+    void schedule(uint16_t id, uint32_t due) {
+        if (id >= N) {
+            return;
+        }
+        uint16_t index = position[id];
+        if (index == ID_NONE) {
+            index = count++;
+            place(index, Entry{ due, id });
+            siftUp(index);
+            return;
+        }
+        bool sooner = earlier(due, heap[index].due);
+        heap[index].due = due;
+        if (sooner) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+    bool cancel(uint16_t id) {
+        if (id >= N || position[id] == ID_NONE) {
+            return false;
+        }
+        removeAt(position[id]);
+        return true;
+    }
+
+    // Removes and returns the earliest id due at or before now
+    bool popDue(uint32_t now, uint16_t& id) {
+        if (count == 0 || earlier(now, heap[0].due)) {
+            return false;
+        }
+        id = heap[0].id;
+        removeAt(0);
+        return true;
+    }
+
+    bool isScheduled(uint16_t id) const { return id < N && position[id] != ID_NONE; }
+    uint32_t getDue(uint16_t id) const { return isScheduled(id) ? heap[position[id]].due : 0; }
+    bool peek(uint16_t& id, uint32_t& due) const {
+        if (count == 0) {
+            return false;
+        }
+        id = heap[0].id;
+        due = heap[0].due;
+        return true;
+    }
+    uint16_t getCount() const { return count; }
+};
+
+// Smallest power of two >= n
+constexpr uint16_t idTableSize(uint16_t n, uint16_t size) {
+    return size >= n ? size : idTableSize(n, size * 2);
+}
+
+template <uint16_t N>
+class ValueIndex {
+private:
+    static const uint16_t SIZE = idTableSize(2 * N, 2);
+    static const uint16_t MASK = SIZE - 1;
+
+    uint16_t table[SIZE];       // slot + 1; 0 is empty
+
+    static uint16_t home(uint32_t value) {
+        return (uint16_t)((value * 2654435761UL) >> 16) & MASK;
+    }
+
+    template <typename KeyOf>
+    uint16_t locate(uint32_t value, KeyOf keyOf) const {
+        for (uint16_t i = home(value);; i = (i + 1) & MASK) {
+            if (table[i] == 0 || keyOf(table[i] - 1) == value) {
+                return i;
+            }
+        }
+    }
+
+public:
+    ValueIndex() { clear(); }
+
+    void clear() {
+        for (uint16_t i = 0; i < SIZE; i++) {
+            table[i] = 0;
+        }
+    }
+
+    // keyOf(slot) returns the value currently stored in slot
+    template <typename KeyOf>
+    uint16_t find(uint32_t value, KeyOf keyOf) const {
+        uint16_t i = locate(value, keyOf);
+        return table[i] == 0 ? ID_NONE : table[i] - 1;
+    }
+
+    // value must not be indexed yet
+    void insert(uint32_t value, uint16_t slot) {
+        uint16_t i = home(value);
+        while (table[i] != 0) {
+            i = (i + 1) & MASK;
+        }
+        table[i] = slot + 1;
+    }
+
+    template <typename KeyOf>
+    bool erase(uint32_t value, KeyOf keyOf) {
+        uint16_t hole = locate(value, keyOf);
+        if (table[hole] == 0) {
+            return false;
+        }
+        // Pull back every later entry of the run whose home is not
+        // between the hole and its current position
+        for (uint16_t i = (hole + 1) & MASK; table[i] != 0; i = (i + 1) & MASK) {
+            uint16_t target = home(keyOf(table[i] - 1));
+            bool stays = hole <= i ? (hole < target && target <= i) : (hole < target || target <= i);
+            if (!stays) {
+                table[hole] = table[i];
+                hole = i;
+            }
+        }
+        table[hole] = 0;
+        return true;
+    }
+};
+
+#endif // ID_ALLOCATOR_H
@@ -0,0 +1,300 @@
+#include "mag_calibrator.h"
+#include <math.h>
+#include <string.h>
+
+// Index of (row, col), row <= col, in the packed upper triangle
+static uint8_t triangleIndex(uint8_t row, uint8_t col) {
+    return row * MAG_CAL_PARAMS - (row * (row - 1)) / 2 + (col - row);
+}
+
+MagCalibrator::MagCalibrator() {
+    begin(1.0f);
+}
+
+void MagCalibrator::begin(float fieldScale, float forgettingFactor) {
+    scale = fieldScale > 0.0f ? fieldScale : 1.0f;
+    forgetting = forgettingFactor;
+    memset(info, 0, sizeof(info));
+    memset(rhs, 0, sizeof(rhs));
+    sumSquares = 0.0f;
+    weight = 0.0f;
+    samples = 0;
+
+    // Until the data says otherwise: a unit sphere at the origin
+    for (uint8_t i = 0; i < MAG_CAL_PARAMS; i++) {
+        prior[i] = i < 3 ? 1.0f : 0.0f;
+    }
+    addPrior(MAG_CAL_PRIOR);
+
+    memset(center, 0, sizeof(center));
+    memset(softIron, 0, sizeof(softIron));
+    softIron[0] = softIron[4] = softIron[8] = 1.0f;
+    radius = scale;
+    valid = false;
+    converged = false;
+    residual = 0.0f;
+    condition = 0.0f;
+}
+
+void MagCalibrator::addPrior(float amount) {
+    for (uint8_t i = 0; i < MAG_CAL_PARAMS; i++) {
+        info[triangleIndex(i, i)] += amount;
+        rhs[i] += amount * prior[i];
+        sumSquares += amount * prior[i] * prior[i];
+    }
+}
+
+void MagCalibrator::addSample(float x, float y, float z) {
+    x /= scale;
+    y /= scale;
+    z /= scale;
+    const float phi[MAG_CAL_PARAMS] = {
+        x * x, y * y, z * z,
+        2.0f * x * y, 2.0f * x * z, 2.0f * y * z,
+        2.0f * x, 2.0f * y, 2.0f * z
+    };
+
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < MAG_CAL_PARAMS; i++) {
+        for (uint8_t j = i; j < MAG_CAL_PARAMS; j++) {
+            info[k] = forgetting * info[k] + phi[i] * phi[j];
+            k++;
+        }
+        rhs[i] = forgetting * rhs[i] + phi[i];
+    }
+    sumSquares = forgetting * sumSquares + 1.0f;
+    weight = forgetting * weight + 1.0f;
+    // Top the prior back up to what was forgotten of it
+    addPrior((1.0f - forgetting) * MAG_CAL_PRIOR);
+    samples++;
+}
+
+MagCalResult MagCalibrator::solve() {
+    condition = 0.0f;
+    if (samples < MAG_CAL_MIN_SAMPLES) {
+        return MagCalResult::COLLECTING;
+    }
+
+    // info = R'R, R upper triangular. The smallest pivot against the
+    // largest diagonal says how well the least-excited direction is known.
+    float factor[MAG_CAL_PACKED];
+    float largest = 0.0f;
+    float smallest = 0.0f;
+    for (uint8_t j = 0; j < MAG_CAL_PARAMS; j++) {
+        float diagonal = info[triangleIndex(j, j)];
+        if (diagonal > largest) {
+            largest = diagonal;
+        }
+        float pivot = diagonal;
+        for (uint8_t k = 0; k < j; k++) {
+            float r = factor[triangleIndex(k, j)];
+            pivot -= r * r;
+        }
+        if (pivot <= 0.0f) {
+            return MagCalResult::COLLECTING;
+        }
+        if (j == 0 || pivot < smallest) {
+            smallest = pivot;
+        }
+        float root = sqrt(pivot);
+        factor[triangleIndex(j, j)] = root;
+        for (uint8_t i = j + 1; i < MAG_CAL_PARAMS; i++) {
+            float sum = info[triangleIndex(j, i)];
+            for (uint8_t k = 0; k < j; k++) {
+                sum -= factor[triangleIndex(k, j)] * factor[triangleIndex(k, i)];
+            }
+            factor[triangleIndex(j, i)] = sum / root;
+        }
+    }
+    condition = smallest / largest;
+
+    // R'z = rhs, then R theta = z
+    float theta[MAG_CAL_PARAMS];
+    for (uint8_t i = 0; i < MAG_CAL_PARAMS; i++) {
+        float sum = rhs[i];
+        for (uint8_t k = 0; k < i; k++) {
+            sum -= factor[triangleIndex(k, i)] * theta[k];
+        }
+        theta[i] = sum / factor[triangleIndex(i, i)];
+    }
+    for (int8_t i = MAG_CAL_PARAMS - 1; i >= 0; i--) {
+        float sum = theta[i];
+        for (uint8_t k = i + 1; k < MAG_CAL_PARAMS; k++) {
+            sum -= factor[triangleIndex(i, k)] * theta[k];
+        }
+        theta[i] = sum / factor[triangleIndex(i, i)];
+    }
+
+    // Residual sum of squares from the sums alone: at the optimum
+    // sum (1 - phi'theta)^2 = sum 1 - theta'rhs
+    float squares = sumSquares;
+    for (uint8_t i = 0; i < MAG_CAL_PARAMS; i++) {
+        squares -= theta[i] * rhs[i];
+    }
+    float algebraic = sqrt((squares > 0.0f ? squares : 0.0f) / weight);
+    residual = 0.0f;
+
+    if (condition < MAG_CAL_MIN_CONDITION) {
+        return MagCalResult::COLLECTING;
+    }
+
+    float fitCenter[3];
+    float fitSoftIron[9];
+    float fitRadius;
+    float k;
+    if (!extract(theta, fitCenter, fitSoftIron, fitRadius, k)) {
+        return MagCalResult::NOT_ELLIPSOID;
+    }
+    // A reading off the surface by a fraction e misses the quadric by
+    // about 2ke, so this is the RMS error in field strength
+    residual = algebraic / (2.0f * k);
+    if (residual > MAG_CAL_RESIDUAL_OK) {
+        return MagCalResult::POOR_FIT;
+    }
+
+    memcpy(center, fitCenter, sizeof(center));
+    memcpy(softIron, fitSoftIron, sizeof(softIron));
+    radius = fitRadius;
+    memcpy(prior, theta, sizeof(prior));
+    valid = true;
+    if (!converged) {
+        converged = true;
+        return MagCalResult::CONVERGED;
+    }
+    return MagCalResult::FITTED;
+}
+
+bool MagCalibrator::extract(const float* theta, float* fitCenter, float* fitSoftIron, float& fitRadius, float& k) const {
+    const float a[9] = {
+        theta[0], theta[3], theta[4],
+        theta[3], theta[1], theta[5],
+        theta[4], theta[5], theta[2]
+    };
+
+    // Centre: A c = -[g h i]
+    float cofactor[9] = {
+        a[4] * a[8] - a[5] * a[7], a[2] * a[7] - a[1] * a[8], a[1] * a[5] - a[2] * a[4],
+        a[5] * a[6] - a[3] * a[8], a[0] * a[8] - a[2] * a[6], a[2] * a[3] - a[0] * a[5],
+        a[3] * a[7] - a[4] * a[6], a[1] * a[6] - a[0] * a[7], a[0] * a[4] - a[1] * a[3]
+    };
+    float det = a[0] * cofactor[0] + a[1] * cofactor[3] + a[2] * cofactor[6];
+    if (fabs(det) < 1e-12f) {
+        return false;
+    }
+    float c[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        c[i] = -(cofactor[i * 3] * theta[6] + cofactor[i * 3 + 1] * theta[7] + cofactor[i * 3 + 2] * theta[8]) / det;
+    }
+
+    // Centred, (x - c)' A (x - c) = k
+    k = 1.0f;
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            k += c[i] * a[i * 3 + j] * c[j];
+        }
+    }
+    if (k <= 0.0f) {
+        return false;
+    }
+
+    float shape[9];
+    for (uint8_t i = 0; i < 9; i++) {
+        shape[i] = a[i] / k;
+    }
+    float values[3];
+    float vectors[9];
+    symmetricEigen3(shape, values, vectors);
+    float lowest = values[0];
+    float highest = values[0];
+    for (uint8_t i = 1; i < 3; i++) {
+        lowest = values[i] < lowest ? values[i] : lowest;
+        highest = values[i] > highest ? values[i] : highest;
+    }
+    // Semi-axes are 1/sqrt(value)
+    if (lowest <= 0.0f || highest > lowest * MAG_CAL_MAX_AXIS_RATIO * MAG_CAL_MAX_AXIS_RATIO) {
+        return false;
+    }
+
+    // Geometric mean of the semi-axes keeps the ellipsoid's volume
+    float meanRadius = pow(values[0] * values[1] * values[2], -1.0f / 6.0f);
+    float gain[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        gain[i] = sqrt(values[i]) * meanRadius;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            float sum = 0.0f;
+            for (uint8_t e = 0; e < 3; e++) {
+                sum += vectors[i * 3 + e] * gain[e] * vectors[j * 3 + e];
+            }
+            fitSoftIron[i * 3 + j] = sum;
+        }
+        fitCenter[i] = c[i] * scale;
+    }
+    fitRadius = meanRadius * scale;
+    return true;
+}
+
+void MagCalibrator::correct(const float* raw, float* corrected) const {
+    if (!valid) {
+        if (corrected != raw) {
+            memcpy(corrected, raw, 3 * sizeof(float));
+        }
+        return;
+    }
+    float offset[3] = { raw[0] - center[0], raw[1] - center[1], raw[2] - center[2] };
+    for (uint8_t i = 0; i < 3; i++) {
+        corrected[i] = softIron[i * 3] * offset[0] + softIron[i * 3 + 1] * offset[1] + softIron[i * 3 + 2] * offset[2];
+    }
+}
+
+void MagCalibrator::symmetricEigen3(const float* m, float* values, float* vectors) {
+    float a[9];
+    memcpy(a, m, sizeof(a));
+    memset(vectors, 0, 9 * sizeof(float));
+    vectors[0] = vectors[4] = vectors[8] = 1.0f;
+
+    static const uint8_t PAIRS[3][2] = { { 0, 1 }, { 0, 2 }, { 1, 2 } };
+    for (uint8_t sweep = 0; sweep < 10; sweep++) {
+        float off = a[1] * a[1] + a[2] * a[2] + a[5] * a[5];
+        float diagonal = a[0] * a[0] + a[4] * a[4] + a[8] * a[8];
+        if (off <= 1e-12f * diagonal) {
+            break;
+        }
+        for (uint8_t n = 0; n < 3; n++) {
+            uint8_t p = PAIRS[n][0];
+            uint8_t q = PAIRS[n][1];
+            float apq = a[p * 3 + q];
+            if (apq == 0.0f) {
+                continue;
+            }
+            // Rotation that zeroes a[p][q]: A' = J'AJ
+            float ratio = (a[q * 3 + q] - a[p * 3 + p]) / (2.0f * apq);
+            float t = fabs(ratio) > 1e6f ? 0.5f / ratio
+                    : (ratio >= 0.0f ? 1.0f : -1.0f) / (fabs(ratio) + sqrt(ratio * ratio + 1.0f));
+            float cs = 1.0f / sqrt(t * t + 1.0f);
+            float sn = t * cs;
+            for (uint8_t r = 0; r < 3; r++) {
+                float rp = a[r * 3 + p];
+                float rq = a[r * 3 + q];
+                a[r * 3 + p] = cs * rp - sn * rq;
+                a[r * 3 + q] = sn * rp + cs * rq;
+            }
+            for (uint8_t r = 0; r < 3; r++) {
+                float pr = a[p * 3 + r];
+                float qr = a[q * 3 + r];
+                a[p * 3 + r] = cs * pr - sn * qr;
+                a[q * 3 + r] = sn * pr + cs * qr;
+            }
+            for (uint8_t r = 0; r < 3; r++) {
+                float rp = vectors[r * 3 + p];
+                float rq = vectors[r * 3 + q];
+                vectors[r * 3 + p] = cs * rp - sn * rq;
+                vectors[r * 3 + q] = sn * rp + cs * rq;
+            }
+        }
+    }
+    values[0] = a[0];
+    values[1] = a[4];
+    values[2] = a[8];
+}
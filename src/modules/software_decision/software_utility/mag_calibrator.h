@@ -0,0 +1,110 @@
+#ifndef MAG_CALIBRATOR_H
+#define MAG_CALIBRATOR_H
+
+#include <stdint.h>
+
+// Online hard- and soft-iron magnetometer calibration.
+//
+// A calibrated magnetometer measures a field of constant strength, so the
+// raw readings lie on an ellipsoid. The general quadric
+//
+//   a x^2 + b y^2 + c z^2 + 2d xy + 2e xz + 2f yz + 2g x + 2h y + 2i z = 1
+//
+// is linear in its nine parameters, so they are fitted by recursive least
+// squares in information form. addSample() folds one reading into a fixed
+// 9x9 information matrix (packed upper triangle) and its right-hand side.
+// solve() factors the matrix (Cholesky) and extracts the ellipsoid. No raw
+// samples are stored, and the fit residual comes from the same sums.
+//
+// A forgetting factor lets the fit keep refining in flight and follow
+// slow changes in the vehicle's own field. The forgotten weight is
+// replaced by a weak prior on the last good fit, so directions that
+// straight flight does not excite hold their value instead of drifting.
+//
+// From the fit: hard-iron centre c = -A^-1 [g h i] and soft-iron
+// correction W = R sqrt(A / k), with k = 1 + c'Ac. W uses the symmetric
+// square root, so the correction does not rotate headings. R keeps the
+// ellipsoid's mean radius, so corrected readings stay in the input units.
+//
+// addSample() is ~100 float operations and solve() ~1000, so both belong
+// in the slow rate group (e.g. 10 Hz samples, 1 Hz solves). Inputs are
+// divided by fieldScale, the expected field magnitude in input units, to
+// keep the float sums well conditioned. RAM: ~360 bytes.
+
+static const uint8_t MAG_CAL_PARAMS = 9;
+static const uint8_t MAG_CAL_PACKED = MAG_CAL_PARAMS * (MAG_CAL_PARAMS + 1) / 2;
+
+static const float MAG_CAL_FORGETTING = 0.999f;     // ~100 s of memory at 10 Hz
+static const float MAG_CAL_PRIOR = 0.001f;          // Weight of the prior, in samples
+static const uint16_t MAG_CAL_MIN_SAMPLES = 150;
+static const float MAG_CAL_RESIDUAL_OK = 0.015f;    // RMS field strength error, fraction of the field
+static const float MAG_CAL_MIN_CONDITION = 0.002f;  // Smallest Cholesky pivot over the largest
+static const float MAG_CAL_MAX_AXIS_RATIO = 2.0f;   // Longest over shortest semi-axis
+
+enum class MagCalResult : uint8_t {
+    COLLECTING,         // Too few samples, or not enough orientations yet
+    NOT_ELLIPSOID,      // The fit is not a plausible ellipsoid
+    POOR_FIT,           // Ellipsoid, but the residual is too large
+    FITTED,             // Good fit, published
+    CONVERGED           // First good fit since begin(), published
+};
+
+class MagCalibrator {
+private:
+    float scale;                        // Input units per normalised unit
+    float forgetting;
+
+    // Information form: sums over forgotten samples, plus the prior
+    float info[MAG_CAL_PACKED];
+    float rhs[MAG_CAL_PARAMS];
+    float sumSquares;                   // Of the targets, for the residual
+    float weight;                       // Effective sample count
+    uint32_t samples;
+
+    float prior[MAG_CAL_PARAMS];        // Last good parameters
+
+    // Published calibration, in input units
+    float center[3];
+    float softIron[9];                  // Row-major
+    float radius;
+    bool valid;
+    bool converged;
+
+    // Last solve
+    float residual;                     // RMS field strength error, fraction
+    float condition;
+
+    void addPrior(float amount);
+    bool extract(const float* theta, float* fitCenter, float* fitSoftIron, float& fitRadius, float& k) const;
+
+public:
+    MagCalibrator();
+
+    // Clears the fit; fieldScale is the expected field magnitude in input units
+    void begin(float fieldScale, float forgettingFactor = MAG_CAL_FORGETTING);
+
+    void addSample(float x, float y, float z);
+    void addSample(const float* field) { addSample(field[0], field[1], field[2]); }
+
+    // Refits from the accumulated sums; publishes a good fit
+    MagCalResult solve();
+
+    // corrected = W (raw - c); raw and corrected may be the same array.
+    // Leaves the reading unchanged until a fit has been published.
+    void correct(const float* raw, float* corrected) const;
+
+    bool isValid() const { return valid; }
+    bool isConverged() const { return converged; }
+    const float* getCenter() const { return center; }
+    const float* getSoftIron() const { return softIron; }
+    float getRadius() const { return radius; }
+    float getResidual() const { return residual; }
+    float getCondition() const { return condition; }
+    uint32_t getSamples() const { return samples; }
+
+    // 3x3 symmetric eigen-decomposition (cyclic Jacobi); vectors are the
+    // columns of a row-major matrix
+    static void symmetricEigen3(const float* m, float* values, float* vectors);
+};
+
+#endif // MAG_CALIBRATOR_H
@@ -0,0 +1,217 @@
+#include "numerical_algorithms.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Temporary allocation for matrices, vectors and statistics scratch.
+// The remaining algorithms are implemented against these helpers.
+
+// Error flag definitions
+#define ERROR_ALLOCATION_FAILED     0x01
+#define ERROR_INVALID_DIMENSIONS    0x02
+
+NumericalAlgorithms::NumericalAlgorithms()
+    : totalExecutions(0), successfulExecutions(0), failedExecutions(0), errorFlags(0),
+      frameArena(nullptr), blockPool(nullptr), memoryInUse(0), arenaBytesInUse(0),
+      memoryHighWater(0), heapAllocations(0) {
+
+    config = NumericalAlgorithmsConfig();
+    config.maxMatrixSize = 16;
+    config.maxVectorSize = 256;
+    config.maxIterations = 100;
+    config.convergenceTolerance = 1e-6f;
+    config.enableOptimization = true;
+    config.threadCount = 1;
+
+    lastError = "";
+}
+
+NumericalAlgorithms::~NumericalAlgorithms() {
+}
+
+void NumericalAlgorithms::setError(StringView error) {
+    lastError = error;
+}
+
+float* NumericalAlgorithms::allocateFloats(uint32_t count) {
+    size_t bytes = (size_t)count * sizeof(float);
+    float* data = nullptr;
+
+    if (blockPool && bytes <= blockPool->getBlockSize()) {
+        data = static_cast<float*>(blockPool->allocate(bytes));
+    }
+    if (!data && frameArena) {
+        data = static_cast<float*>(frameArena->allocate(bytes));
+        if (data) {
+            arenaBytesInUse += bytes;
+        }
+    }
+    if (!data && !frameArena && !blockPool) {
+        // Heap only when no scratch memory is configured
+        data = static_cast<float*>(malloc(bytes));
+        if (data) {
+            heapAllocations++;
+        }
+    }
+
+    if (!data) {
+        errorFlags |= ERROR_ALLOCATION_FAILED;
+        setError("Scratch memory exhausted");
+        return nullptr;
+    }
+
+    memoryInUse += bytes;
+    if (memoryInUse > memoryHighWater) {
+        memoryHighWater = memoryInUse;
+    }
+    return data;
+}
+
+void NumericalAlgorithms::releaseFloats(float*& data, uint32_t count) {
+    if (!data) {
+        return;
+    }
+    size_t bytes = (size_t)count * sizeof(float);
+
+    if (blockPool && blockPool->owns(data)) {
+        blockPool->release(data);
+        memoryInUse -= bytes;
+    } else if (frameArena && frameArena->owns(data)) {
+        // Reclaimed by endFrame()
+    } else {
+        free(data);
+        memoryInUse -= bytes;
+    }
+    data = nullptr;
+}
+
+void NumericalAlgorithms::endFrame() {
+    if (frameArena) {
+        frameArena->reset();
+    }
+    memoryInUse -= arenaBytesInUse;
+    arenaBytesInUse = 0;
+}
+
+Matrix NumericalAlgorithms::createMatrix(uint16_t rows, uint16_t columns) {
+    Matrix matrix = { 0, 0, nullptr };
+    if (rows == 0 || columns == 0 || rows > config.maxMatrixSize || columns > config.maxMatrixSize) {
+        errorFlags |= ERROR_INVALID_DIMENSIONS;
+        setError("Invalid matrix dimensions");
+        return matrix;
+    }
+    matrix.data = allocateFloats((uint32_t)rows * columns);
+    if (matrix.data) {
+        matrix.rows = rows;
+        matrix.columns = columns;
+    }
+    return matrix;
+}
+
+Matrix NumericalAlgorithms::createZeroMatrix(uint16_t rows, uint16_t columns) {
+    Matrix matrix = createMatrix(rows, columns);
+    if (matrix.isValid()) {
+        memset(matrix.data, 0, (size_t)rows * columns * sizeof(float));
+    }
+    return matrix;
+}
+
+Matrix NumericalAlgorithms::createIdentityMatrix(uint16_t size) {
+    Matrix matrix = createZeroMatrix(size, size);
+    if (matrix.isValid()) {
+        for (uint16_t i = 0; i < size; i++) {
+            matrix.data[i * size + i] = 1.0f;
+        }
+    }
+    return matrix;
+}
+
+void NumericalAlgorithms::destroyMatrix(Matrix& matrix) {
+    releaseFloats(matrix.data, (uint32_t)matrix.rows * matrix.columns);
+    matrix.rows = 0;
+    matrix.columns = 0;
+}
+
+Vector NumericalAlgorithms::createVector(uint16_t size) {
+    Vector vector = { 0, nullptr };
+    if (size == 0 || size > config.maxVectorSize) {
+        errorFlags |= ERROR_INVALID_DIMENSIONS;
+        setError("Invalid vector size");
+        return vector;
+    }
+    vector.data = allocateFloats(size);
+    if (vector.data) {
+        vector.size = size;
+    }
+    return vector;
+}
+
+Vector NumericalAlgorithms::createZeroVector(uint16_t size) {
+    Vector vector = createVector(size);
+    if (vector.isValid()) {
+        memset(vector.data, 0, (size_t)size * sizeof(float));
+    }
+    return vector;
+}
+
+void NumericalAlgorithms::destroyVector(Vector& vector) {
+    releaseFloats(vector.data, vector.size);
+    vector.size = 0;
+}
+
+StatisticalData NumericalAlgorithms::calculateStatistics(const float* data, uint32_t count) {
+    StatisticalData stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!data || count == 0) {
+        return stats;
+    }
+
+    stats.count = count;
+    stats.min = data[0];
+    stats.max = data[0];
+    for (uint32_t i = 0; i < count; i++) {
+        stats.sum += data[i];
+        stats.sumSquares += data[i] * data[i];
+        if (data[i] < stats.min) stats.min = data[i];
+        if (data[i] > stats.max) stats.max = data[i];
+    }
+    stats.mean = stats.sum / count;
+
+    float m2 = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        float delta = data[i] - stats.mean;
+        m2 += delta * delta;
+    }
+    stats.variance = count > 1 ? m2 / (count - 1) : 0.0f;
+    stats.standardDeviation = sqrt(stats.variance);
+
+    // Shell sort a scratch copy for the median
+    stats.sortedData = allocateFloats(count);
+    if (!stats.sortedData) {
+        stats.median = stats.mean;
+        return stats;
+    }
+    float* sorted = stats.sortedData;
+    memcpy(sorted, data, count * sizeof(float));
+    for (uint32_t gap = count / 2; gap > 0; gap /= 2) {
+        for (uint32_t i = gap; i < count; i++) {
+            float value = sorted[i];
+            uint32_t j = i;
+            while (j >= gap && sorted[j - gap] > value) {
+                sorted[j] = sorted[j - gap];
+                j -= gap;
+            }
+            sorted[j] = value;
+        }
+    }
+    stats.median = (count & 1) ? sorted[count / 2]
+                               : 0.5f * (sorted[count / 2 - 1] + sorted[count / 2]);
+    return stats;
+}
+
+StatisticalData NumericalAlgorithms::calculateStatistics(const Vector& vector) {
+    return calculateStatistics(vector.data, vector.size);
+}
+
+void NumericalAlgorithms::destroyStatistics(StatisticalData& stats) {
+    releaseFloats(stats.sortedData, stats.count);
+}
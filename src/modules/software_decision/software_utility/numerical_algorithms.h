@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include "../application_data_types/numeric_types.h"
+#include "../application_data_types/fixed_string.h"
+#include "scratch_allocator.h"
 
 // Algorithm categories
 enum class AlgorithmCategory {
@@ -16,11 +18,11 @@ enum class AlgorithmCategory {
     SIGNAL_PROCESSING
 };
 
-// Algorithm precision levels
+// Algorithm precision levels (named like Precision in numeric_types.h)
 enum class AlgorithmPrecision {
-    LOW,
+    COARSE,
     MEDIUM,
-    HIGH,
+    FINE,
     EXTREME
 };
 
@@ -31,7 +33,7 @@ struct AlgorithmPerformance {
     uint32_t iterations;         // Number of iterations
     float accuracy;              // Accuracy percentage
     bool converged;              // Whether algorithm converged
-    String errorMessage;         // Error description if failed
+    ErrorText errorMessage;         // Error description if failed
 };
 
 // Matrix structure
@@ -61,7 +63,7 @@ struct StatisticalData {
     float variance;
     float standardDeviation;
     float median;
-    float* sortedData;
+    float* sortedData;           // Scratch: release with destroyStatistics or endFrame
 };
 
 // Filter configuration
@@ -99,7 +101,15 @@ private:
     
     // Error tracking
     uint8_t errorFlags;
-    String lastError;
+    ErrorText lastError;
+    
+    // Temporaries: pool if the block fits, else frame arena; heap only when neither is set
+    FrameArena* frameArena;
+    BlockPool* blockPool;
+    size_t memoryInUse;
+    size_t arenaBytesInUse;
+    size_t memoryHighWater;
+    uint32_t heapAllocations;
     
     // Helper methods
     bool validateMatrix(const Matrix& matrix) const;
@@ -107,7 +117,9 @@ private:
     bool validateDimensions(const Matrix& a, const Matrix& b) const;
     bool validateDimensions(const Matrix& matrix, const Vector& vector) const;
     
-    void setError(const String& error);
+    void setError(StringView error);
+    float* allocateFloats(uint32_t count);
+    void releaseFloats(float*& data, uint32_t count);
     void updatePerformance(const AlgorithmPerformance& performance);
     float calculateAccuracy(float expected, float actual) const;
 
@@ -120,6 +132,11 @@ public:
     void setConfiguration(const NumericalAlgorithmsConfig& newConfig);
     NumericalAlgorithmsConfig getConfiguration() const { return config; }
     
+    // Scratch memory; both are optional and owned by the caller
+    void setFrameArena(FrameArena* arena) { frameArena = arena; }
+    void setBlockPool(BlockPool* pool) { blockPool = pool; }
+    void endFrame();                    // Releases every arena allocation at once
+    
     // Matrix operations
     Matrix createMatrix(uint16_t rows, uint16_t columns);
     Matrix createIdentityMatrix(uint16_t size);
@@ -165,6 +182,7 @@ public:
     // Statistical algorithms
     StatisticalData calculateStatistics(const float* data, uint32_t count);
     StatisticalData calculateStatistics(const Vector& vector);
+    void destroyStatistics(StatisticalData& stats);
     
     float calculateMean(const float* data, uint32_t count);
     float calculateVariance(const float* data, uint32_t count);
@@ -232,7 +250,7 @@ public:
     
     // Error handling
     uint8_t getErrorFlags() const { return errorFlags; }
-    String getLastError() const { return lastError; }
+    const char* getLastError() const { return lastError.c_str(); }
     void clearErrors();
     
     // System operations
@@ -248,7 +266,9 @@ public:
     void resetPerformance();
     
     // Memory management
-    size_t getMemoryUsage() const;
+    size_t getMemoryUsage() const { return memoryHighWater; }   // Peak bytes held by temporaries
+    size_t getCurrentMemoryUsage() const { return memoryInUse; }
+    uint32_t getHeapAllocations() const { return heapAllocations; }
     bool optimizeMemory();
     void cleanup();
 };
@@ -0,0 +1,72 @@
+#include "scratch_allocator.h"
+
+static size_t alignUp(size_t value) {
+    return (value + SCRATCH_ALIGNMENT - 1) & ~(size_t)(SCRATCH_ALIGNMENT - 1);
+}
+
+FrameArena::FrameArena(void* storage, size_t size)
+    : buffer(static_cast<uint8_t*>(storage)), capacity(size), used(0), highWater(0), failures(0) {
+    // Start on an aligned address; the skipped bytes are simply unused
+    size_t skew = alignUp((uintptr_t)buffer) - (uintptr_t)buffer;
+    if (skew > capacity) {
+        skew = capacity;
+    }
+    buffer += skew;
+    capacity -= skew;
+}
+
+void* FrameArena::allocate(size_t bytes) {
+    size_t size = alignUp(bytes == 0 ? 1 : bytes);
+    if (size > capacity - used) {
+        failures++;
+        return nullptr;
+    }
+    void* block = buffer + used;
+    used += size;
+    if (used > highWater) {
+        highWater = used;
+    }
+    return block;
+}
+
+size_t BlockPool::storageFor(size_t blockSize, uint16_t blockCount) {
+    size_t size = alignUp(blockSize < sizeof(void*) ? sizeof(void*) : blockSize);
+    return size * blockCount + SCRATCH_ALIGNMENT - 1;
+}
+
+BlockPool::BlockPool(void* storage, size_t size, uint16_t count)
+    : buffer(static_cast<uint8_t*>(storage)), blockSize(alignUp(size < sizeof(void*) ? sizeof(void*) : size)),
+      blockCount(count), freeList(nullptr), inUse(0), highWater(0), failures(0) {
+    size_t skew = alignUp((uintptr_t)buffer) - (uintptr_t)buffer;
+    buffer += skew;
+
+    // Thread the free list through the blocks, lowest address first
+    for (uint16_t i = blockCount; i > 0; i--) {
+        void* block = buffer + (size_t)(i - 1) * blockSize;
+        *static_cast<void**>(block) = freeList;
+        freeList = block;
+    }
+}
+
+void* BlockPool::allocate(size_t bytes) {
+    if (bytes > blockSize || freeList == nullptr) {
+        failures++;
+        return nullptr;
+    }
+    void* block = freeList;
+    freeList = *static_cast<void**>(block);
+    inUse++;
+    if (inUse > highWater) {
+        highWater = inUse;
+    }
+    return block;
+}
+
+void BlockPool::release(void* block) {
+    if (block == nullptr || !owns(block)) {
+        return;
+    }
+    *static_cast<void**>(block) = freeList;
+    freeList = block;
+    inUse--;
+}
@@ -0,0 +1,80 @@
+#ifndef SCRATCH_ALLOCATOR_H
+#define SCRATCH_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Heap-free allocators for algorithm temporaries.
+//
+// FrameArena is a bump allocator over a caller-supplied buffer. Allocation
+// is a pointer increment and nothing is freed individually; the owner of
+// the control or analysis frame calls reset() once when the frame ends.
+// mark()/rewind() release everything after a point, for nested scratch.
+//
+// BlockPool hands out fixed-size blocks from a caller-supplied buffer and
+// keeps the free ones on an intrusive list. Use it for temporaries that
+// outlive a frame but have a bounded size, e.g. a filter's 9x9 covariance.
+//
+// Both record a high-water mark so the buffers can be sized from flight logs.
+
+static const uint8_t SCRATCH_ALIGNMENT = sizeof(void*);
+
+class FrameArena {
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    size_t used;
+    size_t highWater;
+    uint16_t failures;
+
+public:
+    FrameArena(void* storage, size_t size);
+
+    // nullptr when the arena is full; failures are counted
+    void* allocate(size_t bytes);
+    void reset() { used = 0; }
+
+    size_t mark() const { return used; }
+    void rewind(size_t position) { if (position < used) used = position; }
+
+    bool owns(const void* block) const {
+        return block >= buffer && block < buffer + capacity;
+    }
+    size_t getUsed() const { return used; }
+    size_t getCapacity() const { return capacity; }
+    size_t getHighWater() const { return highWater; }
+    uint16_t getFailures() const { return failures; }
+};
+
+class BlockPool {
+private:
+    uint8_t* buffer;
+    size_t blockSize;
+    uint16_t blockCount;
+    void* freeList;
+    uint16_t inUse;
+    uint16_t highWater;
+    uint16_t failures;
+
+public:
+    // blockSize is rounded up to SCRATCH_ALIGNMENT; storage must hold
+    // blockCount rounded blocks (see storageFor)
+    BlockPool(void* storage, size_t blockSize, uint16_t blockCount);
+
+    static size_t storageFor(size_t blockSize, uint16_t blockCount);
+
+    // nullptr when bytes exceeds the block size or the pool is empty
+    void* allocate(size_t bytes);
+    void release(void* block);
+
+    bool owns(const void* block) const {
+        return block >= buffer && block < buffer + blockSize * blockCount;
+    }
+    size_t getBlockSize() const { return blockSize; }
+    uint16_t getBlockCount() const { return blockCount; }
+    uint16_t getInUse() const { return inUse; }
+    uint16_t getHighWater() const { return highWater; }
+    uint16_t getFailures() const { return failures; }
+};
+
+#endif // SCRATCH_ALLOCATOR_H
@@ -0,0 +1,91 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+
+// Single-producer, single-consumer ring for handing data from interrupts
+// to the main loop without disabling interrupts.
+//
+// head is written only by the producer and tail only by the consumer.
+// Both are free-running 8-bit counters, so a load or store of either is a
+// single instruction on AVR and needs no critical section; the slot is
+// head & (N - 1) and head - tail is the fill level. The producer stores
+// the item before publishing head (release), and the consumer reads head
+// (acquire) before the item, so a popped item is always complete.
+//
+// AVR interrupts do not nest, so all ISRs together count as one producer.
+// Code that pushes from the main loop needs its own ring.
+//
+// A full ring drops the new item and counts it rather than overwrite one
+// the consumer may be reading.
+
+template <typename T, uint8_t N>
+class SpscRing {
+private:
+    static_assert(N >= 2 && N <= 128 && (N & (N - 1)) == 0,
+                  "SpscRing capacity must be a power of two from 2 to 128");
+
+    T items[N];
+    uint8_t head;       // Next slot to write; producer only
+    uint8_t tail;       // Next slot to read; consumer only
+    uint16_t dropped;   // Producer only
+
+    static uint8_t load(const uint8_t& index) { return __atomic_load_n(&index, __ATOMIC_ACQUIRE); }
+    static void store(uint8_t& index, uint8_t value) { __atomic_store_n(&index, value, __ATOMIC_RELEASE); }
+
+public:
+    SpscRing() : head(0), tail(0), dropped(0) {}
+
+    // Producer side (ISR)
+    bool push(const T& item) {
+        uint8_t h = head;
+        if ((uint8_t)(h - load(tail)) == N) {
+            dropped++;
+            return false;
+        }
+        items[h & (N - 1)] = item;
+        store(head, h + 1);
+        return true;
+    }
+
+    // Consumer side (main loop)
+    bool pop(T& item) {
+        uint8_t t = tail;
+        if (load(head) == t) {
+            return false;
+        }
+        item = items[t & (N - 1)];
+        store(tail, t + 1);
+        return true;
+    }
+
+    bool peek(T& item) const {
+        uint8_t t = tail;
+        if (load(head) == t) {
+            return false;
+        }
+        item = items[t & (N - 1)];
+        return true;
+    }
+
+    // Fill level; exact from the consumer, a snapshot from anywhere else
+    uint8_t size() const { return (uint8_t)(load(head) - load(tail)); }
+    bool isEmpty() const { return size() == 0; }
+    static uint8_t capacity() { return N; }
+
+    // Consumer only: discards everything queued
+    void clear() { store(tail, load(head)); }
+
+    // 16-bit counter read from the main loop: re-read until two reads agree
+    // so an ISR update between the byte loads cannot tear it
+    uint16_t getDropped() const {
+        const volatile uint16_t* counter = &dropped;
+        uint16_t value;
+        do {
+            value = *counter;
+        } while (value != *counter);
+        return value;
+    }
+};
+
+#endif // SPSC_RING_H
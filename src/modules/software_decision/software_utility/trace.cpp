@@ -0,0 +1,108 @@
+#include "trace.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+static_assert((TRACE_CAPACITY & (TRACE_CAPACITY - 1)) == 0 && TRACE_CAPACITY <= 128,
+              "TRACE_CAPACITY must be a power of two up to 128");
+static_assert(static_cast<uint16_t>(TraceId::COUNT) < TRACE_DELTA_HIGH,
+              "Trace point IDs collide with TRACE_DELTA_HIGH");
+
+TraceBuffer traceBuffer;
+
+TraceBuffer::TraceBuffer() : head(0), count(0), lastTime(0), overwritten(0), frozen(false) {
+}
+
+bool TraceBuffer::getEvent(uint8_t index, TraceEvent& event) const {
+    if (index >= count) {
+        return false;
+    }
+    event = events[(uint8_t)(head - count + index) & (TRACE_CAPACITY - 1)];
+    return true;
+}
+
+void TraceBuffer::clear() {
+    head = 0;
+    count = 0;
+    overwritten = 0;
+}
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+static char* writeHex(char* out, uint32_t value, uint8_t digits) {
+    for (int8_t i = digits - 1; i >= 0; i--) {
+        out[i] = HEX_DIGITS[value & 0x0F];
+        value >>= 4;
+    }
+    return out + digits;
+}
+
+uint8_t dumpTrace(TraceLineFn lineFn, void* context) {
+    // Frozen while draining so the header matches the events that follow
+    bool wasFrozen = traceBuffer.isFrozen();
+    traceBuffer.freeze();
+
+    uint8_t total = traceBuffer.getCount();
+    char line[3 + 8 * 9 + 1];
+    char* p = line;
+    *p++ = '@'; *p++ = 'T'; *p++ = ' ';
+    p = writeHex(p, total, 4); *p++ = ' ';
+    p = writeHex(p, traceBuffer.getLastTime(), 8); *p++ = ' ';
+    p = writeHex(p, traceBuffer.getOverwritten(), 4);
+    *p++ = '\n';
+    lineFn(context, line, (uint16_t)(p - line));
+
+    TraceEvent event = { 0, 0 };
+    for (uint8_t i = 0; i < total; i += 8) {
+        p = line;
+        *p++ = '@'; *p++ = 'E';
+        for (uint8_t j = i; j < total && j < i + 8; j++) {
+            traceBuffer.getEvent(j, event);
+            *p++ = ' ';
+            p = writeHex(p, event.id, 4);
+            p = writeHex(p, event.delta, 4);
+        }
+        *p++ = '\n';
+        lineFn(context, line, (uint16_t)(p - line));
+    }
+
+    traceBuffer.clear();
+    // Back to the caller's state: a ring frozen for a post-mortem stays frozen
+    if (wasFrozen) {
+        traceBuffer.freeze();
+    } else {
+        traceBuffer.resume();
+    }
+    return total;
+}
+
+#ifdef ARDUINO
+
+static void printTraceLine(void* context, const char* line, uint16_t length) {
+    static_cast<Print*>(context)->write((const uint8_t*)line, length);
+}
+
+uint8_t dumpTrace(Print& out) {
+    return dumpTrace(printTraceLine, &out);
+}
+
+#else
+
+uint32_t traceHostClock() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+#define TRACE_POINT_NAME(id) #id,
+
+static const char* const TRACE_POINT_NAMES[] = { TRACE_POINTS(TRACE_POINT_NAME) };
+
+#undef TRACE_POINT_NAME
+
+const char* traceIdName(uint16_t id) {
+    id &= ~TRACE_END_FLAG;
+    return id < static_cast<uint16_t>(TraceId::COUNT) ? TRACE_POINT_NAMES[id] : nullptr;
+}
+
+#endif
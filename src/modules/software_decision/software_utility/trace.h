@@ -0,0 +1,154 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Hot-path trace ring.
+//
+// TRACE_BEGIN/TRACE_END store a 16-bit trace point ID and the micros()
+// delta since the previous event in a RAM ring. The ring overwrites its
+// oldest events, so it always holds the last few frames. dumpTrace()
+// drains it as "@T"/"@E" text lines over serial or into the blackbox, and
+// the host tool trace_to_chrome turns those into Chrome/Perfetto JSON.
+//
+//   event: point ID, top bit set for END (2) | delta us (2)
+//
+// A gap longer than 65535 us writes an extra TRACE_DELTA_HIGH event that
+// carries the upper bits. Record from the main loop only, not from ISRs.
+
+// Trace points are numbered by position; only append, as with log_formats.h.
+// The sensor reads, logging and SD writes are instrumented. FRAME,
+// ESTIMATION, PID, MIXER and TELEMETRY are reserved for the main loop and
+// the stages it runs, which this tree does not implement yet.
+#define TRACE_POINTS(X) \
+    X(FRAME)      \
+    X(IMU_READ)   \
+    X(BARO_READ)  \
+    X(GPS_READ)   \
+    X(RADIO_READ) \
+    X(ESTIMATION) \
+    X(PID)        \
+    X(MIXER)      \
+    X(TELEMETRY)  \
+    X(LOGGING)    \
+    X(SD_WRITE)
+
+#define TRACE_POINT_ENUM(id) id,
+
+enum class TraceId : uint16_t {
+    TRACE_POINTS(TRACE_POINT_ENUM)
+    COUNT
+};
+
+#undef TRACE_POINT_ENUM
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#ifndef TRACE_CAPACITY
+#define TRACE_CAPACITY 64   // Events of 4 bytes, power of two up to 128
+#endif
+
+#ifndef TRACE_CLOCK
+#ifdef ARDUINO
+#include <Arduino.h>
+#define TRACE_CLOCK() micros()
+#else
+uint32_t traceHostClock();
+#define TRACE_CLOCK() traceHostClock()
+#endif
+#endif
+
+static const uint16_t TRACE_END_FLAG = 0x8000;
+static const uint16_t TRACE_DELTA_HIGH = 0x7FFF;
+
+struct TraceEvent {
+    uint16_t id;
+    uint16_t delta;
+};
+
+class TraceBuffer {
+private:
+    TraceEvent events[TRACE_CAPACITY];
+    uint8_t head;         // Next slot to write
+    uint8_t count;        // Events held, up to TRACE_CAPACITY
+    uint32_t lastTime;    // Clock value of the newest event
+    uint16_t overwritten; // Events lost to wrap since the last dump
+    bool frozen;
+
+    void push(uint16_t id, uint16_t delta) {
+        events[head] = { id, delta };
+        head = (head + 1) & (TRACE_CAPACITY - 1);
+        if (count < TRACE_CAPACITY) {
+            count++;
+        } else {
+            overwritten++;
+        }
+    }
+
+public:
+    TraceBuffer();
+
+    void record(uint16_t id) {
+        if (frozen) {
+            return;
+        }
+        uint32_t now = TRACE_CLOCK();
+        uint32_t delta = now - lastTime;
+        lastTime = now;
+        // The oldest event's delta is never used to rebuild times
+        if (delta > 0xFFFF && count > 0) {
+            push(TRACE_DELTA_HIGH, (uint16_t)(delta >> 16));
+        }
+        push(id, (uint16_t)delta);
+    }
+
+    // Freeze keeps the frames around an event (e.g. an overrun) until dumped
+    void freeze() { frozen = true; }
+    void resume() { frozen = false; }
+    bool isFrozen() const { return frozen; }
+
+    uint8_t getCount() const { return count; }
+    uint16_t getOverwritten() const { return overwritten; }
+    uint32_t getLastTime() const { return lastTime; }
+    // index 0 is the oldest event held
+    bool getEvent(uint8_t index, TraceEvent& event) const;
+    void clear();
+};
+
+extern TraceBuffer traceBuffer;
+
+// Scoped helper: TRACE_SCOPE(PID) covers the rest of the enclosing block
+struct TraceScope {
+    uint16_t id;
+    explicit TraceScope(uint16_t point) : id(point) { traceBuffer.record(id); }
+    ~TraceScope() { traceBuffer.record(id | TRACE_END_FLAG); }
+};
+
+#if TRACE_ENABLED
+#define TRACE_BEGIN(id) traceBuffer.record(static_cast<uint16_t>(TraceId::id))
+#define TRACE_END(id)   traceBuffer.record(static_cast<uint16_t>(TraceId::id) | TRACE_END_FLAG)
+#define TRACE_SCOPE(id) TraceScope traceScope_##id(static_cast<uint16_t>(TraceId::id))
+#else
+#define TRACE_BEGIN(id) do {} while (0)
+#define TRACE_END(id)   do {} while (0)
+#define TRACE_SCOPE(id) do {} while (0)
+#endif
+
+// Drains the ring as text, oldest first:
+//   "@T <events> <newest clock> <overwritten>\n"  (hex)
+//   "@E <id><delta> ...\n"                       (up to 8 events per line)
+// The host rebuilds absolute times backwards from the newest clock value.
+typedef void (*TraceLineFn)(void* context, const char* line, uint16_t length);
+uint8_t dumpTrace(TraceLineFn lineFn, void* context);
+
+#ifdef ARDUINO
+class Print;
+uint8_t dumpTrace(Print& out);
+#else
+// Host only: trace point name, or nullptr for an unknown ID
+const char* traceIdName(uint16_t id);
+#endif
+
+#endif // TRACE_H
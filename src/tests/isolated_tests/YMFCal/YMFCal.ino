@@ -17,6 +17,10 @@
 
 #include <Wire.h>                          //Include the Wire.h library so we can communicate with the gyro.
 #include <EEPROM.h>                        //Include the EEPROM.h library so we can store information onto the EEPROM
+//The Arduino IDE only compiles the sketch folder, so src/ holds copies of these modules at their paths under modules/.
+//Copy them again (config_store, gyro_bias_model, calibration_arena.h, calibration_stats.cpp) when the modules change.
+#include "src/hardware_hiding/extended_computer/config_store.h"         //Log-structured store after the setup bytes, for the gyro bias model.
+#include "src/hardware_hiding/device_interface/gyro_bias_model.h"      //Gyro bias against temperature, learned over many boots.
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //PID gain and limit settings
@@ -67,6 +71,12 @@ float pid_i_mem_yaw, pid_yaw_setpoint, gyro_yaw_input, pid_output_yaw, pid_last_
 float angle_roll_acc, angle_pitch_acc, angle_pitch, angle_roll;
 boolean gyro_angles_set;
 
+ConfigStore config_store;
+GyroBiasModel gyro_bias_model;
+CalibrationStats gyro_still_window;
+GyroBootResult gyro_boot_result;
+float gyro_model_bias[3];
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //Setup routine
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,30 +107,66 @@ void setup(){
 
   set_gyro_registers();                                                     //Set the specific gyro registers.
 
-  for (cal_int = 0; cal_int < 1250 ; cal_int ++){                           //Wait 5 seconds before continuing.
-    PORTD |= B11110000;                                                     //Set digital poort 4, 5, 6 and 7 high.
-    delayMicroseconds(1000);                                                //Wait 1000us.
-    PORTD &= B00001111;                                                     //Set digital poort 4, 5, 6 and 7 low.
-    delayMicroseconds(3000);                                                //Wait 3000us.
+  config_store.attachEEPROM();                                              //The store starts after the setup bytes at address 0 - 35.
+  config_store.begin();                                                     //Find the newest records.
+  gyro_bias_model.load(config_store);                                       //Load the gyro bias model learned on earlier boots.
+
+  //Instead of a full calibration on every boot, check a 300ms still window against the learned model.
+  for (start = 0; start < 3 ; start ++){                                    //Take up to three windows while the quadcopter is being moved.
+    gyro_still_window.begin(GYRO_BIAS_WINDOW_DIMS);
+    for (cal_int = 0; cal_int < GYRO_BIAS_BOOT_SAMPLES ; cal_int ++){
+      gyro_signalen();                                                      //Read the gyro output.
+      float sample[GYRO_BIAS_WINDOW_DIMS] = {gyro_axis[1] / 65.5, gyro_axis[2] / 65.5, gyro_axis[3] / 65.5, temperature / 340.0 + 36.53};
+      gyro_still_window.add(sample);                                        //Gyro in deg/sec and the temperature in degrees Celsius.
+      PORTD |= B11110000;                                                   //Set digital poort 4, 5, 6 and 7 high.
+      delayMicroseconds(1000);                                              //Wait 1000us.
+      PORTD &= B00001111;                                                   //Set digital poort 4, 5, 6 and 7 low.
+      delay(3);                                                             //Wait 3 milliseconds before the next loop.
+    }
+    gyro_boot_result = gyro_bias_model.checkBoot(gyro_still_window, gyro_model_bias);
+    if(gyro_boot_result != GyroBootResult::MOVING)break;                   //Still: the model either agrees or it does not.
   }
+  start = 0;                                                                //Set start back to zero.
 
-  //Let's take multiple gyro data samples so we can determine the average gyro offset (calibration).
-  for (cal_int = 0; cal_int < 2000 ; cal_int ++){                           //Take 2000 readings for calibration.
-    if(cal_int % 15 == 0)digitalWrite(12, !digitalRead(12));                //Change the led status to indicate calibration.
-    gyro_signalen();                                                        //Read the gyro output.
-    gyro_axis_cal[1] += gyro_axis[1];                                       //Ad roll value to gyro_roll_cal.
-    gyro_axis_cal[2] += gyro_axis[2];                                       //Ad pitch value to gyro_pitch_cal.
-    gyro_axis_cal[3] += gyro_axis[3];                                       //Ad yaw value to gyro_yaw_cal.
-    //We don't want the esc's to be beeping annoyingly. So let's give them a 1000us puls while calibrating the gyro.
-    PORTD |= B11110000;                                                     //Set digital poort 4, 5, 6 and 7 high.
-    delayMicroseconds(1000);                                                //Wait 1000us.
-    PORTD &= B00001111;                                                     //Set digital poort 4, 5, 6 and 7 low.
-    delay(3);                                                               //Wait 3 milliseconds before the next loop.
+  if(gyro_boot_result == GyroBootResult::MODEL){                            //The model agrees with the still window.
+    gyro_axis_cal[1] = gyro_model_bias[0] * 65.5;                           //Roll offset from the model.
+    gyro_axis_cal[2] = gyro_model_bias[1] * 65.5;                           //Pitch offset from the model.
+    gyro_axis_cal[3] = gyro_model_bias[2] * 65.5;                           //Yaw offset from the model.
+    gyro_bias_model.addStillWindow(gyro_still_window);                      //Learn from this window too.
+  }
+  else{                                                                     //No model for this temperature, or it disagrees: full calibration.
+    if(gyro_boot_result == GyroBootResult::DISAGREES)gyro_bias_model.clear();//A model that is off is relearned from this calibration.
+    for (cal_int = 0; cal_int < 1250 ; cal_int ++){                         //Wait 5 seconds before continuing.
+      PORTD |= B11110000;                                                   //Set digital poort 4, 5, 6 and 7 high.
+      delayMicroseconds(1000);                                              //Wait 1000us.
+      PORTD &= B00001111;                                                   //Set digital poort 4, 5, 6 and 7 low.
+      delayMicroseconds(3000);                                              //Wait 3000us.
+    }
+
+    //Let's take multiple gyro data samples so we can determine the average gyro offset (calibration).
+    for (cal_int = 0; cal_int < 2000 ; cal_int ++){                         //Take 2000 readings for calibration.
+      if(cal_int % 15 == 0)digitalWrite(12, !digitalRead(12));              //Change the led status to indicate calibration.
+      gyro_signalen();                                                      //Read the gyro output.
+      gyro_axis_cal[1] += gyro_axis[1];                                     //Ad roll value to gyro_roll_cal.
+      gyro_axis_cal[2] += gyro_axis[2];                                     //Ad pitch value to gyro_pitch_cal.
+      gyro_axis_cal[3] += gyro_axis[3];                                     //Ad yaw value to gyro_yaw_cal.
+      //We don't want the esc's to be beeping annoyingly. So let's give them a 1000us puls while calibrating the gyro.
+      PORTD |= B11110000;                                                   //Set digital poort 4, 5, 6 and 7 high.
+      delayMicroseconds(1000);                                              //Wait 1000us.
+      PORTD &= B00001111;                                                   //Set digital poort 4, 5, 6 and 7 low.
+      delay(3);                                                             //Wait 3 milliseconds before the next loop.
+    }
+    //Now that we have 2000 measures, we need to devide by 2000 to get the average gyro offset.
+    gyro_axis_cal[1] /= 2000;                                               //Divide the roll total by 2000.
+    gyro_axis_cal[2] /= 2000;                                               //Divide the pitch total by 2000.
+    gyro_axis_cal[3] /= 2000;                                               //Divide the yaw total by 2000.
+    gyro_model_bias[0] = gyro_axis_cal[1] / 65.5;                           //Roll offset in deg/sec.
+    gyro_model_bias[1] = gyro_axis_cal[2] / 65.5;                           //Pitch offset in deg/sec.
+    gyro_model_bias[2] = gyro_axis_cal[3] / 65.5;                           //Yaw offset in deg/sec.
+    gyro_bias_model.addObservation(gyro_model_bias, temperature / 340.0 + 36.53, GYRO_BIAS_CALIBRATION_WEIGHT);
   }
-  //Now that we have 2000 measures, we need to devide by 2000 to get the average gyro offset.
-  gyro_axis_cal[1] /= 2000;                                                 //Divide the roll total by 2000.
-  gyro_axis_cal[2] /= 2000;                                                 //Divide the pitch total by 2000.
-  gyro_axis_cal[3] /= 2000;                                                 //Divide the yaw total by 2000.
+  cal_int = 2000;                                                           //Compensate the gyro from now on.
+  gyro_bias_model.save(config_store);                                       //Keep what was learned for the next boot.
 
   PCICR |= (1 << PCIE0);                                                    //Set PCIE0 to enable PCMSK0 scan.
   PCMSK0 |= (1 << PCINT0);                                                  //Set PCINT0 (digital input 8) to trigger an interrupt on state change.
@@ -0,0 +1,207 @@
+#include "gyro_bias_model.h"
+#include <math.h>
+#include <string.h>
+
+static float normalizedTemperature(float temperatureC) {
+    return (temperatureC - GYRO_BIAS_REFERENCE_C) / GYRO_BIAS_SCALE_C;
+}
+
+// The range seen is kept in whole degrees, as int8_t
+static float constrainTemperature(float temperatureC) {
+    return temperatureC < -128.0f ? -128.0f : (temperatureC > 127.0f ? 127.0f : temperatureC);
+}
+
+GyroBiasModel::GyroBiasModel() {
+    clear();
+}
+
+void GyroBiasModel::clear() {
+    memset(&record, 0, sizeof(record));
+    record.minTempC = 127;
+    record.maxTempC = -128;
+    memset(coefficients, 0, sizeof(coefficients));
+    terms = 0;
+}
+
+void GyroBiasModel::addObservation(const float* bias, float temperatureC, float weight) {
+    if (weight <= 0.0f) {
+        return;
+    }
+    // Fade what is already there so the total stays at the cap
+    float total = record.moments[0] + weight;
+    if (total > GYRO_BIAS_MAX_WEIGHT && record.moments[0] > 0.0f) {
+        float fade = (GYRO_BIAS_MAX_WEIGHT - weight) / record.moments[0];
+        fade = fade > 0.0f ? fade : 0.0f;
+        for (uint8_t k = 0; k < 2 * GYRO_BIAS_TERMS - 1; k++) {
+            record.moments[k] *= fade;
+        }
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            for (uint8_t k = 0; k < GYRO_BIAS_TERMS; k++) {
+                record.products[axis][k] *= fade;
+            }
+        }
+    }
+
+    float t = normalizedTemperature(temperatureC);
+    float power = weight;
+    for (uint8_t k = 0; k < 2 * GYRO_BIAS_TERMS - 1; k++) {
+        record.moments[k] += power;
+        if (k < GYRO_BIAS_TERMS) {
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                record.products[axis][k] += power * bias[axis];
+            }
+        }
+        power *= t;
+    }
+
+    float clamped = constrainTemperature(temperatureC);
+    if (floor(clamped) < record.minTempC) {
+        record.minTempC = (int8_t)floor(clamped);
+    }
+    if (ceil(clamped) > record.maxTempC) {
+        record.maxTempC = (int8_t)ceil(clamped);
+    }
+    fit();
+}
+
+bool GyroBiasModel::addStillWindow(const CalibrationStats& window, float weight) {
+    if (window.count < GYRO_BIAS_MIN_WINDOW || !isStill(window)) {
+        return false;
+    }
+    float bias[3] = { window.getMean(0), window.getMean(1), window.getMean(2) };
+    addObservation(bias, window.getMean(3), weight);
+    return true;
+}
+
+void GyroBiasModel::fit() {
+    terms = 0;
+    if (record.moments[0] < GYRO_BIAS_CALIBRATION_WEIGHT) {
+        return;
+    }
+    float span = (float)record.maxTempC - record.minTempC;
+    uint8_t wanted = span >= GYRO_BIAS_QUADRATIC_SPAN_C ? 3 : (span >= GYRO_BIAS_LINEAR_SPAN_C ? 2 : 1);
+
+    // Drop a degree whenever the normal equations are too close to singular
+    for (; wanted > 0; wanted--) {
+        float matrix[GYRO_BIAS_TERMS][GYRO_BIAS_TERMS];
+        float solution[3][GYRO_BIAS_TERMS];
+        for (uint8_t i = 0; i < wanted; i++) {
+            for (uint8_t j = 0; j < wanted; j++) {
+                matrix[i][j] = record.moments[i + j];
+            }
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                solution[axis][i] = record.products[axis][i];
+            }
+        }
+
+        // Gaussian elimination with partial pivoting, three right-hand sides
+        bool singular = false;
+        for (uint8_t col = 0; col < wanted && !singular; col++) {
+            uint8_t pivot = col;
+            for (uint8_t row = col + 1; row < wanted; row++) {
+                if (fabs(matrix[row][col]) > fabs(matrix[pivot][col])) {
+                    pivot = row;
+                }
+            }
+            if (fabs(matrix[pivot][col]) <= 1e-4f * record.moments[0]) {
+                singular = true;
+                break;
+            }
+            if (pivot != col) {
+                for (uint8_t j = 0; j < wanted; j++) {
+                    float swap = matrix[col][j];
+                    matrix[col][j] = matrix[pivot][j];
+                    matrix[pivot][j] = swap;
+                }
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    float swap = solution[axis][col];
+                    solution[axis][col] = solution[axis][pivot];
+                    solution[axis][pivot] = swap;
+                }
+            }
+            for (uint8_t row = col + 1; row < wanted; row++) {
+                float factor = matrix[row][col] / matrix[col][col];
+                for (uint8_t j = col; j < wanted; j++) {
+                    matrix[row][j] -= factor * matrix[col][j];
+                }
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    solution[axis][row] -= factor * solution[axis][col];
+                }
+            }
+        }
+        if (singular) {
+            continue;
+        }
+        for (int8_t row = wanted - 1; row >= 0; row--) {
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                float sum = solution[axis][row];
+                for (uint8_t j = row + 1; j < wanted; j++) {
+                    sum -= matrix[row][j] * solution[axis][j];
+                }
+                solution[axis][row] = sum / matrix[row][row];
+            }
+        }
+
+        memset(coefficients, 0, sizeof(coefficients));
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            for (uint8_t i = 0; i < wanted; i++) {
+                coefficients[axis][i] = solution[axis][i];
+            }
+        }
+        terms = wanted;
+        return;
+    }
+}
+
+bool GyroBiasModel::predict(float temperatureC, float* bias) const {
+    if (terms == 0 ||
+        temperatureC < record.minTempC - GYRO_BIAS_MARGIN_C ||
+        temperatureC > record.maxTempC + GYRO_BIAS_MARGIN_C) {
+        return false;
+    }
+    float t = normalizedTemperature(temperatureC);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        bias[axis] = coefficients[axis][0] + t * (coefficients[axis][1] + t * coefficients[axis][2]);
+    }
+    return true;
+}
+
+bool GyroBiasModel::isStill(const CalibrationStats& window) {
+    if (window.dims < GYRO_BIAS_WINDOW_DIMS) {
+        return false;
+    }
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        if (window.getStdDev(axis) > GYRO_BIAS_STILL_DPS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+GyroBootResult GyroBiasModel::checkBoot(const CalibrationStats& window, float* bias) const {
+    if (window.count < GYRO_BIAS_MIN_WINDOW || !isStill(window)) {
+        return GyroBootResult::MOVING;
+    }
+    if (!predict(window.getMean(3), bias)) {
+        return GyroBootResult::NO_MODEL;
+    }
+    // Allow for the window's own noise on top of the tolerance
+    float samples = sqrt((float)window.count);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        float limit = GYRO_BIAS_TOLERANCE_DPS + 3.0f * window.getStdDev(axis) / samples;
+        if (fabs(window.getMean(axis) - bias[axis]) > limit) {
+            return GyroBootResult::DISAGREES;
+        }
+    }
+    return GyroBootResult::MODEL;
+}
+
+bool GyroBiasModel::load(const ConfigStore& store) {
+    GyroBiasRecord stored;
+    if (!store.loadImage(CONFIG_KEY_GYRO_BIAS_MODEL, GYRO_BIAS_RECORD_VERSION, stored)) {
+        return false;
+    }
+    record = stored;
+    fit();
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef GYRO_BIAS_MODEL_H
+#define GYRO_BIAS_MODEL_H
+
+#include <stdint.h>
+#include "../extended_computer/config_store.h"
+#include "../../software_decision/software_utility/calibration_arena.h"
+
+// Gyro bias against temperature, learned over many power-ups.
+//
+// Each time the vehicle is known to be still, the mean gyro reading and
+// the die temperature are one observation: a full calibration, or a short
+// still window. Observations go into weighted least-squares sums for
+//
+//   bias(T) = c0 + c1 t + c2 t^2,   t = (T - 25 C) / 10 C
+//
+// per axis. The sums are kept rather than the samples: the power sums of
+// t (the normal matrix is Hankel) and the bias-weighted ones per axis.
+// They fit one ConfigStore record, so the model survives power-off. Once
+// the total weight reaches GYRO_BIAS_MAX_WEIGHT, older observations fade.
+//
+// The polynomial degree follows the temperatures seen so far: a constant
+// until they span GYRO_BIAS_LINEAR_SPAN_C, then a line, then a quadratic.
+// The model does not predict further than GYRO_BIAS_MARGIN_C outside them.
+//
+// At boot, checkBoot() compares a few hundred milliseconds of still data
+// with the model. Only if they disagree, or the model has nothing for
+// this temperature, does the caller need a full calibration.
+//
+// Window layout: a CalibrationStats over GYRO_BIAS_WINDOW_DIMS values per
+// sample, gyro x, y, z in deg/s then the temperature in C.
+
+static const uint8_t GYRO_BIAS_TERMS = 3;
+static const uint8_t GYRO_BIAS_WINDOW_DIMS = 4;
+static const uint8_t GYRO_BIAS_RECORD_VERSION = 1;
+
+static const float GYRO_BIAS_REFERENCE_C = 25.0f;
+static const float GYRO_BIAS_SCALE_C = 10.0f;
+static const float GYRO_BIAS_LINEAR_SPAN_C = 6.0f;
+static const float GYRO_BIAS_QUADRATIC_SPAN_C = 15.0f;
+static const float GYRO_BIAS_MARGIN_C = 3.0f;
+
+static const float GYRO_BIAS_WINDOW_WEIGHT = 1.0f;        // Short still window
+static const float GYRO_BIAS_CALIBRATION_WEIGHT = 4.0f;   // Full calibration
+static const float GYRO_BIAS_MAX_WEIGHT = 100.0f;
+
+static const uint16_t GYRO_BIAS_MIN_WINDOW = 50;          // Samples
+static const uint16_t GYRO_BIAS_BOOT_SAMPLES = 75;        // Boot window: 300 ms at 4 ms
+static const float GYRO_BIAS_STILL_DPS = 0.3f;            // Largest gyro std dev when still
+static const float GYRO_BIAS_TOLERANCE_DPS = 0.25f;       // Boot check, beyond the window's own noise
+
+enum class GyroBootResult : uint8_t {
+    MODEL,              // Still, and the model agrees: use its bias
+    MOVING,             // Too much motion to judge; take another window
+    NO_MODEL,           // Nothing learned near this temperature: calibrate
+    DISAGREES           // The model is off: calibrate
+};
+
+// Stored image (58 bytes)
+struct GyroBiasRecord {
+    float moments[2 * GYRO_BIAS_TERMS - 1];         // Sum of w t^k
+    float products[3][GYRO_BIAS_TERMS];             // Sum of w bias t^k, per axis
+    int8_t minTempC;                                // Temperatures seen
+    int8_t maxTempC;
+};
+
+class GyroBiasModel {
+private:
+    GyroBiasRecord record;
+    float coefficients[3][GYRO_BIAS_TERMS];
+    uint8_t terms;                                  // 0 until usable
+
+    void fit();
+
+public:
+    GyroBiasModel();
+
+    // Forgets everything learned (e.g. after the model disagreed)
+    void clear();
+
+    // Folds in a bias measured while still at temperatureC
+    void addObservation(const float* bias, float temperatureC, float weight);
+    // Folds in a still window; false, and nothing learned, if it moved
+    bool addStillWindow(const CalibrationStats& window, float weight = GYRO_BIAS_WINDOW_WEIGHT);
+
+    // False when the model has nothing for this temperature
+    bool predict(float temperatureC, float* bias) const;
+    // Boot check; bias is the model's prediction when it has one
+    GyroBootResult checkBoot(const CalibrationStats& window, float* bias) const;
+    static bool isStill(const CalibrationStats& window);
+
+    uint8_t getTerms() const { return terms; }
+    float getWeight() const { return record.moments[0]; }
+    int8_t getMinTemperature() const { return record.minTempC; }
+    int8_t getMaxTemperature() const { return record.maxTempC; }
+    const GyroBiasRecord& getRecord() const { return record; }
+
+    bool save(ConfigStore& store) const {
+        return store.saveImage(CONFIG_KEY_GYRO_BIAS_MODEL, GYRO_BIAS_RECORD_VERSION, record);
+    }
+    bool load(const ConfigStore& store);
+};
+
+#endif // GYRO_BIAS_MODEL_H
@@ -0,0 +1,96 @@
+#include "calibration_arena.h"
+#include <math.h>
+#include <string.h>
+
+// The accumulators, apart from the arena itself, so code that only keeps
+// statistics (e.g. a flight sketch's gyro window) does not carry the arena.
+
+// Index of (row, col), row <= col, in the packed upper triangle
+static uint8_t triangleIndex(uint8_t row, uint8_t col, uint8_t dims) {
+    if (row > col) {
+        uint8_t swap = row;
+        row = col;
+        col = swap;
+    }
+    return row * dims - (row * (row - 1)) / 2 + (col - row);
+}
+
+void CalibrationStats::begin(uint8_t dimensions) {
+    memset(this, 0, sizeof(*this));
+    dims = dimensions > CALIBRATION_MAX_DIMS ? CALIBRATION_MAX_DIMS : dimensions;
+}
+
+void CalibrationStats::add(const float* sample) {
+    if (count == 0) {
+        for (uint8_t i = 0; i < dims; i++) {
+            origin[i] = sample[i];
+            minimum[i] = sample[i];
+            maximum[i] = sample[i];
+        }
+    }
+    if (count == 0xFFFF) {
+        return;
+    }
+    count++;
+
+    float delta[CALIBRATION_MAX_DIMS];
+    float shifted[CALIBRATION_MAX_DIMS];
+    for (uint8_t i = 0; i < dims; i++) {
+        shifted[i] = sample[i] - origin[i];
+        delta[i] = shifted[i] - mean[i];
+        mean[i] += delta[i] / count;
+        if (sample[i] < minimum[i]) minimum[i] = sample[i];
+        if (sample[i] > maximum[i]) maximum[i] = sample[i];
+    }
+
+    // Co-moment update uses the old delta and the new residual
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < dims; i++) {
+        for (uint8_t j = i; j < dims; j++) {
+            comoment[k++] += delta[i] * (shifted[j] - mean[j]);
+        }
+    }
+}
+
+void CalibrationStats::add(float a, float b, float c, float d, float e, float f) {
+    const float sample[CALIBRATION_MAX_DIMS] = { a, b, c, d, e, f };
+    add(sample);
+}
+
+float CalibrationStats::getMean(uint8_t dim) const {
+    return dim < dims ? origin[dim] + mean[dim] : 0.0f;
+}
+
+float CalibrationStats::getCovariance(uint8_t row, uint8_t col) const {
+    if (row >= dims || col >= dims || count < 2) {
+        return 0.0f;
+    }
+    return comoment[triangleIndex(row, col, dims)] / (count - 1);
+}
+
+float CalibrationStats::getVariance(uint8_t dim) const {
+    return getCovariance(dim, dim);
+}
+
+float CalibrationStats::getStdDev(uint8_t dim) const {
+    return sqrt(getVariance(dim));
+}
+
+void ChannelStats::add(float value) {
+    if (count == 0) {
+        origin = value;
+        minimum = value;
+        maximum = value;
+    }
+    if (count == 0xFFFF) {
+        return;
+    }
+    count++;
+
+    float shifted = value - origin;
+    float delta = shifted - mean;
+    mean += delta / count;
+    m2 += delta * (shifted - mean);
+    if (value < minimum) minimum = value;
+    if (value > maximum) maximum = value;
+}
@@ -2,26 +2,31 @@
 #include "../../modules/behavior_hiding/shared_services/sensors_coordination_module.h"
 
 const int trigPin = 9;
-const int echoPin = 10;
+const int echoPin = 2;  // Needs an external interrupt
 
 SensorsCoordinationModule sensorsModule;
+unsigned long lastPrint = 0;
 
 void setup() {
   Serial.begin(9600);
   sensorsModule.initialize();
   sensorsModule.addSensor(SensorType::ULTRASONIC, 0, trigPin);
+  sensorsModule.attachUltrasonicEcho(0, echoPin);
 }
 
 void loop() {
-  sensorsModule.readSensor(0); // Read ultrasonic sensor
-  float distanceCm = sensorsModule.getUltrasonicDistance();
+  sensorsModule.readAllSensors(); // Pings and collects echoes without waiting
+  if (millis() - lastPrint < 1000) {
+    return;
+  }
+  lastPrint = millis();
+
+  float distanceCm = sensorsModule.getUltrasonicDistance() * 100.0; // Metres to cm
   float distanceInch = distanceCm * 0.393701; // Convert cm to inches
-  
+
   Serial.print("Distance: ");
   Serial.print(distanceCm);
   Serial.print(" cm, ");
   Serial.print(distanceInch);
   Serial.println(" inches");
-  
-  delay(1000);
-}
\ No newline at end of file
+}
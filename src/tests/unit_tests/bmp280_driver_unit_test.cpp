@@ -0,0 +1,224 @@
+/**
+ * @file bmp280_driver_unit_test.cpp
+ * @brief Unit tests for BMP280 compensation and the altitude table
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks the integer compensation against the datasheet's worked example
+ * and the parsing of the trimming registers. Also checks the forced-mode
+ * conversion times and the interpolated pressure-to-altitude table
+ * against the ISA formula, and times the table against pow().
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include "../../modules/hardware_hiding/device_interface/bmp280_driver.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Datasheet section 8.2 example trimming, as the registers hold it
+static const uint8_t DATASHEET_TRIMMING[BMP280_CALIBRATION_LENGTH] = {
+    0x70, 0x6B,     // T1 27504
+    0x43, 0x67,     // T2 26435
+    0x18, 0xFC,     // T3 -1000
+    0x7D, 0x8E,     // P1 36477
+    0x43, 0xD6,     // P2 -10685
+    0xD0, 0x0B,     // P3 3024
+    0x27, 0x0B,     // P4 2855
+    0x8C, 0x00,     // P5 140
+    0xF9, 0xFF,     // P6 -7
+    0x8C, 0x3C,     // P7 15500
+    0xF8, 0xC6,     // P8 -14600
+    0x70, 0x17      // P9 6000
+};
+
+static float isaAltitude(float pa, float seaLevelPa) {
+    return 44330.77f * (1.0f - powf(pa / seaLevelPa, 0.190263f));
+}
+
+// Test functions
+void testCompensation() {
+    Serial.println("\n=== Testing Integer Compensation ===");
+    Bmp280Calibration calibration;
+    bmp280ParseCalibration(DATASHEET_TRIMMING, calibration);
+    assertEqual(27504, calibration.T1, "T1 parsed");
+    assertEqual(-1000, calibration.T3, "T3 sign-extended");
+    assertEqual(36477, calibration.P1, "P1 parsed");
+    assertEqual(-7, calibration.P6, "P6 sign-extended");
+    assertEqual(6000, calibration.P9, "P9 parsed");
+
+    int32_t tFine;
+    int32_t temperature = bmp280CompensateTemperature(519888, calibration, tFine);
+    assertEqual(2508, temperature, "Datasheet temperature 25.08 C");
+    assertEqual(128422, tFine, "Datasheet t_fine");
+    uint32_t pressure = bmp280CompensatePressure(415148, tFine, calibration);
+    Serial.print("pressure Pa: "); Serial.println(pressure / 256.0f, 3);
+    // The datasheet's 100653.27 Pa is from its float routine; its 64-bit
+    // integer routine gives 100653.25
+    assertEqual(25767233, pressure, "Datasheet integer pressure");
+
+    Bmp280Calibration broken = calibration;
+    broken.P1 = 0;
+    assertEqual(0, bmp280CompensatePressure(415148, tFine, broken), "Zero P1 reported, not divided by");
+
+    // Higher adc_P means lower pressure, across the whole ADC range
+    bool monotonic = true;
+    uint32_t previous = 0xFFFFFFFFUL;
+    for (int32_t adc = 200000; adc <= 700000; adc += 5000) {
+        uint32_t p = bmp280CompensatePressure(adc, tFine, calibration);
+        monotonic &= p < previous;
+        previous = p;
+    }
+    assertTrue(monotonic, "Pressure falls as adc_P rises");
+}
+
+void testConversionTime() {
+    Serial.println("\n=== Testing Conversion Times ===");
+    assertEqual(6425, bmp280ConversionUs(Bmp280Oversampling::X1, Bmp280Oversampling::X1), "x1/x1 6.4 ms");
+    assertEqual(13325, bmp280ConversionUs(Bmp280Oversampling::X1, Bmp280Oversampling::X4), "x1/x4 13.3 ms");
+    assertEqual(43225, bmp280ConversionUs(Bmp280Oversampling::X2, Bmp280Oversampling::X16), "x2/x16 43.2 ms");
+    assertEqual(3550, bmp280ConversionUs(Bmp280Oversampling::X1, Bmp280Oversampling::SKIP), "Temperature only");
+
+    Bmp280 sensor;
+    assertTrue(!sensor.isPresent() && !sensor.hasSample(), "No sample before begin");
+    assertEqual(0, sensor.getSampleStartUs(), "No conversion start before a sample");
+    uint32_t readyIn = 1;
+    assertTrue(!sensor.startConversion(0, readyIn), "No conversion without a sensor");
+    assertEqual(1, sensor.getErrors(), "Failed start counted");
+    sensor.configure(Bmp280Oversampling::X2, Bmp280Oversampling::X8, Bmp280Filter::X16);
+    assertEqual(24825, sensor.getConversionUs(), "Settings kept for begin()");
+}
+
+void testAltitudeTable() {
+    Serial.println("\n=== Testing Altitude Table ===");
+    float worst = 0.0f;
+    for (float pa = 30000.0f; pa <= 110000.0f; pa += 37.0f) {
+        float error = fabsf(pressureToAltitude(pa) - isaAltitude(pa, 101325.0f));
+        worst = error > worst ? error : worst;
+    }
+    Serial.print("worst table error m: "); Serial.println(worst, 3);
+    assertTrue(worst < 0.25f, "Within 0.25 m from 30 to 110 kPa");
+
+    float nearGround = 0.0f;
+    for (float pa = 90000.0f; pa <= 105000.0f; pa += 13.0f) {
+        float error = fabsf(pressureToAltitude(pa) - isaAltitude(pa, 101325.0f));
+        nearGround = error > nearGround ? error : nearGround;
+    }
+    assertTrue(nearGround < 0.03f, "Within 3 cm near the ground");
+    assertTrue(fabsf(pressureToAltitude(101325.0f)) < 0.03f, "Zero at standard sea level");
+
+    float qnh = 99800.0f;
+    float error = fabsf(pressureToAltitude(97000.0f, qnh) - isaAltitude(97000.0f, qnh));
+    assertTrue(error < 0.05f, "Follows the sea-level pressure setting");
+    assertTrue(pressureToAltitude(25000.0f) > pressureToAltitude(30000.0f) &&
+               pressureToAltitude(115000.0f) < pressureToAltitude(110000.0f), "Extends past the table ends");
+}
+
+void testSpeed() {
+    Serial.println("\n=== Benchmark: Table vs pow() ===");
+#ifdef ARDUINO
+    const uint16_t iterations = 1000;
+#else
+    const uint32_t iterations = 2000000;
+#endif
+    volatile float sink = 0.0f;
+    volatile float step = 0.37f;
+
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink = sink + isaAltitude(90000.0f + (i & 0x3FFF) * step, 101325.0f);
+    }
+    uint32_t powUs = micros() - start;
+
+    start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink = sink + pressureToAltitude(90000.0f + (i & 0x3FFF) * step);
+    }
+    uint32_t tableUs = micros() - start;
+
+    Serial.print("us per altitude, pow: "); Serial.print((float)powUs / iterations, 3);
+    Serial.print(" table: "); Serial.println((float)tableUs / iterations, 3);
+
+    Bmp280Calibration calibration;
+    bmp280ParseCalibration(DATASHEET_TRIMMING, calibration);
+    start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        int32_t tFine;
+        bmp280CompensateTemperature(519888 + (i & 0xFF), calibration, tFine);
+        sink = sink + bmp280CompensatePressure(415148 + (i & 0xFF), tFine, calibration);
+    }
+    Serial.print("us per compensation: "); Serial.println((float)(micros() - start) / iterations, 3);
+    assertTrue(tableUs < powUs, "Table faster than pow()");
+}
+
+void runAllTests() {
+    Serial.println("Starting BMP280 Driver Unit Tests...");
+    Serial.println("=====================================");
+
+    testCompensation();
+    testConversionTime();
+    testAltitudeTable();
+    testSpeed();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("BMP280 Driver Unit Test Suite");
+    Serial.println("=============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,205 @@
+/**
+ * @file calibration_arena_unit_test.cpp
+ * @brief Unit tests for the shared calibration arena
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Tests lease exclusivity between modules, the streaming mean/covariance
+ * against a two-pass reference, precision with large offsets such as
+ * latitude, and per-channel statistics. Prints the arena size next to the
+ * per-module sample tables it replaces.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/software_utility/calibration_arena.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Stand-ins for the modules leasing the arena
+int navigationModule;
+int airDataModule;
+int panelModule;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertNear(double expected, double actual, double tolerance, const char* testName) {
+    testsRun++;
+    if (fabs(expected - actual) <= tolerance) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected, 6);
+        Serial.print(", Got: ");
+        Serial.println(actual, 6);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Deterministic pseudo-noise in [-1, 1]
+static uint32_t noiseState = 12345;
+float noise() {
+    noiseState = noiseState * 1103515245UL + 12345UL;
+    return ((noiseState >> 16) & 0x7FFF) / 16383.5f - 1.0f;
+}
+
+// Test functions
+void testLeasing() {
+    Serial.println("\n=== Testing Leasing ===");
+    assertTrue(!calibrationArena.isLeased(), "Arena starts free");
+
+    CalibrationStats* nav = calibrationArena.leaseStats(&navigationModule, 6);
+    assertTrue(nav != nullptr && calibrationArena.isOwner(&navigationModule), "First module gets the arena");
+    assertTrue(calibrationArena.leaseStats(&airDataModule, 6) == nullptr, "Second module is refused");
+    assertTrue(calibrationArena.leaseStats(&navigationModule, 3) == nav, "Owner may re-lease");
+
+    calibrationArena.release(&airDataModule);
+    assertTrue(calibrationArena.isOwner(&navigationModule), "Non-owner release ignored");
+    calibrationArena.release(&navigationModule);
+    assertTrue(!calibrationArena.isLeased(), "Owner release frees the arena");
+
+    assertTrue(calibrationArena.leaseChannels(&panelModule, 200) == nullptr, "Oversized lease refused");
+    assertTrue(!calibrationArena.isLeased(), "Refused lease leaves arena free");
+}
+
+void testCovariance() {
+    Serial.println("\n=== Testing Streaming Covariance ===");
+    const uint8_t samples = 100;
+    float data[samples][3];
+    for (uint8_t i = 0; i < samples; i++) {
+        float common = noise();
+        data[i][0] = 1013.25f + 0.5f * common + 0.1f * noise();
+        data[i][1] = 288.15f - 0.2f * common + 0.05f * noise();
+        data[i][2] = 12.0f + noise();
+    }
+
+    CalibrationStats* stats = calibrationArena.leaseStats(&airDataModule, 3);
+    for (uint8_t i = 0; i < samples; i++) {
+        stats->add(data[i]);
+    }
+
+    // Two-pass reference in double
+    double mean[3] = { 0, 0, 0 };
+    for (uint8_t i = 0; i < samples; i++) {
+        for (uint8_t d = 0; d < 3; d++) mean[d] += data[i][d];
+    }
+    for (uint8_t d = 0; d < 3; d++) mean[d] /= samples;
+    double cov01 = 0, var2 = 0;
+    for (uint8_t i = 0; i < samples; i++) {
+        cov01 += (data[i][0] - mean[0]) * (data[i][1] - mean[1]);
+        var2 += (data[i][2] - mean[2]) * (data[i][2] - mean[2]);
+    }
+    cov01 /= samples - 1;
+    var2 /= samples - 1;
+
+    assertTrue(stats->count == samples, "Sample count");
+    assertNear(mean[0], stats->getMean(0), 1e-3, "Pressure mean");
+    assertNear(mean[1], stats->getMean(1), 1e-3, "Temperature mean");
+    assertNear(cov01, stats->getCovariance(0, 1), 1e-4, "Cross covariance");
+    assertTrue(stats->getCovariance(1, 0) == stats->getCovariance(0, 1), "Covariance is symmetric");
+    assertNear(var2, stats->getVariance(2), 1e-4, "Variance");
+    assertTrue(stats->minimum[2] >= 11.0f && stats->maximum[2] <= 13.0f, "Min and max tracked");
+    calibrationArena.release(&airDataModule);
+}
+
+void testLargeOffset() {
+    Serial.println("\n=== Testing Large Offsets ===");
+    CalibrationStats* stats = calibrationArena.leaseStats(&navigationModule, 6);
+    for (uint8_t i = 0; i < 100; i++) {
+        float offset = (i & 1) ? 0.0001f : -0.0001f;
+        stats->add(47.6062f + offset, -122.3321f, 56.0f, 90.0f, 0.0f, 0.0f);
+    }
+    assertNear(47.6062, stats->getMean(0), 1e-4, "Latitude mean");
+    assertNear(1.0e-4, stats->getStdDev(0), 2e-5, "Latitude spread survives the offset");
+    assertNear(0.0, stats->getVariance(1), 1e-12, "Constant longitude has no variance");
+    calibrationArena.release(&navigationModule);
+}
+
+void testChannels() {
+    Serial.println("\n=== Testing IO Channels ===");
+    const uint8_t channels = 64;
+    ChannelStats* stats = calibrationArena.leaseChannels(&panelModule, channels);
+    assertTrue(stats != nullptr, "64 channels fit");
+    for (uint8_t sample = 0; sample < 100; sample++) {
+        for (uint8_t ch = 0; ch < channels; ch++) {
+            stats[ch].add(ch * 16.0f + (sample % 5));
+        }
+    }
+    assertNear(2.0, stats[0].getMean(), 1e-5, "Channel 0 mean");
+    assertNear(63 * 16.0 + 2.0, stats[63].getMean(), 1e-3, "Channel 63 mean");
+    assertNear(2.0202, stats[10].getVariance(), 1e-3, "Channel variance");
+    assertTrue(stats[5].minimum == 80.0f && stats[5].maximum == 84.0f, "Channel range");
+    calibrationArena.release(&panelModule);
+}
+
+void testFootprint() {
+    Serial.println("\n=== Footprint ===");
+    Serial.print("Arena bytes: ");
+    Serial.println(CalibrationArena::getCapacity());
+    Serial.print("High water: ");
+    Serial.println(calibrationArena.getHighWater());
+    Serial.print("Replaced tables (float on AVR): nav ");
+    Serial.print(100 * 6 * 4);
+    Serial.print(", air data ");
+    Serial.print(100 * 6 * 4 + 4 * 100 * 4);
+    Serial.print(", panel IO ");
+    Serial.println(64 * 100 * 4);
+    assertTrue(calibrationArena.getHighWater() <= CalibrationArena::getCapacity(), "High water within arena");
+}
+
+void runAllTests() {
+    Serial.println("Starting Calibration Arena Unit Tests...");
+    Serial.println("=====================================");
+
+    testLeasing();
+    testCovariance();
+    testLargeOffset();
+    testChannels();
+    testFootprint();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Calibration Arena Unit Test Suite");
+    Serial.println("=================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,392 @@
+/**
+ * @file config_store_unit_test.cpp
+ * @brief Unit tests for the log-structured EEPROM configuration store
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Runs the store against a RAM-backed EEPROM that counts reads and writes
+ * per cell and can lose power after a set number of byte writes. Covers
+ * save/load across reboots, versioned images, a power cut at every byte
+ * of a record, a corrupted newest record, wrapping around fixed records,
+ * wear spread, the single-pass boot scan, the YMFC setup import and the
+ * SystemParams and IMUCalibration bindings.
+ */
+
+#include <Arduino.h>
+#include "../../modules/hardware_hiding/extended_computer/config_store.h"
+#include "../../modules/behavior_hiding/shared_services/system_params.h"
+#include "../../modules/hardware_hiding/device_interface/inertial_measurement_interface.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// RAM stand-in for the EEPROM; writeBudget < 0 means no power cut
+static const uint16_t EEPROM_SIZE = 576;
+static const uint16_t REGION_BASE = CONFIG_STORE_BASE;
+static const uint16_t REGION_SIZE = EEPROM_SIZE - REGION_BASE;
+
+struct FakeEeprom {
+    uint8_t cells[EEPROM_SIZE];
+    uint16_t wear[EEPROM_SIZE];
+    uint32_t reads;
+    long writeBudget;
+};
+
+static FakeEeprom eeprom;
+
+uint8_t fakeRead(void* context, uint16_t address) {
+    FakeEeprom* memory = static_cast<FakeEeprom*>(context);
+    memory->reads++;
+    return memory->cells[address];
+}
+
+void fakeWrite(void* context, uint16_t address, uint8_t value) {
+    FakeEeprom* memory = static_cast<FakeEeprom*>(context);
+    if (memory->writeBudget == 0) {
+        return;
+    }
+    if (memory->writeBudget > 0 && --memory->writeBudget == 0) {
+        value ^= 0x5A;      // The byte being written when power went is torn
+    }
+    memory->cells[address] = value;
+    memory->wear[address]++;
+}
+
+void eraseEeprom() {
+    memset(eeprom.cells, 0xFF, sizeof(eeprom.cells));
+    memset(eeprom.wear, 0, sizeof(eeprom.wear));
+    eeprom.reads = 0;
+    eeprom.writeBudget = -1;
+}
+
+// Power-up: a fresh store scans what is in the fake EEPROM
+void boot(ConfigStore& store) {
+    store.attach(fakeRead, fakeWrite, &eeprom, REGION_BASE, REGION_SIZE);
+    store.begin();
+}
+
+uint32_t loadWord(const ConfigStore& store, uint8_t key) {
+    uint32_t value = 0;
+    uint8_t version;
+    return store.load(key, &value, sizeof(value), version) == sizeof(value) ? value : 0;
+}
+
+// Test functions
+void testSaveLoad() {
+    Serial.println("\n=== Testing Save and Load ===");
+    eraseEeprom();
+    ConfigStore store;
+    assertTrue(!store.begin(), "Unattached store refuses to start");
+    boot(store);
+    assertTrue(store.isReady() && !store.has(5), "Erased EEPROM starts empty");
+    assertEqual(0, store.getHead(), "Head starts at the region start");
+
+    uint32_t value = 0x12345678;
+    assertTrue(store.save(5, 1, &value, sizeof(value)), "Save");
+    value = 0xCAFEF00D;
+    assertTrue(store.save(5, 1, &value, sizeof(value)), "Save again");
+    assertEqual((long)0xCAFEF00D, (long)loadWord(store, 5), "Newest copy loads");
+
+    ConfigStore rebooted;
+    boot(rebooted);
+    assertEqual((long)0xCAFEF00D, (long)loadWord(rebooted, 5), "Newest copy survives reboot");
+    assertEqual((long)store.getHead(), (long)rebooted.getHead(), "Head recovered after the newest record");
+    assertEqual(2, (long)rebooted.getSequence(), "Sequence recovered");
+
+    char big[CONFIG_MAX_PAYLOAD + 1];
+    assertTrue(!rebooted.save(6, 1, big, sizeof(big)), "Oversized payload refused");
+    assertTrue(!rebooted.save(CONFIG_MAX_KEYS, 1, &value, sizeof(value)), "Key out of range refused");
+    uint8_t tiny[2];
+    uint8_t version;
+    assertEqual(0, rebooted.load(5, tiny, sizeof(tiny), version), "Short buffer refused");
+}
+
+struct Image {
+    float a, b;
+    uint8_t flags;
+};
+
+void testImages() {
+    Serial.println("\n=== Testing Versioned Images ===");
+    eraseEeprom();
+    ConfigStore store;
+    boot(store);
+
+    Image saved = { 1.5f, -2.25f, 3 };
+    Image loaded = { 0, 0, 0 };
+    store.saveImage(7, 2, saved);
+    assertTrue(store.loadImage(7, 2, loaded) && loaded.b == -2.25f && loaded.flags == 3, "Image round trip");
+
+    Image untouched = { 9.0f, 9.0f, 9 };
+    assertTrue(!store.loadImage(7, 3, untouched) && untouched.a == 9.0f, "Other version reads as missing");
+    uint32_t word;
+    assertTrue(!store.loadImage(7, 2, word), "Other size reads as missing");
+
+    IMUCalibration calibration = { 0.1f, -0.2f, 0.3f, 1.5f, -0.5f, 0.25f, 36.5f, true };
+    store.saveImage(CONFIG_KEY_IMU_CALIBRATION, IMU_CALIBRATION_VERSION, calibration);
+    ConfigStore rebooted;
+    boot(rebooted);
+    IMUCalibration restored = {};
+    assertTrue(rebooted.loadImage(CONFIG_KEY_IMU_CALIBRATION, IMU_CALIBRATION_VERSION, restored) &&
+               restored.gyro_offset_y == -0.5f && restored.is_calibrated, "IMU calibration survives reboot");
+}
+
+void testPowerLoss() {
+    Serial.println("\n=== Testing Power Loss During a Write ===");
+    const uint16_t recordBytes = CONFIG_RECORD_OVERHEAD + sizeof(uint32_t);
+    uint16_t consistent = 0;
+    uint16_t recovered = 0;
+    uint16_t committed = 0;
+
+    // Cut the power after every possible number of bytes, with the head
+    // at different places in the region
+    for (uint16_t history = 0; history < 60; history += 7) {
+        for (uint16_t cut = 0; cut <= recordBytes; cut++) {
+            eraseEeprom();
+            ConfigStore store;
+            boot(store);
+            for (uint32_t i = 0; i <= history; i++) {
+                uint32_t filler = 1000 + i;
+                store.save(3, 1, &filler, sizeof(filler));
+            }
+            uint32_t before = loadWord(store, 3);
+            uint32_t after = 0xA5A5A5A5;
+
+            eeprom.writeBudget = cut + 1;     // cut bytes land, the next one tears
+            store.save(3, 1, &after, sizeof(after));
+            eeprom.writeBudget = -1;
+
+            ConfigStore rebooted;
+            boot(rebooted);
+            uint32_t found = loadWord(rebooted, 3);
+            if (found == before || (found == after && cut == recordBytes)) {
+                consistent++;
+            }
+            if (found == after) {
+                committed++;
+            }
+            uint32_t retry = 42;
+            if (rebooted.save(3, 1, &retry, sizeof(retry))) {
+                ConfigStore again;
+                boot(again);
+                if (loadWord(again, 3) == retry) {
+                    recovered++;
+                }
+            }
+        }
+    }
+    const uint16_t trials = 9 * (recordBytes + 1);
+    assertEqual(trials, consistent, "Every cut leaves the old or the complete new value");
+    assertEqual(9, committed, "Only a complete record commits");
+    assertEqual(trials, recovered, "Saving after the cut works");
+}
+
+void testCorruption() {
+    Serial.println("\n=== Testing Corrupted Record ===");
+    eraseEeprom();
+    ConfigStore store;
+    boot(store);
+    uint32_t first = 111, second = 222;
+    store.save(4, 1, &first, sizeof(first));
+    store.save(4, 1, &second, sizeof(second));
+
+    // Flip a payload bit of the newest copy
+    uint16_t newest = CONFIG_RECORD_OVERHEAD + sizeof(first);
+    eeprom.cells[REGION_BASE + newest + CONFIG_RECORD_HEADER] ^= 0x04;
+    assertEqual(0, (long)loadWord(store, 4), "Load re-checks the CRC");
+
+    ConfigStore rebooted;
+    boot(rebooted);
+    assertEqual(111, (long)loadWord(rebooted, 4), "Boot falls back to the previous copy");
+}
+
+void testWrapAndWear() {
+    Serial.println("\n=== Testing Wrap and Wear ===");
+    eraseEeprom();
+    ConfigStore store;
+    boot(store);
+
+    uint8_t fixed[40];
+    for (uint8_t i = 0; i < sizeof(fixed); i++) fixed[i] = i;
+    store.save(1, 1, fixed, sizeof(fixed));
+
+    const uint16_t saves = 2000;
+    bool allSaved = true;
+    for (uint16_t i = 0; i < saves; i++) {
+        uint32_t value = i;
+        allSaved &= store.save(20 + (i % 8), 1, &value, sizeof(value));
+    }
+    assertTrue(allSaved, "Every save succeeds across laps");
+    assertTrue(store.getLaps() > 10, "Head wrapped many times");
+
+    ConfigStore rebooted;
+    boot(rebooted);
+    uint8_t loaded[40];
+    uint8_t version;
+    assertTrue(rebooted.load(1, loaded, sizeof(loaded), version) == sizeof(loaded) &&
+               memcmp(loaded, fixed, sizeof(fixed)) == 0, "Unchanged record survives every lap");
+    assertEqual(saves - 1, (long)loadWord(rebooted, 20 + ((saves - 1) % 8)), "Newest record found");
+    assertEqual(saves - 2, (long)loadWord(rebooted, 20 + ((saves - 2) % 8)), "Other keys found");
+
+    // Wear: the average cell outside the fixed record sees one write per
+    // lap; no cell should see much more
+    uint16_t hottest = 0;
+    for (uint16_t i = REGION_BASE; i < EEPROM_SIZE; i++) {
+        if (eeprom.wear[i] > hottest) hottest = eeprom.wear[i];
+    }
+    uint32_t average = store.getBytesWritten() / (REGION_SIZE - sizeof(fixed) - CONFIG_RECORD_OVERHEAD);
+    Serial.print("bytes written: "); Serial.println(store.getBytesWritten());
+    Serial.print("average writes/cell: "); Serial.println(average);
+    Serial.print("hottest cell: "); Serial.println(hottest);
+    assertTrue(hottest <= average + average / 4 + 2, "Writes spread across the region");
+    assertTrue(hottest < saves / 4, "Far fewer writes per cell than saves");
+}
+
+void testBootScan() {
+    Serial.println("\n=== Testing Boot Scan ===");
+    eraseEeprom();
+    ConfigStore store;
+    boot(store);
+    for (uint16_t i = 0; i < 300; i++) {
+        uint32_t value = i;
+        store.save(16 + (i % 27), 1, &value, sizeof(value));
+    }
+
+    eeprom.reads = 0;
+    ConfigStore rebooted;
+    unsigned long start = micros();
+    boot(rebooted);
+    unsigned long elapsed = micros() - start;
+    Serial.print("boot reads: "); Serial.print(eeprom.reads);
+    Serial.print(" for "); Serial.print(REGION_SIZE); Serial.print(" bytes, us: ");
+    Serial.println(elapsed);
+    assertTrue(eeprom.reads < 2u * REGION_SIZE, "Boot reads the region about once");
+    assertEqual(299, (long)loadWord(rebooted, 16 + (299 % 27)), "Newest of many keys found");
+}
+
+void testLegacyImport() {
+    Serial.println("\n=== Testing YMFC Setup Import ===");
+    eraseEeprom();
+    for (uint8_t i = 0; i < CONFIG_LEGACY_SETUP_SIZE; i++) eeprom.cells[i] = i;
+    eeprom.cells[33] = 'J';
+    eeprom.cells[34] = 'M';
+    eeprom.cells[35] = 'B';
+
+    ConfigStore store;
+    boot(store);
+    assertTrue(store.importLegacySetup(), "Signed setup imported");
+    assertTrue(!store.importLegacySetup(), "Imported only once");
+    uint8_t setup[CONFIG_LEGACY_SETUP_SIZE];
+    uint8_t version;
+    assertTrue(store.load(CONFIG_KEY_RECEIVER_SETUP, setup, sizeof(setup), version) == sizeof(setup) &&
+               setup[31] == 31 && setup[35] == 'B', "Setup bytes preserved");
+    assertEqual(31, eeprom.cells[31], "Legacy bytes left in place");
+
+    eraseEeprom();
+    ConfigStore blank;
+    boot(blank);
+    assertTrue(!blank.importLegacySetup(), "Unsigned EEPROM not imported");
+}
+
+void testParamBinding() {
+    Serial.println("\n=== Testing SystemParams Binding ===");
+    eraseEeprom();
+    ConfigStore store;
+    boot(store);
+
+    SystemParams params;
+    params.set<Param::RollP>(2.5f);
+    params.set<Param::ThrottleIdle>(1150);
+    params.set<Param::AutoLevel>(false);
+    params.set<Param::DebugOutput>(true);
+    assertEqual(3, params.flushAll(storeParamRecord, &store), "Dirty persistent params stored");
+
+    ConfigStore rebooted;
+    boot(rebooted);
+    SystemParams loaded;
+    assertEqual(3, loadParamRecords(loaded, rebooted), "Stored params restored");
+    assertTrue(loaded.get<Param::RollP>() == 2.5f && loaded.get<Param::ThrottleIdle>() == 1150 &&
+               !loaded.get<Param::AutoLevel>(), "Values match");
+    assertTrue(!loaded.get<Param::DebugOutput>(), "Non-persistent param not stored");
+    assertEqual(0, loaded.getDirtyCount(), "Restored params are clean");
+
+    uint16_t first = beginParamEpoch(loaded, rebooted);
+    SystemParams next;
+    assertEqual(first + 1, beginParamEpoch(next, rebooted), "Each boot a new epoch");
+    assertEqual(first + 1, next.getEpoch(), "Params numbered in the new epoch");
+}
+
+void runAllTests() {
+    Serial.println("Starting Config Store Unit Tests...");
+    Serial.println("=====================================");
+
+    testSaveLoad();
+    testImages();
+    testPowerLoss();
+    testCorruption();
+    testWrapAndWear();
+    testBootScan();
+    testLegacyImport();
+    testParamBinding();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Config Store Unit Test Suite");
+    Serial.println("============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,184 @@
+/**
+ * @file deferred_log_unit_test.cpp
+ * @brief Unit tests for deferred-formatting event logging
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Tests record encoding, ring buffer overflow handling and the cost of a
+ * DLOG_WARNING call compared with building the equivalent String message.
+ */
+
+#include <Arduino.h>
+#include "../../modules/behavior_hiding/shared_services/deferred_log.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Test functions
+void testRecordEncoding() {
+    Serial.println("\n=== Testing Record Encoding ===");
+    deferredLog.clear();
+
+    uint16_t elapsed = 850;
+    assertTrue(DLOG_WARNING(IMU_READ_TIMEOUT, elapsed), "Record accepted");
+
+    uint8_t record[DLOG_MAX_RECORD_SIZE];
+    uint8_t length = 0;
+    assertTrue(deferredLog.pop(record, length), "Record popped");
+    assertEqual(DLOG_HEADER_SIZE + 1 + sizeof(uint16_t), length, "Record length");
+    assertEqual((long)LogFormatId::IMU_READ_TIMEOUT, deferredRecordId(record), "Format ID");
+    assertEqual(DLOG_LEVEL_WARNING, deferredRecordLevel(record), "Level");
+    assertEqual(sizeof(uint16_t), record[DLOG_HEADER_SIZE] & 0x0F, "Argument width tag");
+
+    uint16_t decoded;
+    memcpy(&decoded, record + DLOG_HEADER_SIZE + 1, sizeof(decoded));
+    assertEqual(850, decoded, "Argument value");
+    assertTrue(deferredLog.isEmpty(), "Ring empty after pop");
+}
+
+void testMixedArguments() {
+    Serial.println("\n=== Testing Mixed Arguments ===");
+    deferredLog.clear();
+
+    DLOG_INFO(IMU_CALIBRATED, 0.125f, -1.5f, 2.0f);
+    DLOG_ERROR(IMU_SATURATED, (uint8_t)2, (int16_t)-32768);
+
+    uint8_t record[DLOG_MAX_RECORD_SIZE];
+    uint8_t length = 0;
+    assertTrue(deferredLog.pop(record, length), "Float record popped");
+    assertEqual(DLOG_HEADER_SIZE + 3 * 5, length, "Three float arguments");
+    assertTrue((record[DLOG_HEADER_SIZE] & DLOG_ARG_FLOAT) != 0, "Float tag set");
+
+    assertTrue(deferredLog.pop(record, length), "Integer record popped");
+    assertTrue((record[DLOG_HEADER_SIZE + 2] & DLOG_ARG_SIGNED) != 0, "Signed tag set");
+    assertEqual(DLOG_LEVEL_ERROR, deferredRecordLevel(record), "Error level");
+}
+
+void testOverflow() {
+    Serial.println("\n=== Testing Ring Overflow ===");
+    deferredLog.clear();
+
+    uint16_t accepted = 0;
+    for (uint16_t i = 0; i < 100; i++) {
+        if (DLOG_INFO(BOOT_COMPLETE, (uint32_t)i)) {
+            accepted++;
+        }
+    }
+
+    assertTrue(accepted < 100, "Ring fills up");
+    assertEqual(100 - accepted, deferredLog.getDroppedCount(), "Dropped entries counted");
+    assertEqual(100 - accepted, deferredLog.takeDroppedCount(), "Dropped count taken");
+    assertEqual(0, deferredLog.getDroppedCount(), "Dropped count reset");
+
+    uint8_t record[DLOG_MAX_RECORD_SIZE];
+    uint8_t length = 0;
+    uint32_t first;
+    deferredLog.pop(record, length);
+    memcpy(&first, record + DLOG_HEADER_SIZE + 1, sizeof(first));
+    assertEqual(0, first, "Oldest record kept");
+}
+
+void testTiming() {
+    Serial.println("\n=== Testing Call Cost ===");
+    const uint16_t iterations = 1000;
+    float voltage = 10.87;
+
+    deferredLog.clear();
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        DLOG_WARNING(BATTERY_LOW, voltage);
+        if (deferredLog.available() > DEFERRED_LOG_CAPACITY / 2) {
+            deferredLog.clear();
+        }
+    }
+    unsigned long deferredTime = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        String message = "battery low: " + String(voltage, 2) + " V";
+        if (message.length() == 0) {
+            Serial.println(message);
+        }
+    }
+    unsigned long stringTime = micros() - start;
+
+    Serial.print("DLOG_WARNING: ");
+    Serial.print((float)deferredTime / iterations);
+    Serial.println(" us/call");
+    Serial.print("String message: ");
+    Serial.print((float)stringTime / iterations);
+    Serial.println(" us/call");
+
+    assertTrue(deferredTime < stringTime, "Deferred logging cheaper than String formatting");
+}
+
+void runAllTests() {
+    Serial.println("Starting Deferred Log Unit Tests...");
+    Serial.println("=====================================");
+
+    testRecordEncoding();
+    testMixedArguments();
+    testOverflow();
+    testTiming();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Deferred Log Unit Test Suite");
+    Serial.println("============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
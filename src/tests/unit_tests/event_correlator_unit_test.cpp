@@ -0,0 +1,346 @@
+/**
+ * @file event_correlator_unit_test.cpp
+ * @brief Unit tests for interned-ID correlation rule matching
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks name interning, trigger/required/excluded logic, the timeout and
+ * minDelay/maxDelay windows, and that the inverted index keeps untouched
+ * rules out of evaluation, that a rebuild keeps the history, and that the
+ * correlator fits its SRAM budget. A benchmark with a full table of 32
+ * rules compares the correlator against a linear scan of every rule
+ * comparing names as strings, the way rules were matched before.
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include "../../modules/software_decision/data_banker/event_correlator.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static EventInterner eventNames;
+static EventCorrelator correlator(eventNames);
+
+// Fresh names, rules and history
+static void resetCorrelator() {
+    eventNames.clear();
+    correlator.clear();
+}
+
+static uint8_t addRule(const char* trigger, const char* required, const char* excluded,
+                       uint32_t minDelay, uint32_t maxDelay, uint32_t timeout) {
+    StringView t[1] = { StringView(trigger) };
+    StringView r[1] = { StringView(required ? required : "") };
+    StringView x[1] = { StringView(excluded ? excluded : "") };
+    EventRuleSpec spec = { t, 1, r, (uint8_t)(required ? 1 : 0), x, (uint8_t)(excluded ? 1 : 0),
+                           minDelay, maxDelay, timeout };
+    return correlator.addRule(spec);
+}
+
+static bool fires(const char* name, uint32_t now, uint8_t rule) {
+    EventSet fired;
+    correlator.onEvent(StringView(name), now, fired);
+    return fired.test(rule);
+}
+
+// Test functions
+void testEventSet() {
+    Serial.println("\n=== Testing Event Sets ===");
+    EventSet a, b;
+    a.clear();
+    b.clear();
+    a.set(0); a.set(31); a.set(32); a.set(63);
+    assertEqual(4, a.count(), "Count across words");
+    assertEqual(31, a.next(1), "Next within a word");
+    assertEqual(63, a.next(33), "Next across words");
+    assertEqual(EVENT_ID_NONE, b.next(0), "Next on empty set");
+    b.set(32);
+    assertTrue(a.covers(b) && a.intersects(b) && !b.covers(a), "Covers and intersects");
+    a.reset(32);
+    assertTrue(!a.intersects(b), "Reset clears the bit");
+}
+
+void testInterning() {
+    Serial.println("\n=== Testing Interning ===");
+    EventInterner names;
+    uint8_t gps = names.intern(StringView("GPS_FIX"));
+    uint8_t arm = names.intern(StringView("ARMED"));
+    assertTrue(gps != arm && gps != EVENT_ID_NONE, "Distinct names get distinct IDs");
+    assertEqual(gps, names.intern(StringView("GPS_FIX")), "Same name, same ID");
+    assertEqual(arm, names.find(StringView("ARMED")), "Find by name");
+    assertEqual(EVENT_ID_NONE, names.find(StringView("ARM")), "Prefix is not a match");
+    assertTrue(strcmp(names.getName(gps), "GPS_FIX") == 0, "Name kept");
+    assertEqual(EVENT_ID_NONE, names.intern(StringView("")), "Empty name refused");
+    assertEqual(EVENT_ID_NONE, names.intern(StringView("AN_EVENT_NAME_LONGER_THAN_31_CHARS")), "Long name refused");
+
+    char name[8];
+    bool filled = true;
+    for (uint8_t i = names.getCount(); i < EVENT_ID_MAX; i++) {
+        snprintf(name, sizeof(name), "E%u", i);
+        filled &= names.intern(StringView(name)) == i;
+    }
+    assertTrue(filled, "Table fills to EVENT_ID_MAX");
+    assertEqual(EVENT_ID_NONE, names.intern(StringView("ONE_MORE")), "Full table refuses");
+    assertEqual(gps, names.find(StringView("GPS_FIX")), "Lookups survive a full table");
+}
+
+void testRuleLogic() {
+    Serial.println("\n=== Testing Rule Logic ===");
+    resetCorrelator();
+    uint8_t plain = addRule("TAKEOFF", NULL, NULL, 0, 0, 0);
+    uint8_t needs = addRule("LAND", "GPS_LOST", NULL, 0, 0, 0);
+    uint8_t blocked = addRule("ARM", NULL, "FAILSAFE", 0, 0, 1000);
+
+    assertTrue(fires("TAKEOFF", 10, plain), "Trigger-only rule fires");
+    assertTrue(!fires("LAND", 20, needs), "Required event missing");
+    assertTrue(!fires("UNKNOWN", 30, needs), "Unknown name is ignored");
+    fires("GPS_LOST", 40, needs);
+    assertTrue(fires("LAND", 50, needs), "Required event seen");
+
+    assertTrue(fires("ARM", 100, blocked), "No excluded event");
+    fires("FAILSAFE", 200, blocked);
+    assertTrue(!fires("ARM", 300, blocked), "Excluded event blocks");
+    assertTrue(fires("ARM", 1300, blocked), "Excluded event ages out of timeout");
+
+    correlator.enableRule(plain, false);
+    assertTrue(!fires("TAKEOFF", 1400, plain), "Disabled rule does not fire");
+    correlator.resetHistory();
+    assertTrue(!fires("LAND", 1500, needs), "Reset forgets history");
+    assertEqual(EVENT_ID_NONE, addRule("", NULL, NULL, 0, 0, 0), "Rule without trigger refused");
+}
+
+void testTiming() {
+    Serial.println("\n=== Testing Timing Windows ===");
+    resetCorrelator();
+    uint8_t windowed = addRule("B", "A", NULL, 100, 500, 0);
+    uint8_t timed = addRule("D", "C", NULL, 0, 0, 1000);
+
+    fires("A", 0, windowed);
+    assertTrue(!fires("B", 50, windowed), "Before minDelay");
+    assertTrue(fires("B", 300, windowed), "Inside window");
+    assertTrue(!fires("B", 600, windowed), "After maxDelay");
+    fires("A", 600, windowed);
+    assertTrue(fires("B", 700, windowed), "Newest required event counts");
+
+    fires("C", 1000, timed);
+    assertTrue(fires("D", 2000, timed), "Within timeout");
+    assertTrue(!fires("D", 2001, timed), "Required event timed out");
+    fires("C", 0xFFFFFF00UL, timed);
+    assertTrue(fires("D", 0x00000100UL, timed), "Window across millis() wrap");
+}
+
+void testInvertedIndex() {
+    Serial.println("\n=== Testing Inverted Index ===");
+    resetCorrelator();
+    char trigger[8];
+    for (uint8_t i = 0; i < EVENT_RULE_MAX; i++) {
+        snprintf(trigger, sizeof(trigger), "T%u", i % 8);
+        addRule(trigger, NULL, NULL, 0, 0, 0);
+    }
+    assertEqual(EVENT_RULE_MAX, correlator.getRuleCount(), "Table holds EVENT_RULE_MAX rules");
+    assertEqual(EVENT_ID_NONE, addRule("T0", NULL, NULL, 0, 0, 0), "Full rule table refuses");
+
+    EventSet fired;
+    uint32_t before = correlator.getEvaluations();
+    uint8_t count = correlator.onEvent(StringView("T5"), 0, fired);
+    assertEqual(4, correlator.getEvaluations() - before, "Only the triggered rules are evaluated");
+    assertEqual(4, count, "Each of them fires");
+    assertTrue(fired.test(5) && fired.test(13) && fired.test(21) && fired.test(29), "Fired set holds their indexes");
+
+    before = correlator.getEvaluations();
+    correlator.onEvent(StringView("NOT_A_RULE_EVENT"), 0, fired);
+    assertEqual(0, correlator.getEvaluations() - before, "Unmentioned names evaluate nothing");
+}
+
+void testRebuild() {
+    Serial.println("\n=== Testing Rebuild and Footprint ===");
+    resetCorrelator();
+    addRule("LAND", "GPS_LOST", NULL, 0, 0, 0);
+    fires("GPS_LOST", 100, 0);
+
+    // What ComplexEventsModule does when another rule changes
+    correlator.clearRules();
+    assertEqual(0, correlator.getRuleCount(), "Rules dropped");
+    uint8_t gpsLost = correlator.findEvent(StringView("GPS_LOST"));
+    uint8_t readded = addRule("LAND", "GPS_LOST", NULL, 0, 0, 0);
+    assertEqual(gpsLost, correlator.findEvent(StringView("GPS_LOST")), "Event IDs kept");
+    assertTrue(fires("LAND", 200, readded), "History kept across the rebuild");
+
+    correlator.clear();
+    assertTrue(!fires("LAND", 300, addRule("LAND", "GPS_LOST", NULL, 0, 0, 0)), "Clear forgets the history");
+    assertEqual(gpsLost, correlator.findEvent(StringView("GPS_LOST")), "Names belong to the interner");
+
+    Serial.print("sizeof(EventCorrelator): "); Serial.println((unsigned long)sizeof(EventCorrelator));
+    Serial.print("sizeof(EventInterner): "); Serial.println((unsigned long)sizeof(EventInterner));
+    assertTrue(sizeof(EventCorrelator) + sizeof(EventInterner) <= 3072, "Correlator and names within 3 KB of SRAM");
+}
+
+// Linear string matching, as the module did it before: every rule checked
+// on every event, names compared as strings against a recent-event list
+struct StringRule {
+    const char* trigger;
+    const char* required;
+};
+
+static const uint8_t RECENT_MAX = 32;
+static const char* recent[RECENT_MAX];
+static uint8_t recentCount = 0;
+
+static uint8_t linearMatch(const StringRule* rules, uint8_t count, const char* event) {
+    uint8_t fired = 0;
+    for (uint8_t r = 0; r < count; r++) {
+        if (strcmp(rules[r].trigger, event) != 0) {
+            continue;
+        }
+        for (uint8_t i = 0; i < recentCount; i++) {
+            if (strcmp(recent[i], rules[r].required) == 0) {
+                fired++;
+                break;
+            }
+        }
+    }
+    if (recentCount < RECENT_MAX) {
+        recent[recentCount++] = event;
+    } else {
+        memmove(recent, recent + 1, (RECENT_MAX - 1) * sizeof(recent[0]));
+        recent[RECENT_MAX - 1] = event;
+    }
+    return fired;
+}
+
+void benchmarkMatching() {
+    Serial.println("\n=== Benchmark: 32 Rules ===");
+    static char triggerNames[EVENT_RULE_MAX][12];
+    static char requiredNames[EVENT_RULE_MAX][12];
+    static StringRule stringRules[EVENT_RULE_MAX];
+
+    resetCorrelator();
+    for (uint8_t i = 0; i < EVENT_RULE_MAX; i++) {
+        snprintf(triggerNames[i], sizeof(triggerNames[i]), "SENSOR_%u", i % 48);
+        snprintf(requiredNames[i], sizeof(requiredNames[i]), "MODE_%u", i % 16);
+        stringRules[i].trigger = triggerNames[i];
+        stringRules[i].required = requiredNames[i];
+        StringView t[1] = { StringView(triggerNames[i]) };
+        StringView r[1] = { StringView(requiredNames[i]) };
+        EventRuleSpec spec = { t, 1, r, 1, NULL, 0, 0, 0, 0 };
+        correlator.addRule(spec);
+    }
+
+    // A stream mixing rule events with names no rule mentions
+    static const uint16_t STREAM = 64;
+    static const char* stream[STREAM];
+    static char other[16][12];
+    for (uint8_t i = 0; i < 16; i++) {
+        snprintf(other[i], sizeof(other[i]), "STATUS_%u", i);
+    }
+    for (uint16_t i = 0; i < STREAM; i++) {
+        switch (i % 4) {
+            case 0: stream[i] = triggerNames[(i * 7) % EVENT_RULE_MAX]; break;
+            case 1: stream[i] = requiredNames[((i - 1) * 7) % EVENT_RULE_MAX]; break;
+            default: stream[i] = other[i % 16]; break;
+        }
+    }
+
+    const uint16_t rounds = 200;
+    uint32_t linearFired = 0;
+    uint32_t indexedFired = 0;
+    EventSet fired;
+
+    unsigned long start = micros();
+    for (uint16_t round = 0; round < rounds; round++) {
+        for (uint16_t i = 0; i < STREAM; i++) {
+            linearFired += linearMatch(stringRules, EVENT_RULE_MAX, stream[i]);
+        }
+    }
+    unsigned long linearTime = micros() - start;
+
+    start = micros();
+    for (uint16_t round = 0; round < rounds; round++) {
+        for (uint16_t i = 0; i < STREAM; i++) {
+            indexedFired += correlator.onEvent(StringView(stream[i]), round, fired);
+        }
+    }
+    unsigned long indexedTime = micros() - start;
+
+    float events = (float)rounds * STREAM;
+    Serial.print("linear strcmp us/event: "); Serial.println(linearTime / events, 3);
+    Serial.print("interned bitset us/event: "); Serial.println(indexedTime / events, 3);
+    Serial.print("rules evaluated per event: "); Serial.println(correlator.getEvaluations() / events, 3);
+    assertTrue(indexedFired > 0 && linearFired > 0, "Both fire on the stream");
+    assertTrue(indexedTime < linearTime, "Interned matching is faster");
+}
+
+void runAllTests() {
+    Serial.println("Starting Event Correlator Unit Tests...");
+    Serial.println("=====================================");
+
+    testEventSet();
+    testInterning();
+    testRuleLogic();
+    testTiming();
+    testInvertedIndex();
+    testRebuild();
+    benchmarkMatching();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Event Correlator Unit Test Suite");
+    Serial.println("================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
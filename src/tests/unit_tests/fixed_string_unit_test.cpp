@@ -0,0 +1,282 @@
+/**
+ * @file fixed_string_unit_test.cpp
+ * @brief Unit tests for FixedString and StringView
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Tests truncation, number formatting, views and comparisons, and checks
+ * that setting error and event text in a loop never touches the heap,
+ * both directly and through AirDataInterface update cycles.
+ * On the board the heap top (__brkval) must not move; on the host every
+ * operator new call is counted. Build with air_data_interface.cpp, trace.cpp,
+ * bmp280_driver.cpp, i2c_bus.cpp, timer_clock.cpp and time_base.cpp.
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include "../../modules/software_decision/application_data_types/fixed_string.h"
+#include "../../modules/hardware_hiding/device_interface/air_data_interface.h"
+
+#ifndef ARDUINO
+#include <cstdlib>
+#include <new>
+
+static unsigned long heapAllocations = 0;
+
+void* operator new(size_t size) {
+    heapAllocations++;
+    void* block = malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void operator delete(void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+#endif
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+void assertText(const char* expected, const char* actual, const char* testName) {
+    testsRun++;
+    if (strcmp(expected, actual) == 0) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Heap usage probe: allocations on the host, heap top on the board
+unsigned long heapMark() {
+#ifdef ARDUINO
+    extern char* __brkval;
+    return (unsigned long)__brkval;
+#else
+    return heapAllocations;
+#endif
+}
+
+// Shaped like the module state converted from String
+struct ModuleState {
+    ErrorText lastError;
+    EventText description;
+    NameText source;
+};
+
+void recordError(ModuleState& state, StringView message, uint8_t sensor) {
+    state.lastError = message;
+    state.lastError += " (sensor ";
+    state.lastError += sensor;
+    state.lastError += ')';
+}
+
+// Test functions
+void testAssignAndTruncate() {
+    Serial.println("\n=== Testing Assign and Truncate ===");
+    FixedString<8> text("abc");
+    assertEqual(3, text.length(), "Length after assign");
+    assertTrue(!text.isTruncated(), "Short text not truncated");
+
+    text = "abcdefghijkl";
+    assertText("abcdefgh", text.c_str(), "Long text cut at capacity");
+    assertTrue(text.isTruncated(), "Truncation flagged");
+
+    text.clear();
+    assertTrue(text.isEmpty() && !text.isTruncated(), "Clear resets flag");
+
+    text = "1234567";
+    text += "89";
+    assertText("12345678", text.c_str(), "Append stops at capacity");
+    assertTrue(text.isTruncated(), "Append truncation flagged");
+}
+
+void testNumbers() {
+    Serial.println("\n=== Testing Number Formatting ===");
+    FixedString<31> text;
+    text += -1234;
+    text += ' ';
+    text += 4000000000UL;
+    text += ' ';
+    text += 3.14159f;
+    assertText("-1234 4000000000 3.14", text.c_str(), "Integers and float");
+
+    text.clear();
+    text.append(-0.005, 2);
+    text += ' ';
+    text.append(2.5, 0);
+    assertText("-0.01 3", text.c_str(), "Rounding matches Print");
+
+    text.clear();
+    text += (long)-2147483647L - 1;
+    assertText("-2147483648", text.c_str(), "Most negative long");
+
+    // Widest unsigned long on this target (20 digits where long is 64-bit)
+    char expected[24];
+    snprintf(expected, sizeof(expected), "%lu", ULONG_MAX);
+    text.clear();
+    text += ULONG_MAX;
+    assertText(expected, text.c_str(), "Largest unsigned long");
+
+    text.clear();
+    text.append(1e30, 2);
+    text += ' ';
+    text.append(-1e30, 0);
+    assertText("ovf -ovf", text.c_str(), "Out-of-range floats marked, not cast");
+
+    text.clear();
+    text += NAN;
+    text += ' ';
+    text += -INFINITY;
+    assertText("nan inf", text.c_str(), "NaN and infinity");
+}
+
+void testViews() {
+    Serial.println("\n=== Testing Views ===");
+    StringView command("SET ROLL_P 4.5");
+    assertTrue(command.startsWith("SET"), "startsWith");
+    assertEqual(3, command.indexOf(' '), "indexOf");
+
+    StringView name = command.substring(4, 10);
+    assertEqual(6, name.length(), "Substring length");
+    assertTrue(name == "ROLL_P", "Substring compares by content");
+
+    NameText copy(name);
+    assertText("ROLL_P", copy.c_str(), "Copy from view is terminated");
+    assertTrue(copy == name && copy != "ROLL_I", "FixedString comparisons");
+
+    EventText wider(copy);
+    assertTrue(wider.equals(copy), "Copy across capacities");
+
+    // Source and destination overlap when a string takes its own substring
+    EventText self("SET ROLL_P 4.5");
+    self.assign(self.view().substring(4));
+    assertText("ROLL_P 4.5", self.c_str(), "Assign from own substring");
+    self += self.view().substring(0, 4);
+    assertText("ROLL_P 4.5ROLL", self.c_str(), "Append own substring");
+}
+
+void testNoHeapUse() {
+    Serial.println("\n=== Testing Heap Use ===");
+    ModuleState state;
+
+    unsigned long before = heapMark();
+    for (uint8_t cycle = 0; cycle < 100; cycle++) {
+        recordError(state, "No valid sensor readings", cycle);
+        state.description = "Altitude hold engaged";
+        state.source = state.lastError.view().substring(0, 9);
+        state.lastError.clear();
+    }
+    unsigned long after = heapMark();
+
+    assertEqual(0, (long)(after - before), "100 update cycles leave the heap alone");
+    assertText("No valid ", state.source.c_str(), "State holds last values");
+    assertEqual(sizeof(ErrorText) + sizeof(EventText) + sizeof(NameText), sizeof(ModuleState),
+                "Text is stored inline");
+}
+
+// A converted module: every update and error path writes its ErrorText
+AirDataInterface airData;
+
+void testModuleUpdate() {
+    Serial.println("\n=== Testing Heap Use in a Module Update ===");
+    AirDataMeasurement measurement;
+    airData.addSensor(AirDataSensorType::STATIC_PRESSURE, 0x76);
+    // First pass binds the driver and registers with the bus
+    airData.update();
+    airData.getAirData(measurement);
+
+    unsigned long before = heapMark();
+    for (uint8_t cycle = 0; cycle < 100; cycle++) {
+        airData.update();
+        airData.getAirData(measurement);
+        airData.addSensor(AirDataSensorType::STATIC_PRESSURE, 0x76);
+        airData.clearErrors();
+    }
+    unsigned long after = heapMark();
+
+    assertEqual(0, (long)(after - before), "100 AirDataInterface update cycles leave the heap alone");
+    airData.addSensor(AirDataSensorType::STATIC_PRESSURE, 0x76);
+    assertText("Sensor address already in use", airData.getLastError(), "Module error text kept inline");
+}
+
+void runAllTests() {
+    Serial.println("Starting FixedString Unit Tests...");
+    Serial.println("=====================================");
+
+    testAssignAndTruncate();
+    testNumbers();
+    testViews();
+    testNoHeapUse();
+    testModuleUpdate();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("FixedString Unit Test Suite");
+    Serial.println("===========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,292 @@
+/**
+ * @file flight_recorder_unit_test.cpp
+ * @brief Unit tests for the crash-safe flight recorder ring
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Runs the recorder against a small RAM block device. Covers session
+ * numbering, recovery in sequence order, ring wrap, corrupted blocks and a
+ * simulated power loss that tears a block halfway through programming.
+ */
+
+#include <Arduino.h>
+#include "../../modules/behavior_hiding/shared_services/flight_recorder.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// RAM block device; tearAfter simulates power loss on the Nth write
+const uint8_t TEST_BLOCKS = 4;
+uint8_t device[TEST_BLOCKS][FLIGHT_BLOCK_SIZE];
+int16_t tearAfter = -1;
+uint16_t deviceWrites = 0;
+uint8_t scratch[FLIGHT_BLOCK_SIZE];
+
+bool readTestBlock(void* context, uint32_t block, uint8_t* buffer) {
+    memcpy(buffer, device[block], FLIGHT_BLOCK_SIZE);
+    return true;
+}
+
+bool writeTestBlock(void* context, uint32_t block, const uint8_t* buffer) {
+    if (tearAfter >= 0 && deviceWrites >= (uint16_t)tearAfter) {
+        if (deviceWrites == (uint16_t)tearAfter) {
+            // Power fails with half the block programmed
+            memcpy(device[block], buffer, FLIGHT_BLOCK_SIZE / 2);
+        }
+        deviceWrites++;
+        return false;
+    }
+    memcpy(device[block], buffer, FLIGHT_BLOCK_SIZE);
+    deviceWrites++;
+    return true;
+}
+
+// Recovered stream is checked against the generator instead of being stored
+uint32_t recoveredBytes = 0;
+uint32_t mismatches = 0;
+uint16_t gapLines = 0;
+
+char expectedByte(uint32_t position) {
+    // Fixed 16-byte records: "R0000012,000120\n"
+    static char record[24];
+    uint32_t index = position / 16;
+    snprintf(record, sizeof(record), "R%07lu,%06lu\n", (unsigned long)index, (unsigned long)(index * 10));
+    return record[position % 16];
+}
+
+bool checkRecovered(void* context, const char* data, uint16_t length) {
+    const char* line = data[0] == '\n' ? data + 1 : data;
+    if (length < 16 && line[0] == '@' && line[1] == 'G') {
+        gapLines++;
+        return true;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        if (data[i] != expectedByte(recoveredBytes + i)) {
+            mismatches++;
+        }
+    }
+    recoveredBytes += length;
+    return true;
+}
+
+void resetSink() {
+    recoveredBytes = 0;
+    mismatches = 0;
+    gapLines = 0;
+}
+
+uint32_t writeRecords(FlightRecorder& recorder, uint32_t first, uint32_t count) {
+    char record[24];
+    uint32_t accepted = 0;
+    for (uint32_t i = first; i < first + count; i++) {
+        snprintf(record, sizeof(record), "R%07lu,%06lu\n", (unsigned long)i, (unsigned long)(i * 10));
+        if (recorder.append(record, 16, i * 10)) {
+            accepted++;
+        }
+    }
+    return accepted;
+}
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+void assertFalse(bool condition, const char* testName) {
+    assertTrue(!condition, testName);
+}
+
+// Test functions
+void testRecordAndRecover(FlightRecorder& recorder) {
+    Serial.println("\n=== Testing Record and Recover ===");
+    memset(device, 0xFF, sizeof(device));
+    tearAfter = -1;
+
+    assertTrue(recorder.begin(), "Recorder starts on blank region");
+    assertEqual(1, recorder.getSession(), "First session is 1");
+    assertEqual(0, recorder.getSequence(), "First sequence is 0");
+
+    // 60 records = 960 bytes: one full block plus a partial one
+    assertEqual(60, writeRecords(recorder, 0, 60), "Records appended");
+    assertEqual(1, recorder.getBlocksWritten(), "Full block written");
+    assertTrue(recorder.end(), "Partial block sealed on end");
+
+    FlightRecoveryResult result;
+    resetSink();
+    assertTrue(recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 0, checkRecovered, nullptr,
+                                    recorder.getIdleBuffer(), result), "Latest session recovered");
+    assertEqual(1, result.session, "Recovered session");
+    assertEqual(2, result.blocksRecovered, "Blocks recovered");
+    assertEqual(0, result.blocksMissing, "No blocks missing");
+    assertEqual(960, recoveredBytes, "All bytes recovered");
+    assertEqual(0, mismatches, "Stream matches");
+    assertEqual(590, result.lastTimestamp, "Last timestamp");
+}
+
+void testRingWrap(FlightRecorder& recorder) {
+    Serial.println("\n=== Testing Ring Wrap ===");
+    assertTrue(recorder.begin(), "Second session starts");
+    assertEqual(2, recorder.getSession(), "Session incremented");
+    assertEqual(2, recorder.getSequence(), "Sequence continues");
+
+    // 6 full blocks into a 4-block ring
+    writeRecords(recorder, 0, 6 * FLIGHT_BLOCK_PAYLOAD_SIZE / 16);
+    recorder.end();
+    assertEqual(6, recorder.getBlocksWritten(), "Six blocks written");
+
+    FlightRecoveryResult result;
+    resetSink();
+    uint8_t* block = recorder.getIdleBuffer();
+    assertTrue(recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 2, checkRecovered, nullptr,
+                                    block, result), "Wrapped session recovered");
+    assertEqual(TEST_BLOCKS, result.blocksRecovered, "Newest blocks kept");
+    assertEqual(result.lastSequence - TEST_BLOCKS + 1, result.firstSequence, "Oldest blocks overwritten");
+    assertFalse(recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 1, checkRecovered, nullptr,
+                                     block, result), "Previous session fully overwritten");
+}
+
+void testCorruptBlock(FlightRecorder& recorder) {
+    Serial.println("\n=== Testing Corrupt Block ===");
+    FlightRecoveryResult result;
+    uint8_t* block = recorder.getIdleBuffer();
+    recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 2, checkRecovered, nullptr, block, result);
+
+    // Flip one payload bit in the second-oldest block
+    uint32_t victim = (result.firstSequence + 1) % TEST_BLOCKS;
+    device[victim][FLIGHT_BLOCK_HEADER_SIZE + 10] ^= 0x01;
+
+    resetSink();
+    assertTrue(recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 2, checkRecovered, nullptr,
+                                    block, result), "Session recovered around bad block");
+    assertEqual(1, result.blocksMissing, "Bad block reported missing");
+    assertEqual(1, gapLines, "Gap marker written");
+}
+
+void testPowerLoss(FlightRecorder& recorder) {
+    Serial.println("\n=== Testing Power Loss ===");
+    memset(device, 0xFF, sizeof(device));
+    assertTrue(recorder.begin(), "Recorder starts");
+
+    // Third block write is torn and nothing after it reaches the card
+    deviceWrites = 0;
+    tearAfter = 2;
+    uint32_t perBlock = FLIGHT_BLOCK_PAYLOAD_SIZE / 16;
+    writeRecords(recorder, 0, perBlock * 3 + 5);
+    assertEqual(1, recorder.getWriteErrors(), "Torn write reported");
+    tearAfter = -1;
+
+    // After the reboot only what reached the card is left; the recorder never ended
+    FlightRecoveryResult result;
+    resetSink();
+    assertTrue(recoverFlightSession(readTestBlock, nullptr, TEST_BLOCKS, 0, checkRecovered, nullptr,
+                                    scratch, result), "Crashed session recovered");
+    assertEqual(1, result.session, "Crashed session found");
+    assertEqual(2, result.blocksRecovered, "Committed blocks survive");
+    assertEqual(2 * FLIGHT_BLOCK_PAYLOAD_SIZE, recoveredBytes, "Committed bytes survive");
+    assertEqual(0, mismatches, "Stream intact up to the tear");
+
+    assertTrue(recorder.begin(), "Recorder restarts after power loss");
+    assertEqual(2, recorder.getSession(), "New session after crash");
+    assertEqual(2, recorder.getSequence(), "Torn block's sequence reused");
+    recorder.end();
+}
+
+void testTiming(FlightRecorder& recorder) {
+    Serial.println("\n=== Testing Hot Path Cost ===");
+    memset(device, 0xFF, sizeof(device));
+    recorder.begin();
+
+    const uint16_t iterations = 500;
+    char record[17] = "R0000000,000000\n";
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        recorder.append(record, 16, i);
+    }
+    unsigned long appendTime = micros() - start;
+    recorder.end();
+
+    memset(scratch, 0x5A, sizeof(scratch));
+    start = micros();
+    volatile uint32_t crc = flightBlockCrc(scratch);
+    unsigned long crcTime = micros() - start;
+    (void)crc;
+
+    Serial.print("append (16 bytes, incl. block writes): ");
+    Serial.print((float)appendTime / iterations);
+    Serial.println(" us/record");
+    Serial.print("Block CRC32: ");
+    Serial.print(crcTime);
+    Serial.println(" us/block");
+    assertTrue(recorder.getBlocksWritten() == (iterations * 16UL + FLIGHT_BLOCK_PAYLOAD_SIZE - 1) / FLIGHT_BLOCK_PAYLOAD_SIZE,
+               "One write per filled block");
+}
+
+void runAllTests() {
+    Serial.println("Starting Flight Recorder Unit Tests...");
+    Serial.println("=====================================");
+
+    static FlightRecorder recorder;
+    recorder.attach(readTestBlock, writeTestBlock, nullptr, TEST_BLOCKS);
+
+    testRecordAndRecover(recorder);
+    testRingWrap(recorder);
+    testCorruptBlock(recorder);
+    testPowerLoss(recorder);
+    testTiming(recorder);
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Flight Recorder Unit Test Suite");
+    Serial.println("===============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,278 @@
+/**
+ * @file gyro_bias_model_unit_test.cpp
+ * @brief Unit tests for the gyro bias against temperature model
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Feeds GyroBiasModel still windows from a simulated gyro whose bias
+ * follows a known curve in temperature. Checks the boot decision (model,
+ * moving, no model, disagrees), the degree growing with the temperatures
+ * seen, fading of old observations, and the round trip through ConfigStore.
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+#include "../../modules/hardware_hiding/device_interface/gyro_bias_model.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+void assertNear(float expected, float actual, float tolerance, const char* testName) {
+    testsRun++;
+    if (fabs(expected - actual) <= tolerance) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected, 4);
+        Serial.print(", Got: ");
+        Serial.println(actual, 4);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Simulated gyro: bias in deg/s curving with temperature, plus noise
+static float biasShift = 0.0f;
+static uint32_t seed = 2024;
+
+static float uniform() {
+    seed = seed * 1664525UL + 1013904223UL;
+    return (seed >> 8) / 16777216.0f;
+}
+
+static float trueBias(uint8_t axis, float temperatureC) {
+    static const float OFFSET[3] = { -1.2f, 0.8f, 0.3f };
+    static const float SLOPE[3] = { 0.03f, -0.02f, 0.01f };
+    static const float CURVE[3] = { 0.0010f, 0.0005f, -0.0008f };
+    float d = temperatureC - 25.0f;
+    return OFFSET[axis] + biasShift + SLOPE[axis] * d + CURVE[axis] * d * d;
+}
+
+// A window of samples at one temperature; motion adds rotation noise
+static void fillWindow(CalibrationStats& window, float temperatureC, float motion, uint16_t samples = 75) {
+    window.begin(GYRO_BIAS_WINDOW_DIMS);
+    for (uint16_t n = 0; n < samples; n++) {
+        float sample[GYRO_BIAS_WINDOW_DIMS];
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            float noise = (2.0f * uniform() - 1.0f) * (0.05f + motion);
+            sample[axis] = trueBias(axis, temperatureC) + noise;
+        }
+        sample[3] = temperatureC + (uniform() - 0.5f) * 0.1f;
+        window.add(sample);
+    }
+}
+
+// A full calibration: the bias at a temperature, measured well
+static void calibrateAt(GyroBiasModel& model, float temperatureC) {
+    float bias[3] = { trueBias(0, temperatureC), trueBias(1, temperatureC), trueBias(2, temperatureC) };
+    model.addObservation(bias, temperatureC, GYRO_BIAS_CALIBRATION_WEIGHT);
+}
+
+// RAM stand-in for the EEPROM
+static uint8_t cells[512];
+
+uint8_t fakeRead(void* context, uint16_t address) {
+    return static_cast<uint8_t*>(context)[address];
+}
+
+void fakeWrite(void* context, uint16_t address, uint8_t value) {
+    static_cast<uint8_t*>(context)[address] = value;
+}
+
+// Test functions
+void testBootDecision() {
+    Serial.println("\n=== Testing Boot Decision ===");
+    GyroBiasModel model;
+    CalibrationStats window;
+    float bias[3];
+
+    fillWindow(window, 22.0f, 0.0f);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::NO_MODEL, "Empty model: calibrate");
+
+    calibrateAt(model, 22.0f);
+    assertEqual(1, model.getTerms(), "One temperature: a constant");
+    fillWindow(window, 23.5f, 0.0f);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::MODEL, "Near the calibration: model used");
+    assertNear(trueBias(0, 22.0f), bias[0], 0.01f, "Model bias returned");
+
+    fillWindow(window, 23.5f, 3.0f);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::MOVING, "Handled vehicle: try again");
+    fillWindow(window, 23.5f, 0.0f, 20);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::MOVING, "Window too short");
+
+    fillWindow(window, 35.0f, 0.0f);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::NO_MODEL, "Far outside the range seen");
+
+    biasShift = 0.6f;
+    fillWindow(window, 22.5f, 0.0f);
+    assertTrue(model.checkBoot(window, bias) == GyroBootResult::DISAGREES, "Shifted bias caught");
+    biasShift = 0.0f;
+}
+
+void testLearning() {
+    Serial.println("\n=== Testing Learning Over Temperature ===");
+    GyroBiasModel model;
+    CalibrationStats window;
+
+    // Boots on cold and warm days, each one calibration plus still windows
+    // while the IMU warms up
+    const float days[] = { 8.0f, 15.0f, 22.0f, 30.0f, 38.0f };
+    for (uint8_t d = 0; d < 5; d++) {
+        calibrateAt(model, days[d]);
+        for (uint8_t w = 1; w <= 4; w++) {
+            fillWindow(window, days[d] + w * 1.5f, 0.0f);
+            model.addStillWindow(window);
+        }
+        if (d == 1) {
+            assertEqual(2, model.getTerms(), "Line once the range widens");
+        }
+    }
+    assertEqual(3, model.getTerms(), "Quadratic over a wide range");
+    assertEqual(8, model.getMinTemperature(), "Coldest seen");
+    assertEqual(44, model.getMaxTemperature(), "Warmest seen");
+
+    float worst = 0.0f;
+    for (float t = 8.0f; t <= 44.0f; t += 2.0f) {
+        float bias[3];
+        model.predict(t, bias);
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            float error = fabs(bias[axis] - trueBias(axis, t));
+            worst = error > worst ? error : worst;
+        }
+    }
+    assertTrue(worst < 0.02f, "Curve recovered within 0.02 deg/s");
+
+    fillWindow(window, 40.0f, 2.0f);
+    float before = model.getWeight();
+    assertTrue(!model.addStillWindow(window), "Moving window not learned");
+    assertNear(before, model.getWeight(), 1e-4f, "Weight unchanged");
+}
+
+void testFading() {
+    Serial.println("\n=== Testing Fading ===");
+    GyroBiasModel model;
+    for (uint8_t i = 0; i < 40; i++) {
+        calibrateAt(model, 20.0f);
+    }
+    assertNear(GYRO_BIAS_MAX_WEIGHT, model.getWeight(), 0.01f, "Total weight capped");
+
+    // The sensor ages: new calibrations take over
+    biasShift = 0.5f;
+    for (uint8_t i = 0; i < 60; i++) {
+        calibrateAt(model, 20.0f);
+    }
+    float bias[3];
+    model.predict(20.0f, bias);
+    assertNear(trueBias(0, 20.0f), bias[0], 0.05f, "Aged bias followed");
+    biasShift = 0.0f;
+
+    model.clear();
+    assertEqual(0, model.getTerms(), "Cleared");
+    assertTrue(!model.predict(20.0f, bias), "Nothing predicted after clear");
+}
+
+void testPersistence() {
+    Serial.println("\n=== Testing Persistence ===");
+    memset(cells, 0xFF, sizeof(cells));
+    ConfigStore store;
+    store.attach(fakeRead, fakeWrite, cells, CONFIG_STORE_BASE, sizeof(cells) - CONFIG_STORE_BASE);
+    store.begin();
+
+    GyroBiasModel model;
+    calibrateAt(model, 12.0f);
+    calibrateAt(model, 30.0f);
+    assertTrue(model.save(store), "Model saved");
+
+    ConfigStore rebooted;
+    rebooted.attach(fakeRead, fakeWrite, cells, CONFIG_STORE_BASE, sizeof(cells) - CONFIG_STORE_BASE);
+    rebooted.begin();
+    GyroBiasModel loaded;
+    assertTrue(loaded.load(rebooted), "Model loaded after a reboot");
+    assertEqual(model.getTerms(), loaded.getTerms(), "Same degree");
+    float a[3];
+    float b[3];
+    model.predict(20.0f, a);
+    loaded.predict(20.0f, b);
+    assertNear(a[1], b[1], 1e-6f, "Same prediction");
+
+    GyroBiasModel empty;
+    memset(cells, 0xFF, sizeof(cells));
+    rebooted.begin();
+    assertTrue(!empty.load(rebooted), "Missing record reported");
+}
+
+void runAllTests() {
+    Serial.println("Starting Gyro Bias Model Unit Tests...");
+    Serial.println("=====================================");
+
+    testBootDecision();
+    testLearning();
+    testFading();
+    testPersistence();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Gyro Bias Model Unit Test Suite");
+    Serial.println("===============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,288 @@
+/**
+ * @file i2c_bus_unit_test.cpp
+ * @brief Unit tests for the shared I2C bus manager
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Drives I2cBus through a simulated bus holding a few devices. Checks the
+ * registry, WHO_AM_I verification and step-wise probing, per-device
+ * transfer statistics, and recovery of a bus held low by a slave.
+ */
+
+#include <Arduino.h>
+#include "../../modules/hardware_hiding/extended_computer/i2c_bus.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Simulated bus: an MPU6050, a BMP280 and a chip at 0x1E that is not an
+// HMC5883L. Each device's registers are one byte holding register + id.
+struct SimDevice {
+    uint8_t address;
+    uint8_t idRegister;
+    uint8_t id;
+};
+
+struct SimBus {
+    SimDevice devices[3];
+    uint8_t pointer;            // Register set by the last write
+    bool stuck;                 // SDA held low until recovered
+    uint8_t clocksToRelease;    // Recovery clocks the slave needs
+    uint16_t transfers;
+    uint16_t recoverCalls;
+};
+
+static SimBus sim;
+
+static const SimDevice* simFind(uint8_t address) {
+    for (uint8_t i = 0; i < 3; i++) {
+        if (sim.devices[i].address == address) {
+            return &sim.devices[i];
+        }
+    }
+    return nullptr;
+}
+
+static uint8_t simWrite(void*, uint8_t address, const uint8_t* data, uint8_t length, bool) {
+    sim.transfers++;
+    if (sim.stuck) {
+        return (uint8_t)I2cResult::TIMEOUT;
+    }
+    if (simFind(address) == nullptr) {
+        return (uint8_t)I2cResult::NAK_ADDRESS;
+    }
+    if (length > 0) {
+        sim.pointer = data[0];
+    }
+    return (uint8_t)I2cResult::OK;
+}
+
+static uint8_t simRead(void*, uint8_t address, uint8_t* data, uint8_t length) {
+    const SimDevice* device = simFind(address);
+    if (sim.stuck || device == nullptr) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t reg = sim.pointer + i;
+        data[i] = reg == device->idRegister ? device->id : reg;
+    }
+    return length;
+}
+
+static bool simRecover(void*) {
+    sim.recoverCalls++;
+    if (sim.clocksToRelease <= I2C_RECOVERY_CLOCKS) {
+        sim.stuck = false;
+    }
+    return !sim.stuck;
+}
+
+static const I2cTransport SIM_TRANSPORT = { simWrite, simRead, simRecover };
+
+static void resetSim() {
+    sim.devices[0] = { 0x68, 0x75, 0x68 };
+    sim.devices[1] = { 0x76, 0xD0, 0x58 };
+    sim.devices[2] = { 0x1E, 0x0A, 0x55 };
+    sim.pointer = 0;
+    sim.stuck = false;
+    sim.clocksToRelease = 3;
+    sim.transfers = 0;
+    sim.recoverCalls = 0;
+}
+
+// Test functions
+void testRegistry() {
+    Serial.println("\n=== Testing Device Registry ===");
+    resetSim();
+    I2cBus bus;
+    assertTrue(bus.ping(0x68) == I2cResult::NOT_ATTACHED, "Nothing sent before attach");
+    bus.attach(&SIM_TRANSPORT, nullptr);
+
+    uint8_t imu = bus.addDevice(I2C_DEVICE_MPU6050);
+    uint8_t baro = bus.addDevice(I2C_DEVICE_BMP280);
+    uint8_t baro2 = bus.addDevice(I2C_DEVICE_BMP280_SECONDARY);
+    uint8_t compass = bus.addDevice(I2C_DEVICE_HMC5883L);
+    assertEqual(4, bus.getDeviceCount(), "Four devices registered");
+    assertEqual(baro, bus.addDevice(I2C_DEVICE_BMP280), "Same address, same handle");
+    assertEqual(imu, bus.findDevice(0x68), "Found by address");
+    assertEqual(I2C_NO_DEVICE, bus.findDevice(0x50), "Unknown address");
+    assertTrue(bus.getDevice(imu).state == I2cDeviceState::UNKNOWN, "Unknown before the probe");
+
+    // Step-wise probing: one device per call
+    uint8_t steps = 0;
+    while (bus.probeStep()) {
+        steps++;
+        assertEqual(steps, sim.transfers, "One transfer per step");
+    }
+    assertEqual(4, steps, "Every device probed once");
+    assertTrue(bus.isPresent(imu) && bus.isPresent(baro), "Expected chips present");
+    assertTrue(bus.getDevice(baro2).state == I2cDeviceState::MISSING, "Empty address missing");
+    assertTrue(bus.getDevice(compass).state == I2cDeviceState::WRONG_ID, "Wrong WHO_AM_I caught");
+    assertEqual(0x55, bus.getDevice(compass).lastId, "WHO_AM_I kept");
+    assertTrue(!bus.probeStep(), "Nothing left to probe");
+
+    sim.devices[1].id = 0x60;
+    assertTrue(bus.probe(baro) == I2cDeviceState::PRESENT, "Alternate WHO_AM_I accepted");
+
+    // Waiting on one device steps only as far as it
+    resetSim();
+    I2cBus stepped;
+    stepped.attach(&SIM_TRANSPORT, nullptr);
+    stepped.addDevice(I2C_DEVICE_MPU6050);
+    uint8_t steppedBaro = stepped.addDevice(I2C_DEVICE_BMP280);
+    uint8_t steppedCompass = stepped.addDevice(I2C_DEVICE_HMC5883L);
+    assertTrue(stepped.awaitProbe(steppedBaro) == I2cDeviceState::PRESENT, "Awaited device checked");
+    assertEqual(2, sim.transfers, "Devices before it checked on the way");
+    assertTrue(stepped.getDevice(steppedCompass).state == I2cDeviceState::UNKNOWN, "Later device left for later steps");
+    assertTrue(stepped.awaitProbe(steppedBaro) == I2cDeviceState::PRESENT && sim.transfers == 2, "Known state not probed again");
+    assertTrue(stepped.awaitProbe(I2C_NO_DEVICE) == I2cDeviceState::UNKNOWN, "Bad handle");
+
+    I2cBus small;
+    bool filled = true;
+    for (uint8_t i = 0; i < I2C_MAX_DEVICES; i++) {
+        I2cDeviceSpec spec = { (uint8_t)(0x10 + i), false, 0, 0, 0 };
+        filled &= small.addDevice(spec) == i;
+    }
+    I2cDeviceSpec extra = { 0x70, false, 0, 0, 0 };
+    assertTrue(filled && small.addDevice(extra) == I2C_NO_DEVICE, "Registry full");
+}
+
+void testStatistics() {
+    Serial.println("\n=== Testing Transfer Statistics ===");
+    resetSim();
+    I2cBus bus;
+    bus.attach(&SIM_TRANSPORT, nullptr);
+    uint8_t imu = bus.addDevice(I2C_DEVICE_MPU6050);
+    uint8_t baro2 = bus.addDevice(I2C_DEVICE_BMP280_SECONDARY);
+
+    uint8_t data[6];
+    bool read = true;
+    for (uint8_t i = 0; i < 10; i++) {
+        read &= bus.readRegisters(0x68, 0x3B, data, 6) == I2cResult::OK;
+    }
+    assertTrue(read && data[0] == 0x3B && data[5] == 0x40, "Register burst read");
+    assertTrue(bus.writeRegister(0x68, 0x6B, 0x00) == I2cResult::OK, "Register write");
+    assertEqual(11, bus.getStats(imu).transactions, "Transactions per device");
+    assertEqual(0, I2cBus::failurePercent(bus.getStats(imu)), "No failures");
+
+    for (uint8_t i = 0; i < 4; i++) {
+        bus.ping(0x77);
+    }
+    assertEqual(4, bus.getStats(baro2).naks, "NAKs counted");
+    assertEqual(100, I2cBus::failurePercent(bus.getStats(baro2)), "NAK rate");
+    assertEqual(0, bus.getRecoveries(), "NAKs do not trigger recovery");
+
+    bus.ping(0x50);
+    assertEqual(1, bus.getStats(I2C_NO_DEVICE).naks, "Unregistered address counted apart");
+    assertTrue(bus.getStats(imu).maxUs >= I2cBus::averageUs(bus.getStats(imu)), "Latency recorded");
+
+    bus.resetStats();
+    assertEqual(0, bus.getStats(imu).transactions, "Statistics reset");
+}
+
+void testRecovery() {
+    Serial.println("\n=== Testing Bus Recovery ===");
+    resetSim();
+    I2cBus bus;
+    bus.attach(&SIM_TRANSPORT, nullptr);
+    uint8_t imu = bus.addDevice(I2C_DEVICE_MPU6050);
+
+    sim.stuck = true;
+    uint8_t data[2];
+    assertTrue(bus.readRegisters(0x68, 0x75, data, 1) == I2cResult::TIMEOUT, "Stuck bus times out");
+    assertEqual(0, sim.recoverCalls, "One timeout is not yet a stuck bus");
+    bus.readRegisters(0x68, 0x75, data, 1);
+    assertEqual(1, sim.recoverCalls, "Recovered after repeated timeouts");
+    assertEqual(2, bus.getStats(imu).timeouts, "Timeouts counted");
+    assertTrue(bus.readRegisters(0x68, 0x75, data, 1) == I2cResult::OK && data[0] == 0x68, "Transfers work again");
+
+    // A slave that needs more clocks than recovery gives it stays stuck
+    sim.stuck = true;
+    sim.clocksToRelease = I2C_RECOVERY_CLOCKS + 1;
+    bus.ping(0x68);
+    bus.ping(0x68);
+    assertEqual(2, bus.getRecoveries(), "Second recovery attempted");
+    assertEqual(1, bus.getFailedRecoveries(), "Failed recovery counted");
+
+    // A success between faults starts the count again
+    sim.stuck = false;
+    sim.clocksToRelease = 3;
+    bus.recover();
+    sim.stuck = true;
+    bus.ping(0x68);
+    sim.stuck = false;
+    bus.ping(0x68);
+    sim.stuck = true;
+    bus.ping(0x68);
+    assertEqual(3, bus.getRecoveries(), "Isolated timeouts do not trigger recovery");
+}
+
+void runAllTests() {
+    Serial.println("Starting I2C Bus Unit Tests...");
+    Serial.println("=====================================");
+
+    testRegistry();
+    testStatistics();
+    testRecovery();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("I2C Bus Unit Test Suite");
+    Serial.println("=======================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
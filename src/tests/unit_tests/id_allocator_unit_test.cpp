@@ -0,0 +1,311 @@
+/**
+ * @file id_allocator_unit_test.cpp
+ * @brief Unit tests and benchmark for IdBitmap, ExpiryHeap and ValueIndex
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks lowest-free allocation and release in the two-level bitmap, heap
+ * order under schedule/reschedule/cancel against a brute-force reference,
+ * and value lookup after random inserts and erases. The benchmark fills a
+ * 1024-slot table like SingularValues and times generation, lookup,
+ * release and expiry against the linear scans they replace.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/software_utility/id_allocator.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static const uint16_t CAPACITY = 1024;
+
+static uint32_t rngState = 12345;
+uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Test functions
+void testBitmap() {
+    Serial.println("\n=== Testing Id Bitmap ===");
+    static IdBitmap<CAPACITY> ids;
+    ids.reset();
+
+    bool inOrder = true;
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        inOrder &= ids.acquire() == i;
+    }
+    assertTrue(inOrder, "Ids come out lowest first");
+    assertEqual(ID_NONE, ids.acquire(), "Full bitmap returns ID_NONE");
+
+    ids.release(700);
+    ids.release(33);
+    ids.release(1023);
+    assertEqual(3, ids.getFreeCount(), "Free count tracks releases");
+    assertEqual(33, ids.acquire(), "Lowest released id first");
+    assertEqual(700, ids.acquire(), "Then the next one");
+    assertTrue(!ids.release(CAPACITY) && !ids.release(1023), "Out of range and double release refused");
+    assertTrue(ids.acquire(1023) && !ids.acquire(1023), "Claim a specific id once");
+
+    IdBitmap<40> small;
+    for (uint8_t i = 0; i < 40; i++) small.acquire();
+    assertEqual(ID_NONE, small.acquire(), "Partial last word never hands out padding");
+}
+
+void testHeap() {
+    Serial.println("\n=== Testing Expiry Heap ===");
+    static ExpiryHeap<CAPACITY> heap;
+    static uint32_t due[CAPACITY];
+    static bool scheduled[CAPACITY];
+    memset(scheduled, 0, sizeof(scheduled));
+
+    // Random schedule / reschedule / cancel, with times around the
+    // millis() wrap, then drain and compare with a brute-force minimum
+    const uint32_t base = 0xFFFF0000UL;
+    for (uint16_t step = 0; step < 5000; step++) {
+        uint16_t id = nextRandom() % CAPACITY;
+        if (nextRandom() % 4 == 0) {
+            heap.cancel(id);
+            scheduled[id] = false;
+        } else {
+            due[id] = base + nextRandom() % 200000;
+            heap.schedule(id, due[id]);
+            scheduled[id] = true;
+        }
+    }
+    uint16_t expected = 0;
+    for (uint16_t id = 0; id < CAPACITY; id++) expected += scheduled[id];
+    assertEqual(expected, heap.getCount(), "Count matches reference");
+
+    bool ordered = true;
+    bool matches = true;
+    uint32_t previous = base;
+    uint16_t id;
+    uint16_t popped = 0;
+    while (heap.popDue(base + 300000, id)) {
+        ordered &= (int32_t)(due[id] - previous) >= 0;
+        matches &= scheduled[id];
+        previous = due[id];
+        scheduled[id] = false;
+        popped++;
+    }
+    assertTrue(ordered, "Pops come out in due order across the wrap");
+    assertTrue(matches && popped == expected, "Every scheduled id popped once");
+
+    heap.schedule(5, 1000);
+    assertTrue(!heap.popDue(999, id), "Nothing due early");
+    heap.schedule(5, 500);
+    assertTrue(heap.popDue(999, id) && id == 5, "Rescheduled sooner");
+}
+
+static uint32_t slotValues[CAPACITY];
+
+struct SlotKey {
+    uint32_t operator()(uint16_t slot) const { return slotValues[slot]; }
+};
+
+void testValueIndex() {
+    Serial.println("\n=== Testing Value Index ===");
+    static ValueIndex<CAPACITY> index;
+    static bool present[CAPACITY];
+    memset(present, 0, sizeof(present));
+    index.clear();
+
+    // Clustered values (sequential ids) and random ones, with churn
+    bool found = true;
+    for (uint16_t step = 0; step < 20000; step++) {
+        uint16_t slot = nextRandom() % CAPACITY;
+        if (present[slot]) {
+            found &= index.find(slotValues[slot], SlotKey()) == slot;
+            index.erase(slotValues[slot], SlotKey());
+            present[slot] = false;
+        } else {
+            uint32_t value = (step & 1) ? nextRandom() | 1 : 1000 + step;
+            if (index.find(value, SlotKey()) != ID_NONE) {
+                continue;
+            }
+            slotValues[slot] = value;
+            index.insert(value, slot);
+            present[slot] = true;
+        }
+    }
+    assertTrue(found, "Inserted values found before erase");
+
+    bool consistent = true;
+    for (uint16_t slot = 0; slot < CAPACITY; slot++) {
+        uint16_t hit = index.find(slotValues[slot], SlotKey());
+        consistent &= present[slot] ? hit == slot : hit == ID_NONE;
+    }
+    assertTrue(consistent, "Index agrees with the table after churn");
+}
+
+// Benchmark: the table SingularValues keeps, with and without the indexes
+struct Entry {
+    uint32_t value;
+    uint32_t expires;
+    bool used;
+};
+
+static Entry table[CAPACITY];
+static IdBitmap<CAPACITY> benchIds;
+static ValueIndex<CAPACITY> benchIndex;
+static ExpiryHeap<CAPACITY> benchHeap;
+
+struct TableKey {
+    uint32_t operator()(uint16_t slot) const { return table[slot].value; }
+};
+
+uint16_t linearFree() {
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        if (!table[i].used) return i;
+    }
+    return ID_NONE;
+}
+
+uint16_t linearFind(uint32_t value) {
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        if (table[i].used && table[i].value == value) return i;
+    }
+    return ID_NONE;
+}
+
+void testBenchmark() {
+    Serial.println("\n=== Benchmark: 1024-slot table at full capacity ===");
+    const uint16_t rounds = 2000;
+
+    // Linear: fill the table, then churn one value per round
+    memset(table, 0, sizeof(table));
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        table[i].value = 1 + i;
+        table[i].expires = 100000 + i;
+        table[i].used = true;
+    }
+    uint32_t nextValue = CAPACITY + 1;
+    unsigned long start = micros();
+    for (uint16_t r = 0; r < rounds; r++) {
+        uint16_t victim = linearFind(nextValue - CAPACITY + 1);   // Release the oldest by value
+        table[victim].used = false;
+        uint32_t value = nextValue++;
+        while (linearFind(value) != ID_NONE) value = nextValue++;   // Uniqueness check
+        uint16_t slot = linearFree();
+        table[slot].value = value;
+        table[slot].expires = 100000 + value;
+        table[slot].used = true;
+        for (uint16_t i = 0; i < CAPACITY; i++) {                  // Expiry sweep
+            if (table[i].used && (int32_t)(r - table[i].expires) >= 0) table[i].used = false;
+        }
+    }
+    unsigned long linear = micros() - start;
+
+    // Indexed: same workload
+    memset(table, 0, sizeof(table));
+    benchIds.reset();
+    benchIndex.clear();
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        uint16_t slot = benchIds.acquire();
+        table[slot].value = 1 + i;
+        table[slot].used = true;
+        benchIndex.insert(table[slot].value, slot);
+        benchHeap.schedule(slot, 100000 + i);
+    }
+    nextValue = CAPACITY + 1;
+    bool consistent = true;
+    start = micros();
+    for (uint16_t r = 0; r < rounds; r++) {
+        uint16_t victim = benchIndex.find(nextValue - CAPACITY + 1, TableKey());
+        benchIndex.erase(table[victim].value, TableKey());
+        benchHeap.cancel(victim);
+        benchIds.release(victim);
+        table[victim].used = false;
+        uint32_t value = nextValue++;
+        while (benchIndex.find(value, TableKey()) != ID_NONE) value = nextValue++;
+        uint16_t slot = benchIds.acquire();
+        table[slot].value = value;
+        table[slot].used = true;
+        benchIndex.insert(value, slot);
+        benchHeap.schedule(slot, 100000 + value);
+        uint16_t due;
+        while (benchHeap.popDue(r, due)) {
+            consistent = false;     // Nothing is due in this workload
+        }
+    }
+    unsigned long indexed = micros() - start;
+
+    Serial.print("linear  us/round: "); Serial.println((float)linear / rounds, 3);
+    Serial.print("indexed us/round: "); Serial.println((float)indexed / rounds, 3);
+    assertTrue(consistent && benchIds.getFreeCount() == 0, "Indexed table stays full and consistent");
+    assertTrue(indexed * 10 < linear, "Indexed round at least 10x faster at full capacity");
+}
+
+void runAllTests() {
+    Serial.println("Starting Id Allocator Unit Tests...");
+    Serial.println("=====================================");
+
+    testBitmap();
+    testHeap();
+    testValueIndex();
+    testBenchmark();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Id Allocator Unit Test Suite");
+    Serial.println("============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,172 @@
+/**
+ * @file log_filter_unit_test.cpp
+ * @brief Unit tests for compile-time log level and module filtering
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks that filtered log calls never evaluate their arguments, that
+ * runtime-adjustable modules honour setLogModuleLevel(), and prints the
+ * per-call cost of filtered, enabled and String-based logging on the
+ * Velma board.
+ */
+
+#include <Arduino.h>
+#include "../../modules/behavior_hiding/shared_services/deferred_log.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Counts how often an argument expression is evaluated
+uint16_t evaluations = 0;
+
+uint16_t countedArgument(uint16_t value) {
+    evaluations++;
+    return value;
+}
+
+String countedMessage() {
+    evaluations++;
+    return String("message ") + String(evaluations);
+}
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertFalse(bool condition, const char* testName) {
+    assertTrue(!condition, testName);
+}
+
+// Test functions
+void testCompileTimeFilter() {
+    Serial.println("\n=== Testing Compile-Time Filter ===");
+
+    assertFalse(logCompiledIn(DLOG_LEVEL_DEBUG, LogModule::IMU), "IMU debug compiled out");
+    assertTrue(logCompiledIn(DLOG_LEVEL_WARNING, LogModule::IMU), "IMU warning compiled in");
+    assertFalse(logCompiledIn(DLOG_LEVEL_INFO, LogModule::ESC), "ESC info compiled out");
+
+    deferredLog.clear();
+    evaluations = 0;
+    assertFalse(DLOG_DEBUG(IMU_READ_TIMEOUT, countedArgument(100)), "Filtered call returns false");
+    assertTrue(evaluations == 0, "Filtered call skips arguments");
+    assertTrue(deferredLog.isEmpty(), "Filtered call records nothing");
+
+    assertTrue(DLOG_WARNING(IMU_READ_TIMEOUT, countedArgument(100)), "Enabled call records");
+    assertTrue(evaluations == 1, "Enabled call evaluates arguments once");
+
+    evaluations = 0;
+    String sink;
+    LOG_IF(SYSTEM, DLOG_LEVEL_DEBUG, sink = countedMessage());
+    assertTrue(evaluations == 0, "LOG_IF skips String building");
+    LOG_IF(SYSTEM, DLOG_LEVEL_INFO, sink = countedMessage());
+    assertTrue(evaluations == 1, "LOG_IF runs enabled statement");
+}
+
+void testRuntimeLevels() {
+    Serial.println("\n=== Testing Runtime-Adjustable Modules ===");
+    deferredLog.clear();
+
+    assertTrue(setLogModuleLevel(LogModule::IMU, DLOG_LEVEL_ERROR), "IMU level adjustable");
+    assertFalse(DLOG_WARNING(IMU_READ_TIMEOUT, (uint16_t)5), "IMU warning suppressed at runtime");
+    assertTrue(DLOG_ERROR(IMU_SATURATED, (uint8_t)0, (int16_t)1), "IMU error still logged");
+
+    assertTrue(setLogModuleLevel(LogModule::IMU, DLOG_LEVEL_DEBUG), "IMU level lowered");
+    assertTrue(getLogModuleLevel(LogModule::IMU) == LOG_MODULE_LEVELS[(uint8_t)LogModule::IMU],
+               "Runtime level clamped to compiled-in minimum");
+
+    assertFalse(setLogModuleLevel(LogModule::BATTERY, DLOG_LEVEL_ERROR), "BATTERY level fixed");
+    assertTrue(DLOG_WARNING(BATTERY_LOW, 10.5f), "BATTERY warning unaffected");
+}
+
+void testCallCost() {
+    Serial.println("\n=== Measuring Call Cost ===");
+    const uint16_t iterations = 1000;
+    float voltage = 10.87;
+    volatile uint16_t sink = 0;
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        sink += i;
+    }
+    unsigned long baseline = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        sink += i;
+        DLOG_DEBUG(IMU_CALIBRATED, voltage, voltage, voltage);
+    }
+    unsigned long filtered = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        sink += i;
+        DLOG_WARNING(BATTERY_LOW, voltage);
+        if (deferredLog.available() > DEFERRED_LOG_CAPACITY / 2) {
+            deferredLog.clear();
+        }
+    }
+    unsigned long enabled = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        sink += i;
+        String message = "battery low: " + String(voltage, 2) + " V";
+        sink += message.length();
+    }
+    unsigned long stringTime = micros() - start;
+
+    Serial.print("Loop baseline:        "); Serial.print((float)baseline / iterations); Serial.println(" us/call");
+    Serial.print("Compiled-out DLOG:    "); Serial.print((float)filtered / iterations); Serial.println(" us/call");
+    Serial.print("Enabled DLOG:         "); Serial.print((float)enabled / iterations); Serial.println(" us/call");
+    Serial.print("String message:       "); Serial.print((float)stringTime / iterations); Serial.println(" us/call");
+
+    assertTrue(filtered <= baseline + baseline / 10 + 50, "Compiled-out call costs nothing");
+}
+
+void runAllTests() {
+    Serial.println("Starting Log Filter Unit Tests...");
+    Serial.println("=====================================");
+
+    testCompileTimeFilter();
+    testRuntimeLevels();
+    testCallCost();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Log Filter Unit Test Suite");
+    Serial.println("==========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
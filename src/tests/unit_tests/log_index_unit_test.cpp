@@ -0,0 +1,258 @@
+/**
+ * @file log_index_unit_test.cpp
+ * @brief Unit tests for the flight log seek index
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Builds a log in RAM the way DataLoggerModule writes it: records, an
+ * index line after every block, then the footer and trailer on close.
+ * Checks the line encodings, block boundaries, the binary searches by
+ * time and by event type, the sidecar fallback, and rejection of a
+ * damaged trailer.
+ */
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../modules/behavior_hiding/shared_services/log_index.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// RAM stand-ins for the log and its sidecar
+struct MemoryFile {
+    char data[4096];
+    uint32_t size;
+};
+
+static MemoryFile logFile;
+static MemoryFile sidecarFile;
+
+static void append(MemoryFile& file, const char* data, uint16_t length) {
+    memcpy(file.data + file.size, data, length);
+    file.size += length;
+}
+
+uint16_t readMemory(void* context, uint32_t offset, char* buffer, uint16_t length) {
+    MemoryFile* file = static_cast<MemoryFile*>(context);
+    if (offset >= file->size) {
+        return 0;
+    }
+    if (offset + length > file->size) {
+        length = file->size - offset;
+    }
+    memcpy(buffer, file->data + offset, length);
+    return length;
+}
+
+// Record n is logged at 100 ms intervals; every 25th is an error
+static uint8_t recordType(uint16_t n) {
+    return (n % 25 == 24) ? 3 : 0;
+}
+
+static void writeIndexLine(LogIndexBuilder& builder) {
+    LogIndexEntry entry;
+    if (builder.takeEntry(entry)) {
+        char line[LOG_INDEX_ENTRY_SIZE];
+        formatLogIndexEntry(entry, line);
+        append(logFile, line, LOG_INDEX_ENTRY_SIZE);
+        append(sidecarFile, line, LOG_INDEX_ENTRY_SIZE);
+    }
+}
+
+// Writes count records in blocks of interval, optionally closing the log
+static void buildLog(uint16_t count, uint16_t interval, bool close) {
+    logFile.size = 0;
+    sidecarFile.size = 0;
+    LogIndexBuilder builder(interval);
+    char record[32];
+    for (uint16_t n = 0; n < count; n++) {
+        uint32_t offset = logFile.size;
+        int length = snprintf(record, sizeof(record), "%lu REC %u\n", (unsigned long)n * 100UL, n);
+        append(logFile, record, (uint16_t)length);
+        if (builder.addRecord(n * 100UL, offset, recordType(n))) {
+            writeIndexLine(builder);
+        }
+    }
+    if (!close) {
+        return;
+    }
+    writeIndexLine(builder);
+
+    LogIndexTrailer trailer;
+    trailer.footerOffset = logFile.size;
+    trailer.entryCount = sidecarFile.size / LOG_INDEX_ENTRY_SIZE;
+    append(logFile, sidecarFile.data, sidecarFile.size);
+    char line[LOG_INDEX_TRAILER_SIZE];
+    formatLogIndexTrailer(trailer, line);
+    append(logFile, line, LOG_INDEX_TRAILER_SIZE);
+}
+
+// Test functions
+void testEncoding() {
+    Serial.println("\n=== Testing Line Encoding ===");
+    LogIndexEntry entry = { 0x12345678UL, 0xABCDEF01UL, 42, LOG_FLAG_ERROR_EVENT, 0x0009 };
+    char line[LOG_INDEX_ENTRY_SIZE];
+    formatLogIndexEntry(entry, line);
+    assertTrue(isLogIndexLine(line), "Entry starts with @I");
+    assertTrue(line[LOG_INDEX_ENTRY_SIZE - 1] == '\n', "Entry is one fixed-width line");
+
+    LogIndexEntry parsed;
+    assertTrue(parseLogIndexEntry(line, parsed), "Entry parses");
+    assertTrue(parsed.timestamp == entry.timestamp && parsed.offset == entry.offset, "Timestamp and offset kept");
+    assertEqual(42, parsed.recordNumber, "Record number kept");
+    assertEqual(0x0009, parsed.cumulativeFlags, "Flags kept");
+
+    line[5] = 'z';
+    assertTrue(!parseLogIndexEntry(line, parsed), "Bad hex digit rejected");
+
+    LogIndexTrailer trailer = { 1000, 7 };
+    char trailerLine[LOG_INDEX_TRAILER_SIZE];
+    formatLogIndexTrailer(trailer, trailerLine);
+    LogIndexTrailer parsedTrailer;
+    assertTrue(parseLogIndexTrailer(trailerLine, parsedTrailer), "Trailer parses");
+    assertEqual(7, parsedTrailer.entryCount, "Entry count kept");
+    assertTrue(!isLogIndexLine(trailerLine), "Trailer is not an index line");
+}
+
+void testBuilder() {
+    Serial.println("\n=== Testing Block Boundaries ===");
+    LogIndexBuilder builder(4);
+    LogIndexEntry entry;
+    assertTrue(!builder.takeEntry(entry), "Empty block gives no entry");
+
+    bool full = false;
+    for (uint8_t n = 0; n < 4; n++) {
+        full = builder.addRecord(1000 + n, 50 * n, n == 2 ? 2 : 0);
+    }
+    assertTrue(full, "Block full after the interval");
+    assertTrue(builder.takeEntry(entry), "Entry taken");
+    assertEqual(1000, entry.timestamp, "Entry holds the first record's time");
+    assertEqual(0, entry.offset, "Entry holds the first record's offset");
+    assertEqual(LOG_FLAG_FLIGHT_DATA | LOG_FLAG_SYSTEM_EVENT, entry.blockFlags, "Block flags");
+
+    builder.addRecord(2000, 200, 0);
+    assertTrue(builder.takeEntry(entry), "Partial block taken on close");
+    assertEqual(4, entry.recordNumber, "Record numbers continue");
+    assertEqual(0, entry.blockFlags & LOG_FLAG_SYSTEM_EVENT, "Block flags reset");
+    assertTrue((entry.cumulativeFlags & LOG_FLAG_SYSTEM_EVENT) != 0, "Cumulative flags kept");
+}
+
+void testFooterSearch() {
+    Serial.println("\n=== Testing Footer Search ===");
+    buildLog(100, 16, true);
+    LogIndexReader reader(readMemory, &logFile);
+    assertTrue(reader.openFooter(logFile.size), "Footer found");
+    assertEqual(7, reader.getEntryCount(), "One entry per block, last one partial");
+
+    LogIndexEntry entry;
+    uint32_t index;
+    assertTrue(reader.findByTime(5000, entry, &index), "Time found");
+    assertEqual(3, index, "Block holding 5000 ms");
+    assertEqual(4800, entry.timestamp, "Block starts at or before the target");
+    assertTrue(strncmp(logFile.data + entry.offset, "4800 REC 48\n", 12) == 0, "Offset points at the record");
+
+    assertTrue(reader.findByTime(0, entry, &index) && index == 0, "Start of log");
+    assertTrue(reader.findByTime(99999, entry, &index) && index == 6, "Past the end gives the last block");
+
+    assertTrue(reader.findFirstWithFlags(LOG_FLAG_ERROR_EVENT, entry, &index), "First error found");
+    assertEqual(1, index, "Record 24 sits in the second block");
+    assertTrue(!reader.findFirstWithFlags(LOG_FLAG_USER_ACTION, entry), "Absent type not found");
+}
+
+void testSidecarAndDamage() {
+    Serial.println("\n=== Testing Sidecar and Damaged Logs ===");
+    buildLog(100, 16, false);
+    LogIndexReader footer(readMemory, &logFile);
+    assertTrue(!footer.openFooter(logFile.size), "Unclosed log has no footer");
+
+    LogIndexReader sidecar(readMemory, &sidecarFile);
+    assertTrue(sidecar.openSidecar(sidecarFile.size), "Sidecar opened");
+    assertEqual(6, sidecar.getEntryCount(), "Only full blocks before close");
+    LogIndexEntry entry;
+    assertTrue(sidecar.findByTime(5000, entry) && entry.timestamp == 4800, "Sidecar searched by time");
+
+    buildLog(100, 16, true);
+    logFile.data[logFile.size - 8] ^= 1;
+    LogIndexReader damaged(readMemory, &logFile);
+    assertTrue(!damaged.openFooter(logFile.size), "Damaged trailer rejected");
+
+    buildLog(100, 16, true);
+    logFile.size -= LOG_INDEX_TRAILER_SIZE;
+    LogIndexTrailer trailer = { 0, 99 };
+    char line[LOG_INDEX_TRAILER_SIZE];
+    formatLogIndexTrailer(trailer, line);
+    append(logFile, line, LOG_INDEX_TRAILER_SIZE);
+    assertTrue(!damaged.openFooter(logFile.size), "Footer that does not meet the trailer rejected");
+}
+
+void runAllTests() {
+    Serial.println("Starting Log Index Unit Tests...");
+    Serial.println("=====================================");
+
+    testEncoding();
+    testBuilder();
+    testFooterSearch();
+    testSidecarAndDamage();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Log Index Unit Test Suite");
+    Serial.println("=========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,278 @@
+/**
+ * @file mag_calibrator_unit_test.cpp
+ * @brief Unit tests for the online magnetometer calibrator
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Feeds MagCalibrator synthetic readings of a fixed field seen through a
+ * known hard-iron offset and soft-iron distortion, with noise. Checks that
+ * the fit recovers the distortion without turning headings, reports
+ * convergence once, refuses single-plane data, and follows an offset that
+ * changes after convergence.
+ */
+
+#include <Arduino.h>
+#include <math.h>
+#include "../../modules/software_decision/software_utility/mag_calibrator.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertNear(float expected, float actual, float tolerance, const char* testName) {
+    testsRun++;
+    if (fabs(expected - actual) <= tolerance) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected, 4);
+        Serial.print(", Got: ");
+        Serial.println(actual, 4);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Synthetic magnetometer: raw = S * field + offset + noise, in sensor counts
+static const float FIELD = 450.0f;
+static const float SOFT_IRON[9] = {
+    1.10f, 0.06f, -0.03f,
+    0.06f, 0.92f, 0.04f,
+    -0.03f, 0.04f, 1.02f
+};
+static float hardIron[3] = { 120.0f, -80.0f, 45.0f };
+static uint32_t seed = 12345;
+
+static float uniform() {
+    seed = seed * 1664525UL + 1013904223UL;
+    return (seed >> 8) / 16777216.0f;
+}
+
+// Random direction; planar keeps it in the horizontal plane
+static void randomDirection(float* direction, bool planar) {
+    float z = planar ? 0.0f : 2.0f * uniform() - 1.0f;
+    float angle = 2.0f * PI * uniform();
+    float horizontal = sqrt(1.0f - z * z);
+    direction[0] = horizontal * cos(angle);
+    direction[1] = horizontal * sin(angle);
+    direction[2] = z;
+}
+
+static void measure(const float* direction, float noise, float* raw) {
+    for (uint8_t i = 0; i < 3; i++) {
+        raw[i] = hardIron[i] + (2.0f * uniform() - 1.0f) * noise;
+        for (uint8_t j = 0; j < 3; j++) {
+            raw[i] += SOFT_IRON[i * 3 + j] * FIELD * direction[j];
+        }
+    }
+}
+
+static float magnitude(const float* v) {
+    return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+// Feeds count readings, solving every tenth as the slow loop would; returns
+// how many solves reported CONVERGED
+static uint8_t feed(MagCalibrator& calibrator, uint16_t count, bool planar, MagCalResult* last) {
+    uint8_t convergedReports = 0;
+    for (uint16_t n = 1; n <= count; n++) {
+        float direction[3];
+        float raw[3];
+        randomDirection(direction, planar);
+        measure(direction, 2.0f, raw);
+        calibrator.addSample(raw);
+        if (n % 10 == 0) {
+            *last = calibrator.solve();
+            convergedReports += *last == MagCalResult::CONVERGED;
+        }
+    }
+    return convergedReports;
+}
+
+// Test functions
+void testEigen() {
+    Serial.println("\n=== Testing Symmetric Eigen-Decomposition ===");
+    float values[3];
+    float vectors[9];
+    MagCalibrator::symmetricEigen3(SOFT_IRON, values, vectors);
+    bool reconstructed = true;
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            float sum = 0.0f;
+            for (uint8_t e = 0; e < 3; e++) {
+                sum += vectors[i * 3 + e] * values[e] * vectors[j * 3 + e];
+            }
+            reconstructed &= fabs(sum - SOFT_IRON[i * 3 + j]) < 1e-5f;
+        }
+    }
+    assertTrue(reconstructed, "V diag(values) V' rebuilds the matrix");
+    assertNear(1.10f + 0.92f + 1.02f, values[0] + values[1] + values[2], 1e-5f, "Trace kept");
+}
+
+void testConvergence() {
+    Serial.println("\n=== Testing Convergence ===");
+    MagCalibrator calibrator;
+    calibrator.begin(FIELD);
+    MagCalResult last = MagCalResult::COLLECTING;
+    float raw[3] = { 1.0f, 2.0f, 3.0f };
+    float out[3];
+    calibrator.correct(raw, out);
+    assertTrue(out[0] == 1.0f && out[2] == 3.0f, "Readings pass through before a fit");
+
+    feed(calibrator, 100, false, &last);
+    assertTrue(last == MagCalResult::COLLECTING && !calibrator.isValid(), "Still collecting below the minimum");
+
+    uint8_t reports = feed(calibrator, 400, false, &last);
+    assertTrue(calibrator.isConverged(), "Converged on full coverage");
+    assertTrue(reports == 1, "Convergence reported once");
+    assertTrue(last == MagCalResult::FITTED, "Later solves keep refining");
+    assertTrue(calibrator.getResidual() < 0.005f, "Residual at the noise level");
+
+    const float* center = calibrator.getCenter();
+    assertNear(120.0f, center[0], 1.5f, "Hard iron X");
+    assertNear(-80.0f, center[1], 1.5f, "Hard iron Y");
+    assertNear(45.0f, center[2], 1.5f, "Hard iron Z");
+
+    // Corrected readings: constant strength, and the true direction
+    float worstStrength = 0.0f;
+    float worstAngle = 0.0f;
+    for (uint8_t n = 0; n < 50; n++) {
+        float direction[3];
+        randomDirection(direction, false);
+        measure(direction, 0.0f, raw);
+        calibrator.correct(raw, raw);
+        float strength = magnitude(raw);
+        float error = fabs(strength / calibrator.getRadius() - 1.0f);
+        worstStrength = error > worstStrength ? error : worstStrength;
+        float cosine = (raw[0] * direction[0] + raw[1] * direction[1] + raw[2] * direction[2]) / strength;
+        float angle = acos(cosine > 1.0f ? 1.0f : cosine) * 180.0f / PI;
+        worstAngle = angle > worstAngle ? angle : worstAngle;
+    }
+    assertTrue(worstStrength < 0.01f, "Corrected strength within 1%");
+    assertTrue(worstAngle < 1.0f, "Correction does not rotate the field");
+    // The correction keeps the ellipsoid's volume
+    float volumeRadius = FIELD * pow(1.10f * 0.92f * 1.02f, 1.0f / 3.0f);
+    assertNear(volumeRadius, calibrator.getRadius(), 0.01f * volumeRadius, "Mean radius");
+}
+
+void testPlanarRejected() {
+    Serial.println("\n=== Testing Single-Plane Data ===");
+    MagCalibrator calibrator;
+    calibrator.begin(FIELD);
+    MagCalResult last = MagCalResult::COLLECTING;
+    uint8_t reports = feed(calibrator, 600, true, &last);
+    assertTrue(reports == 0 && !calibrator.isValid(), "Level turns alone do not converge");
+    assertTrue(calibrator.getCondition() < MAG_CAL_MIN_CONDITION, "Poor conditioning reported");
+}
+
+void testTracking() {
+    Serial.println("\n=== Testing In-Flight Refinement ===");
+    MagCalibrator calibrator;
+    calibrator.begin(FIELD);
+    MagCalResult last = MagCalResult::COLLECTING;
+    feed(calibrator, 500, false, &last);
+    bool converged = calibrator.isConverged();
+
+    // Level flight only: unexcited directions hold the fit
+    feed(calibrator, 1500, true, &last);
+    assertTrue(calibrator.isValid(), "Fit kept through level flight");
+    assertNear(45.0f, calibrator.getCenter()[2], 3.0f, "Vertical offset held");
+
+    // A new payload shifts the offset; the fit follows
+    hardIron[0] += 30.0f;
+    uint8_t reports = feed(calibrator, 4000, false, &last);
+    assertTrue(converged && reports == 0, "No second convergence report");
+    assertNear(150.0f, calibrator.getCenter()[0], 2.0f, "Shifted offset followed");
+    hardIron[0] -= 30.0f;
+}
+
+void benchmarkCalibrator() {
+    Serial.println("\n=== Benchmarking Calibrator ===");
+#ifdef ARDUINO
+    const uint16_t iterations = 100;
+#else
+    const uint16_t iterations = 10000;
+#endif
+    MagCalibrator calibrator;
+    calibrator.begin(FIELD);
+    float raw[3];
+    float direction[3];
+    randomDirection(direction, false);
+    measure(direction, 2.0f, raw);
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        calibrator.addSample(raw);
+    }
+    unsigned long sampleUs = micros() - start;
+
+    MagCalResult last;
+    feed(calibrator, 300, false, &last);
+    start = micros();
+    for (uint16_t i = 0; i < iterations / 10; i++) {
+        calibrator.solve();
+    }
+    unsigned long solveUs = micros() - start;
+
+    Serial.print("addSample (us): ");
+    Serial.println((float)sampleUs / iterations, 3);
+    Serial.print("solve (us): ");
+    Serial.println((float)solveUs / (iterations / 10), 3);
+}
+
+void runAllTests() {
+    Serial.println("Starting Magnetometer Calibrator Unit Tests...");
+    Serial.println("=====================================");
+
+    testEigen();
+    testConvergence();
+    testPlanarRejected();
+    testTracking();
+    benchmarkCalibrator();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Magnetometer Calibrator Unit Test Suite");
+    Serial.println("=======================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,394 @@
+/**
+ * @file pattern_automaton_unit_test.cpp
+ * @brief Unit tests for the compiled event pattern automaton
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks sequence matching with interleaved and repeated events, contiguous
+ * runs, minDelay/maxDelay windows, and agreement with straightforward
+ * reference matchers on random streams, and names shared with
+ * EventCorrelator. A replay benchmark feeds a long event log through 32
+ * patterns and compares it with re-evaluating every pattern from scratch
+ * over the recent events on each arrival.
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include "../../modules/software_decision/data_banker/pattern_automaton.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static EventInterner eventNames;
+static PatternAutomaton automaton(eventNames);
+
+// Fresh names and patterns
+static void resetAutomaton() {
+    eventNames.clear();
+    automaton.clear();
+}
+
+// Steps as a space-separated string, e.g. "A B C"
+static uint8_t addPattern(const char* sequence, bool contiguous,
+                          const uint32_t* minDelay = NULL, const uint32_t* maxDelay = NULL) {
+    static char buffer[64];
+    StringView steps[PATTERN_STEPS_MAX];
+    uint8_t count = 0;
+    strncpy(buffer, sequence, sizeof(buffer) - 1);
+    for (char* token = strtok(buffer, " "); token && count < PATTERN_STEPS_MAX; token = strtok(NULL, " ")) {
+        steps[count++] = StringView(token);
+    }
+    PatternSpec spec = { steps, count, minDelay, maxDelay, contiguous };
+    return automaton.addPattern(spec);
+}
+
+static bool feed(const char* name, uint32_t now, uint8_t pattern) {
+    EventSet matched;
+    automaton.onEvent(StringView(name), now, matched);
+    return matched.test(pattern);
+}
+
+// Test functions
+void testSequences() {
+    Serial.println("\n=== Testing Sequences ===");
+    resetAutomaton();
+    uint8_t abc = addPattern("ARM TAKEOFF CLIMB", false);
+    uint8_t aab = addPattern("GPS GPS FIX", false);
+
+    assertTrue(!feed("ARM", 0, abc) && !feed("TAKEOFF", 1, abc), "Partial match does not fire");
+    assertEqual(2, automaton.getProgress(abc), "Progress tracked");
+    assertTrue(!feed("NOISE", 2, abc), "Unknown event is ignored");
+    assertTrue(feed("CLIMB", 3, abc), "Interleaved sequence completes");
+    assertEqual(0, automaton.getProgress(abc), "Match resets the pattern");
+    assertTrue(!feed("CLIMB", 4, abc), "No second match without a new run");
+
+    assertTrue(!feed("GPS", 10, aab) && !feed("FIX", 11, aab), "Repeated step needs both");
+    feed("GPS", 12, aab);
+    assertTrue(feed("FIX", 13, aab), "Repeated step completes");
+    feed("GPS", 14, aab);
+    feed("GPS", 15, aab);
+    feed("GPS", 16, aab);
+    assertTrue(feed("FIX", 17, aab), "Extra repeats are absorbed");
+
+    automaton.enablePattern(abc, false);
+    feed("ARM", 20, abc);
+    feed("TAKEOFF", 21, abc);
+    assertTrue(!feed("CLIMB", 22, abc), "Disabled pattern does not match");
+    assertEqual(EVENT_ID_NONE, addPattern("", false), "Empty pattern refused");
+}
+
+void testContiguous() {
+    Serial.println("\n=== Testing Contiguous Runs ===");
+    resetAutomaton();
+    uint8_t run = addPattern("A B C", true);
+    addPattern("X Y", false);
+
+    feed("A", 0, run);
+    feed("B", 1, run);
+    assertTrue(feed("C", 2, run), "Consecutive events match");
+    feed("A", 3, run);
+    feed("X", 4, run);
+    feed("B", 5, run);
+    assertTrue(!feed("C", 6, run), "Known event in between breaks the run");
+    feed("A", 7, run);
+    feed("UNKNOWN", 8, run);
+    feed("B", 9, run);
+    assertTrue(!feed("C", 10, run), "Unknown event in between breaks the run");
+    feed("A", 11, run);
+    feed("A", 12, run);
+    feed("B", 13, run);
+    assertTrue(feed("C", 14, run), "Run restarts on the repeated first step");
+}
+
+void testWindows() {
+    Serial.println("\n=== Testing Time Windows ===");
+    resetAutomaton();
+    const uint32_t minDelay[3] = { 0, 100, 0 };
+    const uint32_t maxDelay[3] = { 0, 500, 50 };
+    uint8_t timed = addPattern("A B C", false, minDelay, maxDelay);
+
+    feed("A", 0, timed);
+    feed("B", 50, timed);
+    assertEqual(1, automaton.getProgress(timed), "B before minDelay is not taken");
+    feed("B", 200, timed);
+    assertTrue(feed("C", 240, timed), "Both gaps inside their windows");
+
+    feed("A", 1000, timed);
+    feed("B", 1600, timed);
+    assertEqual(1, automaton.getProgress(timed), "B after maxDelay is not taken");
+    feed("A", 1700, timed);
+    feed("B", 1900, timed);
+    assertTrue(!feed("C", 2000, timed), "C after its maxDelay");
+    feed("B", 2100, timed);
+    assertTrue(feed("C", 2120, timed), "Window measured from the latest B");
+
+    feed("A", 0xFFFFFFA0UL, timed);
+    feed("B", 0x00000010UL, timed);
+    assertTrue(feed("C", 0x00000020UL, timed), "Windows across millis() wrap");
+}
+
+static uint32_t rng = 12345;
+static uint8_t nextRandom(uint8_t range) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng % range;
+}
+
+void testAgainstReference() {
+    Serial.println("\n=== Testing Against Reference Matchers ===");
+    static const char* alphabet[4] = { "A", "B", "C", "D" };
+    static const uint8_t seqA[4] = { 0, 1, 0, 2 };
+    static const uint8_t seqB[3] = { 1, 1, 3 };
+
+    resetAutomaton();
+    uint8_t sub = addPattern("A B A C", false);
+    uint8_t run = addPattern("B B D", true);
+
+    static uint8_t stream[4000];
+    uint16_t automatonSub = 0, automatonRun = 0;
+    for (uint16_t i = 0; i < sizeof(stream); i++) {
+        stream[i] = nextRandom(4);
+        EventSet matched;
+        automaton.onEvent(StringView(alphabet[stream[i]]), i, matched);
+        automatonSub += matched.test(sub);
+        automatonRun += matched.test(run);
+    }
+
+    // Subsequence: a greedy pointer is optimal, restarting after each match
+    uint16_t referenceSub = 0;
+    uint8_t position = 0;
+    for (uint16_t i = 0; i < sizeof(stream); i++) {
+        if (stream[i] == seqA[position] && ++position == 4) {
+            referenceSub++;
+            position = 0;
+        }
+    }
+    // Contiguous: the last three events equal the pattern, not overlapping
+    // the previous match
+    uint16_t referenceRun = 0;
+    long lastEnd = -1;
+    for (uint16_t i = 2; i < sizeof(stream); i++) {
+        if ((long)i - 2 > lastEnd && stream[i - 2] == seqB[0] && stream[i - 1] == seqB[1] && stream[i] == seqB[2]) {
+            referenceRun++;
+            lastEnd = i;
+        }
+    }
+    assertTrue(referenceSub > 10 && referenceRun > 10, "Stream exercises both patterns");
+    assertEqual(referenceSub, automatonSub, "Subsequence matches agree");
+    assertEqual(referenceRun, automatonRun, "Contiguous matches agree");
+}
+
+void testEdges() {
+    Serial.println("\n=== Testing Shared Transitions ===");
+    resetAutomaton();
+    char sequence[32];
+    for (uint8_t p = 0; p < PATTERN_MAX; p++) {
+        snprintf(sequence, sizeof(sequence), "S%u M%u E%u", p % 8, p % 16, p);
+        addPattern(sequence, false);
+    }
+    assertEqual(PATTERN_MAX, automaton.getPatternCount(), "Table holds PATTERN_MAX patterns");
+    assertEqual(EVENT_ID_NONE, addPattern("S0 M0", false), "Full table refuses");
+
+    EventSet matched;
+    uint32_t before = automaton.getAdvances();
+    automaton.onEvent(StringView("S3"), 0, matched);
+    assertEqual(PATTERN_MAX / 8, automaton.getAdvances() - before, "Only patterns using the event advance");
+    before = automaton.getAdvances();
+    automaton.onEvent(StringView("E31"), 0, matched);
+    assertEqual(1, automaton.getAdvances() - before, "Rare event touches one pattern");
+}
+
+void testSharedNames() {
+    Serial.println("\n=== Testing Names Shared with the Correlator ===");
+    resetAutomaton();
+    static EventCorrelator correlator(eventNames);
+    correlator.clear();
+
+    StringView trigger[1] = { StringView("TAKEOFF") };
+    StringView required[1] = { StringView("ARMED") };
+    EventRuleSpec rule = { trigger, 1, required, 1, NULL, 0, 0, 0, 0 };
+    correlator.addRule(rule);
+    uint8_t pattern = addPattern("ARMED TAKEOFF CLIMB", false);
+
+    assertEqual(3, eventNames.getCount(), "Each name interned once");
+    assertEqual(correlator.findEvent(StringView("ARMED")), automaton.findEvent(StringView("ARMED")),
+                "Same ID in both");
+    EventSet matched;
+    assertEqual(0, automaton.onEvent(StringView("GEAR_UP"), 0, matched), "Unknown name ignored");
+
+    // One ID drives both, as ComplexEventsModule feeds them
+    uint8_t takeoff = eventNames.find(StringView("TAKEOFF"));
+    EventSet fired;
+    automaton.onEvent(eventNames.find(StringView("ARMED")), 0, matched);
+    correlator.onEvent(eventNames.find(StringView("ARMED")), 0, fired);
+    automaton.onEvent(takeoff, 10, matched);
+    assertEqual(1, correlator.onEvent(takeoff, 10, fired), "Rule fires on the shared ID");
+    assertTrue(feed("CLIMB", 20, pattern), "Pattern completes on the shared IDs");
+
+    Serial.print("sizeof(PatternAutomaton): "); Serial.println((unsigned long)sizeof(PatternAutomaton));
+    assertTrue(sizeof(PatternAutomaton) <= 3072, "Automaton within 3 KB of SRAM");
+}
+
+// Re-evaluation from scratch, as processEventPatterns would without state:
+// every pattern checked as a subsequence of the recent events on each
+// arrival, names compared as strings
+static const uint8_t RECENT_MAX = 16;
+static const char* recent[RECENT_MAX];
+static uint8_t recentCount = 0;
+
+static uint16_t rescanPatterns(const char* const (*sequences)[4], uint8_t count, const char* event) {
+    if (recentCount < RECENT_MAX) {
+        recent[recentCount++] = event;
+    } else {
+        memmove(recent, recent + 1, (RECENT_MAX - 1) * sizeof(recent[0]));
+        recent[RECENT_MAX - 1] = event;
+    }
+    uint16_t found = 0;
+    for (uint8_t p = 0; p < count; p++) {
+        if (strcmp(sequences[p][3], event) != 0) {
+            continue;
+        }
+        uint8_t step = 0;
+        for (uint8_t i = 0; i < recentCount && step < 4; i++) {
+            if (strcmp(recent[i], sequences[p][step]) == 0) {
+                step++;
+            }
+        }
+        found += step == 4;
+    }
+    return found;
+}
+
+void benchmarkReplay() {
+    Serial.println("\n=== Benchmark: Log Replay, 32 Patterns ===");
+    static char names[32][8];
+    static const char* sequences[PATTERN_MAX][4];
+    for (uint8_t i = 0; i < 32; i++) {
+        snprintf(names[i], sizeof(names[i]), "EV%u", i);
+    }
+
+    resetAutomaton();
+    for (uint8_t p = 0; p < PATTERN_MAX; p++) {
+        StringView steps[4];
+        for (uint8_t k = 0; k < 4; k++) {
+            sequences[p][k] = names[(p * 5 + k * 7) % 32];
+            steps[k] = StringView(sequences[p][k]);
+        }
+        const uint32_t maxDelay[4] = { 0, 2000, 2000, 2000 };
+        PatternSpec spec = { steps, 4, NULL, maxDelay, false };
+        automaton.addPattern(spec);
+    }
+
+    // A log of events every 10 ms, generated in chunks; on the host this is
+    // about three hours of logging
+#ifdef ARDUINO
+    const uint32_t replayEvents = 20000UL;
+#else
+    const uint32_t replayEvents = 1000000UL;
+#endif
+    static PatternEvent chunk[256];
+    rng = 777;
+    uint32_t matches = 0;
+    unsigned long elapsed = 0;
+    for (uint32_t done = 0; done < replayEvents; done += 256) {
+        for (uint16_t i = 0; i < 256; i++) {
+            chunk[i].id = automaton.findEvent(StringView(names[nextRandom(32)]));
+            chunk[i].time = (done + i) * 10;
+        }
+        unsigned long start = micros();
+        matches += automaton.replay(chunk, 256, NULL, NULL);
+        elapsed += micros() - start;
+    }
+    float automatonPerEvent = (float)elapsed / replayEvents;
+
+    const uint16_t rescanEvents = 20000;
+    rng = 777;
+    uint32_t rescanMatches = 0;
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < rescanEvents; i++) {
+        rescanMatches += rescanPatterns(sequences, PATTERN_MAX, names[nextRandom(32)]);
+    }
+    float rescanPerEvent = (float)(micros() - start) / rescanEvents;
+
+    Serial.print("replayed events: "); Serial.println(replayEvents);
+    Serial.print("automaton us/event: "); Serial.println(automatonPerEvent, 3);
+    Serial.print("rescan us/event: "); Serial.println(rescanPerEvent, 3);
+    Serial.print("automaton events/s: "); Serial.println(1000000.0 / automatonPerEvent, 0);
+    assertTrue(matches > 0 && rescanMatches > 0, "Both find matches in the log");
+    assertTrue(automatonPerEvent < rescanPerEvent, "Automaton is faster than rescanning");
+}
+
+void runAllTests() {
+    Serial.println("Starting Pattern Automaton Unit Tests...");
+    Serial.println("=====================================");
+
+    testSequences();
+    testContiguous();
+    testWindows();
+    testAgainstReference();
+    testEdges();
+    testSharedNames();
+    benchmarkReplay();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Pattern Automaton Unit Test Suite");
+    Serial.println("=================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
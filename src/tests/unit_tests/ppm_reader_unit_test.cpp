@@ -0,0 +1,246 @@
+/**
+ * @file ppm_reader_unit_test.cpp
+ * @brief Unit tests for double-buffered PPM frame capture
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Feeds simulated pulse times to PPMReader the way its interrupt would.
+ * Checks that only complete frames are published, that a frame being
+ * received never shows through a snapshot, short and long frames, the
+ * validity window and failsafe timeout, and the interrupt slot table.
+ */
+
+#include <Arduino.h>
+#include "../../lib/velma_external_libraries/PPMreader/src/PPMReader.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static const byte CHANNELS = 6;
+static unsigned long pulseTime = 0;
+
+// The receiver's first pulse, which only starts the timing, ageUs ago
+static void startSignal(PPMReader& reader, unsigned long ageUs = 100000) {
+    pulseTime = micros() - ageUs;
+    reader.handlePulse(pulseTime);
+}
+
+// Sends the sync pulse that ends the blank, then one pulse per channel
+static void sendFrame(PPMReader& reader, const unsigned* values, byte count) {
+    pulseTime += 5000;
+    reader.handlePulse(pulseTime);
+    for (byte i = 0; i < count; ++i) {
+        pulseTime += values[i];
+        reader.handlePulse(pulseTime);
+    }
+}
+
+static bool frameEquals(const unsigned* a, const unsigned* b) {
+    for (byte i = 0; i < CHANNELS; ++i) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Test functions
+void testFrames() {
+    Serial.println("\n=== Testing Frame Publication ===");
+    PPMReader reader(2, CHANNELS);
+    pulseTime = micros() - 100000;
+    unsigned frame[CHANNELS];
+    assertEqual(0, reader.latestFrame(frame), "No frame before the first sync");
+
+    // Joined midway: pulses before the first blank are not channels
+    const unsigned tail[3] = { 1400, 1500, 1600 };
+    for (byte i = 0; i < 3; ++i) {
+        pulseTime += tail[i];
+        reader.handlePulse(pulseTime);
+    }
+    assertEqual(0, reader.rawChannelValue(1), "Partial frame before sync ignored");
+
+    const unsigned first[CHANNELS] = { 1100, 1200, 1300, 1400, 1500, 1600 };
+    sendFrame(reader, first, CHANNELS);
+    unsigned long received = 0;
+    assertEqual(1, reader.latestFrame(frame, &received), "Published with the last channel");
+    assertTrue(frameEquals(frame, first), "Snapshot holds every channel");
+    assertTrue(received == pulseTime, "Frame time is its last pulse");
+
+    // Half of the next frame must not show through
+    const unsigned second[CHANNELS] = { 1900, 1800, 1700, 1600, 1500, 1400 };
+    sendFrame(reader, second, 3);
+    assertEqual(1, reader.latestFrame(frame), "Frame in progress not published");
+    assertTrue(frameEquals(frame, first), "No mix of old and new channels");
+    assertEqual(1100, reader.rawChannelValue(1), "Raw value from the complete frame");
+    for (byte i = 3; i < CHANNELS; ++i) {
+        pulseTime += second[i];
+        reader.handlePulse(pulseTime);
+    }
+    assertEqual(2, reader.latestFrame(frame), "Second frame published");
+    assertTrue(frameEquals(frame, second), "Second frame complete");
+    assertEqual(1400, reader.rawChannelValue(6), "Raw value of the last channel");
+}
+
+void testFrameLength() {
+    Serial.println("\n=== Testing Short and Long Frames ===");
+    PPMReader reader(2, CHANNELS);
+    startSignal(reader);
+    const unsigned full[CHANNELS] = { 1100, 1200, 1300, 1400, 1500, 1600 };
+    sendFrame(reader, full, CHANNELS);
+
+    // Four channels: published at the blank, the rest keep their values
+    const unsigned shortFrame[4] = { 1010, 1020, 1030, 1040 };
+    sendFrame(reader, shortFrame, 4);
+    unsigned frame[CHANNELS];
+    assertEqual(1, reader.latestFrame(frame), "Short frame waits for the blank");
+    sendFrame(reader, full, 0);
+    assertEqual(2, reader.latestFrame(frame), "Short frame published at the blank");
+    const unsigned merged[CHANNELS] = { 1010, 1020, 1030, 1040, 1500, 1600 };
+    assertTrue(frameEquals(frame, merged), "Missing channels keep old values");
+
+    // Eight channels: the extra two are discarded
+    const unsigned longFrame[8] = { 1900, 1900, 1900, 1900, 1900, 1900, 1050, 1060 };
+    sendFrame(reader, longFrame, 8);
+    sendFrame(reader, longFrame, 0);
+    assertEqual(3, reader.latestFrame(frame), "Long frame published once");
+    assertEqual(1900, frame[5], "Extra channels discarded");
+}
+
+void testValidity() {
+    Serial.println("\n=== Testing Validity and Failsafe ===");
+    PPMReader reader(2, CHANNELS);
+    assertEqual(1234, reader.latestValidChannelValue(1, 1234), "Default before any frame");
+
+    startSignal(reader);
+    const unsigned values[CHANNELS] = { 995, 2005, 950, 2100, 1500, 1000 };
+    sendFrame(reader, values, CHANNELS);
+    assertEqual(1000, reader.latestValidChannelValue(1, 0), "Small error constrained up");
+    assertEqual(2000, reader.latestValidChannelValue(2, 0), "Small error constrained down");
+    assertEqual(0, reader.latestValidChannelValue(3, 0), "Too short is invalid");
+    assertEqual(0, reader.latestValidChannelValue(4, 0), "Too long is invalid");
+    assertEqual(1500, reader.latestValidChannelValue(5, 0), "Valid value");
+    assertEqual(0, reader.latestValidChannelValue(7, 0), "Channel out of range");
+    assertEqual(0, reader.rawChannelValue(0), "Channels count from 1");
+
+    // The last frame arrived longer ago than the failsafe timeout
+    PPMReader stale(3, CHANNELS);
+    startSignal(stale, stale.failsafeTimeout + 100000);
+    sendFrame(stale, values, CHANNELS);
+    assertEqual(0, stale.latestValidChannelValue(5, 0), "Failsafe after the timeout");
+    assertEqual(1500, stale.rawChannelValue(5), "Raw value kept through failsafe");
+
+    // A pulse after a gap longer than the timeout only restarts the timing
+    sendFrame(stale, values, 3);
+    pulseTime += stale.failsafeTimeout + 1;
+    stale.handlePulse(pulseTime);
+    for (byte i = 0; i < 3; ++i) {
+        pulseTime += values[i];
+        stale.handlePulse(pulseTime);
+    }
+    sendFrame(stale, values, 0);
+    unsigned frame[CHANNELS];
+    assertEqual(1, stale.latestFrame(frame), "Frames broken by signal loss not published");
+}
+
+void testInstances() {
+    Serial.println("\n=== Testing Multiple Instances ===");
+    PPMReader* readers[PPM_READER_MAX_INSTANCES];
+    bool attached = true;
+    for (byte i = 0; i < PPM_READER_MAX_INSTANCES; ++i) {
+        readers[i] = new PPMReader(2 + i, 4);
+        attached &= readers[i]->isAttached();
+    }
+    assertTrue(attached, "Every slot attached");
+    PPMReader* extra = new PPMReader(18, 4);
+    assertTrue(!extra->isAttached(), "No slot past the table");
+    delete extra;
+
+    delete readers[1];
+    readers[1] = new PPMReader(19, 4);
+    assertTrue(readers[1]->isAttached(), "Freed slot reused");
+
+    // Each instance decodes its own signal
+    const unsigned a[4] = { 1100, 1100, 1100, 1100 };
+    const unsigned b[4] = { 1900, 1900, 1900, 1900 };
+    startSignal(*readers[0]);
+    sendFrame(*readers[0], a, 4);
+    startSignal(*readers[1]);
+    sendFrame(*readers[1], b, 4);
+    assertTrue(readers[0]->rawChannelValue(2) == 1100 && readers[1]->rawChannelValue(2) == 1900,
+               "Instances independent");
+    for (byte i = 0; i < PPM_READER_MAX_INSTANCES; ++i) {
+        delete readers[i];
+    }
+}
+
+void runAllTests() {
+    Serial.println("Starting PPM Reader Unit Tests...");
+    Serial.println("=====================================");
+
+    testFrames();
+    testFrameLength();
+    testValidity();
+    testInstances();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("PPM Reader Unit Test Suite");
+    Serial.println("==========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
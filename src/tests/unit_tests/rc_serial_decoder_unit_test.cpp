@@ -0,0 +1,279 @@
+/**
+ * @file rc_serial_decoder_unit_test.cpp
+ * @brief Unit tests for the SBUS and iBus receiver decoders
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Replays captured receiver byte streams through RcSerialDecoder with
+ * their byte timing. Checks channel decoding and the SBUS flags, the
+ * extended iBus channels, sync on frame gaps and on headers, and the
+ * rejection of damaged frames. Also times the decoding of a frame.
+ */
+
+#include <Arduino.h>
+#include "../../modules/hardware_hiding/device_interface/rc_serial_decoder.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Sticks centred, throttle low, channel 5 high
+static const uint8_t SBUS_CENTRED[SBUS_FRAME_LENGTH] = {
+    0x0F, 0xE0, 0x03, 0x1F, 0x2B, 0xC0, 0x37, 0x71, 0x56, 0x80, 0x0F, 0x7C, 0xE0,
+    0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00
+};
+
+// Channels 1024, 1100, ... 900; channel 17 on; SBUS2 end byte
+static const uint8_t SBUS_SWEEP[SBUS_FRAME_LENGTH] = {
+    0x0F, 0x00, 0x64, 0x22, 0x2C, 0x29, 0x8A, 0x57, 0xEE, 0x02, 0x99, 0xD4, 0xC8,
+    0x60, 0x09, 0x64, 0xE8, 0x83, 0x25, 0x5E, 0x81, 0x8C, 0x70, 0x01, 0x04
+};
+
+// Receiver in failsafe: frame lost and failsafe flags set
+static const uint8_t SBUS_FAILSAFE[SBUS_FRAME_LENGTH] = {
+    0x0F, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0xC7, 0x0A, 0x56, 0xB0, 0x82, 0x15, 0xAC,
+    0x60, 0x05, 0x2B, 0x58, 0xC1, 0x0A, 0x56, 0xB0, 0x82, 0x15, 0x0C, 0x00
+};
+
+// FS-iA6B, 14 slots
+static const uint8_t IBUS_IA6B[IBUS_FRAME_LENGTH] = {
+    0x20, 0x40, 0xDB, 0x05, 0xDC, 0x05, 0x54, 0x05, 0xDC, 0x05, 0xE8, 0x03, 0xD0, 0x07,
+    0xD2, 0x05, 0xE8, 0x03, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05, 0xDC, 0x05,
+    0xDC, 0x05, 0xDA, 0xF3
+};
+
+// 18-channel receiver: channels 15..18 are 1000, 2000, 1234, 1500
+static const uint8_t IBUS_EXTENDED[IBUS_FRAME_LENGTH] = {
+    0x20, 0x40, 0xDC, 0x85, 0xDC, 0xE5, 0xE8, 0x33, 0xDC, 0x05, 0xD0, 0xD7, 0xE8, 0x73,
+    0xDC, 0x25, 0xDC, 0xD5, 0xDC, 0x45, 0xDC, 0xC5, 0xDC, 0xD5, 0xDC, 0x55, 0xDC, 0x05,
+    0xDC, 0x05, 0x67, 0xED
+};
+
+static RcSerialDecoder decoder;
+static uint32_t now = 0xFFFF0000UL;     // Streams straddle a micros() wrap
+
+// Replays bytes at the line's byte time; returns the frames completed
+static uint8_t replay(const uint8_t* bytes, uint8_t count, uint32_t byteUs) {
+    uint8_t completed = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        completed += decoder.feed(bytes[i], now) ? 1 : 0;
+        now += byteUs;
+    }
+    return completed;
+}
+
+// SBUS 8E2 at 100 kbaud: 120 us a byte, then the rest of a 14 ms frame
+static uint8_t sbusFrame(const uint8_t* frame) {
+    uint8_t completed = replay(frame, SBUS_FRAME_LENGTH, 120);
+    now += 14000 - SBUS_FRAME_LENGTH * 120;
+    return completed;
+}
+
+// iBus 8N1 at 115200: 87 us a byte, then the rest of a 7 ms frame
+static uint8_t ibusFrame(const uint8_t* frame) {
+    uint8_t completed = replay(frame, IBUS_FRAME_LENGTH, 87);
+    now += 7000 - IBUS_FRAME_LENGTH * 87;
+    return completed;
+}
+
+// Test functions
+void testSbus() {
+    Serial.println("\n=== Testing SBUS Decoding ===");
+    decoder.begin(RcProtocol::SBUS);
+    assertTrue(!decoder.hasFrame() && !decoder.hasSignal(now, 100000), "No signal before a frame");
+    assertEqual(1, sbusFrame(SBUS_CENTRED), "Captured frame decoded");
+    assertEqual(18, decoder.getChannelCount(), "16 channels plus 2 digital");
+    assertEqual(1500, decoder.getChannel(0), "992 is 1500 us");
+    assertEqual(987, decoder.getChannel(2), "172 is 987 us");
+    assertEqual(2011, decoder.getChannel(4), "1811 is 2011 us");
+    assertEqual(1500, decoder.getChannel(15), "Last analog channel");
+    assertEqual(987, decoder.getChannel(16), "Digital channel 17 off");
+    assertTrue(!decoder.isFailsafe() && !decoder.isFrameLost(), "No flags");
+    assertTrue(decoder.hasSignal(now, 100000), "Signal present");
+
+    assertEqual(1, sbusFrame(SBUS_SWEEP), "SBUS2 end byte accepted");
+    bool sweep = true;
+    const uint16_t raw[16] = { 1024, 1100, 1200, 1300, 1400, 1500, 1600, 1700, 200, 300, 400, 500, 600, 700, 800, 900 };
+    for (uint8_t i = 0; i < 16; i++) {
+        sweep &= decoder.getChannel(i) == RcSerialDecoder::sbusToUs(raw[i]);
+    }
+    assertTrue(sweep, "All 16 packed channels");
+    assertEqual(2011, decoder.getChannel(16), "Digital channel 17 on");
+    assertEqual(987, decoder.getChannel(17), "Digital channel 18 off");
+
+    assertEqual(1, sbusFrame(SBUS_FAILSAFE), "Failsafe frame decoded");
+    assertTrue(decoder.isFailsafe() && decoder.isFrameLost(), "Failsafe and frame lost flags");
+    assertTrue(!decoder.hasSignal(now, 100000), "No signal in failsafe");
+    assertEqual(1, decoder.getLostFrames(), "Lost frame counted");
+    sbusFrame(SBUS_CENTRED);
+    assertTrue(decoder.hasSignal(now, 100000), "Signal back with a clean frame");
+    assertTrue(!decoder.hasSignal(now + 100000, 100000), "Signal times out");
+    assertEqual(4, decoder.getFrames(), "Frames counted");
+}
+
+void testIbus() {
+    Serial.println("\n=== Testing iBus Decoding ===");
+    decoder.begin(RcProtocol::IBUS);
+    assertEqual(1, ibusFrame(IBUS_IA6B), "Captured frame decoded");
+    assertEqual(1499, decoder.getChannel(0), "Channel 1");
+    assertEqual(1364, decoder.getChannel(2), "Channel 3");
+    assertEqual(1000, decoder.getChannel(4), "Channel 5");
+    assertEqual(2000, decoder.getChannel(5), "Channel 6");
+    assertEqual(1500, decoder.getChannel(13), "Channel 14");
+    assertEqual(0, decoder.getChannel(14), "No channel 15 from a 14-slot receiver");
+
+    assertEqual(1, ibusFrame(IBUS_EXTENDED), "Extended frame decoded");
+    assertEqual(1500, decoder.getChannel(0), "Slot value without its high nibble");
+    assertEqual(1000, decoder.getChannel(2), "Channel 3 of the extended frame");
+    assertEqual(1000, decoder.getChannel(14), "Channel 15");
+    assertEqual(2000, decoder.getChannel(15), "Channel 16");
+    assertEqual(1234, decoder.getChannel(16), "Channel 17");
+    assertEqual(1500, decoder.getChannel(17), "Channel 18");
+
+    uint8_t damaged[IBUS_FRAME_LENGTH];
+    for (uint8_t i = 0; i < IBUS_FRAME_LENGTH; i++) {
+        damaged[i] = IBUS_IA6B[i];
+    }
+    damaged[5] ^= 0x10;
+    assertEqual(0, ibusFrame(damaged), "Bad checksum rejected");
+    assertEqual(1, decoder.getFrameErrors(), "Checksum error counted");
+    assertEqual(1000, decoder.getChannel(14), "Channels kept from the last good frame");
+}
+
+void testSync() {
+    Serial.println("\n=== Testing Frame Sync ===");
+    // Joined midway: byte 10 of the tail is 0x0F and starts a false frame,
+    // which the gap before the next header cuts short
+    decoder.begin(RcProtocol::SBUS);
+    replay(SBUS_CENTRED + 5, SBUS_FRAME_LENGTH - 5, 120);
+    now += 14000;
+    assertEqual(1, sbusFrame(SBUS_SWEEP), "Frame after a partial one decoded");
+    assertEqual(1, decoder.getSyncErrors(), "False frame cut by the gap");
+    assertEqual(RcSerialDecoder::sbusToUs(1024), decoder.getChannel(0), "Channels from the real frame");
+
+    // A frame cut by a dropout is noticed while the line is idle
+    replay(SBUS_CENTRED, 12, 120);
+    decoder.idle(now + SBUS_FRAME_GAP_US + 1);
+    now += 14000;
+    assertEqual(2, decoder.getSyncErrors(), "Idle line ends the frame");
+    assertEqual(1, sbusFrame(SBUS_CENTRED), "Next frame decoded");
+
+    // A bad end byte is a frame error, not channels
+    uint8_t damaged[SBUS_FRAME_LENGTH];
+    for (uint8_t i = 0; i < SBUS_FRAME_LENGTH; i++) {
+        damaged[i] = SBUS_SWEEP[i];
+    }
+    damaged[SBUS_FRAME_LENGTH - 1] = 0xFF;
+    assertEqual(0, sbusFrame(damaged), "Bad end byte rejected");
+    assertEqual(1500, decoder.getChannel(0), "Channels kept");
+
+    // Polled too slowly to see gaps: every byte read at once, junk first
+    decoder.begin(RcProtocol::IBUS);
+    const uint8_t junk[5] = { 0x55, 0x20, 0x13, 0xFF, 0x00 };
+    replay(junk, 5, 0);
+    replay(IBUS_IA6B, IBUS_FRAME_LENGTH, 0);
+    replay(IBUS_EXTENDED, IBUS_FRAME_LENGTH, 0);
+    assertEqual(2, decoder.getFrames(), "Header sync without gaps");
+    assertEqual(5, decoder.getSkippedBytes(), "Junk skipped");
+    assertEqual(1234, decoder.getChannel(16), "Last frame's channels");
+}
+
+void testSpeed() {
+    Serial.println("\n=== Benchmark: Frame Decoding ===");
+#ifdef ARDUINO
+    const uint16_t iterations = 200;
+#else
+    const uint32_t iterations = 200000;
+#endif
+    decoder.begin(RcProtocol::SBUS);
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (uint8_t b = 0; b < SBUS_FRAME_LENGTH; b++) {
+            decoder.feed(SBUS_SWEEP[b], b);
+        }
+    }
+    uint32_t sbusUs = micros() - start;
+
+    decoder.begin(RcProtocol::IBUS);
+    start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (uint8_t b = 0; b < IBUS_FRAME_LENGTH; b++) {
+            decoder.feed(IBUS_EXTENDED[b], b);
+        }
+    }
+    uint32_t ibusUs = micros() - start;
+
+    Serial.print("us per frame, SBUS: "); Serial.print((float)sbusUs / iterations, 3);
+    Serial.print(" iBus: "); Serial.println((float)ibusUs / iterations, 3);
+    assertEqual(iterations, decoder.getFrames(), "Every benchmark frame decoded");
+}
+
+void runAllTests() {
+    Serial.println("Starting RC Serial Decoder Unit Tests...");
+    Serial.println("=====================================");
+
+    testSbus();
+    testIbus();
+    testSync();
+    testSpeed();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("RC Serial Decoder Unit Test Suite");
+    Serial.println("=================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,200 @@
+/**
+ * @file scratch_allocator_unit_test.cpp
+ * @brief Unit tests and benchmark for FrameArena and BlockPool
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Tests alignment, exhaustion, frame reset, mark/rewind, pool reuse and
+ * high-water marks, then times the temporaries of one estimator step
+ * (two 6x6 matrices, two 6-vectors and a 64-sample median) allocated
+ * through NumericalAlgorithms on the heap, the pool and the arena.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/software_utility/scratch_allocator.h"
+#include "../../modules/software_decision/software_utility/numerical_algorithms.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+static uint8_t arenaStorage[1024];
+static uint8_t poolStorage[1536];
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Test functions
+void testArena() {
+    Serial.println("\n=== Testing Frame Arena ===");
+    FrameArena arena(arenaStorage + 1, sizeof(arenaStorage) - 1);
+
+    void* a = arena.allocate(3);
+    void* b = arena.allocate(36 * sizeof(float));
+    assertTrue(((uintptr_t)a % SCRATCH_ALIGNMENT) == 0 && ((uintptr_t)b % SCRATCH_ALIGNMENT) == 0,
+               "Allocations are aligned");
+    assertTrue(arena.owns(a) && arena.owns(b), "Arena owns its blocks");
+
+    size_t mark = arena.mark();
+    arena.allocate(100);
+    arena.rewind(mark);
+    assertEqual((long)mark, (long)arena.getUsed(), "Rewind drops nested scratch");
+
+    assertTrue(arena.allocate(4096) == nullptr, "Oversized request fails");
+    assertEqual(1, arena.getFailures(), "Failure counted");
+
+    size_t peak = arena.getHighWater();
+    arena.reset();
+    assertEqual(0, (long)arena.getUsed(), "Reset frees the frame");
+    assertEqual((long)peak, (long)arena.getHighWater(), "High water survives reset");
+    assertTrue(arena.allocate(16) == a, "Next frame reuses the start");
+}
+
+void testPool() {
+    Serial.println("\n=== Testing Block Pool ===");
+    BlockPool pool(poolStorage, 36 * sizeof(float), 4);
+    assertTrue(BlockPool::storageFor(36 * sizeof(float), 4) <= sizeof(poolStorage), "Storage size helper");
+
+    void* blocks[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        blocks[i] = pool.allocate(36 * sizeof(float));
+    }
+    assertTrue(blocks[3] != nullptr && pool.allocate(4) == nullptr, "Pool exhausts after four blocks");
+    assertTrue(pool.allocate(200) == nullptr, "Request above block size refused");
+    assertEqual(4, pool.getHighWater(), "High water");
+
+    pool.release(blocks[1]);
+    assertEqual(3, pool.getInUse(), "Release returns a block");
+    assertTrue(pool.allocate(8) == blocks[1], "Freed block reused first");
+
+    int outside;
+    pool.release(&outside);
+    assertEqual(4, pool.getInUse(), "Foreign pointer ignored");
+}
+
+// One estimator step's temporaries through NumericalAlgorithms: two 6x6
+// matrices, two 6-vectors and the 64-sample sort buffer of a median
+static float stepSamples[64];
+
+unsigned long benchSteps(NumericalAlgorithms& algorithms, uint16_t steps) {
+    unsigned long start = micros();
+    for (uint16_t s = 0; s < steps; s++) {
+        Matrix covariance = algorithms.createMatrix(6, 6);
+        Matrix gain = algorithms.createMatrix(6, 6);
+        Vector state = algorithms.createVector(6);
+        Vector innovation = algorithms.createVector(6);
+        stepSamples[0] = s;
+        StatisticalData stats = algorithms.calculateStatistics(stepSamples, 64);
+        ((volatile float*)covariance.data)[0] = stats.median;
+
+        algorithms.destroyStatistics(stats);
+        algorithms.destroyVector(innovation);
+        algorithms.destroyVector(state);
+        algorithms.destroyMatrix(gain);
+        algorithms.destroyMatrix(covariance);
+        algorithms.endFrame();
+    }
+    return micros() - start;
+}
+
+void testBenchmark() {
+    Serial.println("\n=== Benchmark: one estimator step ===");
+#ifdef ARDUINO
+    const uint16_t steps = 200;
+#else
+    const uint16_t steps = 2000;
+#endif
+    for (uint8_t i = 0; i < 64; i++) {
+        stepSamples[i] = (float)((i * 37) % 64);
+    }
+
+    NumericalAlgorithms onHeap;
+    unsigned long heap = benchSteps(onHeap, steps);
+
+    NumericalAlgorithms onPool;
+    BlockPool pool(poolStorage, 64 * sizeof(float), 5);   // storageFor() <= sizeof(poolStorage)
+    onPool.setBlockPool(&pool);
+    unsigned long pooled = benchSteps(onPool, steps);
+
+    NumericalAlgorithms onArena;
+    FrameArena arena(arenaStorage, sizeof(arenaStorage));
+    onArena.setFrameArena(&arena);
+    unsigned long arenaUs = benchSteps(onArena, steps);
+
+    Serial.print("heap  us/step: "); Serial.println((float)heap / steps, 3);
+    Serial.print("pool  us/step: "); Serial.println((float)pooled / steps, 3);
+    Serial.print("arena us/step: "); Serial.println((float)arenaUs / steps, 3);
+
+    assertEqual((long)steps * 5, onHeap.getHeapAllocations(), "Heap path allocates every temporary");
+    assertEqual(0, onPool.getHeapAllocations(), "Pool path never touches the heap");
+    assertEqual(0, onArena.getHeapAllocations(), "Arena path never touches the heap");
+    assertEqual(0, pool.getInUse(), "Every pool block returned");
+    assertEqual(0, onArena.getCurrentMemoryUsage(), "endFrame() reclaims the arena");
+    assertEqual((2 * 36 + 2 * 6 + 64) * sizeof(float), onArena.getMemoryUsage(), "Peak is one step");
+}
+
+void runAllTests() {
+    Serial.println("Starting Scratch Allocator Unit Tests...");
+    Serial.println("=====================================");
+
+    testArena();
+    testPool();
+    testBenchmark();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Scratch Allocator Unit Test Suite");
+    Serial.println("=================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,320 @@
+/**
+ * @file sensor_scheduler_unit_test.cpp
+ * @brief Unit tests for the budgeted step-wise sensor scheduler
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Drives SensorScheduler with simulated sensors on a simulated clock.
+ * Each step advances the clock by its cost. The tests check periods and
+ * waits, frame budgets, carry-over, rate tracking under overload and wait
+ * timeouts. They also compare the worst frame time with a synchronous
+ * read-everything loop over the same sensors.
+ */
+
+#include <Arduino.h>
+#include "../../modules/behavior_hiding/shared_services/sensor_scheduler.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Simulated clock, starting close to a wrap
+static uint32_t fakeNow = 0xFFF00000UL;
+static uint32_t fakeClock() { return fakeNow; }
+
+// Simulated sensor: step costs and conversion time in microseconds
+struct FakeSensor {
+    uint32_t triggerUs;
+    uint32_t pollUs;
+    uint32_t collectUs;
+    uint32_t conversionUs;
+    bool hasReady;
+    bool neverReady;
+    uint32_t triggeredAt;
+    uint32_t collects;
+    uint32_t earlyCollects;             // Before the conversion finished
+};
+
+static FakeSensor sensors[SENSOR_TASK_MAX];
+
+static bool fakeTrigger(void*, uint8_t index, uint32_t& readyInUs) {
+    FakeSensor& s = sensors[index];
+    s.triggeredAt = fakeNow;
+    fakeNow += s.triggerUs;
+    readyInUs = s.hasReady ? s.conversionUs / 2 : s.conversionUs;
+    return true;
+}
+
+static bool fakeReady(void*, uint8_t index) {
+    FakeSensor& s = sensors[index];
+    fakeNow += s.pollUs;
+    return !s.neverReady && fakeNow - s.triggeredAt >= s.conversionUs;
+}
+
+static bool fakeCollect(void*, uint8_t index) {
+    FakeSensor& s = sensors[index];
+    if (fakeNow - s.triggeredAt < s.conversionUs) {
+        s.earlyCollects++;
+    }
+    fakeNow += s.collectUs;
+    s.collects++;
+    return true;
+}
+
+static const SensorTaskOps TIMED_OPS = { fakeTrigger, nullptr, fakeCollect };
+static const SensorTaskOps POLLED_OPS = { fakeTrigger, fakeReady, fakeCollect };
+
+static SensorScheduler scheduler;
+
+static void setSensor(uint8_t i, uint32_t trigger, uint32_t collect, uint32_t conversion) {
+    sensors[i] = FakeSensor();
+    sensors[i].triggerUs = trigger;
+    sensors[i].pollUs = 40;
+    sensors[i].collectUs = collect;
+    sensors[i].conversionUs = conversion;
+}
+
+// Runs frames every frameUs (plus whatever the frame took) for durationUs
+static uint32_t runFor(uint32_t durationUs, uint32_t frameUs) {
+    uint32_t worst = 0;
+    uint32_t end = fakeNow + durationUs;
+    while ((int32_t)(end - fakeNow) > 0) {
+        scheduler.runFrame(fakeClock);
+        if (scheduler.getFrameUs() > worst) {
+            worst = scheduler.getFrameUs();
+        }
+        fakeNow += frameUs;
+    }
+    return worst;
+}
+
+// Test functions
+void testPeriodsAndWaits() {
+    Serial.println("\n=== Testing Periods and Waits ===");
+    scheduler.reset();
+    setSensor(0, 50, 300, 0);           // IMU: no conversion wait, 250 Hz
+    setSensor(1, 80, 200, 6400);        // Barometer: 6.4 ms conversion, 25 Hz
+    sensors[1].hasReady = true;
+    assertEqual(0, scheduler.addTask(&TIMED_OPS, nullptr, 0, 4000), "First task added");
+    assertEqual(1, scheduler.addTask(&POLLED_OPS, nullptr, 1, 40000), "Second task added");
+
+    runFor(2000000UL, 1000);
+    Serial.print("IMU Hz: "); Serial.print(scheduler.getAchievedRate(0), 3);
+    Serial.print(" baro Hz: "); Serial.println(scheduler.getAchievedRate(1), 3);
+    assertTrue(scheduler.getAchievedRate(0) > 245 && scheduler.getAchievedRate(0) < 255, "IMU at 250 Hz");
+    assertTrue(scheduler.getAchievedRate(1) > 24.5f && scheduler.getAchievedRate(1) < 25.5f, "Barometer at 25 Hz");
+    assertTrue(sensors[1].collects >= 49 && sensors[1].collects <= 51, "Barometer collected 50 times");
+    assertEqual(0, sensors[1].earlyCollects, "No collect before the conversion finished");
+    assertEqual(0, scheduler.getTask(0).missedPeriods, "No IMU periods missed");
+    assertTrue(!scheduler.isBehind(0) && !scheduler.isBehind(1), "Neither behind");
+    assertTrue(scheduler.getWorstFrameUs() <= SENSOR_FRAME_BUDGET_US, "Frames within budget");
+}
+
+void testBudget() {
+    Serial.println("\n=== Testing Frame Budget ===");
+    scheduler.reset();
+    scheduler.setBudget(1000);
+    for (uint8_t i = 0; i < 3; i++) {
+        setSensor(i, 20, 700, 0);       // Two collects never fit one frame
+        scheduler.addTask(&TIMED_OPS, nullptr, i, 10000);
+    }
+
+    // Step costs are learned in the first frames
+    runFor(50000UL, 500);
+    uint32_t worst = runFor(1000000UL, 500);
+    Serial.print("worst frame us: "); Serial.println(worst);
+    assertTrue(worst <= 1000 + 20, "Frame time held to the budget after warm-up");
+    bool carried = false;
+    bool onRate = true;
+    for (uint8_t i = 0; i < 3; i++) {
+        carried |= scheduler.getTask(i).deferredFrames > 0;
+        onRate &= sensors[i].collects >= 103;
+    }
+    assertTrue(carried, "Steps carried to the next frame");
+    assertTrue(onRate, "All sensors still at 100 Hz");
+
+    // A step larger than the budget still runs, alone
+    scheduler.reset();
+    scheduler.setBudget(500);
+    setSensor(0, 10, 2000, 0);
+    scheduler.addTask(&TIMED_OPS, nullptr, 0, 10000);
+    runFor(100000UL, 500);
+    assertTrue(sensors[0].collects >= 9, "Oversized step is not starved");
+    assertTrue(scheduler.getFrameSteps() <= 1, "Oversized step runs alone");
+}
+
+void testOverload() {
+    Serial.println("\n=== Testing Overload ===");
+    scheduler.reset();
+    scheduler.setBudget(1000);
+    // Four sensors at 500 Hz, each needing ~0.9 ms: about 1.8x what fits
+    for (uint8_t i = 0; i < 4; i++) {
+        setSensor(i, 10, 900, 0);
+        scheduler.addTask(&TIMED_OPS, nullptr, i, 2000);
+    }
+    runFor(1000000UL, 100);
+
+    uint32_t least = 0xFFFFFFFFUL;
+    uint32_t most = 0;
+    bool allBehind = true;
+    bool allMissed = true;
+    for (uint8_t i = 0; i < 4; i++) {
+        uint32_t n = sensors[i].collects;
+        least = n < least ? n : least;
+        most = n > most ? n : most;
+        allBehind &= scheduler.isBehind(i);
+        allMissed &= scheduler.getTask(i).missedPeriods > 0;
+    }
+    Serial.print("collects min/max: "); Serial.print(least); Serial.print("/"); Serial.println(most);
+    Serial.print("achieved Hz: "); Serial.print(scheduler.getAchievedRate(0), 3);
+    Serial.print(" of "); Serial.println(scheduler.getTargetRate(0), 3);
+    assertTrue(allBehind, "Every sensor reported behind its rate");
+    assertTrue(allMissed, "Lost periods counted, not queued");
+    assertTrue(most - least <= most / 10, "Round robin shares the frame fairly");
+    assertTrue(scheduler.getAchievedRate(0) < 400, "Achieved rate below target");
+
+    // Back to a sustainable rate, the sensors catch up
+    for (uint8_t i = 0; i < 4; i++) {
+        scheduler.setPeriod(i, 10000);
+    }
+    runFor(1000000UL, 100);
+    bool recovered = true;
+    for (uint8_t i = 0; i < 4; i++) {
+        recovered &= !scheduler.isBehind(i);
+    }
+    assertTrue(recovered, "Rate recovers after the period change");
+}
+
+void testWaitTimeout() {
+    Serial.println("\n=== Testing Ready Polling ===");
+    scheduler.reset();
+    setSensor(0, 20, 100, 5000);
+    sensors[0].hasReady = true;
+    sensors[0].neverReady = true;
+    scheduler.addTask(&POLLED_OPS, nullptr, 0, 100000);
+    runFor(500000UL, 1000);
+    assertEqual(0, sensors[0].collects, "Never-ready sensor not collected");
+    assertTrue(scheduler.getTask(0).failures >= 4, "Wait timeouts counted as failures");
+
+    sensors[0].neverReady = false;
+    scheduler.setEnabled(0, false);
+    runFor(200000UL, 1000);
+    assertEqual(0, sensors[0].collects, "Disabled sensor not run");
+    scheduler.setEnabled(0, true);
+    runFor(200000UL, 1000);
+    assertTrue(sensors[0].collects >= 2 && sensors[0].earlyCollects == 0, "Re-enabled sensor collects when ready");
+}
+
+// Synchronous reference: trigger, busy-wait, collect each sensor in turn
+static uint32_t synchronousFrame(uint8_t count) {
+    uint32_t start = fakeNow;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t readyIn;
+        fakeTrigger(nullptr, i, readyIn);
+        if ((int32_t)(sensors[i].triggeredAt + sensors[i].conversionUs - fakeNow) > 0) {
+            fakeNow = sensors[i].triggeredAt + sensors[i].conversionUs;
+        }
+        fakeCollect(nullptr, i);
+    }
+    return fakeNow - start;
+}
+
+void testAgainstSynchronous() {
+    Serial.println("\n=== Comparing with Synchronous Reads ===");
+    // IMU, barometer, magnetometer, GPS drain, ultrasonic echo
+    const uint32_t costs[5][4] = {
+        { 30, 0, 350, 0 },
+        { 80, 0, 250, 6400 },
+        { 80, 0, 300, 6000 },
+        { 10, 0, 900, 0 },
+        { 20, 0, 60, 25000 }
+    };
+    const uint32_t periods[5] = { 4000, 40000, 13333, 100000, 50000 };
+
+    scheduler.reset();
+    for (uint8_t i = 0; i < 5; i++) {
+        setSensor(i, costs[i][0], costs[i][2], costs[i][3]);
+        scheduler.addTask(&TIMED_OPS, nullptr, i, periods[i]);
+    }
+    uint32_t syncFrame = synchronousFrame(5);
+    uint32_t worst = runFor(2000000UL, 1000);
+    Serial.print("worst frame us, synchronous: "); Serial.print(syncFrame);
+    Serial.print(" scheduled: "); Serial.println(worst);
+    assertTrue(worst <= SENSOR_FRAME_BUDGET_US && syncFrame > 10 * worst, "Worst frame an order of magnitude shorter");
+    bool onRate = true;
+    for (uint8_t i = 0; i < 5; i++) {
+        onRate &= !scheduler.isBehind(i);
+    }
+    assertTrue(onRate, "Every sensor on its target rate");
+}
+
+void runAllTests() {
+    Serial.println("Starting Sensor Scheduler Unit Tests...");
+    Serial.println("=====================================");
+
+    testPeriodsAndWaits();
+    testBudget();
+    testOverload();
+    testWaitTimeout();
+    testAgainstSynchronous();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Sensor Scheduler Unit Test Suite");
+    Serial.println("================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
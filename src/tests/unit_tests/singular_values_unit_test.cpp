@@ -0,0 +1,216 @@
+/**
+ * @file singular_values_unit_test.cpp
+ * @brief Unit tests for SingularValues on its slot, value and expiry indexes
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Drives SingularValues through its public operations: sequential and
+ * circular generation, specific values, reservation and locking by owner,
+ * validation rules, filling the 64-slot table, release and reuse, and
+ * expiry cleanup. The index structures themselves are covered by
+ * id_allocator_unit_test.cpp.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/data_banker/singular_values.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// SingularValues slot count; its capacity is private
+static const uint16_t TABLE_SLOTS = 64;
+
+// One table for every test; it is too large for the stack
+static SingularValues registry;
+
+static bool rejectThirteen(uint32_t value) {
+    return value != 13;
+}
+
+// Test functions
+void testGeneration() {
+    Serial.println("\n=== Testing Value Generation ===");
+    registry.initialize();
+    assertEqual(0, registry.generateValue(SingularValueType::EVENT_ID), "Unregistered type refused");
+
+    assertTrue(registry.registerValueType(SingularValueType::EVENT_ID, "events", 10, 14), "Type registered");
+    assertTrue(registry.isValueTypeRegistered(SingularValueType::EVENT_ID), "Type reported");
+    assertTrue(!registry.registerValueType(SingularValueType::FILE_ID, "bad", 5, 4), "Empty range refused");
+
+    assertEqual(10, registry.generateValue(SingularValueType::EVENT_ID, "first", "nav"), "First value is the start");
+    assertEqual(11, registry.generateValue(SingularValueType::EVENT_ID), "Values count up");
+    assertTrue(registry.getValueStatus(10) == SingularValueStatus::IN_USE, "Generated value in use");
+    assertTrue(registry.getValueOwner(10) == "nav", "Owner recorded");
+
+    assertEqual(0, registry.generateValue(SingularValueType::EVENT_ID, 11), "Taken specific value refused");
+    assertEqual(20, registry.generateValue(SingularValueType::EVENT_ID, 20), "Free specific value taken");
+    assertEqual(3, registry.getValueCount(), "Three values held");
+
+    // Non-circular: the range runs out
+    registry.generateValue(SingularValueType::EVENT_ID);
+    registry.generateValue(SingularValueType::EVENT_ID);
+    registry.generateValue(SingularValueType::EVENT_ID);
+    assertEqual(0, registry.generateValue(SingularValueType::EVENT_ID), "Exhausted range refused");
+
+    // Circular: wraps past values still in use to the released one
+    registry.registerValueType(SingularValueType::MESSAGE_ID, "messages", 100, 102, 1, true);
+    registry.generateValue(SingularValueType::MESSAGE_ID);
+    registry.generateValue(SingularValueType::MESSAGE_ID);
+    registry.generateValue(SingularValueType::MESSAGE_ID);
+    assertTrue(registry.releaseValue(101), "Value released");
+    assertEqual(101, registry.generateValue(SingularValueType::MESSAGE_ID), "Released value handed out again");
+}
+
+void testOwnership() {
+    Serial.println("\n=== Testing Reservation and Locking ===");
+    registry.initialize();
+    registry.registerValueType(SingularValueType::SESSION_ID, "sessions", 1, 1000);
+
+    assertTrue(registry.reserveValue(500, "ground"), "Unissued value reserved");
+    assertTrue(registry.getValueStatus(500) == SingularValueStatus::RESERVED, "Reserved status");
+    assertTrue(!registry.reserveValue(500, "radio"), "Other owner refused");
+    assertTrue(!registry.reserveValue(5000, "ground"), "Value outside every type refused");
+
+    assertTrue(registry.lockValue(500, "ground"), "Owner locks");
+    assertTrue(!registry.releaseValue(500), "Locked value not released");
+    assertTrue(registry.unlockValue(500), "Unlocked");
+    assertTrue(registry.releaseValue(500), "Released after unlock");
+    assertTrue(registry.getValueStatus(500) == SingularValueStatus::AVAILABLE, "Available again");
+    assertEqual(0, registry.getValueCount(), "Table empty");
+}
+
+void testValidation() {
+    Serial.println("\n=== Testing Validation Rules ===");
+    SingularValuesConfig config = {};
+    config.enableValidation = true;
+    registry.initialize(config);
+    registry.registerValueType(SingularValueType::DEVICE_ID, "devices", 12, 20);
+    assertTrue(registry.addValidationRule("not13", rejectThirteen, "13 is reserved"), "Rule added");
+    assertTrue(!registry.addValidationRule("not13", rejectThirteen), "Duplicate rule refused");
+
+    assertEqual(12, registry.generateValue(SingularValueType::DEVICE_ID), "Valid value kept");
+    assertEqual(14, registry.generateValue(SingularValueType::DEVICE_ID), "Rejected value skipped");
+}
+
+void testCapacity() {
+    Serial.println("\n=== Testing Full Table ===");
+    registry.initialize();
+    registry.registerValueType(SingularValueType::TRANSACTION_ID, "transactions", 1, 5000);
+
+    bool allIssued = true;
+    for (uint16_t i = 0; i < TABLE_SLOTS; i++) {
+        allIssued &= registry.generateValue(SingularValueType::TRANSACTION_ID) == (uint32_t)i + 1;
+    }
+    assertTrue(allIssued, "64 values issued in order");
+    assertEqual(0, registry.generateValue(SingularValueType::TRANSACTION_ID), "Full table refused");
+    assertTrue((registry.getErrorFlags() & 0x01) != 0, "Table full flagged");
+
+    bool allReleased = true;
+    for (uint32_t value = 1; value <= TABLE_SLOTS; value += 2) {
+        allReleased &= registry.releaseValue(value);
+    }
+    assertTrue(allReleased, "Every other value released");
+    assertEqual(TABLE_SLOTS / 2, registry.getValueCount(), "Half the table held");
+    assertEqual(TABLE_SLOTS + 1, registry.generateValue(SingularValueType::TRANSACTION_ID), "Freed slot reused");
+    assertTrue(registry.getValueStatus(TABLE_SLOTS) == SingularValueStatus::IN_USE, "Kept values still found");
+    assertTrue(registry.getValueStatus(TABLE_SLOTS - 1) == SingularValueStatus::AVAILABLE, "Released values gone");
+}
+
+void testExpiry() {
+    Serial.println("\n=== Testing Expiry ===");
+    registry.initialize();
+    registry.registerValueType(SingularValueType::USER_ID, "users", 1, 100);
+    uint32_t due = registry.generateValue(SingularValueType::USER_ID);
+    uint32_t later = registry.generateValue(SingularValueType::USER_ID);
+    uint32_t locked = registry.generateValue(SingularValueType::USER_ID);
+    uint32_t kept = registry.generateValue(SingularValueType::USER_ID);
+
+    unsigned long now = millis();
+    assertTrue(registry.setValueExpiration(due, now - 1), "Past expiry set");
+    assertTrue(registry.setValueExpiration(later, now + 60000UL), "Future expiry set");
+    registry.lockValue(locked, "ops");
+    registry.setValueExpiration(locked, now - 1);
+    assertTrue(!registry.setValueExpiration(999, now), "Unknown value refused");
+
+    assertTrue(registry.cleanupExpiredValues(), "Due value released");
+    assertTrue(registry.getValueStatus(due) == SingularValueStatus::AVAILABLE, "Expired value gone");
+    assertTrue(registry.getValueStatus(later) == SingularValueStatus::IN_USE, "Future expiry kept");
+    assertTrue(registry.getValueStatus(locked) == SingularValueStatus::LOCKED, "Lock outlives its expiry");
+    assertTrue(registry.getValueStatus(kept) == SingularValueStatus::IN_USE, "Unscheduled value kept");
+
+    assertTrue(registry.removeValueExpiration(later), "Expiry removed");
+    assertTrue(!registry.cleanupExpiredValues(), "Nothing left to release");
+    assertEqual(3, registry.getValueCount(), "Three values held");
+}
+
+void runAllTests() {
+    Serial.println("Starting Singular Values Unit Tests...");
+    Serial.println("=====================================");
+
+    testGeneration();
+    testOwnership();
+    testValidation();
+    testCapacity();
+    testExpiry();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Singular Values Unit Test Suite");
+    Serial.println("===============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
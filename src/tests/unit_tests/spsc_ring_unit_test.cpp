@@ -0,0 +1,227 @@
+/**
+ * @file spsc_ring_unit_test.cpp
+ * @brief Unit tests for the interrupt-to-loop SPSC ring
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks FIFO order, full and empty behaviour, drop counting, peek and
+ * clear, and wrap of the 8-bit counters. On the board a timer interrupt
+ * posts while loop() drains with interrupts enabled; on the host a
+ * producer thread stands in for the ISR. Both check that every item
+ * arrives once, in order, or is counted as dropped.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/software_utility/spsc_ring.h"
+
+#ifndef ARDUINO
+#include <atomic>
+#include <thread>
+#endif
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+struct Sample {
+    uint16_t sequence;
+    uint16_t check;
+};
+
+// Test functions
+void testBasics() {
+    Serial.println("\n=== Testing Ring Basics ===");
+    SpscRing<uint8_t, 8> ring;
+    uint8_t value = 0;
+    assertTrue(ring.isEmpty() && !ring.pop(value), "Starts empty");
+
+    for (uint8_t i = 0; i < 8; i++) ring.push(i);
+    assertEqual(8, ring.size(), "Holds its full capacity");
+    assertTrue(!ring.push(99), "Full ring refuses");
+    assertEqual(1, ring.getDropped(), "Drop counted");
+
+    assertTrue(ring.peek(value) && value == 0 && ring.size() == 8, "Peek leaves the item");
+    bool ordered = true;
+    for (uint8_t i = 0; i < 8; i++) {
+        ordered &= ring.pop(value) && value == i;
+    }
+    assertTrue(ordered, "FIFO order");
+
+    ring.push(1);
+    ring.push(2);
+    ring.clear();
+    assertTrue(ring.isEmpty(), "Clear empties");
+}
+
+void testCounterWrap() {
+    Serial.println("\n=== Testing Index Wrap ===");
+    SpscRing<uint16_t, 128> ring;
+    bool ordered = true;
+    uint16_t next = 0;
+    // 1000 items through a 128 ring wraps the 8-bit counters several times
+    for (uint16_t produced = 0; produced < 1000;) {
+        for (uint8_t burst = 0; burst < 100 && produced < 1000; burst++) {
+            ring.push(produced++);
+        }
+        uint16_t value;
+        while (ring.pop(value)) {
+            ordered &= value == next++;
+        }
+    }
+    assertTrue(ordered && next == 1000, "Order kept across counter wrap");
+    assertEqual(0, ring.getDropped(), "Nothing dropped below capacity");
+}
+
+static SpscRing<Sample, 32> shared;
+static const uint16_t STRESS_COUNT = 20000;
+
+#ifdef ARDUINO
+static volatile uint16_t isrSequence = 0;
+
+ISR(TIMER2_COMPA_vect) {
+    if (isrSequence < STRESS_COUNT) {
+        Sample sample = { isrSequence, (uint16_t)~isrSequence };
+        shared.push(sample);
+        isrSequence++;
+    }
+}
+
+void startProducer() {
+    // Timer2 CTC at ~16 kHz
+    TCCR2A = _BV(WGM21);
+    TCCR2B = _BV(CS21);
+    OCR2A = 124;
+    TIMSK2 |= _BV(OCIE2A);
+}
+
+void stopProducer() {
+    TIMSK2 &= ~_BV(OCIE2A);
+}
+
+bool producerDone() {
+    return isrSequence >= STRESS_COUNT;
+}
+#else
+static std::thread producer;
+static std::atomic<bool> producerFinished(false);
+
+void startProducer() {
+    producerFinished = false;
+    producer = std::thread([] {
+        for (uint16_t i = 0; i < STRESS_COUNT; i++) {
+            Sample sample = { i, (uint16_t)~i };
+            shared.push(sample);
+            std::this_thread::yield();
+        }
+        producerFinished = true;
+    });
+}
+
+void stopProducer() {
+    producer.join();
+}
+
+bool producerDone() {
+    return producerFinished;
+}
+#endif
+
+void testConcurrent() {
+    Serial.println("\n=== Testing Concurrent Producer ===");
+    uint16_t received = 0;
+    bool intact = true;
+    bool ordered = true;
+    long lastSequence = -1;
+    Sample sample;
+
+    // The consumer never disables interrupts
+    startProducer();
+    for (;;) {
+        bool done = producerDone();
+        while (shared.pop(sample)) {
+            intact &= sample.check == (uint16_t)~sample.sequence;
+            ordered &= (long)sample.sequence > lastSequence;
+            lastSequence = sample.sequence;
+            received++;
+        }
+        if (done && shared.isEmpty()) {
+            break;
+        }
+    }
+    stopProducer();
+
+    Serial.print("received: "); Serial.print(received);
+    Serial.print(" dropped: "); Serial.println(shared.getDropped());
+    assertTrue(intact, "No torn items");
+    assertTrue(ordered, "Items arrive in order");
+    assertEqual(STRESS_COUNT, received + shared.getDropped(), "Every item received or counted as dropped");
+}
+
+void runAllTests() {
+    Serial.println("Starting SPSC Ring Unit Tests...");
+    Serial.println("=====================================");
+
+    testBasics();
+    testCounterWrap();
+    testConcurrent();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("SPSC Ring Unit Test Suite");
+    Serial.println("=========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
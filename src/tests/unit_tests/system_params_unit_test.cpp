@@ -0,0 +1,343 @@
+/**
+ * @file system_params_unit_test.cpp
+ * @brief Unit tests for compile-time keyed system parameters
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks that the generated perfect hash resolves every SYSTEM_PARAMS name
+ * to its own Param and rejects unknown names, tests typed and by-name
+ * access with range checks, dirty tracking, settled and rate-limited
+ * flushing timed from the change, resets, and the changed-since query
+ * used for parameter sync across boot epochs, and times
+ * a console-style lookup against the linear name compare it replaces and
+ * against a typed get<>().
+ */
+
+#include <Arduino.h>
+#include "../../modules/behavior_hiding/shared_services/system_params.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Fake millis() for change times
+unsigned long testNow = 0;
+
+unsigned long testClock() {
+    return testNow;
+}
+
+bool findName(const char* name, Param& param) {
+    return SystemParams::find(name, (uint8_t)strlen(name), param);
+}
+
+// Test functions
+void testPerfectHash() {
+    Serial.println("\n=== Testing Perfect Hash ===");
+    uint8_t resolved = 0;
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        char name[PARAM_NAME_MAX + 1];
+        uint8_t length = getParamName(static_cast<Param>(i), name);
+        Param param;
+        if (SystemParams::find(name, length, param) && static_cast<uint8_t>(param) == i) {
+            resolved++;
+        } else {
+            Serial.print("Unresolved: ");
+            Serial.println(name);
+        }
+    }
+    assertEqual(PARAM_COUNT, resolved, "Every name maps to its own Param");
+
+    Param param;
+    assertTrue(!findName("ROLL_Q", param), "Unknown name rejected");
+    assertTrue(!findName("ROLL", param), "Prefix rejected");
+    assertTrue(!findName("roll_p", param), "Names are case sensitive");
+    assertTrue(!findName("", param), "Empty name rejected");
+    assertTrue(!findName("A_VERY_LONG_PARAMETER_NAME", param), "Overlong name rejected");
+}
+
+void testTypedAccess() {
+    Serial.println("\n=== Testing Typed Access ===");
+    SystemParams params;
+    assertTrue(params.get<Param::RollP>() == 1.3f, "Float default");
+    assertEqual(400, params.get<Param::RollMax>(), "Int default");
+    assertTrue(params.get<Param::AutoLevel>(), "Bool default");
+
+    assertTrue(params.set<Param::RollP>(2.5f) && params.get<Param::RollP>() == 2.5f, "Typed set");
+    assertTrue(!params.set<Param::RollP>(25.0f), "Typed set range checked");
+    assertTrue(params.get<Param::RollP>() == 2.5f, "Rejected set keeps value");
+    assertTrue(!params.set<Param::ThrottleIdle>(900), "Int range checked");
+
+    params.set<Param::YawP>(6.0f);
+    uint32_t before = params.getSequence();
+    params.resetToDefaults();
+    assertTrue(params.get<Param::RollP>() == 1.3f && params.get<Param::YawP>() == 4.0f, "Reset restores defaults");
+    assertEqual(2, params.getDirtyCount(), "Only changed parameters dirty");
+    assertEqual(before + 1, params.getSequence(), "Reset is one change");
+    assertEqual(params.getSequence(), params.getChangedAt(Param::YawP), "Reset parameters share its number");
+    params.resetToDefaults();
+    assertEqual(before + 1, params.getSequence(), "Reset at defaults changes nothing");
+}
+
+void testByName() {
+    Serial.println("\n=== Testing By-Name Access ===");
+    SystemParams params;
+    Param param;
+
+    assertTrue(findName("THR_IDLE", param) && params.setNumeric(param, 1149.6f), "Set int by name");
+    assertEqual(1150, params.get<Param::ThrottleIdle>(), "Int rounded");
+    assertTrue(findName("AUTO_LEVEL", param) && params.setNumeric(param, 0.0f), "Set bool by name");
+    assertTrue(!params.get<Param::AutoLevel>(), "Bool cleared");
+    assertTrue(findName("MAG_DECL_DEG", param) && !params.setNumeric(param, NAN), "NaN rejected");
+    assertTrue(params.getNumeric(Param::BatteryCells) == 3.0f, "Get by Param");
+
+    ParamInfo info;
+    getParamInfo(Param::GeofenceRadius, info);
+    assertTrue(info.kind == ParamKind::FLOAT && info.maxValue == 5000.0f &&
+               info.category == static_cast<uint8_t>(SystemValueCategory::NAVIGATION), "Metadata from table");
+}
+
+// Stand-in for the EEPROM store
+struct FakeStore {
+    uint8_t writes;
+    bool failing;
+    Param last;
+};
+
+bool storeWrite(void* context, Param param, const ParamValue&) {
+    FakeStore* store = static_cast<FakeStore*>(context);
+    if (store->failing) {
+        return false;
+    }
+    store->writes++;
+    store->last = param;
+    return true;
+}
+
+void testDirtyTracking() {
+    Serial.println("\n=== Testing Dirty Tracking ===");
+    SystemParams params;
+    assertEqual(0, params.getDirtyCount(), "Defaults start clean");
+    assertEqual(0, (long)params.getSequence(), "Sequence starts at zero");
+
+    params.set<Param::RollP>(1.3f);
+    assertEqual(0, params.getDirtyCount(), "Unchanged value stays clean");
+
+    params.set<Param::RollP>(1.5f);
+    params.set<Param::RollP>(1.6f);
+    params.set<Param::YawI>(0.03f);
+    assertEqual(2, params.getDirtyCount(), "Repeated sets coalesce");
+    assertTrue(params.isDirty(Param::RollP) && !params.isDirty(Param::RollI), "Per-entry bits");
+
+    ParamValue stored;
+    stored.floatValue = 0.5f;
+    params.restore(Param::YawI, stored);
+    assertTrue(!params.isDirty(Param::YawI), "Restore does not dirty");
+}
+
+void testBatchedFlush() {
+    Serial.println("\n=== Testing Batched Flush ===");
+    SystemParams params;
+    params.setClock(testClock);
+    FakeStore store = { 0, false, Param::RollP };
+    ParamFlushPolicy policy = { 1000, 50, 1 };
+
+    // A slider drag: many changes, 20 ms apart
+    unsigned long now = 0;
+    for (uint8_t i = 0; i < 50; i++) {
+        testNow = now;
+        params.set<Param::PitchP>(1.0f + i * 0.01f);
+        if (i == 10) params.set<Param::LevelGain>(12.0f);
+        params.flush(storeWrite, &store, now, policy);
+        now += 20;
+    }
+    assertEqual(0, store.writes, "Nothing written while changing");
+
+    params.flush(storeWrite, &store, now + 500, policy);
+    assertEqual(0, store.writes, "Nothing written before settle time");
+
+    assertEqual(1, params.flush(storeWrite, &store, now + 1000, policy), "One write per step");
+    assertEqual(0, params.flush(storeWrite, &store, now + 1020, policy), "Steps are rate limited");
+    assertEqual(1, params.flush(storeWrite, &store, now + 1060, policy), "Second entry next step");
+    assertEqual(2, store.writes, "Fifty changes cost two writes");
+    assertEqual(0, params.getDirtyCount(), "All clean after flush");
+
+    params.set<Param::DebugOutput>(true);
+    params.flush(storeWrite, &store, now + 2000, policy);
+    params.flush(storeWrite, &store, now + 3100, policy);
+    assertEqual(2, store.writes, "Non-persistent parameter not written");
+    assertEqual(0, params.getDirtyCount(), "Non-persistent parameter cleared");
+
+    params.set<Param::RollD>(20.0f);
+    store.failing = true;
+    params.flush(storeWrite, &store, now + 4000, policy);
+    params.flush(storeWrite, &store, now + 5100, policy);
+    assertTrue(params.isDirty(Param::RollD), "Failed write stays dirty");
+    store.failing = false;
+    assertEqual(1, params.flushAll(storeWrite, &store), "flushAll writes immediately");
+    assertTrue(store.last == Param::RollD, "Retried entry written");
+
+    // The settle time runs from the change, even if flush() was not called since
+    testNow = now + 10000;
+    params.set<Param::RollD>(22.0f);
+    assertEqual(0, params.flush(storeWrite, &store, now + 10900, policy), "Settling from the change");
+    assertEqual(1, params.flush(storeWrite, &store, now + 11000, policy), "Written a settle time after the change");
+    testNow = 0;
+}
+
+void testChangedSince() {
+    Serial.println("\n=== Testing Changed Since ===");
+    SystemParams params;
+    Param changed[PARAM_COUNT];
+
+    assertEqual(PARAM_COUNT, params.changedSince(0, changed, PARAM_COUNT), "Sequence 0 lists everything");
+
+    params.set<Param::RollP>(2.0f);
+    uint32_t synced = params.getSequence();
+    params.set<Param::ThrottleIdle>(1150);
+    params.set<Param::GpsRate>(10);
+    params.set<Param::ThrottleIdle>(1160);
+
+    uint8_t count = params.changedSince(synced, changed, PARAM_COUNT);
+    assertEqual(2, count, "Only later changes listed");
+    assertTrue(changed[0] == Param::ThrottleIdle && changed[1] == Param::GpsRate, "Listed in Param order");
+    assertEqual(0, params.changedSince(params.getSequence(), changed, PARAM_COUNT), "Up to date lists nothing");
+    assertEqual(1, params.changedSince(synced, changed, 1), "Output bounded by caller");
+
+    // After a reboot the ground station still holds the old boot's number
+    SystemParams rebooted;
+    rebooted.setEpoch(7);
+    assertEqual(7, rebooted.getEpoch(), "Epoch in the top bits");
+    assertEqual(PARAM_COUNT, rebooted.changedSince(synced, changed, PARAM_COUNT), "Old epoch lists everything");
+    uint32_t resynced = rebooted.getSequence();
+    assertEqual(0, rebooted.changedSince(resynced, changed, PARAM_COUNT), "Synced this epoch lists nothing");
+    rebooted.set<Param::GpsRate>(10);
+    assertEqual(1, rebooted.changedSince(resynced, changed, PARAM_COUNT), "Then only changes");
+    assertTrue(changed[0] == Param::GpsRate, "Changed parameter listed");
+}
+
+// The lookup SystemValues used to do: compare against every entry
+bool linearFind(const char* name, Param& param) {
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        char candidate[PARAM_NAME_MAX + 1];
+        getParamName(static_cast<Param>(i), candidate);
+        if (strcmp(candidate, name) == 0) {
+            param = static_cast<Param>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void testTiming() {
+    Serial.println("\n=== Lookup Timing ===");
+    const char* names[] = { "ROLL_P", "YAW_D", "THR_MAX", "TELEM_RATE_HZ", "DEBUG_OUT" };
+    const uint8_t nameCount = sizeof(names) / sizeof(names[0]);
+    const uint16_t rounds = 200;
+    SystemParams params;
+    Param param;
+    volatile float sink = 0;
+
+    unsigned long start = micros();
+    for (uint16_t r = 0; r < rounds; r++) {
+        for (uint8_t n = 0; n < nameCount; n++) {
+            linearFind(names[n], param);
+        }
+    }
+    unsigned long linear = micros() - start;
+
+    start = micros();
+    for (uint16_t r = 0; r < rounds; r++) {
+        for (uint8_t n = 0; n < nameCount; n++) {
+            findName(names[n], param);
+        }
+    }
+    unsigned long hashed = micros() - start;
+
+    start = micros();
+    for (uint16_t r = 0; r < rounds * nameCount; r++) {
+        sink += params.get<Param::RollP>();
+    }
+    unsigned long typed = micros() - start;
+
+    Serial.print("linear name compare us/lookup: ");
+    Serial.println((float)linear / (rounds * nameCount), 3);
+    Serial.print("perfect hash us/lookup: ");
+    Serial.println((float)hashed / (rounds * nameCount), 3);
+    Serial.print("get<Param> us/read: ");
+    Serial.println((float)typed / (rounds * nameCount), 3);
+    assertTrue(hashed <= linear, "Hash no slower than linear compare");
+}
+
+void runAllTests() {
+    Serial.println("Starting System Params Unit Tests...");
+    Serial.println("=====================================");
+
+    testPerfectHash();
+    testTypedAccess();
+    testByName();
+    testDirtyTracking();
+    testBatchedFlush();
+    testChangedSince();
+    testTiming();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("System Params Unit Test Suite");
+    Serial.println("=============================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
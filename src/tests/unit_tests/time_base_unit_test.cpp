@@ -0,0 +1,249 @@
+/**
+ * @file time_base_unit_test.cpp
+ * @brief Unit tests for the 64-bit time base and PPS discipline
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks extension of the 32-bit micros() counter across wraps and for
+ * slightly stale readings. A simulated oscillator with a known rate error
+ * and capture jitter then drives the PPS discipline. The tests check the
+ * rate estimate, lock, rejection of spurious and missed pulses, continuity
+ * of corrected time, and conversion to and from GPS time of week.
+ */
+
+#include <Arduino.h>
+#include "../../modules/hardware_hiding/extended_computer/time_base.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static TimeBase timeBase;
+
+// Simulated board oscillator: local = offset + true * (1 + rate) + jitter
+static const int32_t OSCILLATOR_PPB = 150000;       // 150 ppm fast
+static const uint64_t BOOT_OFFSET_US = 4294000000ULL;   // Close to a micros() wrap
+
+static uint32_t rng = 2024;
+static int32_t jitterUs() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (int32_t)(rng % 9) - 4;                  // +-4 us capture jitter
+}
+
+static uint64_t localAt(uint64_t trueUs) {
+    return BOOT_OFFSET_US + trueUs + (uint64_t)((int64_t)trueUs * OSCILLATOR_PPB / 1000000000LL);
+}
+
+// Main loop advances and one pulse at true second s
+static void pulseAt(uint32_t second) {
+    uint64_t local = localAt((uint64_t)second * 1000000ULL) + jitterUs();
+    timeBase.advance((uint32_t)local);
+    timeBase.capturePps(timeBase.extend((uint32_t)local));
+    timeBase.processPps();
+}
+
+static long absDiff(uint64_t a, uint64_t b) {
+    return a > b ? (long)(a - b) : (long)(b - a);
+}
+
+// Test functions
+void testExtension() {
+    Serial.println("\n=== Testing 64-bit Extension ===");
+    TimeBase clock;
+    clock.advance(0xFFFFFF00UL);
+    assertTrue(clock.extend(0x00000100UL) == 0x100000100ULL, "Wrap since last advance");
+    clock.advance(0x00000100UL);
+    assertTrue(clock.extend(0xFFFFFF80UL) == 0xFFFFFF80ULL, "Stale reading from before the wrap");
+    assertTrue(clock.extend(0x00000200UL) == 0x100000200ULL, "Fresh reading after the wrap");
+
+    clock.reset();
+    bool monotonic = true;
+    uint64_t previous = 0;
+    uint32_t raw = 0;
+    for (uint32_t i = 0; i < 3300; i++) {
+        raw += 4000000UL + i;                       // ~4 s loop steps, three wraps
+        clock.advance(raw);
+        uint64_t now = clock.extend(raw);
+        monotonic &= now > previous;
+        previous = now;
+    }
+    assertTrue(monotonic, "Monotonic across repeated wraps");
+    assertTrue((previous >> 32) == 3, "Three wraps counted");
+}
+
+void testDiscipline() {
+    Serial.println("\n=== Testing PPS Discipline ===");
+    timeBase.reset();
+    timeBase.advance((uint32_t)BOOT_OFFSET_US);
+
+    for (uint32_t s = 1; s <= 3; s++) {
+        pulseAt(s);
+    }
+    assertTrue(!timeBase.isLocked(localAt(3000000ULL)), "Not locked after three pulses");
+    for (uint32_t s = 4; s <= 60; s++) {
+        pulseAt(s);
+    }
+    uint64_t now = localAt(60000000ULL);
+    assertTrue(timeBase.isLocked(now), "Locked");
+    long rateError = timeBase.getRateErrorPpb() - OSCILLATOR_PPB;
+    Serial.print("rate estimate ppb: "); Serial.println(timeBase.getRateErrorPpb());
+    assertTrue(rateError > -3000 && rateError < 3000, "Rate error within 3 ppm");
+
+    // Over 100 s corrected time tracks true time; raw time is 15 ms off
+    uint64_t startLocal = localAt(61000000ULL);
+    uint64_t startCorrected = timeBase.correctedUs(startLocal);
+    bool monotonic = true;
+    uint64_t previous = startCorrected;
+    for (uint32_t s = 61; s <= 161; s++) {
+        pulseAt(s);
+        uint64_t corrected = timeBase.correctedUs(localAt((uint64_t)s * 1000000ULL + 500000ULL));
+        monotonic &= corrected > previous;
+        previous = corrected;
+    }
+    uint64_t endLocal = localAt(161000000ULL);
+    long correctedError = absDiff(timeBase.correctedUs(endLocal) - startCorrected, 100000000ULL);
+    long rawError = absDiff(endLocal - startLocal, 100000000ULL);
+    Serial.print("100 s error us, raw: "); Serial.print(rawError);
+    Serial.print(" corrected: "); Serial.println(correctedError);
+    assertTrue(monotonic, "Corrected time monotonic across anchors");
+    assertTrue(correctedError < 500 && rawError > 10000, "Corrected time follows GPS rate");
+
+    assertTrue(!timeBase.isLocked(localAt(165000000ULL)), "Lock lost without pulses");
+}
+
+void testBadPulses() {
+    Serial.println("\n=== Testing Spurious and Missed Pulses ===");
+    timeBase.reset();
+    timeBase.advance((uint32_t)BOOT_OFFSET_US);
+    for (uint32_t s = 1; s <= 10; s++) {
+        pulseAt(s);
+    }
+    int32_t rate = timeBase.getRateErrorPpb();
+
+    // Spurious edge half way through a second
+    uint64_t glitch = localAt(10500000ULL);
+    timeBase.capturePps(glitch);
+    timeBase.processPps();
+    assertEqual(1, timeBase.getRejectedPulses(), "Spurious edge rejected");
+    pulseAt(11);
+    assertEqual(1, timeBase.getRejectedPulses(), "Next real pulse accepted");
+
+    // Two pulses missed
+    for (uint32_t s = 14; s <= 20; s++) {
+        pulseAt(s);
+    }
+    assertEqual(1, timeBase.getRejectedPulses(), "Gap of three seconds accepted");
+    long drift = timeBase.getRateErrorPpb() - rate;
+    assertTrue(drift > -3000 && drift < 3000, "Rate unchanged by the gap");
+    assertTrue(timeBase.isLocked(localAt(20100000ULL)), "Locked again");
+}
+
+void testGpsTime() {
+    Serial.println("\n=== Testing GPS Time of Week ===");
+    timeBase.reset();
+    timeBase.advance((uint32_t)BOOT_OFFSET_US);
+    const uint64_t towAtZero = 604795000000ULL;     // 5 s before the week ends
+
+    uint64_t tow;
+    assertTrue(!timeBase.toGpsTowUs(localAt(0), tow), "No GPS time before tagging");
+    for (uint32_t s = 1; s <= 20; s++) {
+        pulseAt(s);
+        if (s == 2) {
+            // NAV-PVT for the second pulse 70 ms after it, and a 10 Hz one
+            // that is not on a whole second
+            timeBase.onGpsEpoch((uint32_t)((towAtZero + 2000000ULL) / 1000), localAt(2070000ULL));
+            timeBase.onGpsEpoch((uint32_t)((towAtZero + 2100000ULL) / 1000), localAt(2170000ULL));
+        }
+    }
+    assertTrue(timeBase.hasGpsTime(), "Pulse tagged with its GPS second");
+
+    // 20.25 s after zero is past the week boundary
+    uint64_t trueUs = 20250000ULL;
+    assertTrue(timeBase.toGpsTowUs(localAt(trueUs), tow), "Converts to GPS time");
+    uint64_t expected = (towAtZero + trueUs) % GPS_WEEK_US;
+    Serial.print("tow error us: "); Serial.println(absDiff(tow, expected));
+    assertTrue(absDiff(tow, expected) < 20, "GPS time of week within 20 us");
+
+    uint64_t local;
+    assertTrue(timeBase.toLocalUs(expected, local), "Converts back to local time");
+    assertTrue(absDiff(local, localAt(trueUs)) < 20, "Round trip within 20 us");
+    assertTrue(timeBase.toLocalUs((towAtZero + 19000000ULL) % GPS_WEEK_US, local) &&
+               absDiff(local, localAt(19000000ULL)) < 20, "Round trip across the week boundary");
+
+    timeBase.onGpsEpoch(1000, localAt(25000000ULL));
+    uint64_t again;
+    timeBase.toGpsTowUs(localAt(trueUs), again);
+    assertTrue(again == tow, "Epoch far from the last pulse is ignored");
+}
+
+void runAllTests() {
+    Serial.println("Starting Time Base Unit Tests...");
+    Serial.println("=====================================");
+
+    testExtension();
+    testDiscipline();
+    testBadPulses();
+    testGpsTime();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Time Base Unit Test Suite");
+    Serial.println("=========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,219 @@
+/**
+ * @file trace_unit_test.cpp
+ * @brief Unit tests for the hot-path trace ring
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Tests event encoding, ring overwrite, long gaps and the dump format read
+ * by tools/trace_to_chrome, and prints the cost of a TRACE_BEGIN/TRACE_END
+ * pair. The dump of a simulated frame is echoed so it can be captured and
+ * converted on the host.
+ */
+
+#include <Arduino.h>
+#include "../../modules/software_decision/software_utility/trace.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Collects dumpTrace() output
+String dumpText;
+uint8_t dumpLines = 0;
+
+void captureLine(void* context, const char* line, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        dumpText += line[i];
+    }
+    dumpLines++;
+}
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+// Test functions
+void testEventEncoding() {
+    Serial.println("\n=== Testing Event Encoding ===");
+    traceBuffer.clear();
+
+    TRACE_BEGIN(PID);
+    delayMicroseconds(200);
+    TRACE_END(PID);
+
+    TraceEvent begin, end;
+    assertEqual(2, traceBuffer.getCount(), "Two events recorded");
+    assertTrue(traceBuffer.getEvent(0, begin) && traceBuffer.getEvent(1, end), "Events readable");
+    assertEqual((long)TraceId::PID, begin.id, "BEGIN carries point ID");
+    assertEqual((long)TraceId::PID | TRACE_END_FLAG, end.id, "END sets top bit");
+    assertTrue(end.delta >= 200, "END delta covers the span");
+}
+
+void testScope() {
+    Serial.println("\n=== Testing Scoped Trace ===");
+    traceBuffer.clear();
+    {
+        TRACE_SCOPE(MIXER);
+        delayMicroseconds(50);
+    }
+    TraceEvent end;
+    traceBuffer.getEvent(1, end);
+    assertEqual((long)TraceId::MIXER | TRACE_END_FLAG, end.id, "Scope ends on exit");
+}
+
+void testOverwrite() {
+    Serial.println("\n=== Testing Ring Overwrite ===");
+    traceBuffer.clear();
+    for (uint16_t i = 0; i < TRACE_CAPACITY + 10; i++) {
+        TRACE_BEGIN(LOGGING);
+    }
+    assertEqual(TRACE_CAPACITY, traceBuffer.getCount(), "Ring holds capacity events");
+    assertEqual(10, traceBuffer.getOverwritten(), "Overwritten events counted");
+
+    traceBuffer.freeze();
+    TRACE_BEGIN(SD_WRITE);
+    TraceEvent newest;
+    traceBuffer.getEvent(TRACE_CAPACITY - 1, newest);
+    assertEqual((long)TraceId::LOGGING, newest.id, "Frozen ring ignores events");
+    traceBuffer.resume();
+}
+
+void testLongGap() {
+    Serial.println("\n=== Testing Long Gap ===");
+    traceBuffer.clear();
+    TRACE_BEGIN(TELEMETRY);
+    delay(70);
+    TRACE_END(TELEMETRY);
+
+    TraceEvent high, end;
+    assertEqual(3, traceBuffer.getCount(), "Gap adds a high-delta event");
+    traceBuffer.getEvent(1, high);
+    traceBuffer.getEvent(2, end);
+    assertEqual(TRACE_DELTA_HIGH, high.id, "High-delta marker");
+    uint32_t gap = ((uint32_t)high.delta << 16) | end.delta;
+    assertTrue(gap >= 70000UL, "Full gap recoverable");
+}
+
+void testDumpFormat() {
+    Serial.println("\n=== Testing Dump Format ===");
+    traceBuffer.clear();
+
+    // One simulated frame
+    TRACE_BEGIN(FRAME);
+    TRACE_BEGIN(IMU_READ);   delayMicroseconds(400); TRACE_END(IMU_READ);
+    TRACE_BEGIN(ESTIMATION); delayMicroseconds(900); TRACE_END(ESTIMATION);
+    TRACE_BEGIN(PID);        delayMicroseconds(300); TRACE_END(PID);
+    TRACE_BEGIN(MIXER);      delayMicroseconds(100); TRACE_END(MIXER);
+    TRACE_END(FRAME);
+
+    dumpText = "";
+    dumpLines = 0;
+    assertEqual(10, dumpTrace(captureLine, nullptr), "All events dumped");
+    assertEqual(3, dumpLines, "Header plus two event lines");
+    assertTrue(dumpText.startsWith("@T 000a "), "Header carries event count");
+    assertTrue(dumpText.indexOf("\n@E 0000") > 0, "First event is FRAME begin");
+    assertEqual(0, traceBuffer.getCount(), "Dump drains the ring");
+    assertTrue(!traceBuffer.isFrozen(), "Running ring resumes after the dump");
+
+    traceBuffer.freeze();
+    dumpTrace(captureLine, nullptr);
+    assertTrue(traceBuffer.isFrozen(), "Frozen ring stays frozen after the dump");
+    traceBuffer.resume();
+
+    Serial.println("Captured frame (feed to trace_to_chrome):");
+    Serial.print(dumpText);
+}
+
+void testTiming() {
+    Serial.println("\n=== Testing Call Cost ===");
+    const uint16_t iterations = 1000;
+    volatile uint16_t sink = 0;
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        sink += i;
+    }
+    unsigned long baseline = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        TRACE_BEGIN(PID);
+        sink += i;
+        TRACE_END(PID);
+    }
+    unsigned long traced = micros() - start;
+    traceBuffer.clear();
+
+    Serial.print("TRACE_BEGIN + TRACE_END: ");
+    Serial.print((float)(traced - baseline) / iterations);
+    Serial.println(" us/pair");
+    assertTrue(traced >= baseline, "Timing measured");
+}
+
+void runAllTests() {
+    Serial.println("Starting Trace Unit Tests...");
+    Serial.println("=====================================");
+
+    testEventEncoding();
+    testScope();
+    testOverwrite();
+    testLongGap();
+    testDumpFormat();
+    testTiming();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Trace Unit Test Suite");
+    Serial.println("=====================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
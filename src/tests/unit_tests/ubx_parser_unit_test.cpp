@@ -0,0 +1,362 @@
+/**
+ * @file ubx_parser_unit_test.cpp
+ * @brief Unit tests for the UBX NAV-PVT/STATUS/DOP parser
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Checks configuration frame encoding against known receiver frames,
+ * decoding of NAV-PVT (including negative coordinates), NAV-STATUS,
+ * NAV-DOP and ACK, and resynchronisation on noise, NMEA text, corrupted
+ * checksums, false lengths and oversized frames. A benchmark parses the
+ * same recorded flight as UBX and as NMEA (GGA, RMC, GSA through TinyGPS++)
+ * and reports time and link bytes per epoch.
+ */
+
+#include <Arduino.h>
+#include <string.h>
+#include <stdio.h>
+#include <TinyGPS++.h>
+#include "../../modules/hardware_hiding/device_interface/ubx_parser.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static void putU2(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void putU4(uint8_t* p, uint32_t v) { putU2(p, v & 0xFFFF); putU2(p + 2, v >> 16); }
+
+struct Epoch {
+    uint32_t iTOW;
+    int32_t lat, lon;       // 1e-7 deg
+    int32_t hMSL;           // mm
+    int32_t gSpeed;         // mm/s
+    int32_t headMot;        // 1e-5 deg
+    uint8_t numSV;
+    uint16_t hDOP;          // 0.01
+};
+
+// One epoch as the receiver sends it: NAV-STATUS, NAV-DOP, NAV-PVT
+static uint16_t buildUbxEpoch(const Epoch& e, uint8_t* out, uint16_t outSize) {
+    uint8_t status[16], dop[18], pvt[92];
+    memset(status, 0, sizeof(status));
+    putU4(status, e.iTOW);
+    status[4] = UBX_FIX_3D;
+    status[5] = 0x01;
+    putU4(status + 12, 60000 + e.iTOW);
+
+    memset(dop, 0, sizeof(dop));
+    putU4(dop, e.iTOW);
+    putU2(dop + 6, 160);
+    putU2(dop + 10, 210);
+    putU2(dop + 12, e.hDOP);
+
+    memset(pvt, 0, sizeof(pvt));
+    putU4(pvt, e.iTOW);
+    putU2(pvt + 4, 2025);
+    pvt[6] = 6; pvt[7] = 14; pvt[8] = 12; pvt[9] = 30;
+    pvt[10] = (e.iTOW / 1000) % 60;
+    pvt[11] = 0x07;
+    pvt[20] = UBX_FIX_3D;
+    pvt[21] = 0x01;
+    pvt[23] = e.numSV;
+    putU4(pvt + 24, (uint32_t)e.lon);
+    putU4(pvt + 28, (uint32_t)e.lat);
+    putU4(pvt + 32, (uint32_t)(e.hMSL + 46900));
+    putU4(pvt + 36, (uint32_t)e.hMSL);
+    putU4(pvt + 40, 1500);
+    putU4(pvt + 44, 2500);
+    putU4(pvt + 60, (uint32_t)e.gSpeed);
+    putU4(pvt + 64, (uint32_t)e.headMot);
+
+    uint16_t n = ubxFrame(UBX_CLASS_NAV, UBX_NAV_STATUS, status, sizeof(status), out, outSize);
+    n += ubxFrame(UBX_CLASS_NAV, UBX_NAV_DOP, dop, sizeof(dop), out + n, outSize - n);
+    n += ubxFrame(UBX_CLASS_NAV, UBX_NAV_PVT, pvt, sizeof(pvt), out + n, outSize - n);
+    return n;
+}
+
+static uint16_t nmeaSentence(const char* body, char* out, uint16_t outSize) {
+    uint8_t sum = 0;
+    for (const char* c = body; *c; c++) {
+        sum ^= (uint8_t)*c;
+    }
+    return snprintf(out, outSize, "$%s*%02X\r\n", body, sum);
+}
+
+static void nmeaAngle(int32_t value, bool latitude, char* out, uint16_t outSize) {
+    uint32_t magnitude = value < 0 ? -value : value;
+    uint32_t degrees = magnitude / 10000000UL;
+    double minutes = (magnitude % 10000000UL) * 60.0 / 1e7;
+    snprintf(out, outSize, latitude ? "%02u%08.5f,%c" : "%03u%08.5f,%c", (unsigned)degrees, minutes,
+             latitude ? (value < 0 ? 'S' : 'N') : (value < 0 ? 'W' : 'E'));
+}
+
+// The same epoch as NMEA: GGA, GSA and RMC
+static uint16_t buildNmeaEpoch(const Epoch& e, char* out, uint16_t outSize) {
+    char lat[24], lon[24], body[128];
+    nmeaAngle(e.lat, true, lat, sizeof(lat));
+    nmeaAngle(e.lon, false, lon, sizeof(lon));
+    uint32_t seconds = e.iTOW / 1000;
+    unsigned hh = 12, mm = 30 + (seconds / 60) % 30, ss = seconds % 60, cs = (e.iTOW % 1000) / 10;
+
+    uint16_t n = 0;
+    snprintf(body, sizeof(body), "GPGGA,%02u%02u%02u.%02u,%s,%s,1,%02u,%.2f,%.1f,M,46.9,M,,",
+             hh, mm, ss, cs, lat, lon, e.numSV, e.hDOP * 0.01, e.hMSL * 1e-3);
+    n += nmeaSentence(body, out + n, outSize - n);
+    snprintf(body, sizeof(body), "GPGSA,A,3,04,05,09,12,24,25,29,31,,,,,1.60,%.2f,2.10", e.hDOP * 0.01);
+    n += nmeaSentence(body, out + n, outSize - n);
+    snprintf(body, sizeof(body), "GPRMC,%02u%02u%02u.%02u,A,%s,%s,%.3f,%.2f,140625,,,A",
+             hh, mm, ss, cs, lat, lon, e.gSpeed * 1e-3 / 0.514444, e.headMot * 1e-5);
+    n += nmeaSentence(body, out + n, outSize - n);
+    return n;
+}
+
+static Epoch makeEpoch(uint32_t i) {
+    Epoch e;
+    e.iTOW = 388800000UL + i * 100;
+    e.lat = 515074000L + (int32_t)(i * 37);
+    e.lon = -1278000L - (int32_t)(i * 53);
+    e.hMSL = 120000 + (int32_t)(i % 500) * 10;
+    e.gSpeed = 15000 + (int32_t)(i % 100) * 20;
+    e.headMot = 9000000 + (int32_t)(i % 360) * 100000;
+    e.numSV = 8 + i % 6;
+    e.hDOP = 90 + i % 40;
+    return e;
+}
+
+static uint8_t feed(UbxParser& parser, const uint8_t* bytes, uint16_t length) {
+    uint8_t got = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        got |= parser.encode(bytes[i]);
+    }
+    return got;
+}
+
+// Test functions
+void testConfigFrames() {
+    Serial.println("\n=== Testing Configuration Frames ===");
+    uint8_t frame[32];
+    // CFG-RATE 100 ms as u-center writes it
+    static const uint8_t rate10Hz[14] = { 0xB5, 0x62, 0x06, 0x08, 0x06, 0x00, 0x64, 0x00,
+                                          0x01, 0x00, 0x01, 0x00, 0x7A, 0x12 };
+    uint16_t n = ubxCfgRate(100, frame, sizeof(frame));
+    assertTrue(n == sizeof(rate10Hz) && memcmp(frame, rate10Hz, n) == 0, "CFG-RATE 10 Hz matches u-center");
+
+    // CFG-MSG NAV-PVT on, short form
+    static const uint8_t pvtOn[11] = { 0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x07, 0x01, 0x13, 0x51 };
+    n = ubxCfgMsg(UBX_CLASS_NAV, UBX_NAV_PVT, 1, frame, sizeof(frame));
+    assertTrue(n == sizeof(pvtOn) && memcmp(frame, pvtOn, n) == 0, "CFG-MSG NAV-PVT matches u-center");
+
+    n = ubxCfgPrtUart(115200, frame, sizeof(frame));
+    assertEqual(28, n, "CFG-PRT frame length");
+    assertTrue(frame[14] == 0x00 && frame[15] == 0xC2 && frame[16] == 0x01, "CFG-PRT carries 115200");
+    assertTrue(frame[18] == 0x01 && frame[20] == 0x01, "CFG-PRT is UBX in and out");
+    UbxParser parser;
+    assertEqual(UBX_GOT_OTHER, feed(parser, frame, n), "CFG-PRT parses back with a good checksum");
+    assertEqual(0, ubxCfgPrtUart(115200, frame, 20), "Builder refuses a short buffer");
+}
+
+void testNavDecoding() {
+    Serial.println("\n=== Testing NAV Decoding ===");
+    UbxParser parser;
+    uint8_t stream[256];
+    Epoch e = makeEpoch(7);
+    e.lat = -338688000L;
+    e.lon = 1512093000L;
+    uint16_t n = buildUbxEpoch(e, stream, sizeof(stream));
+
+    uint8_t got = feed(parser, stream, n);
+    const UbxNavSolution& nav = parser.getSolution();
+    assertEqual(UBX_GOT_PVT | UBX_GOT_STATUS | UBX_GOT_DOP, got, "All three messages decoded");
+    assertEqual(e.lat, nav.lat, "Negative latitude");
+    assertEqual(e.lon, nav.lon, "Longitude");
+    assertEqual(e.hMSL, nav.hMSL, "Height above MSL");
+    assertEqual(e.gSpeed, nav.gSpeed, "Ground speed");
+    assertEqual(e.headMot, nav.headMot, "Heading of motion");
+    assertEqual(e.numSV, nav.numSV, "Satellites");
+    assertEqual(UBX_FIX_3D, nav.fixType, "Fix type");
+    assertEqual(2025, nav.year, "Date");
+    assertEqual(e.hDOP, nav.hDOP, "HDOP from NAV-DOP");
+    assertEqual(60000 + e.iTOW, nav.msss, "NAV-STATUS msss");
+    assertTrue(parser.isEpochComplete(), "Epoch complete");
+    assertEqual(3, parser.getFrames(), "Frames counted");
+
+    // NAV-PVT of the next epoch without its DOP
+    Epoch next = makeEpoch(8);
+    n = buildUbxEpoch(next, stream, sizeof(stream));
+    feed(parser, stream + 34, n - 34);
+    assertTrue(!parser.isEpochComplete(), "Missing NAV-DOP detected");
+
+    uint8_t ack[2] = { UBX_CLASS_CFG, UBX_CFG_RATE };
+    n = ubxFrame(UBX_CLASS_ACK, UBX_ACK_ACK, ack, 2, stream, sizeof(stream));
+    assertEqual(UBX_GOT_ACK, feed(parser, stream, n), "ACK decoded");
+    assertTrue(parser.isAckFor(UBX_CLASS_CFG, UBX_CFG_RATE), "ACK names the message");
+}
+
+void testResync() {
+    Serial.println("\n=== Testing Resynchronisation ===");
+    UbxParser parser;
+    uint8_t stream[600];
+    uint16_t n = 0;
+
+    static const char noise[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    memcpy(stream + n, noise, sizeof(noise) - 1);
+    n += sizeof(noise) - 1;
+    stream[n++] = UBX_SYNC1;                    // B5 B5 62 ...
+    uint16_t first = n;
+    n += buildUbxEpoch(makeEpoch(1), stream + n, sizeof(stream) - n);
+    stream[first + 20] ^= 0x40;                 // Corrupt NAV-STATUS payload
+    stream[n++] = UBX_SYNC1;                    // False sync with a huge length
+    stream[n++] = UBX_SYNC2;
+    stream[n++] = 0x01;
+    stream[n++] = 0x07;
+    stream[n++] = 0xFF;
+    stream[n++] = 0xFF;
+    n += buildUbxEpoch(makeEpoch(2), stream + n, sizeof(stream) - n);
+
+    uint8_t payload[120];
+    memset(payload, 0x11, sizeof(payload));
+    n += ubxFrame(0x02, 0x15, payload, sizeof(payload), stream + n, sizeof(stream) - n);
+
+    uint8_t pvtCount = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        pvtCount += (parser.encode(stream[i]) & UBX_GOT_PVT) != 0;
+    }
+    assertEqual(2, pvtCount, "Both NAV-PVT recovered through noise");
+    assertEqual(makeEpoch(2).lat, parser.getSolution().lat, "Latest epoch kept");
+    assertEqual(2, parser.getChecksumErrors(), "Bad checksum and false length counted");
+    assertEqual(1, parser.getSkippedFrames(), "Oversized frame skipped");
+    assertTrue(parser.isEpochComplete(), "Second epoch complete");
+}
+
+void benchmarkAgainstNmea() {
+    Serial.println("\n=== Benchmark: UBX vs NMEA (TinyGPS++) ===");
+#ifdef ARDUINO
+    const uint16_t epochs = 200;
+#else
+    const uint16_t epochs = 20000;
+#endif
+    static uint8_t ubxBytes[256];
+    static char nmeaBytes[400];
+    unsigned long ubxTime = 0, nmeaTime = 0;
+    uint32_t ubxLength = 0, nmeaLength = 0;
+    uint32_t ubxEpochs = 0, nmeaEpochs = 0;
+    double worstError = 0;
+
+    UbxParser parser;
+    TinyGPSPlus nmea;
+    for (uint16_t i = 0; i < epochs; i++) {
+        Epoch e = makeEpoch(i);
+        uint16_t ubxN = buildUbxEpoch(e, ubxBytes, sizeof(ubxBytes));
+        uint16_t nmeaN = buildNmeaEpoch(e, nmeaBytes, sizeof(nmeaBytes));
+        ubxLength += ubxN;
+        nmeaLength += nmeaN;
+
+        unsigned long start = micros();
+        for (uint16_t b = 0; b < ubxN; b++) {
+            if (parser.encode(ubxBytes[b]) & UBX_GOT_PVT) {
+                ubxEpochs++;
+            }
+        }
+        ubxTime += micros() - start;
+
+        start = micros();
+        for (uint16_t b = 0; b < nmeaN; b++) {
+            nmea.encode(nmeaBytes[b]);
+        }
+        if (nmea.location.isUpdated()) {
+            double lat = nmea.location.lat();
+            nmeaEpochs++;
+            nmeaTime += micros() - start;
+            double error = fabs(lat - parser.getSolution().lat * 1e-7);
+            if (error > worstError) {
+                worstError = error;
+            }
+        } else {
+            nmeaTime += micros() - start;
+        }
+    }
+
+    float ubxPerEpoch = (float)ubxTime / epochs;
+    float nmeaPerEpoch = (float)nmeaTime / epochs;
+    Serial.print("UBX us/epoch: "); Serial.println(ubxPerEpoch, 3);
+    Serial.print("NMEA us/epoch: "); Serial.println(nmeaPerEpoch, 3);
+    Serial.print("UBX bytes/epoch: "); Serial.println((float)ubxLength / epochs, 3);
+    Serial.print("NMEA bytes/epoch: "); Serial.println((float)nmeaLength / epochs, 3);
+    // 10 bits per byte on the wire
+    Serial.print("NMEA max Hz at 9600: "); Serial.println(960.0 * epochs / nmeaLength, 3);
+    Serial.print("UBX max Hz at 115200: "); Serial.println(11520.0 * epochs / ubxLength, 3);
+    assertEqual(epochs, ubxEpochs, "Every UBX epoch decoded");
+    assertEqual(epochs, nmeaEpochs, "Every NMEA epoch decoded");
+    assertTrue(worstError < 1e-6, "Both agree on position");
+    assertTrue(ubxPerEpoch < nmeaPerEpoch, "UBX parses faster than NMEA");
+}
+
+void runAllTests() {
+    Serial.println("Starting UBX Parser Unit Tests...");
+    Serial.println("=====================================");
+
+    testConfigFrames();
+    testNavDecoding();
+    testResync();
+    benchmarkAgainstNmea();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("UBX Parser Unit Test Suite");
+    Serial.println("==========================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,190 @@
+/**
+ * @file ultrasonic_ranger_unit_test.cpp
+ * @brief Unit tests for interrupt-timed HC-SR04 ranging
+ * @author Velma Development Team
+ * @version 1.0
+ * @date 2025
+ *
+ * @details
+ * Feeds simulated echo edges to UltrasonicRanger the way its interrupt
+ * would. Checks distance from echo width, the median-of-N filter against
+ * outliers, timeouts, out-of-range echoes, the refused trigger during a
+ * no-target echo, and temperature compensation.
+ */
+
+#include <Arduino.h>
+#include "../../modules/hardware_hiding/device_interface/ultrasonic_ranger.h"
+
+// Test results tracking
+bool allTestsPassed = true;
+int testsRun = 0;
+int testsPassed = 0;
+
+// Test utilities
+void assertTrue(bool condition, const char* testName) {
+    testsRun++;
+    if (condition) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+    }
+    Serial.println(testName);
+}
+
+void assertEqual(long expected, long actual, const char* testName) {
+    testsRun++;
+    if (expected == actual) {
+        testsPassed++;
+        Serial.print("PASS: ");
+    } else {
+        allTestsPassed = false;
+        Serial.print("FAIL: ");
+        Serial.print(testName);
+        Serial.print(" - Expected: ");
+        Serial.print(expected);
+        Serial.print(", Got: ");
+        Serial.println(actual);
+        return;
+    }
+    Serial.println(testName);
+}
+
+static UltrasonicRanger ranger;
+static uint32_t now = 0xFFFFF000UL;     // Echoes straddle a micros() wrap
+
+// One ping: echo rises after 450 us and lasts widthUs (0 for none)
+static UltrasonicResult ping(uint32_t widthUs) {
+    if (!ranger.trigger(now)) {
+        return UltrasonicResult::PENDING;
+    }
+    if (widthUs > 0) {
+        ranger.onEchoEdge(true, now + 450);
+        if (ranger.poll(now + 450 + widthUs / 2) != UltrasonicResult::PENDING) {
+            return UltrasonicResult::NO_ECHO;
+        }
+        ranger.onEchoEdge(false, now + 450 + widthUs);
+    }
+    UltrasonicResult result = ranger.poll(now + 450 + widthUs + 100);
+    if (widthUs == 0) {
+        result = ranger.poll(now + ULTRASONIC_TIMEOUT_US + 1);
+    }
+    now += ULTRASONIC_MIN_CYCLE_MS * 1000UL;
+    return result;
+}
+
+static bool near(float a, float b, float tolerance) {
+    return a > b - tolerance && a < b + tolerance;
+}
+
+// Test functions
+void testDistance() {
+    Serial.println("\n=== Testing Echo Timing ===");
+    ranger.reset();
+    assertTrue(!ranger.hasDistance(), "No distance before an echo");
+    // 1 m at 20 C: 2 m of travel at 343.42 m/s
+    assertTrue(ping(5824) == UltrasonicResult::ECHO, "Echo collected");
+    assertTrue(near(ranger.getDistance(), 1.0f, 0.002f), "5824 us is 1 m");
+    assertTrue(ping(583) == UltrasonicResult::ECHO && ping(583) == UltrasonicResult::ECHO, "Short echoes");
+    assertTrue(near(ranger.getDistance(), 0.1f, 0.002f), "Median follows the majority");
+    assertEqual(3, ranger.getEchoes(), "Echoes counted");
+}
+
+void testMedian() {
+    Serial.println("\n=== Testing Median Filter ===");
+    const uint16_t odd[5] = { 900, 100, 500, 300, 700 };
+    assertEqual(500, UltrasonicRanger::median(odd, 5), "Median of five");
+    assertEqual(400, UltrasonicRanger::median(odd, 4), "Median of four is the middle mean");
+    assertEqual(900, UltrasonicRanger::median(odd, 1), "Median of one");
+
+    ranger.reset();
+    const uint16_t widths[8] = { 2912, 2915, 20000, 2910, 2918, 150, 2909, 2914 };
+    bool steady = true;
+    for (uint8_t i = 0; i < 8; i++) {
+        ping(widths[i]);
+        if (i >= 2) {
+            steady &= near(ranger.getDistance(), 0.5f, 0.003f);
+        }
+    }
+    assertTrue(steady, "Spikes and dropouts do not reach the distance");
+}
+
+void testMisses() {
+    Serial.println("\n=== Testing Timeouts and Range ===");
+    ranger.reset();
+    ping(2912);
+    float before = ranger.getDistance();
+
+    assertTrue(ping(0) == UltrasonicResult::NO_ECHO, "No echo times out");
+    assertTrue(ping(80) == UltrasonicResult::NO_ECHO, "Echo below 2 cm rejected");
+    assertEqual(2, ranger.getMisses(), "Misses counted");
+    assertTrue(ranger.getDistance() == before, "Distance kept through misses");
+
+    // No target: echo stays high ~38 ms, past the timeout
+    ranger.trigger(now);
+    ranger.onEchoEdge(true, now + 450);
+    assertTrue(ranger.poll(now + 20000) == UltrasonicResult::PENDING, "Pending while the echo is high");
+    assertTrue(ranger.poll(now + ULTRASONIC_TIMEOUT_US + 1) == UltrasonicResult::NO_ECHO, "Timed out while high");
+    assertTrue(!ranger.trigger(now + ULTRASONIC_TIMEOUT_US + 2), "No new ping while the echo is high");
+    ranger.onEchoEdge(false, now + 38450);
+    assertTrue(ranger.poll(now + 38500) == UltrasonicResult::NO_ECHO, "Late end of the echo is out of range");
+    now += 60000;
+    assertTrue(ping(2912) == UltrasonicResult::ECHO, "Next ping works");
+
+    // A stray rising edge with no ping outstanding is ignored
+    ranger.onEchoEdge(true, now);
+    ranger.onEchoEdge(false, now + 1000);
+    assertTrue(ranger.poll(now + 2000) == UltrasonicResult::NO_ECHO, "Unrequested echo ignored");
+}
+
+void testTemperature() {
+    Serial.println("\n=== Testing Temperature Compensation ===");
+    ranger.reset();
+    ranger.setTemperature(-10.0f);
+    ping(5824);
+    float cold = ranger.getDistance();
+    ranger.reset();
+    ranger.setTemperature(35.0f);
+    ping(5824);
+    float hot = ranger.getDistance();
+    Serial.print("1 m echo at -10 C / 35 C: "); Serial.print(cold, 3);
+    Serial.print(" / "); Serial.println(hot, 3);
+    assertTrue(near(cold, 0.947f, 0.003f) && near(hot, 1.027f, 0.003f), "Speed of sound follows temperature");
+}
+
+void runAllTests() {
+    Serial.println("Starting Ultrasonic Ranger Unit Tests...");
+    Serial.println("=====================================");
+
+    testDistance();
+    testMedian();
+    testMisses();
+    testTemperature();
+
+    // Print test summary
+    Serial.println("\n=====================================");
+    Serial.println("Test Summary:");
+    Serial.print("Tests Run: ");
+    Serial.println(testsRun);
+    Serial.print("Tests Passed: ");
+    Serial.println(testsPassed);
+    Serial.print("Tests Failed: ");
+    Serial.println(testsRun - testsPassed);
+    Serial.print("Overall Result: ");
+    Serial.println(allTestsPassed ? "ALL TESTS PASSED" : "SOME TESTS FAILED");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("Ultrasonic Ranger Unit Test Suite");
+    Serial.println("=================================");
+
+    runAllTests();
+}
+
+void loop() {
+    // Tests run once in setup
+}
@@ -0,0 +1,60 @@
+// Pressure to altitude table generator for the barometer.
+//
+// Build: g++ -O2 -o altitude_table_gen altitude_table_gen.cpp
+//
+// Usage: altitude_table_gen > ../modules/hardware_hiding/device_interface/altitude_table.h
+//
+// Tabulates the ISA troposphere, h = T0 / L * (1 - (p / P0)^(R L / g)),
+// in centimetres at fixed pressure steps from P0 = 101325 Pa. Linear
+// interpolation between 500 Pa steps is within 0.2 m of the formula at
+// 30 kPa (about 9 km) and within 2 cm near sea level.
+
+#include <math.h>
+#include <stdio.h>
+
+static const double T0 = 288.15;        // K
+static const double L = 0.0065;         // K/m
+static const double R = 287.053;        // J/(kg K)
+static const double G = 9.80665;        // m/s^2
+static const double P0 = 101325.0;      // Pa
+
+static const int MIN_PA = 30000;
+static const int MAX_PA = 110000;
+static const int STEP_PA = 500;
+
+static double altitude(double pa) {
+    return T0 / L * (1.0 - pow(pa / P0, R * L / G));
+}
+
+int main() {
+    int count = (MAX_PA - MIN_PA) / STEP_PA + 1;
+
+    // Worst interpolation error, sampled between entries
+    double worst = 0.0;
+    for (int i = 0; i + 1 < count; i++) {
+        double p0 = MIN_PA + i * STEP_PA;
+        double h0 = floor(altitude(p0) * 100.0 + 0.5) / 100.0;
+        double h1 = floor(altitude(p0 + STEP_PA) * 100.0 + 0.5) / 100.0;
+        for (int k = 1; k < 10; k++) {
+            double f = k / 10.0;
+            double error = fabs(h0 + (h1 - h0) * f - altitude(p0 + STEP_PA * f));
+            worst = error > worst ? error : worst;
+        }
+    }
+
+    printf("#ifndef ALTITUDE_TABLE_H\n#define ALTITUDE_TABLE_H\n\n");
+    printf("// Generated by tools/altitude_table_gen. Do not edit.\n\n");
+    printf("#define ALTITUDE_TABLE_MIN_PA %d\n", MIN_PA);
+    printf("#define ALTITUDE_TABLE_STEP_PA %d\n", STEP_PA);
+    printf("#define ALTITUDE_TABLE_COUNT %d\n\n", count);
+    printf("// ISA altitude in cm at ALTITUDE_TABLE_MIN_PA + i * ALTITUDE_TABLE_STEP_PA\n");
+    printf("static const int32_t ALTITUDE_TABLE[ALTITUDE_TABLE_COUNT] PROGMEM = {");
+    for (int i = 0; i < count; i++) {
+        long cm = lround(altitude(MIN_PA + i * STEP_PA) * 100.0);
+        printf("%s%s%ld", i ? "," : "", (i % 8) ? " " : "\n    ", cm);
+    }
+    printf("\n};\n\n#endif // ALTITUDE_TABLE_H\n");
+
+    fprintf(stderr, "%d entries, worst interpolation error %.3f m\n", count, worst);
+    return 0;
+}
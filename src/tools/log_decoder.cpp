@@ -0,0 +1,170 @@
+// Host-side flight log decoder.
+//
+// Build: g++ -O2 -o log_decoder log_decoder.cpp
+//            ../modules/behavior_hiding/shared_services/log_index.cpp
+//            ../modules/behavior_hiding/shared_services/deferred_log.cpp
+//
+// Usage: log_decoder <log file> [--from ms] [--to ms] [--first-error] [--index]
+//
+// Uses the seek index footer (or the .IDX sidecar of a log that was never
+// closed) to jump straight to a time window or to the first ERROR_EVENT.
+// Logs without any index are scanned linearly. Deferred event records
+// ("@D" lines) are expanded to text using the log_formats.h dictionary.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "../modules/behavior_hiding/shared_services/log_index.h"
+#include "../modules/behavior_hiding/shared_services/deferred_log.h"
+
+static const char* const LEVEL_NAMES[] = { "DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL" };
+
+static uint16_t readFileAt(void* context, uint32_t offset, char* buffer, uint16_t length) {
+    FILE* file = static_cast<FILE*>(context);
+    if (fseek(file, offset, SEEK_SET) != 0) {
+        return 0;
+    }
+    return (uint16_t)fread(buffer, 1, length, file);
+}
+
+static uint32_t fileSize(FILE* file) {
+    fseek(file, 0, SEEK_END);
+    return (uint32_t)ftell(file);
+}
+
+static std::string sidecarName(const std::string& filename) {
+    size_t dot = filename.find_last_of('.');
+    return (dot == std::string::npos ? filename : filename.substr(0, dot)) + ".IDX";
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool printDeferredLine(const char* line) {
+    uint8_t record[DLOG_MAX_RECORD_SIZE];
+    uint8_t length = 0;
+    for (const char* p = line + 3; length < DLOG_MAX_RECORD_SIZE; p += 2) {
+        int high = hexValue(p[0]);
+        int low = high < 0 ? -1 : hexValue(p[1]);
+        if (low < 0) {
+            break;
+        }
+        record[length++] = (uint8_t)((high << 4) | low);
+    }
+    if (length < DLOG_HEADER_SIZE) {
+        return false;
+    }
+
+    char text[256];
+    formatDeferredRecord(record, length, text, sizeof(text));
+    uint8_t level = deferredRecordLevel(record);
+    const char* component = deferredComponent(deferredRecordId(record));
+    printf("%u,%s,%s,%s\n", (unsigned)deferredRecordTimestamp(record),
+           level <= DLOG_LEVEL_CRITICAL ? LEVEL_NAMES[level] : "?",
+           component != nullptr ? component : "?", text);
+    return true;
+}
+
+static void printRange(FILE* file, uint32_t start, uint32_t end) {
+    char line[512];
+    fseek(file, start, SEEK_SET);
+    while (ftell(file) < (long)end && fgets(line, sizeof(line), file) != nullptr) {
+        if (isLogIndexLine(line)) {
+            continue;
+        }
+        if (strncmp(line, "@D ", 3) == 0 && printDeferredLine(line)) {
+            continue;
+        }
+        fputs(line, stdout);
+    }
+}
+
+static void printIndex(LogIndexReader& reader) {
+    LogIndexEntry entry;
+    printf("%10s %10s %10s %5s %5s\n", "timestamp", "offset", "record", "flags", "cumul");
+    for (uint32_t i = 0; reader.getEntry(i, entry); i++) {
+        printf("%10u %10u %10u  %04x  %04x\n", (unsigned)entry.timestamp, (unsigned)entry.offset,
+               (unsigned)entry.recordNumber, entry.blockFlags, entry.cumulativeFlags);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <log file> [--from ms] [--to ms] [--first-error] [--index]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t fromTime = 0;
+    uint32_t toTime = 0xFFFFFFFF;
+    bool firstError = false;
+    bool dumpIndex = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--from") == 0 && i + 1 < argc) {
+            fromTime = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--to") == 0 && i + 1 < argc) {
+            toTime = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--first-error") == 0) {
+            firstError = true;
+        } else if (strcmp(argv[i], "--index") == 0) {
+            dumpIndex = true;
+        }
+    }
+
+    FILE* log = fopen(argv[1], "rb");
+    if (log == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    uint32_t logSize = fileSize(log);
+    uint32_t dataEnd = logSize;
+
+    FILE* sidecar = nullptr;
+    LogIndexReader reader(readFileAt, log);
+    if (reader.openFooter(logSize)) {
+        dataEnd = reader.getFooterOffset();
+    } else {
+        sidecar = fopen(sidecarName(argv[1]).c_str(), "rb");
+        if (sidecar != nullptr) {
+            reader = LogIndexReader(readFileAt, sidecar);
+            reader.openSidecar(fileSize(sidecar));
+        }
+    }
+    if (!reader.isValid()) {
+        fprintf(stderr, "no seek index, scanning linearly\n");
+    }
+
+    LogIndexEntry entry;
+    uint32_t index;
+    if (dumpIndex) {
+        printIndex(reader);
+    } else if (firstError) {
+        if (!reader.isValid() || !reader.findFirstWithFlags(LOG_FLAG_ERROR_EVENT, entry, &index)) {
+            fprintf(stderr, "no ERROR_EVENT found\n");
+        } else {
+            LogIndexEntry next;
+            uint32_t end = reader.getEntry(index + 1, next) ? next.offset : dataEnd;
+            printRange(log, entry.offset, end);
+        }
+    } else {
+        uint32_t start = 0;
+        uint32_t end = dataEnd;
+        if (reader.findByTime(fromTime, entry)) {
+            start = entry.offset;
+        }
+        if (reader.findByTime(toTime, entry, &index) && reader.getEntry(index + 1, entry)) {
+            end = entry.offset;
+        }
+        printRange(log, start, end);
+    }
+
+    if (sidecar != nullptr) {
+        fclose(sidecar);
+    }
+    fclose(log);
+    return 0;
+}
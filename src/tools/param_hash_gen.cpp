@@ -0,0 +1,111 @@
+// Minimal perfect hash generator for SYSTEM_PARAMS names.
+//
+// Build: g++ -O2 -o param_hash_gen param_hash_gen.cpp
+//
+// Usage: param_hash_gen > ../modules/behavior_hiding/shared_services/system_params_hash.h
+//
+// Hash and displace: every name falls into a bucket by paramHash(name, 0).
+// Buckets are placed largest first; each gets the first 8-bit seed that
+// sends all of its names, by paramHash(name, seed), to distinct free slots.
+// The output holds one seed per bucket plus the slot -> Param order.
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "../modules/behavior_hiding/shared_services/system_params.h"
+
+#define PARAM_NAME(id, name, kind, def, lo, hi, category, persistent) name,
+
+static const char* const NAMES[] = { SYSTEM_PARAMS(PARAM_NAME) };
+
+#undef PARAM_NAME
+
+static bool build(uint8_t bucketCount, std::vector<uint8_t>& seeds, std::vector<uint8_t>& order) {
+    std::vector<std::vector<uint8_t> > buckets(bucketCount);
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        uint8_t length = (uint8_t)strlen(NAMES[i]);
+        buckets[paramHash(NAMES[i], length, 0) % bucketCount].push_back(i);
+    }
+
+    std::vector<uint8_t> bySize(bucketCount);
+    for (uint8_t b = 0; b < bucketCount; b++) bySize[b] = b;
+    std::stable_sort(bySize.begin(), bySize.end(), [&](uint8_t a, uint8_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    seeds.assign(bucketCount, 0);
+    order.assign(PARAM_COUNT, 0xFF);
+    std::vector<bool> used(PARAM_COUNT, false);
+    for (uint8_t b : bySize) {
+        if (buckets[b].empty()) {
+            continue;
+        }
+        bool placed = false;
+        for (uint16_t seed = 1; seed < 256 && !placed; seed++) {
+            std::vector<uint8_t> slots;
+            for (uint8_t key : buckets[b]) {
+                uint8_t slot = paramHash(NAMES[key], (uint8_t)strlen(NAMES[key]), (uint8_t)seed) % PARAM_COUNT;
+                if (used[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (slots.size() == buckets[b].size()) {
+                for (size_t k = 0; k < slots.size(); k++) {
+                    used[slots[k]] = true;
+                    order[slots[k]] = buckets[b][k];
+                }
+                seeds[b] = (uint8_t)seed;
+                placed = true;
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+        if (strlen(NAMES[i]) > PARAM_NAME_MAX) {
+            fprintf(stderr, "name too long: %s\n", NAMES[i]);
+            return 1;
+        }
+        for (uint8_t j = 0; j < i; j++) {
+            if (strcmp(NAMES[i], NAMES[j]) == 0) {
+                fprintf(stderr, "duplicate name: %s\n", NAMES[i]);
+                return 1;
+            }
+        }
+    }
+
+    std::vector<uint8_t> seeds, order;
+    uint8_t bucketCount = (PARAM_COUNT + 3) / 4;
+    while (!build(bucketCount, seeds, order)) {
+        if (++bucketCount > PARAM_COUNT) {
+            fprintf(stderr, "no perfect hash found\n");
+            return 1;
+        }
+    }
+
+    printf("#ifndef SYSTEM_PARAMS_HASH_H\n#define SYSTEM_PARAMS_HASH_H\n\n");
+    printf("// Generated by tools/param_hash_gen from SYSTEM_PARAMS. Do not edit.\n\n");
+    printf("#define PARAM_HASH_KEYS %u\n", PARAM_COUNT);
+    printf("#define PARAM_HASH_BUCKETS %u\n\n", bucketCount);
+    printf("// Per-bucket seed for the slot hash\n");
+    printf("static const uint8_t PARAM_HASH_SEEDS[PARAM_HASH_BUCKETS] PROGMEM = {");
+    for (uint8_t b = 0; b < bucketCount; b++) {
+        printf("%s%s%u", b ? "," : "", (b % 16) ? " " : "\n    ", seeds[b]);
+    }
+    printf("\n};\n\n// Slot -> Param\n");
+    printf("static const uint8_t PARAM_HASH_ORDER[PARAM_HASH_KEYS] PROGMEM = {");
+    for (uint8_t s = 0; s < PARAM_COUNT; s++) {
+        printf("%s%s%u", s ? "," : "", (s % 16) ? " " : "\n    ", order[s]);
+    }
+    printf("\n};\n\n#endif // SYSTEM_PARAMS_HASH_H\n");
+
+    fprintf(stderr, "%u names, %u buckets\n", PARAM_COUNT, bucketCount);
+    return 0;
+}
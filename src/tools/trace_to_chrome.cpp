@@ -0,0 +1,133 @@
+// Host-side trace converter.
+//
+// Build: g++ -O2 -o trace_to_chrome trace_to_chrome.cpp
+//            ../modules/software_decision/software_utility/trace.cpp
+//
+// Usage: trace_to_chrome <serial capture or log file> > trace.json
+//
+// Collects every "@T"/"@E" snapshot written by dumpTrace(), rebuilds
+// absolute times from the per-event deltas and prints Chrome trace JSON
+// that chrome://tracing and ui.perfetto.dev load directly. END events
+// whose BEGIN was overwritten in the ring are dropped.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "../modules/software_decision/software_utility/trace.h"
+
+struct Snapshot {
+    uint32_t lastTime;
+    uint32_t overwritten;
+    std::vector<TraceEvent> events;
+};
+
+static bool parseHex(const char* text, uint8_t digits, uint32_t& value) {
+    value = 0;
+    for (uint8_t i = 0; i < digits; i++) {
+        char c = text[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+        else return false;
+        value = (value << 4) | nibble;
+    }
+    return true;
+}
+
+static void readSnapshots(FILE* file, std::vector<Snapshot>& snapshots) {
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        uint32_t count, lastTime, overwritten;
+        if (strncmp(line, "@T ", 3) == 0 && parseHex(line + 3, 4, count) &&
+            parseHex(line + 8, 8, lastTime) && parseHex(line + 17, 4, overwritten)) {
+            Snapshot snapshot;
+            snapshot.lastTime = lastTime;
+            snapshot.overwritten = overwritten;
+            snapshots.push_back(snapshot);
+        } else if (strncmp(line, "@E", 2) == 0 && !snapshots.empty()) {
+            for (const char* p = line + 2; p[0] == ' '; p += 9) {
+                uint32_t id, delta;
+                if (!parseHex(p + 1, 4, id) || !parseHex(p + 5, 4, delta)) {
+                    break;
+                }
+                TraceEvent event = { (uint16_t)id, (uint16_t)delta };
+                snapshots.back().events.push_back(event);
+            }
+        }
+    }
+}
+
+// Absolute times, walking back from the newest event
+static void rebuildTimes(const Snapshot& snapshot, std::vector<uint32_t>& times) {
+    const std::vector<TraceEvent>& events = snapshot.events;
+    times.assign(events.size(), 0);
+    uint32_t time = snapshot.lastTime;
+    for (size_t i = events.size(); i-- > 0;) {
+        times[i] = time;
+        if (events[i].id == TRACE_DELTA_HIGH) {
+            continue;
+        }
+        uint32_t delta = events[i].delta;
+        if (i > 0 && events[i - 1].id == TRACE_DELTA_HIGH) {
+            delta |= (uint32_t)events[i - 1].delta << 16;
+        }
+        time -= delta;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture> > trace.json\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<Snapshot> snapshots;
+    readSnapshots(file, snapshots);
+    fclose(file);
+
+    printf("{\"traceEvents\":[\n");
+    bool first = true;
+    size_t total = 0;
+    uint32_t lost = 0;
+    for (size_t s = 0; s < snapshots.size(); s++) {
+        const Snapshot& snapshot = snapshots[s];
+        std::vector<uint32_t> times;
+        rebuildTimes(snapshot, times);
+        lost += snapshot.overwritten;
+
+        int open[static_cast<uint16_t>(TraceId::COUNT)] = { 0 };
+        for (size_t i = 0; i < snapshot.events.size(); i++) {
+            uint16_t id = snapshot.events[i].id;
+            const char* name = traceIdName(id);
+            if (id == TRACE_DELTA_HIGH || name == nullptr) {
+                continue;
+            }
+            uint16_t point = id & ~TRACE_END_FLAG;
+            bool end = (id & TRACE_END_FLAG) != 0;
+            if (end) {
+                if (open[point] == 0) {
+                    continue;
+                }
+                open[point]--;
+            } else {
+                open[point]++;
+            }
+            printf("%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":1}",
+                   first ? "" : ",\n", name, end ? 'E' : 'B', (unsigned long)times[i]);
+            first = false;
+            total++;
+        }
+    }
+    printf("\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    fprintf(stderr, "%zu events from %zu snapshots, %lu overwritten before dump\n",
+            total, snapshots.size(), (unsigned long)lost);
+    return 0;
+}